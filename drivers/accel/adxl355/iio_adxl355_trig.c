@@ -49,6 +49,7 @@
 /******************************************************************************/
 struct iio_trigger adxl355_iio_trig_desc = {
 	.is_synchronous = false,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable
 };
@@ -42,6 +42,38 @@
 #include "no_os_delay.h"
 #include "no_os_print_log.h"
 
+/* Raw result fields of a conversion frame with bits per channel packet. */
+#define AD4858_RAW_FIELDS(bits) { \
+	{ 0 * (bits), 20 }, { 1 * (bits), 20 }, \
+	{ 2 * (bits), 20 }, { 3 * (bits), 20 }, \
+	{ 4 * (bits), 20 }, { 5 * (bits), 20 }, \
+	{ 6 * (bits), 20 }, { 7 * (bits), 20 }, \
+}
+
+/* Status fields offsets from the start of a channel packet. */
+#define AD4858_OR_UR_OFFSET	20
+#define AD4858_CHN_ID_OFFSET	21
+#define AD4858_SPAN_ID_OFFSET	24
+
+/**
+ * @struct ad4858_frame_layout
+ * @brief Conversion frame layout of a packet format.
+ */
+static const struct ad4858_frame_layout {
+	/** Packet size in bits */
+	uint8_t chn_bits;
+	/** OR/UR and channel ID bits follow the result */
+	bool has_status;
+	/** Softspan ID bits follow the status */
+	bool has_softspan;
+	/** Raw result field of each channel */
+	struct no_os_bitfield raw[AD4858_NUM_CHANNELS];
+} ad4858_frame_layouts[AD4858_NUM_OF_PACKETS] = {
+	[AD4858_PACKET_20_BIT] = { 20, false, false, AD4858_RAW_FIELDS(20) },
+	[AD4858_PACKET_24_BIT] = { 24, true, false, AD4858_RAW_FIELDS(24) },
+	[AD4858_PACKET_32_BIT] = { 32, true, true, AD4858_RAW_FIELDS(32) },
+};
+
 /**
  * @brief Write device register.
  * @param dev- The device structure.
@@ -658,88 +690,81 @@ int ad4858_perform_conv(struct ad4858_dev *dev)
  */
 int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data)
 {
-	int ret;
+	const struct ad4858_frame_layout *layout;
+	uint8_t buff[32] = {0};
 	uint16_t nb_bytes;
-	uint8_t indx;
+	uint16_t offset;
 	uint8_t chn;
-	uint8_t buff[32] = {0};
-	// Buffer index offset for each channel while reading 20-bit conversion result
-	uint8_t buff_chn_offset[] = { 0, 2, 5, 7, 10, 12, 15, 17 };
+	int ret;
 
-	if (!dev || !data)
+	if (!dev || !data || dev->packet_format >= AD4858_NUM_OF_PACKETS)
 		return -EINVAL;
 
-	switch (dev->packet_format) {
-	case AD4858_PACKET_20_BIT:
-		nb_bytes = (20 * AD4858_NUM_CHANNELS) >> 3;
-		break;
-
-	case AD4858_PACKET_24_BIT:
-		nb_bytes = (24 * AD4858_NUM_CHANNELS) >> 3;
-		break;
+	layout = &ad4858_frame_layouts[dev->packet_format];
 
-	case AD4858_PACKET_32_BIT:
-		nb_bytes = (32 * AD4858_NUM_CHANNELS) >> 3;
-		break;
-
-	default:
-		return -EINVAL;
-	}
+	nb_bytes = layout->chn_bits * AD4858_NUM_CHANNELS / 8;
 
 	/* Read SPI data */
 	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
 	if (ret)
 		return ret;
 
-	switch (dev->packet_format) {
-	case AD4858_PACKET_20_BIT:
-		/* 20-bit conversion result */
-		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-			indx = buff_chn_offset[chn];
-			if (!(chn % 2))
-				data->raw[chn] = (((uint32_t)buff[indx] << 16) |
-						  ((uint32_t)buff[indx + 1] << 8) |
-						  (buff[indx + 2])) >> 4;
-			else
-				data->raw[chn] = ((uint32_t)(buff[indx] & 0x0f) << 16) |
-						 ((uint32_t)buff[indx + 1] << 8) |
-						 (buff[indx + 2]);
-		}
-		break;
-
-	case AD4858_PACKET_24_BIT:
-		/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID */
-		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-			indx = chn * 3;
-			data->raw[chn] = (((uint32_t)buff[indx] << 16) |
-					  ((uint32_t)buff[indx + 1] << 8) |
-					  (buff[indx + 2])) >> 4;
-			data->or_ur_status[chn] = (buff[indx + 2] >> 3) & 0x1;
-			data->chn_id[chn] = buff[indx + 2] & 0x7;
+	for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
+		offset = layout->raw[chn].offset;
+		data->raw[chn] = no_os_get_bitfield_be(buff, offset, 20);
+
+		if (layout->has_status) {
+			data->or_ur_status[chn] =
+				no_os_get_bitfield_be(buff, offset +
+						      AD4858_OR_UR_OFFSET, 1);
+			data->chn_id[chn] =
+				no_os_get_bitfield_be(buff, offset +
+						      AD4858_CHN_ID_OFFSET, 3);
 		}
-		chn = 0;
-		break;
-
-	case AD4858_PACKET_32_BIT:
-		/* 20-bit conversion result + 1-bit OR/UR + 3-bit channel ID + 4-bit softspan ID + 4 0's */
-		for (chn = 0; chn < AD4858_NUM_CHANNELS; chn++) {
-			indx = chn * 4;
-			data->raw[chn] = (((uint32_t)buff[indx] << 16) |
-					  ((uint32_t)buff[indx + 1] << 8) |
-					  (buff[indx + 2])) >> 4;
-			data->or_ur_status[chn] = (buff[indx + 2] >> 3) & 0x1;
-			data->chn_id[chn] = buff[indx + 2] & 0x7;
-			data->softspan_id[chn] = (buff[indx + 3] >> 4) & 0xf;
-		}
-		break;
 
-	default:
-		return -EINVAL;
+		if (layout->has_softspan)
+			data->softspan_id[chn] =
+				no_os_get_bitfield_be(buff, offset +
+						      AD4858_SPAN_ID_OFFSET, 4);
 	}
 
 	return 0;
 }
 
+/**
+ * @brief Read the conversion frame and unpack the selected channels.
+ * @param dev - Pointer to the device structure.
+ * @param chn_mask - Bit i selects channel i.
+ * @param scan - Raw results of the selected channels, in channel order and
+ * 		 with the status bits stripped.
+ * @return Number of unpacked channels in case of success, negative error
+ * 	   code otherwise.
+ * @note The frame is clocked out only up to the last selected channel.
+ */
+int ad4858_spi_data_read_scan(struct ad4858_dev *dev, uint8_t chn_mask,
+			      uint32_t *scan)
+{
+	const struct ad4858_frame_layout *layout;
+	uint8_t buff[32] = {0};
+	uint16_t nb_bytes;
+	int ret;
+
+	if (!dev || !scan || !chn_mask ||
+	    dev->packet_format >= AD4858_NUM_OF_PACKETS)
+		return -EINVAL;
+
+	layout = &ad4858_frame_layouts[dev->packet_format];
+	nb_bytes = NO_OS_DIV_ROUND_UP((no_os_find_last_set_bit(chn_mask) + 1) *
+				      layout->chn_bits, 8);
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, buff, nb_bytes);
+	if (ret)
+		return ret;
+
+	return no_os_unpack_bitfields(buff, layout->raw, AD4858_NUM_CHANNELS,
+				      chn_mask, sizeof(*scan), scan);
+}
+
 /**
  * @brief Read ADC data (for all channels).
  * @param dev - Pointer to the device structure.
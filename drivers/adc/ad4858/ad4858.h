@@ -442,6 +442,10 @@ int ad4858_perform_conv(struct ad4858_dev *dev);
 /* Read ADC conversion data over SPI. */
 int ad4858_spi_data_read(struct ad4858_dev *dev, struct ad4858_conv_data *data);
 
+/* Read ADC conversion data over SPI into a scan of the selected channels. */
+int ad4858_spi_data_read_scan(struct ad4858_dev *dev, uint8_t chn_mask,
+			      uint32_t *scan);
+
 /* Perform conversion and read ADC data (for all channels). */
 int ad4858_read_data(struct ad4858_dev *dev, struct ad4858_conv_data *data);
 
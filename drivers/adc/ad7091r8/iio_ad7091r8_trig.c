@@ -53,6 +53,7 @@
 #ifndef LINUX_PLATFORM
 struct iio_trigger ad7091r8_iio_timer_trig_desc = {
 	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable,
 };
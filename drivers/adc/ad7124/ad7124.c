@@ -440,6 +440,218 @@ int32_t ad7124_get_read_chan_id(struct ad7124_dev *dev, uint32_t *status)
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Clock bytes in continuous read mode.
+ * @param dev     - The handler of the instance of the driver.
+ * @param tx      - Bytes to send, NULL to keep DIN low.
+ * @param rx      - Buffer for the received bytes, may be NULL.
+ * @param len     - Number of bytes to transfer.
+ * @param release - Deassert CS at the end of the transfer. CS is otherwise
+ *                  kept asserted so that DOUT/RDY keeps signalling new data.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int ad7124_cont_xfer(struct ad7124_dev *dev, uint8_t *tx, uint8_t *rx,
+			    uint32_t len, bool release)
+{
+	struct no_os_spi_msg msg = {
+		.tx_buff = tx,
+		.rx_buff = rx,
+		.bytes_number = len,
+		.cs_change = release,
+	};
+
+	return no_os_spi_transfer(dev->spi_desc, &msg, 1);
+}
+
+/***************************************************************************//**
+ * @brief Read one continuous read frame into the sample ring.
+ * @param dev - The handler of the instance of the driver.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int ad7124_cont_read_frame(struct ad7124_dev *dev)
+{
+	uint8_t frame[AD7124_CONT_FRAME_LEN];
+	uint32_t head, next;
+	int ret;
+
+	ret = ad7124_cont_xfer(dev, NULL, frame, sizeof(frame), false);
+	if (ret)
+		return ret;
+
+	head = dev->ring_head;
+	next = (head + 1) % AD7124_RING_SIZE;
+	if (next == dev->ring_tail) {
+		dev->overruns++;
+		return 0;
+	}
+
+	dev->ring[head].value = no_os_get_unaligned_be24(frame);
+	dev->ring[head].ch = AD7124_STATUS_REG_CH_ACTIVE(frame[3]);
+	dev->ring_head = next;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief DOUT/RDY falling edge handler used in continuous read mode.
+ * @param context - The handler of the instance of the driver.
+*******************************************************************************/
+static void ad7124_rdy_irq_handler(void *context)
+{
+	struct ad7124_dev *dev = context;
+	uint8_t rdy;
+
+	/* DOUT toggles while a frame is clocked out, only a low level is RDY */
+	if (no_os_gpio_get_value(dev->gpio_rdy, &rdy) || rdy)
+		return;
+
+	ad7124_cont_read_frame(dev);
+}
+
+/***************************************************************************//**
+ * @brief Enter continuous read mode with the status byte appended to the data.
+ *
+ * Conversions are clocked out as fixed 4 byte frames without a command byte
+ * and the channel ID is decoded from the appended status byte. When an
+ * interrupt controller is available the frames are read on the DOUT/RDY
+ * falling edge, otherwise ad7124_get_cont_sample() polls the pin. No other
+ * register access is allowed until ad7124_stop_cont_read() is called.
+ * @param dev - The handler of the instance of the driver.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_start_cont_read(struct ad7124_dev *dev)
+{
+	uint8_t buf[3];
+	uint32_t ctrl;
+	int ret;
+
+	if (!dev || !dev->gpio_rdy)
+		return -EINVAL;
+
+	/* The frame length is only fixed with the interface CRC disabled */
+	if (dev->use_crc != AD7124_DISABLE_CRC)
+		return -EINVAL;
+
+	if (dev->cont_read)
+		return -EBUSY;
+
+	ctrl = dev->regs[AD7124_ADC_Control].value |
+	       AD7124_ADC_CTRL_REG_CONT_READ | AD7124_ADC_CTRL_REG_DATA_STATUS;
+
+	dev->ring_head = 0;
+	dev->ring_tail = 0;
+	dev->overruns = 0;
+
+	buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_WR |
+		 AD7124_COMM_REG_RA(AD7124_ADC_CTRL_REG);
+	no_os_put_unaligned_be16(ctrl, &buf[1]);
+
+	ret = ad7124_cont_xfer(dev, buf, NULL, sizeof(buf), false);
+	if (ret)
+		return ret;
+
+	dev->regs[AD7124_ADC_Control].value = ctrl;
+	dev->cont_read = true;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+		if (ret) {
+			ad7124_stop_cont_read(dev);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Exit continuous read mode.
+ *
+ * The exit command is only accepted while DOUT/RDY is low, so the function
+ * waits for the next conversion and clocks it out along with the command.
+ * @param dev - The handler of the instance of the driver.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+int ad7124_stop_cont_read(struct ad7124_dev *dev)
+{
+	uint8_t buf[AD7124_CONT_FRAME_LEN + 1] = { 0 };
+	uint32_t timeout;
+	uint8_t rdy;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->cont_read)
+		return 0;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		if (ret)
+			return ret;
+	}
+
+	timeout = dev->spi_rdy_poll_cnt;
+	do {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+	} while (rdy && --timeout);
+
+	if (!timeout)
+		return -ETIMEDOUT;
+
+	buf[0] = AD7124_COMM_REG_WEN | AD7124_COMM_REG_RD |
+		 AD7124_COMM_REG_RA(AD7124_DATA_REG);
+	ret = ad7124_cont_xfer(dev, buf, NULL, sizeof(buf), true);
+	if (ret)
+		return ret;
+
+	dev->regs[AD7124_ADC_Control].value &= ~AD7124_ADC_CTRL_REG_CONT_READ;
+	dev->cont_read = false;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Get the next conversion captured in continuous read mode.
+ * @param dev    - The handler of the instance of the driver.
+ * @param sample - Pointer to store the conversion and its channel.
+ * @return Returns 0 for success, -EAGAIN if no conversion is available yet or
+ *         negative error code otherwise.
+*******************************************************************************/
+int ad7124_get_cont_sample(struct ad7124_dev *dev,
+			   struct ad7124_sample *sample)
+{
+	uint32_t tail;
+	uint8_t rdy;
+	int ret;
+
+	if (!dev || !sample || !dev->cont_read)
+		return -EINVAL;
+
+	if (!dev->irq_ctrl && dev->ring_head == dev->ring_tail) {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+		if (rdy)
+			return -EAGAIN;
+
+		ret = ad7124_cont_read_frame(dev);
+		if (ret)
+			return ret;
+	}
+
+	tail = dev->ring_tail;
+	if (dev->ring_head == tail)
+		return -EAGAIN;
+
+	*sample = dev->ring[tail];
+	dev->ring_tail = (tail + 1) % AD7124_RING_SIZE;
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Computes the CRC checksum for a data buffer.
  * @param p_buf    - Data buffer
@@ -987,6 +1199,42 @@ int ad7124_set_power_mode(struct ad7124_dev *device,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Register the DOUT/RDY interrupt used in continuous read mode.
+ * @param dev      - The device structure.
+ * @param irq_ctrl - The interrupt controller the RDY pin is routed to.
+ * @return Returns 0 for success or negative error code otherwise.
+*******************************************************************************/
+static int ad7124_rdy_init(struct ad7124_dev *dev,
+			   struct no_os_irq_ctrl_desc *irq_ctrl)
+{
+	int ret;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = ad7124_rdy_irq_handler,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(irq_ctrl, dev->gpio_rdy->number,
+					  &dev->irq_cb);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_trigger_level_set(irq_ctrl, dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret) {
+		no_os_irq_unregister_callback(irq_ctrl, dev->gpio_rdy->number,
+					      &dev->irq_cb);
+		return ret;
+	}
+
+	dev->irq_ctrl = irq_ctrl;
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Initializes the AD7124.
  * @param device     - The device structure.
@@ -1002,7 +1250,7 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	uint8_t setup_index;
 	uint8_t ch_index;
 
-	dev = (struct ad7124_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad7124_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
 
@@ -1014,18 +1262,34 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	if (ret)
 		goto error_dev;
 
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param->gpio_rdy);
+	if (ret)
+		goto error_spi;
+
+	if (dev->gpio_rdy) {
+		ret = no_os_gpio_direction_input(dev->gpio_rdy);
+		if (ret)
+			goto error_gpio;
+
+		if (init_param->irq_ctrl) {
+			ret = ad7124_rdy_init(dev, init_param->irq_ctrl);
+			if (ret)
+				goto error_gpio;
+		}
+	}
+
 	/* Update the device structure with power-on/reset settings. */
 	dev->check_ready = init_param->check_ready;
 
 	/*  Reset the device interface.*/
 	ret = ad7124_reset(dev);
 	if (ret)
-		goto error_spi;
+		goto error_irq;
 
 	/* Initialize ADC mode register. */
 	ret = ad7124_write_register(dev, dev->regs[AD7124_ADC_CTRL_REG]);
 	if (ret)
-		goto error_spi;
+		goto error_irq;
 
 	/* Get CRC State. */
 	ad7124_update_crcsetting(dev);
@@ -1036,13 +1300,13 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 	/* Read ID register to identify the part. */
 	ret = ad7124_read_register(dev, &dev->regs[AD7124_ID_REG]);
 	if (ret)
-		goto error_spi;
+		goto error_irq;
 	if (dev->active_device == ID_AD7124_4) {
 		if (dev->regs[AD7124_ID_REG].value != AD7124_4_ID)
-			goto error_spi;
+			goto error_irq;
 	} else if (dev->active_device == ID_AD7124_8) {
 		if (dev->regs[AD7124_ID_REG].value != AD7124_8_ID)
-			goto error_spi;
+			goto error_irq;
 	}
 
 	for (setup_index = 0; setup_index < AD7124_MAX_SETUPS; setup_index++) {
@@ -1050,60 +1314,67 @@ int32_t ad7124_setup(struct ad7124_dev **device,
 					  init_param->setups[setup_index].bi_unipolar,
 					  setup_index);
 		if (ret)
-			goto error_spi;
+			goto error_irq;
 
 		ret = ad7124_set_reference_source(dev,
 						  init_param->setups[setup_index].ref_source,
 						  setup_index,
 						  init_param->ref_en);
 		if (ret)
-			goto error_spi;
+			goto error_irq;
 
 		ret = ad7124_enable_buffers(dev,
 					    init_param->setups[setup_index].ain_buff,
 					    init_param->setups[setup_index].ref_buff,
 					    setup_index);
 		if (ret)
-			goto error_spi;
+			goto error_irq;
 	}
 
 	ret = ad7124_set_adc_mode(dev, init_param->mode);
 	if (ret)
-		goto error_spi;
+		goto error_irq;
 
 	ret = ad7124_set_power_mode(dev,
 				    init_param->power_mode);
 	if (ret)
-		goto error_spi;
+		goto error_irq;
 
 	for (ch_index = 0; ch_index < AD7124_MAX_CHANNELS; ch_index++) {
 		ret = ad7124_connect_analog_input(dev,
 						  ch_index,
 						  init_param->chan_map[ch_index].ain);
 		if (ret)
-			goto error_spi;
+			goto error_irq;
 
 		ret = ad7124_assign_setup(dev,
 					  ch_index,
 					  init_param->chan_map[ch_index].setup_sel);
 		if (ret)
-			goto error_spi;
+			goto error_irq;
 
 		ret = ad7124_set_channel_status(dev,
 						ch_index,
 						init_param->chan_map[ch_index].channel_enable);
 		if (ret)
-			goto error_spi;
+			goto error_irq;
 	}
 
 	*device = dev;
 
 	return 0;
 
+error_irq:
+	if (dev->irq_ctrl)
+		no_os_irq_unregister_callback(dev->irq_ctrl,
+					      dev->gpio_rdy->number,
+					      &dev->irq_cb);
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
 error_spi:
 	no_os_spi_remove(dev->spi_desc);
 error_dev:
-	free(dev);
+	no_os_free(dev);
 
 	return ret;
 }
@@ -1117,6 +1388,22 @@ int32_t ad7124_remove(struct ad7124_dev *dev)
 {
 	int32_t ret;
 
+	ret = ad7124_stop_cont_read(dev);
+	if (ret)
+		return ret;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_unregister_callback(dev->irq_ctrl,
+						    dev->gpio_rdy->number,
+						    &dev->irq_cb);
+		if (ret)
+			return ret;
+	}
+
+	ret = no_os_gpio_remove(dev->gpio_rdy);
+	if (ret)
+		return ret;
+
 	ret = no_os_spi_remove(dev->spi_desc);
 	if (ret)
 		return ret;
@@ -46,6 +46,8 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_delay.h"
 #include "no_os_util.h"
 
@@ -58,6 +60,10 @@
 
 /* Total Number of Setups */
 #define AD7124_MAX_SETUPS	8
+/* Conversions buffered by the continuous read interrupt handler */
+#define AD7124_RING_SIZE	64u
+/* Continuous read frame: 24-bit conversion followed by the status byte */
+#define AD7124_CONT_FRAME_LEN	4
 /* Maximum number of channels */
 #define AD7124_MAX_CHANNELS	16
 /* Device IDs
@@ -472,6 +478,17 @@ enum ad7124_registers {
 	AD7124_REG_NO
 };
 
+/**
+ * @struct ad7124_sample
+ * @brief Conversion captured in continuous read mode.
+ */
+struct ad7124_sample {
+	/** Channel that produced the conversion, from the status byte */
+	uint8_t ch;
+	/** Raw conversion result */
+	uint32_t value;
+};
+
 /**
  * The structure describes the device and is used with the ad7124 driver.
  * @brief Device Structure
@@ -495,6 +512,17 @@ struct ad7124_dev {
 	struct ad7124_channel_setup setups[AD7124_MAX_SETUPS];
 	/* Channel Mapping*/
 	struct ad7124_channel_map chan_map[AD7124_MAX_CHANNELS];
+	/* DOUT/RDY pin sensed as a GPIO, optional */
+	struct no_os_gpio_desc *gpio_rdy;
+	/* Interrupt controller for the RDY pin, optional */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	struct no_os_callback_desc irq_cb;
+	/* Continuous read state */
+	bool cont_read;
+	struct ad7124_sample ring[AD7124_RING_SIZE];
+	volatile uint32_t ring_head;
+	volatile uint32_t ring_tail;
+	uint32_t overruns;
 };
 
 struct ad7124_init_param {
@@ -516,6 +544,10 @@ struct ad7124_init_param {
 	struct ad7124_channel_setup setups[AD7124_MAX_SETUPS];
 	/* Channel Mapping*/
 	struct ad7124_channel_map chan_map[AD7124_MAX_CHANNELS];
+	/* DOUT/RDY pin sensed as a GPIO, needed for continuous read */
+	struct no_os_gpio_init_param *gpio_rdy;
+	/* Interrupt controller for the RDY pin, optional */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
 };
 
 /******************************************************************************/
@@ -569,6 +601,16 @@ int32_t ad7124_read_data(struct ad7124_dev *dev,
 /* Get the ID of the channel of the latest conversion. */
 int32_t ad7124_get_read_chan_id(struct ad7124_dev *dev, uint32_t *status);
 
+/* Enter continuous read mode with the status byte appended to the data. */
+int ad7124_start_cont_read(struct ad7124_dev *dev);
+
+/* Exit continuous read mode. */
+int ad7124_stop_cont_read(struct ad7124_dev *dev);
+
+/* Get the next conversion captured in continuous read mode. */
+int ad7124_get_cont_sample(struct ad7124_dev *dev,
+			   struct ad7124_sample *sample);
+
 /* Computes the CRC checksum for a data buffer. */
 uint8_t ad7124_compute_crc8(uint8_t* p_buf,
 			    uint8_t buf_size);
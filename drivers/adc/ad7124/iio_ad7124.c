@@ -631,78 +631,130 @@ static int32_t iio_ad7124_close_channels(void *dev)
 }
 
 /**
- * @brief Get active channels in the form of a mask.
+ * @brief Get the next conversion together with the channel that produced it.
  * @param [in] desc - Device descriptor.
- * @param [out] mask - Resulting mask representing active channels.
+ * @param [out] sample - Conversion result and channel ID.
  * @return 0 in case of success, error code otherwise.
  */
-static int32_t iio_ad7124_get_active_channels(struct ad7124_dev * desc,
-		uint32_t *mask)
+static int32_t iio_ad7124_next_sample(struct ad7124_dev *desc,
+				      struct ad7124_sample *sample)
 {
-	int32_t ret, i;
-	uint32_t reg_temp;
+	int32_t ret;
+	int32_t value;
+	uint32_t ch;
 
-	*mask = 0;
-	for (i = 0; i < 16; i++) {
-		ret = ad7124_read_register2(desc,
-					    (AD7124_CH0_MAP_REG + i),
-					    &reg_temp);
+	if (desc->cont_read) {
+		do {
+			ret = ad7124_get_cont_sample(desc, sample);
+		} while (ret == -EAGAIN);
+
+		return ret;
+	}
+
+	ret = ad7124_wait_for_conv_ready(desc, 10000);
+	if (ret != 0)
+		return ret;
+	ret = ad7124_read_data(desc, &value);
+	if (ret != 0)
+		return ret;
+	ret = ad7124_get_read_chan_id(desc, &ch);
+	if (ret != 0)
+		return ret;
+
+	sample->value = value;
+	sample->ch = ch;
+
+	return 0;
+}
+
+/**
+ * @brief Assemble the interleaved conversions into scans and push them.
+ *
+ * The ADC sequences through the enabled channels in ascending order, so a
+ * scan starts at the lowest active channel and is pushed once every active
+ * channel has delivered a conversion. A conversion that arrives out of
+ * sequence discards the partial scan.
+ * @param [in] dev_data - IIO device data.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int32_t iio_ad7124_submit(struct iio_device_data *dev_data)
+{
+	struct ad7124_dev *desc = (struct ad7124_dev *)dev_data->dev;
+	uint32_t mask = dev_data->buffer->active_mask;
+	int32_t scan[AD7124_MAX_CHANNELS];
+	struct ad7124_sample sample;
+	uint32_t got = 0, first, i = 0;
+	int32_t ret;
+
+	if (!mask)
+		return -EINVAL;
+
+	first = no_os_find_first_set_bit(mask);
+
+	while (i < dev_data->buffer->samples) {
+		ret = iio_ad7124_next_sample(desc, &sample);
 		if (ret != 0)
 			return ret;
-		if (reg_temp & AD7124_CH_MAP_REG_CH_ENABLE)
-			*mask |= 1 << i;
+
+		if (!(mask & NO_OS_BIT(sample.ch)))
+			continue;
+
+		if (sample.ch == first || (got & NO_OS_BIT(sample.ch)))
+			got = 0;
+
+		scan[no_os_hweight32(mask & (NO_OS_BIT(sample.ch) - 1))] =
+			sample.value;
+		got |= NO_OS_BIT(sample.ch);
+		if (got != mask)
+			continue;
+
+		ret = iio_buffer_push_scan(dev_data->buffer, scan);
+		if (ret != 0)
+			return ret;
+
+		got = 0;
+		i++;
 	}
 
 	return 0;
 }
 
 /**
- * @brief Get a number of samples from all the active channels.
+ * @brief Enable the buffer channels and start streaming.
  * @param [in] dev - Device descriptor.
- * @param [out] buff - Sample buffer.
- * @param [in] bn_samples - Number of samples to get.
- * @return Number of samples read.
+ * @param [in] mask - Active channels mask.
+ * @return 0 in case of success, error code otherwise.
  */
-static int32_t iio_ad7124_read_samples(void *dev, int32_t *buff,
-				       uint32_t nb_samples)
+static int32_t iio_ad7124_buffer_enable(void *dev, uint32_t mask)
 {
 	struct ad7124_dev *desc = (struct ad7124_dev *)dev;
-	int32_t ret, i = 0, k;
-	int32_t value;
-	uint32_t ch_id = -1, test;
-	uint32_t mask;
+	int32_t ret;
 
-	ret = iio_ad7124_get_active_channels(desc, &mask);
+	ret = iio_ad7124_update_active_channels(dev, mask);
 	if (ret != 0)
 		return ret;
 
-	get_next_ch_idx(mask, ch_id, &ch_id);
-	do {
-		ret = ad7124_wait_for_conv_ready(desc, 10000);
-		if (ret != 0)
-			return ret;
-		ret = ad7124_read_data(desc, &value);
-		if (ret != 0)
-			return ret;
-		ret = ad7124_get_read_chan_id(desc, &test);
-		if (ret != 0)
-			return ret;
-	} while (ch_id != test);
-	buff[i++] = value;
-
-	for (k = 0; k < nb_samples; k++) {
-		while (get_next_ch_idx(mask, ch_id, &ch_id)) {
-			ret = ad7124_wait_for_conv_ready(desc, 10000);
-			if (ret != 0)
-				return ret;
-			ret = ad7124_read_data(desc, &value);
-			if (ret != 0)
-				return ret;
-			buff[i++] = value;
-		}
-	}
+	/* Without the DOUT/RDY pin the conversions are polled over SPI */
+	if (!desc->gpio_rdy || desc->use_crc != AD7124_DISABLE_CRC)
+		return 0;
+
+	return ad7124_start_cont_read(desc);
+}
+
+/**
+ * @brief Stop streaming and disable the buffer channels.
+ * @param [in] dev - Device descriptor.
+ * @return 0 in case of success, error code otherwise.
+ */
+static int32_t iio_ad7124_buffer_disable(void *dev)
+{
+	int32_t ret;
+
+	ret = ad7124_stop_cont_read(dev);
+	if (ret != 0)
+		return ret;
 
-	return nb_samples;
+	return iio_ad7124_close_channels(dev);
 }
 
 struct iio_device iio_ad7124_device = {
@@ -711,9 +763,9 @@ struct iio_device iio_ad7124_device = {
 	.attributes = NULL,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
-	.pre_enable = iio_ad7124_update_active_channels,
-	.post_disable = iio_ad7124_close_channels,
-	.read_dev = (int32_t (*)())iio_ad7124_read_samples,
+	.pre_enable = iio_ad7124_buffer_enable,
+	.post_disable = iio_ad7124_buffer_disable,
+	.submit = iio_ad7124_submit,
 	.debug_reg_read = (int32_t (*)())ad7124_read_register2,
 	.debug_reg_write = (int32_t (*)())ad7124_write_register2
 };
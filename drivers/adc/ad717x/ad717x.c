@@ -526,6 +526,12 @@ int32_t AD717X_WriteRegister(ad717x_dev *device,
 				       wrBuf,
 				       (device->useCRC != AD717X_DISABLE) ?
 				       preg->size + 2 : preg->size + 1);
+	if (ret < 0)
+		return ret;
+
+	/* The data register length only changes with the interface mode */
+	if (preg->addr == AD717X_IFMODE_REG)
+		ret = AD717X_ComputeDataregSize(device);
 
 	return ret;
 }
@@ -609,11 +615,8 @@ int32_t AD717X_ReadData(ad717x_dev *device,
 	if (!dataReg)
 		return INVALID_VAL;
 
-	/* Update the data register length with respect to device and options */
-	ret = AD717X_ComputeDataregSize(device);
-
 	/* Read the value of the Status Register */
-	ret |= AD717X_ReadRegister(device, AD717X_DATA_REG);
+	ret = AD717X_ReadRegister(device, AD717X_DATA_REG);
 
 	/* Get the read result */
 	*pData = dataReg->value;
@@ -773,6 +776,290 @@ int32_t ad717x_configure_device_odr(ad717x_dev *dev,
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Clock bytes in continuous read mode.
+ *
+ * @param dev     - The handler of the instance of the driver.
+ * @param tx      - Bytes to send, NULL to keep DIN low.
+ * @param rx      - Buffer for the received bytes, may be NULL.
+ * @param len     - Number of bytes to transfer.
+ * @param release - Deassert CS at the end of the transfer. CS is otherwise
+ *                  kept asserted so that DOUT/RDY keeps signalling new data.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int ad717x_cont_xfer(ad717x_dev *dev, uint8_t *tx, uint8_t *rx,
+			    uint32_t len, bool release)
+{
+	struct no_os_spi_msg msg = {
+		.tx_buff = tx,
+		.rx_buff = rx,
+		.bytes_number = len,
+		.cs_change = release,
+	};
+
+	return no_os_spi_transfer(dev->spi_desc, &msg, 1);
+}
+
+/***************************************************************************//**
+ * @brief Read one continuous read frame into the sample ring.
+ *
+ * @param dev - The handler of the instance of the driver.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int ad717x_cont_read_frame(ad717x_dev *dev)
+{
+	uint8_t frame[5];
+	uint32_t head, next, value = 0;
+	uint8_t i;
+	int ret;
+
+	ret = ad717x_cont_xfer(dev, NULL, frame, dev->cont_frame_len, false);
+	if (ret)
+		return ret;
+
+	head = dev->ring_head;
+	next = (head + 1) % AD717X_RING_SIZE;
+	if (next == dev->ring_tail) {
+		dev->overruns++;
+		return 0;
+	}
+
+	/* The status byte trails the 16, 24 or 32-bit conversion */
+	for (i = 0; i < dev->cont_frame_len - 1; i++)
+		value = (value << 8) | frame[i];
+
+	dev->ring[head].value = value;
+	dev->ring[head].ch = AD717X_STATUS_REG_CH(frame[i]);
+	dev->ring_head = next;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief DOUT/RDY falling edge handler used in continuous read mode.
+ *
+ * @param context - The handler of the instance of the driver.
+*******************************************************************************/
+static void ad717x_rdy_irq_handler(void *context)
+{
+	ad717x_dev *dev = context;
+	uint8_t rdy;
+
+	/* DOUT toggles while a frame is clocked out, only a low level is RDY */
+	if (no_os_gpio_get_value(dev->gpio_rdy, &rdy) || rdy)
+		return;
+
+	ad717x_cont_read_frame(dev);
+}
+
+/***************************************************************************//**
+ * @brief Register the DOUT/RDY interrupt used in continuous read mode.
+ *
+ * @param dev      - The handler of the instance of the driver.
+ * @param irq_ctrl - The interrupt controller the RDY pin is routed to.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int ad717x_rdy_init(ad717x_dev *dev,
+			   struct no_os_irq_ctrl_desc *irq_ctrl)
+{
+	int ret;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = ad717x_rdy_irq_handler,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(irq_ctrl, dev->gpio_rdy->number,
+					  &dev->irq_cb);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_trigger_level_set(irq_ctrl, dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret) {
+		no_os_irq_unregister_callback(irq_ctrl, dev->gpio_rdy->number,
+					      &dev->irq_cb);
+		return ret;
+	}
+
+	dev->irq_ctrl = irq_ctrl;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Enter continuous read mode with the status byte appended to the data.
+ *
+ * Conversions are clocked out as fixed size frames without a command byte and
+ * the channel ID is decoded from the appended status byte. The frame size is
+ * computed once here from the data word length and the part. When an
+ * interrupt controller is available the frames are read on the DOUT/RDY
+ * falling edge, otherwise ad717x_get_cont_sample() polls the pin. No other
+ * register access is allowed until ad717x_stop_cont_read() is called.
+ *
+ * @param dev - The handler of the instance of the driver.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad717x_start_cont_read(ad717x_dev *dev)
+{
+	ad717x_st_reg *ifmode, *data;
+	uint8_t buf[3];
+	int ret;
+
+	if (!dev || !dev->gpio_rdy)
+		return -EINVAL;
+
+	/* The frame size is only fixed with the interface checksum disabled */
+	if (dev->useCRC != AD717X_DISABLE)
+		return -EINVAL;
+
+	if (dev->cont_read)
+		return -EBUSY;
+
+	ifmode = AD717X_GetReg(dev, AD717X_IFMODE_REG);
+	data = AD717X_GetReg(dev, AD717X_DATA_REG);
+	if (!ifmode || !data)
+		return -EINVAL;
+
+	dev->cont_saved_ifmode = ifmode->value;
+	ifmode->value |= AD717X_IFMODE_REG_CONT_READ |
+			 AD717X_IFMODE_REG_DATA_STAT;
+	AD717X_ComputeDataregSize(dev);
+	dev->cont_frame_len = data->size;
+
+	dev->ring_head = 0;
+	dev->ring_tail = 0;
+	dev->overruns = 0;
+
+	buf[0] = AD717X_COMM_REG_WEN | AD717X_COMM_REG_WR |
+		 AD717X_COMM_REG_RA(AD717X_IFMODE_REG);
+	no_os_put_unaligned_be16(ifmode->value, &buf[1]);
+
+	ret = ad717x_cont_xfer(dev, buf, NULL, sizeof(buf), false);
+	if (ret) {
+		ifmode->value = dev->cont_saved_ifmode;
+		AD717X_ComputeDataregSize(dev);
+		return ret;
+	}
+
+	dev->cont_read = true;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+		if (ret) {
+			ad717x_stop_cont_read(dev);
+			return ret;
+		}
+	}
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Exit continuous read mode.
+ *
+ * The exit command is only accepted while DOUT/RDY is low, so the function
+ * waits for the next conversion and clocks it out along with the command.
+ * The interface mode register is then restored to its value before
+ * ad717x_start_cont_read().
+ *
+ * @param dev - The handler of the instance of the driver.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int ad717x_stop_cont_read(ad717x_dev *dev)
+{
+	uint8_t buf[6] = { 0 };
+	ad717x_st_reg *ifmode;
+	uint32_t timeout = 10000;
+	uint8_t rdy;
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (!dev->cont_read)
+		return 0;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		if (ret)
+			return ret;
+	}
+
+	do {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+	} while (rdy && --timeout);
+
+	if (!timeout)
+		return -ETIMEDOUT;
+
+	buf[0] = AD717X_COMM_REG_WEN | AD717X_COMM_REG_RD |
+		 AD717X_COMM_REG_RA(AD717X_DATA_REG);
+	ret = ad717x_cont_xfer(dev, buf, NULL, dev->cont_frame_len + 1, true);
+	if (ret)
+		return ret;
+
+	dev->cont_read = false;
+
+	/* Restore the interface mode, dropping the status byte if unused */
+	ifmode = AD717X_GetReg(dev, AD717X_IFMODE_REG);
+	ifmode->value = dev->cont_saved_ifmode;
+	ret = AD717X_WriteRegister(dev, AD717X_IFMODE_REG);
+	if (ret)
+		return ret;
+
+	return AD717X_ComputeDataregSize(dev);
+}
+
+/***************************************************************************//**
+ * @brief Get the next conversion captured in continuous read mode.
+ *
+ * @param dev    - The handler of the instance of the driver.
+ * @param sample - Pointer to store the conversion and its channel.
+ *
+ * @return 0 in case of success, -EAGAIN if no conversion is available yet or
+ *         negative error code otherwise.
+*******************************************************************************/
+int ad717x_get_cont_sample(ad717x_dev *dev, struct ad717x_sample *sample)
+{
+	uint32_t tail;
+	uint8_t rdy;
+	int ret;
+
+	if (!dev || !sample || !dev->cont_read)
+		return -EINVAL;
+
+	if (!dev->irq_ctrl && dev->ring_head == dev->ring_tail) {
+		ret = no_os_gpio_get_value(dev->gpio_rdy, &rdy);
+		if (ret)
+			return ret;
+		if (rdy)
+			return -EAGAIN;
+
+		ret = ad717x_cont_read_frame(dev);
+		if (ret)
+			return ret;
+	}
+
+	tail = dev->ring_tail;
+	if (dev->ring_head == tail)
+		return -EAGAIN;
+
+	*sample = dev->ring[tail];
+	dev->ring_tail = (tail + 1) % AD717X_RING_SIZE;
+
+	return 0;
+}
+
 /***************************************************************************//**
 * @brief Initializes the AD717X.
 *
@@ -791,7 +1078,7 @@ int32_t AD717X_Init(ad717x_dev **device,
 	uint8_t setup_index;
 	uint8_t ch_index;
 
-	dev = (ad717x_dev *)no_os_malloc(sizeof(*dev));
+	dev = (ad717x_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
@@ -844,6 +1131,11 @@ int32_t AD717X_Init(ad717x_dev **device,
 	ret = AD717X_ReadRegister(dev, AD717X_ID_REG);
 	if(ret < 0)
 		return ret;
+
+	/* The data register is one byte wider on 32-bit parts */
+	ret = AD717X_ComputeDataregSize(dev);
+	if (ret < 0)
+		return ret;
 	dev->active_device = init_param.active_device;
 	dev->num_channels = init_param.num_channels;
 
@@ -896,8 +1188,32 @@ int32_t AD717X_Init(ad717x_dev **device,
 		if (ret < 0)
 			return ret;
 	}
+
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param.gpio_rdy);
+	if (ret < 0)
+		return ret;
+
+	if (dev->gpio_rdy) {
+		ret = no_os_gpio_direction_input(dev->gpio_rdy);
+		if (ret < 0)
+			goto error_gpio;
+
+		if (init_param.irq_ctrl) {
+			ret = ad717x_rdy_init(dev, init_param.irq_ctrl);
+			if (ret < 0)
+				goto error_gpio;
+		}
+	}
+
 	*device = dev;
 
+	return ret;
+
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
+	no_os_spi_remove(dev->spi_desc);
+	no_os_free(dev);
+
 	return ret;
 }
 
@@ -910,6 +1226,22 @@ int32_t AD717X_remove(ad717x_dev *dev)
 {
 	int32_t ret;
 
+	ret = ad717x_stop_cont_read(dev);
+	if (ret)
+		return ret;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_unregister_callback(dev->irq_ctrl,
+						    dev->gpio_rdy->number,
+						    &dev->irq_cb);
+		if (ret)
+			return ret;
+	}
+
+	ret = no_os_gpio_remove(dev->gpio_rdy);
+	if (ret)
+		return ret;
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	no_os_free(dev);
@@ -48,6 +48,8 @@
 /******************************************************************************/
 #include <stdint.h>
 #include "no_os_spi.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_util.h"
 #include <stdbool.h>
 
@@ -258,6 +260,20 @@ typedef struct {
 	int32_t size;
 } ad717x_st_reg;
 
+/* Conversions buffered by the continuous read interrupt handler */
+#define AD717X_RING_SIZE	64u
+
+/**
+ * @struct ad717x_sample
+ * @brief Conversion captured in continuous read mode.
+ */
+struct ad717x_sample {
+	/** Channel that produced the conversion, from the status byte */
+	uint8_t ch;
+	/** Raw conversion result */
+	uint32_t value;
+};
+
 /*
  * The structure describes the device and is used with the ad717x driver.
  * @slave_select_id: The ID of the Slave Select to be passed to the SPI calls.
@@ -289,6 +305,19 @@ typedef struct {
 	struct ad717x_filtcon filter_configuration[AD717x_MAX_SETUPS];
 	/* ADC Mode */
 	enum ad717x_mode mode;
+	/* DOUT/RDY pin sensed as a GPIO, optional */
+	struct no_os_gpio_desc *gpio_rdy;
+	/* Interrupt controller for the RDY pin, optional */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	struct no_os_callback_desc irq_cb;
+	/* Continuous read state */
+	bool cont_read;
+	uint8_t cont_frame_len;
+	int32_t cont_saved_ifmode;
+	struct ad717x_sample ring[AD717X_RING_SIZE];
+	volatile uint32_t ring_head;
+	volatile uint32_t ring_tail;
+	uint32_t overruns;
 } ad717x_dev;
 
 typedef struct {
@@ -315,6 +344,10 @@ typedef struct {
 	struct ad717x_filtcon filter_configuration[AD717x_MAX_SETUPS];
 	/* ADC Mode */
 	enum ad717x_mode mode;
+	/* DOUT/RDY pin sensed as a GPIO, needed for continuous read */
+	struct no_os_gpio_init_param *gpio_rdy;
+	/* Interrupt controller for the RDY pin, optional */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
 } ad717x_init_param;
 
 /*****************************************************************************/
@@ -612,4 +645,13 @@ int ad717x_single_read(ad717x_dev* device, uint8_t id,
 int32_t ad717x_configure_device_odr(ad717x_dev *dev, uint8_t filtcon_id,
 				    uint8_t odr_sel);
 
+/* Enter continuous read mode with the status byte appended to the data */
+int ad717x_start_cont_read(ad717x_dev *dev);
+
+/* Exit continuous read mode */
+int ad717x_stop_cont_read(ad717x_dev *dev);
+
+/* Get the next conversion captured in continuous read mode */
+int ad717x_get_cont_sample(ad717x_dev *dev, struct ad717x_sample *sample);
+
 #endif /* __AD717X_H__ */
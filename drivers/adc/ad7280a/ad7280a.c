@@ -43,8 +43,19 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
 #include "ad7280a.h"
 #include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+NO_OS_DECLARE_CRC8_TABLE(ad7280a_crc8_table);
+static bool ad7280a_crc8_ready;
 
 /*****************************************************************************/
 /************************ Functions Definitions ******************************/
@@ -65,13 +76,35 @@ int8_t ad7280a_init(struct ad7280a_dev **device,
 		    struct ad7280a_init_param init_param)
 {
 	struct ad7280a_dev *dev;
+	uint32_t nb_words, i;
 	int8_t status;
 	uint32_t value;
 
-	dev = (struct ad7280a_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad7280a_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
+	dev->num_devices = init_param.num_devices ? init_param.num_devices : 2;
+	if (dev->num_devices > AD7280A_MAX_CHAIN)
+		goto error_dev;
+
+	/* Two command words followed by the readback of every channel */
+	nb_words = 2 + dev->num_devices * AD7280A_CHANS_PER_DEV;
+	dev->chain_tx = no_os_calloc(nb_words, sizeof(uint32_t));
+	dev->chain_buf = no_os_calloc(nb_words, sizeof(uint32_t));
+	dev->chain_msgs = no_os_calloc(nb_words, sizeof(*dev->chain_msgs));
+	if (!dev->chain_tx || !dev->chain_buf || !dev->chain_msgs)
+		goto error_chain;
+
+	for (i = 0; i < nb_words; i++) {
+		dev->chain_msgs[i].tx_buff = &dev->chain_buf[i * 4];
+		dev->chain_msgs[i].rx_buff = &dev->chain_buf[i * 4];
+		dev->chain_msgs[i].bytes_number = 4;
+		dev->chain_msgs[i].cs_change = 1;
+		no_os_put_unaligned_be32(AD7280A_READ_TXVAL,
+					 &dev->chain_tx[i * 4]);
+	}
+
 	/* GPIO */
 	status = no_os_gpio_get(&dev->gpio_pd, &init_param.gpio_pd);
 	status |= no_os_gpio_get(&dev->gpio_cnvst, &init_param.gpio_cnvst);
@@ -115,6 +148,15 @@ int8_t ad7280a_init(struct ad7280a_dev **device,
 	*device = dev;
 
 	return status;
+
+error_chain:
+	no_os_free(dev->chain_tx);
+	no_os_free(dev->chain_buf);
+	no_os_free(dev->chain_msgs);
+error_dev:
+	no_os_free(dev);
+
+	return -1;
 }
 
 /***************************************************************************//**
@@ -134,6 +176,9 @@ int32_t ad7280a_remove(struct ad7280a_dev *dev)
 	ret |= no_os_gpio_remove(dev->gpio_cnvst);
 	ret |= no_os_gpio_remove(dev->gpio_alert);
 
+	no_os_free(dev->chain_tx);
+	no_os_free(dev->chain_buf);
+	no_os_free(dev->chain_msgs);
 	no_os_free(dev);
 
 	return ret;
@@ -171,6 +216,31 @@ uint32_t ad7280a_transfer_32bits(struct ad7280a_dev *dev,
 	return received_data;
 }
 
+/******************************************************************************
+ * @brief Computes the CRC of a 21 or 22 bit codeword payload.
+ *
+ * The last byte is only XORed into the remainder, which makes the table
+ * driven computation match the bit serial definition from the datasheet.
+ *
+ * @param val : The payload, right aligned.
+ *
+ * @return The CRC.
+******************************************************************************/
+static uint8_t ad7280a_crc8(uint32_t val)
+{
+	uint8_t buf[3];
+
+	if (!ad7280a_crc8_ready) {
+		no_os_crc8_populate_msb(ad7280a_crc8_table,
+					AD7280A_CRC_POLYNOMIAL);
+		ad7280a_crc8_ready = true;
+	}
+
+	no_os_put_unaligned_be24(val, buf);
+
+	return no_os_crc8(ad7280a_crc8_table, buf, 2, 0) ^ buf[2];
+}
+
 /******************************************************************************
  * @brief Computes the CRC value for a write transmission, and prepares the
  *        complete write codeword
@@ -182,45 +252,12 @@ uint32_t ad7280a_transfer_32bits(struct ad7280a_dev *dev,
 ******************************************************************************/
 uint32_t ad7280a_crc_write(uint32_t message)
 {
-	int32_t i;
-	int32_t crc;
-	int32_t xor1 = 0;
-	int32_t xor2 = 0;
-	int32_t xor3 = 0;
-	int32_t xor4 = 0;
-	int32_t xor5 = 0;
-	uint32_t data_out = 0;
-	int32_t crc0 = 0;
-	int32_t crc1 = 0;
-	int32_t crc2 = 0;
-	int32_t crc3 = 0;
-	int32_t crc4 = 0;
-	int32_t crc5 = 0;
-	int32_t crc6 = 0;
-	int32_t crc7 = 0;
+	uint8_t crc;
 
 	message = message >> 11;
-	for (i = NUMBITS_WRITE; i >= 0; i--) {
-		xor5 = (crc4 ^ crc7) ? 1 : 0;
-		xor4 = (crc2 ^ crc7) ? 1 : 0;
-		xor3 = (crc1 ^ crc7) ? 1 : 0;
-		xor2 = (crc0 ^ crc7) ? 1 : 0;
-		xor1 = ((message & (1 << i)) ? 1 : 0) ^ (crc7 ? 1 : 0);
-		crc7 = crc6;
-		crc6 = crc5;
-		crc5 = xor5;
-		crc4 = crc3;
-		crc3 = xor4;
-		crc2 = xor3;
-		crc1 = xor2;
-		crc0 = xor1;
-	}
-	crc = (crc0 ? (1 << 0) : 0) | (crc1 ? (1 << 1) : 0) | (crc2 ? (1 << 2) : 0) |
-	      (crc3 ? (1 << 3) : 0) | (crc4 ? (1 << 4) : 0) | (crc5 ? (1 << 5) : 0) |
-	      (crc6 ? (1 << 6) : 0) | (crc7 ? (1 << 7) : 0);
-	data_out = (message << 11) | (crc << 3) | 2;
+	crc = ad7280a_crc8(message);
 
-	return data_out;
+	return (message << 11) | (crc << 3) | 2;
 }
 
 /******************************************************************************
@@ -234,50 +271,7 @@ uint32_t ad7280a_crc_write(uint32_t message)
 ******************************************************************************/
 int32_t ad7280a_crc_read(uint32_t message)
 {
-	int32_t i;
-	uint32_t data_in = 0;
-	int32_t crc_rec;
-	int32_t crc_computed;
-	int32_t xor1 = 0;
-	int32_t xor2 = 0;
-	int32_t xor3 = 0;
-	int32_t xor4 = 0;
-	int32_t xor5 = 0;
-	int32_t crc0 = 0;
-	int32_t crc1 = 0;
-	int32_t crc2 = 0;
-	int32_t crc3 = 0;
-	int32_t crc4 = 0;
-	int32_t crc5 = 0;
-	int32_t crc6 = 0;
-	int32_t crc7 = 0;
-
-	crc_rec= (message >> 2) & 0xFF;
-	data_in = message >> 10;
-	for (i = NUMBITS_READ; i >= 0; i--) {
-		xor5 = (crc4 ^ crc7) ? 1 : 0;
-		xor4 = (crc2 ^ crc7) ? 1 : 0;
-		xor3 = (crc1 ^ crc7) ? 1 : 0;
-		xor2 = (crc0 ^ crc7) ? 1 : 0;
-		xor1 = ((data_in & (1 << i)) ? 1 : 0) ^ (crc7 ? 1 : 0);
-		crc7 = crc6;
-		crc6 = crc5;
-		crc5 = xor5;
-		crc4 = crc3;
-		crc3 = xor4;
-		crc2 = xor3;
-		crc1 = xor2;
-		crc0 = xor1;
-	}
-	crc_computed = (crc0 ? (1 << 0) : 0) | (crc1 ? (1 << 1) : 0) |
-		       (crc2 ? (1 << 2) : 0) | (crc3 ? (1 << 3) : 0) |
-		       (crc4 ? (1 << 4) : 0) | (crc5 ? (1 << 5) : 0) |
-		       (crc6 ? (1 << 6) : 0) | (crc7 ? (1 << 7) : 0);
-	if (crc_rec == crc_computed) {
-		return 1;
-	} else {
-		return 0;
-	}
+	return ((message >> 2) & 0xFF) == ad7280a_crc8(message >> 10);
 }
 
 /******************************************************************************
@@ -761,3 +755,120 @@ uint8_t ad7280a_alert_pin(struct ad7280a_dev *dev)
 
 	return alert_ad7280a;
 }
+
+/******************************************************************************
+ * @brief Configures conversion and readback of all channels on the whole chain.
+ *
+ * The command words of an acquisition are computed here once, so that
+ * ad7280a_chain_acquire() only replays them.
+ *
+ * @param dev      - The device structure.
+ *        conv_avg - Conversion averaging, AD7280A_CONV_AVG_DIS to
+ *                   AD7280A_CONV_AVG_8.
+ *        acq_time - Acquisition time, AD7280A_ACQ_TIME_400ns to
+ *                   AD7280A_ACQ_TIME_1600ns.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+******************************************************************************/
+int32_t ad7280a_chain_setup(struct ad7280a_dev *dev,
+			    uint8_t conv_avg,
+			    uint8_t acq_time)
+{
+	uint32_t value;
+	uint32_t acq_ns;
+
+	if (!dev || conv_avg > AD7280A_CONV_AVG_8 ||
+	    acq_time > AD7280A_ACQ_TIME_1600ns)
+		return -EINVAL;
+
+	/* Acquisition time applies to all devices */
+	value = ad7280a_crc_write((uint32_t) (AD7280A_CONTROL_LB << 21) |
+				  ((AD7280A_CTRL_LB_MUST_SET |
+				    AD7280A_CTRL_LB_LOCK_DEV_ADDR |
+				    AD7280A_CTRL_LB_DAISY_CHAIN_RB_EN |
+				    AD7280A_CTRL_LB_ACQ_TIME(acq_time)) << 13) |
+				  (1 << 12));
+	ad7280a_transfer_32bits(dev, value);
+
+	/* Point the Read register of all devices at the first cell */
+	value = ad7280a_crc_write((uint32_t) (AD7280A_READ << 21) |
+				  (AD7280A_CELL_VOLTAGE_1 << 15) |
+				  (1 << 12));
+	no_os_put_unaligned_be32(value, &dev->chain_tx[0]);
+
+	/* Convert and read all channels, conversion started by CS */
+	value = ad7280a_crc_write((uint32_t) (AD7280A_CONTROL_HB << 21) |
+				  ((AD7280A_CTRL_HB_CONV_RES_READ_ALL |
+				    AD7280A_CTRL_HB_CONV_INPUT_ALL |
+				    AD7280A_CTRL_HB_CONV_START_CS |
+				    AD7280A_CTRL_HB_CONV_AVG(conv_avg)) << 13) |
+				  (1 << 12));
+	no_os_put_unaligned_be32(value, &dev->chain_tx[4]);
+
+	/* The devices in the chain convert in parallel */
+	acq_ns = 400 * (acq_time + 1);
+	dev->conv_time_us = NO_OS_DIV_ROUND_UP(AD7280A_CHANS_PER_DEV *
+					       (1 << conv_avg) *
+					       (acq_ns + AD7280A_T_CONV_NS),
+					       1000);
+
+	return 0;
+}
+
+/******************************************************************************
+ * @brief Converts all channels of the chain and reads them back in one
+ *        transfer.
+ *
+ * The readback is handed to the platform as a single message list, using DMA
+ * when the platform supports it. Every word is checked for its CRC and for
+ * the expected channel address.
+ *
+ * @param dev  - The device structure.
+ *        scan - Filled with the conversion codes of the chain.
+ *
+ * @return 0 in case of success, -EIO if any word failed the checks (the
+ *         failing devices are flagged in crc_err_mask) or negative error code
+ *         otherwise.
+******************************************************************************/
+int32_t ad7280a_chain_acquire(struct ad7280a_dev *dev,
+			      struct ad7280a_chain_scan *scan)
+{
+	uint32_t nb_chans, word, i;
+	int32_t ret;
+
+	if (!dev || !scan || !dev->conv_time_us)
+		return -EINVAL;
+
+	nb_chans = dev->num_devices * AD7280A_CHANS_PER_DEV;
+
+	/* The transfers overwrite the buffer with the received words */
+	memcpy(dev->chain_buf, dev->chain_tx, (nb_chans + 2) * 4);
+
+	ret = no_os_spi_transfer(dev->spi_desc, dev->chain_msgs, 2);
+	if (ret)
+		return ret;
+
+	no_os_udelay(dev->conv_time_us);
+
+	ret = no_os_spi_transfer_dma_sync(dev->spi_desc, &dev->chain_msgs[2],
+					  nb_chans);
+	if (ret == -ENOSYS)
+		ret = no_os_spi_transfer(dev->spi_desc, &dev->chain_msgs[2],
+					 nb_chans);
+	if (ret)
+		return ret;
+
+	scan->crc_err_mask = 0;
+	for (i = 0; i < nb_chans; i++) {
+		word = no_os_get_unaligned_be32(&dev->chain_buf[(i + 2) * 4]);
+		if (!ad7280a_crc_read(word) ||
+		    ((word >> 23) & 0xF) != i % AD7280A_CHANS_PER_DEV)
+			scan->crc_err_mask |=
+				NO_OS_BIT(i / AD7280A_CHANS_PER_DEV);
+		scan->data[i] = (word >> 11) & 0xFFF;
+	}
+
+	scan->alert = ad7280a_alert_pin(dev);
+
+	return scan->crc_err_mask ? -EIO : 0;
+}
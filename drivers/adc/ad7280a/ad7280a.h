@@ -165,6 +165,17 @@
 #define NUMBITS_READ        22   // Number of bits for CRC when reading
 #define NUMBITS_WRITE       21   // Number of bits for CRC when writing
 
+/* CRC-8 polynomial x^8 + x^5 + x^3 + x^2 + x + 1 */
+#define AD7280A_CRC_POLYNOMIAL      0x2F
+
+/* Daisy chain acquisition */
+#define AD7280A_MAX_CHAIN           8
+#define AD7280A_CELLS_PER_DEV       6
+#define AD7280A_CHANS_PER_DEV       12
+#define AD7280A_MAX_CHANS           (AD7280A_MAX_CHAIN * AD7280A_CHANS_PER_DEV)
+/* Conversion time of one channel, acquisition time excluded */
+#define AD7280A_T_CONV_NS           1000
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -179,6 +190,13 @@ struct ad7280a_dev {
 	uint32_t		read_data[24];
 	float			cell_voltage[12];
 	float			aux_adc[12];
+	/* Daisy chain */
+	uint8_t			num_devices;
+	uint32_t		conv_time_us;
+	/* Chain acquisition: command words, then a readback word per channel */
+	uint8_t			*chain_tx;
+	uint8_t			*chain_buf;
+	struct no_os_spi_msg	*chain_msgs;
 };
 
 struct ad7280a_init_param {
@@ -188,6 +206,21 @@ struct ad7280a_init_param {
 	struct no_os_gpio_init_param	gpio_pd;
 	struct no_os_gpio_init_param	gpio_cnvst;
 	struct no_os_gpio_init_param	gpio_alert;
+	/* Number of devices in the daisy chain, 0 selects 2 */
+	uint8_t				num_devices;
+};
+
+/**
+ * @struct ad7280a_chain_scan
+ * @brief Conversions of the whole daisy chain, channel d * 12 + k holds
+ *        cell k (k < 6) or auxiliary input k - 6 of device d.
+ */
+struct ad7280a_chain_scan {
+	uint16_t	data[AD7280A_MAX_CHANS];
+	/** One bit per device with a CRC or framing error */
+	uint32_t	crc_err_mask;
+	/** Level of the ALERT pin */
+	uint8_t		alert;
 };
 
 /*****************************************************************************/
@@ -246,4 +279,13 @@ void ad7280a_selftest_all(struct ad7280a_dev *dev,
 /* Reads the value of Alert Pin from the device. */
 uint8_t ad7280a_alert_pin(struct ad7280a_dev *dev);
 
+/* Configures conversion and readback of all channels on the whole chain. */
+int32_t ad7280a_chain_setup(struct ad7280a_dev *dev,
+			    uint8_t conv_avg,
+			    uint8_t acq_time);
+
+/* Converts all channels of the chain and reads them back in one transfer. */
+int32_t ad7280a_chain_acquire(struct ad7280a_dev *dev,
+			      struct ad7280a_chain_scan *scan);
+
 #endif /*_AD7280A_H_*/
@@ -0,0 +1,427 @@
+/***************************************************************************//**
+ *   @file   iio_ad7280a.c
+ *   @brief  Implementation of the AD7280A IIO driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "iio_ad7280a.h"
+#include "ad7280a.h"
+#include "iio.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/* Scan index of the alert status channel */
+#define AD7280A_IIO_ALERT_IDX		AD7280A_CHANS_PER_DEV
+/* Alert status channel bits */
+#define AD7280A_IIO_ALERT_PIN		NO_OS_BIT(0)
+#define AD7280A_IIO_ALERT_CRC_ERR	NO_OS_BIT(1)
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+static int ad7280a_iio_read_raw(void *dev, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv);
+static int ad7280a_iio_read_scale(void *dev, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv);
+static int ad7280a_iio_read_offset(void *dev, char *buf, uint32_t len,
+				   const struct iio_ch_info *channel,
+				   intptr_t priv);
+static int32_t ad7280a_iio_submit(struct iio_device_data *dev_data);
+static int32_t ad7280a_iio_trigger_handler(struct iio_device_data *dev_data);
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+static struct iio_attribute ad7280a_cell_attrs[] = {
+	{
+		.name = "raw",
+		.show = ad7280a_iio_read_raw,
+	},
+	{
+		.name = "scale",
+		.show = ad7280a_iio_read_scale,
+	},
+	{
+		.name = "offset",
+		.show = ad7280a_iio_read_offset,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute ad7280a_aux_attrs[] = {
+	{
+		.name = "raw",
+		.show = ad7280a_iio_read_raw,
+	},
+	{
+		.name = "scale",
+		.show = ad7280a_iio_read_scale,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct iio_attribute ad7280a_alert_attrs[] = {
+	{
+		.name = "raw",
+		.show = ad7280a_iio_read_raw,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+static struct scan_type ad7280a_iio_scan_type = {
+	.sign = 'u',
+	.realbits = 12,
+	.storagebits = 16,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+static struct scan_type ad7280a_iio_alert_scan_type = {
+	.sign = 'u',
+	.realbits = 16,
+	.storagebits = 16,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+#define AD7280A_IIO_CELL(_idx) { \
+	.ch_type = IIO_VOLTAGE, \
+	.channel = _idx, \
+	.address = _idx, \
+	.scan_index = _idx, \
+	.indexed = true, \
+	.scan_type = &ad7280a_iio_scan_type, \
+	.attributes = ad7280a_cell_attrs, \
+}
+
+#define AD7280A_IIO_AUX(_idx) { \
+	.ch_type = IIO_TEMP, \
+	.channel = _idx, \
+	.address = AD7280A_CELLS_PER_DEV + _idx, \
+	.scan_index = AD7280A_CELLS_PER_DEV + _idx, \
+	.indexed = true, \
+	.scan_type = &ad7280a_iio_scan_type, \
+	.attributes = ad7280a_aux_attrs, \
+}
+
+/*
+ * Every module exposes the same channels: the cell voltages, the auxiliary
+ * inputs and the alert status (bit 0 the ALERT pin, bit 1 a CRC error).
+ */
+static struct iio_channel ad7280a_iio_channels[] = {
+	AD7280A_IIO_CELL(0),
+	AD7280A_IIO_CELL(1),
+	AD7280A_IIO_CELL(2),
+	AD7280A_IIO_CELL(3),
+	AD7280A_IIO_CELL(4),
+	AD7280A_IIO_CELL(5),
+	AD7280A_IIO_AUX(0),
+	AD7280A_IIO_AUX(1),
+	AD7280A_IIO_AUX(2),
+	AD7280A_IIO_AUX(3),
+	AD7280A_IIO_AUX(4),
+	AD7280A_IIO_AUX(5),
+	{
+		.name = "alert",
+		.ch_type = IIO_COUNT,
+		.address = AD7280A_IIO_ALERT_IDX,
+		.scan_index = AD7280A_IIO_ALERT_IDX,
+		.scan_type = &ad7280a_iio_alert_scan_type,
+		.attributes = ad7280a_alert_attrs,
+	},
+};
+
+static struct iio_device ad7280a_iio_dev = {
+	.num_ch = NO_OS_ARRAY_SIZE(ad7280a_iio_channels),
+	.channels = ad7280a_iio_channels,
+	.submit = ad7280a_iio_submit,
+	.trigger_handler = ad7280a_iio_trigger_handler,
+};
+
+/**
+ * @brief Get the chain data for a module, starting a new chain acquisition
+ * once the module has consumed the current one.
+ * @param module - The module descriptor.
+ * @return 0 in case of success, error code otherwise. A CRC error is not
+ * an error here, it is reported in the alert status channel.
+ */
+static int ad7280a_iio_update(struct ad7280a_iio_module *module)
+{
+	struct ad7280a_iio_desc *desc = module->desc;
+	int ret;
+
+	if (module->seq == desc->scan_seq) {
+		ret = ad7280a_chain_acquire(desc->ad7280a_dev, &desc->scan);
+		if (ret && ret != -EIO)
+			return ret;
+
+		desc->scan_seq++;
+	}
+
+	module->seq = desc->scan_seq;
+
+	return 0;
+}
+
+/**
+ * @brief Get a channel value of a module from the latest chain acquisition.
+ * @param module - The module descriptor.
+ * @param idx - Channel index within the module.
+ * @return The channel value.
+ */
+static uint16_t ad7280a_iio_value(struct ad7280a_iio_module *module,
+				  uint32_t idx)
+{
+	struct ad7280a_chain_scan *scan = &module->desc->scan;
+	uint16_t status = 0;
+
+	if (idx < AD7280A_CHANS_PER_DEV)
+		return scan->data[module->index * AD7280A_CHANS_PER_DEV + idx];
+
+	if (scan->alert)
+		status |= AD7280A_IIO_ALERT_PIN;
+	if (scan->crc_err_mask & NO_OS_BIT(module->index))
+		status |= AD7280A_IIO_ALERT_CRC_ERR;
+
+	return status;
+}
+
+/**
+ * @brief Read the raw attribute for a specific channel.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ad7280a_iio_read_raw(void *dev, char *buf, uint32_t len,
+				const struct iio_ch_info *channel,
+				intptr_t priv)
+{
+	struct ad7280a_iio_module *module = dev;
+	int32_t val;
+	int ret;
+
+	ret = ad7280a_iio_update(module);
+	if (ret)
+		return ret;
+
+	if (channel->address < AD7280A_CHANS_PER_DEV &&
+	    module->desc->scan.crc_err_mask & NO_OS_BIT(module->index))
+		return -EIO;
+
+	val = ad7280a_iio_value(module, channel->address);
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Read the scale attribute for a specific channel, in millivolts:
+ * 0.9765625 mV per code for the cells, 1.2207031 mV for the auxiliary inputs.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ad7280a_iio_read_scale(void *dev, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv)
+{
+	int32_t vals[2];
+
+	if (channel->address < AD7280A_CELLS_PER_DEV) {
+		vals[0] = 0;
+		vals[1] = 976562;
+	} else {
+		vals[0] = 1;
+		vals[1] = 220703;
+	}
+
+	return iio_format_value(buf, len, IIO_VAL_INT_PLUS_MICRO, 2, vals);
+}
+
+/**
+ * @brief Read the offset attribute of a cell channel, the cell input range
+ * starts at 1 V.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int ad7280a_iio_read_offset(void *dev, char *buf, uint32_t len,
+				   const struct iio_ch_info *channel,
+				   intptr_t priv)
+{
+	int32_t val = 1024;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Push the enabled channels of a module as one scan.
+ * @param module - The module descriptor.
+ * @param buffer - The iio buffer.
+ * @return 0 in case of success, error code otherwise
+ */
+static int ad7280a_iio_push(struct ad7280a_iio_module *module,
+			    struct iio_buffer *buffer)
+{
+	uint16_t scan[AD7280A_CHANS_PER_DEV + 1];
+	uint32_t cnt = 0;
+	uint32_t i;
+	int ret;
+
+	ret = ad7280a_iio_update(module);
+	if (ret)
+		return ret;
+
+	for (i = 0; i <= AD7280A_IIO_ALERT_IDX; i++)
+		if (buffer->active_mask & NO_OS_BIT(i))
+			scan[cnt++] = ad7280a_iio_value(module, i);
+
+	return iio_buffer_push_scan(buffer, scan);
+}
+
+/**
+ * @brief Push the requested number of scans.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t ad7280a_iio_submit(struct iio_device_data *dev_data)
+{
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < dev_data->buffer->samples; i++) {
+		ret = ad7280a_iio_push(dev_data->dev, dev_data->buffer);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Trigger handler, pushes one scan per trigger.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t ad7280a_iio_trigger_handler(struct iio_device_data *dev_data)
+{
+	return ad7280a_iio_push(dev_data->dev, dev_data->buffer);
+}
+
+/**
+ * @brief Initializes the AD7280A IIO descriptor, with an IIO device per
+ * device in the daisy chain.
+ * @param desc - The iio device descriptor.
+ * @param init_param - The structure that contains the device initial
+ * 		       parameters.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int ad7280a_iio_init(struct ad7280a_iio_desc **desc,
+		     struct ad7280a_iio_init_param *init_param)
+{
+	struct ad7280a_iio_desc *descriptor;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !init_param || !init_param->ad7280a_init_param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ret = ad7280a_init(&descriptor->ad7280a_dev,
+			   *init_param->ad7280a_init_param);
+	if (ret)
+		goto free_desc;
+
+	ret = ad7280a_chain_setup(descriptor->ad7280a_dev,
+				  init_param->conv_avg, init_param->acq_time);
+	if (ret)
+		goto remove_dev;
+
+	descriptor->num_modules = descriptor->ad7280a_dev->num_devices;
+	for (i = 0; i < descriptor->num_modules; i++) {
+		descriptor->modules[i].desc = descriptor;
+		descriptor->modules[i].index = i;
+		descriptor->modules[i].iio_device = ad7280a_iio_dev;
+	}
+
+	*desc = descriptor;
+
+	return 0;
+
+remove_dev:
+	ad7280a_remove(descriptor->ad7280a_dev);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret ? ret : -EIO;
+}
+
+/**
+ * @brief Free an iio descriptor.
+ * @param desc - The descriptor to be freed.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int ad7280a_iio_remove(struct ad7280a_iio_desc *desc)
+{
+	int ret;
+
+	ret = ad7280a_remove(desc->ad7280a_dev);
+	if (ret)
+		return ret;
+
+	no_os_free(desc);
+
+	return 0;
+}
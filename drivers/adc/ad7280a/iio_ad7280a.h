@@ -0,0 +1,103 @@
+/***************************************************************************//**
+ *   @file   iio_ad7280a.h
+ *   @brief  Header file of the AD7280A IIO driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef IIO_AD7280A_H
+#define IIO_AD7280A_H
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "iio.h"
+#include "ad7280a.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+struct ad7280a_iio_desc;
+
+/**
+ * @brief IIO device of one AD7280A in the daisy chain.
+ */
+struct ad7280a_iio_module {
+	struct ad7280a_iio_desc *desc;
+	/** Position in the chain, 0 is the master */
+	uint8_t index;
+	/** Chain acquisition this module has last consumed */
+	uint32_t seq;
+	struct iio_device iio_device;
+};
+
+/**
+ * @brief Descriptor that stores an iio specific state.
+ *
+ * The IIO buffer mask is limited to 32 channels, so every device of the chain
+ * is exposed as its own IIO device (modules[i].iio_device). A chain
+ * acquisition is shared, each module consumes it once before a new one is
+ * started.
+ */
+struct ad7280a_iio_desc {
+	struct ad7280a_dev *ad7280a_dev;
+	struct ad7280a_chain_scan scan;
+	uint32_t scan_seq;
+	uint8_t num_modules;
+	struct ad7280a_iio_module modules[AD7280A_MAX_CHAIN];
+};
+
+/**
+ * @brief Init parameter for the iio descriptor.
+ */
+struct ad7280a_iio_init_param {
+	struct ad7280a_init_param *ad7280a_init_param;
+	/** Conversion averaging, AD7280A_CONV_AVG_x */
+	uint8_t conv_avg;
+	/** Acquisition time, AD7280A_ACQ_TIME_x */
+	uint8_t acq_time;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/** Intialize the iio descriptor */
+int ad7280a_iio_init(struct ad7280a_iio_desc **,
+		     struct ad7280a_iio_init_param *);
+
+/** Free the iio descriptor */
+int ad7280a_iio_remove(struct ad7280a_iio_desc *);
+
+#endif /** IIO_AD7280A_H */
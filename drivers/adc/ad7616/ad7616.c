@@ -232,7 +232,7 @@ static int32_t ad7616_toggle_conv(struct ad7616_dev *dev)
 }
 
 /**
- * @brief Reads all conversion results with optional CRC
+ * @brief Reads all conversion results with optional CRC in one SPI frame
  * @param dev - The device structure.
  * @param res - Array of conversion results. The caller is responsible for allocating enough space
  * @param crc - Pointer to store the CRC received from the device
@@ -242,36 +242,30 @@ static int32_t ad7616_read_channels(struct ad7616_dev *dev,
 				    struct ad7616_conversion_result *res,
 				    uint8_t *crc)
 {
-	int32_t ret;
+	uint8_t buf[(AD7616_MAX_LAYERS * 2 + 1) * 2] = {0};
 	uint32_t read_nb = dev->layers_nb * 2;
-	uint16_t tmp = 0;
-
-	for (uint32_t i = 0; i < read_nb; i++, tmp = 0) {
-		ret = no_os_spi_write_and_read(dev->spi_desc, (void *)&tmp,
-					       sizeof(tmp));
-		if (ret != 0)
-			return ret;
-
-		tmp = no_os_get_unaligned_be16((void *)&tmp);
+	int32_t ret;
+	uint32_t i;
 
-		if (i % 2 == 0)
-			res[i / 2].channel_a = tmp;
-		else
-			res[i / 2].channel_b = tmp;
-	}
+	if (dev->layers_nb > AD7616_MAX_LAYERS)
+		return -EINVAL;
 
-	// Check CRC
-	if (dev->crc) {
-		ret = no_os_spi_write_and_read(dev->spi_desc, (void *)&tmp,
-					       sizeof(tmp));
-		if (ret != 0)
-			return ret;
+	// The CRC follows the results in the same frame
+	if (dev->crc)
+		read_nb++;
 
-		tmp = no_os_get_unaligned_be16((void *)&tmp);
+	ret = no_os_spi_write_and_read(dev->spi_desc, buf, read_nb * 2);
+	if (ret != 0)
+		return ret;
 
-		*crc = tmp & 0xFF;
+	for (i = 0; i < dev->layers_nb; i++) {
+		res[i].channel_a = no_os_get_unaligned_be16(&buf[i * 4]);
+		res[i].channel_b = no_os_get_unaligned_be16(&buf[i * 4 + 2]);
 	}
 
+	if (dev->crc)
+		*crc = buf[read_nb * 2 - 1];
+
 	return 0;
 }
 
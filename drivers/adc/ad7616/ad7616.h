@@ -75,6 +75,9 @@
 #define AD7616_REG_INPUT_RANGE_B2		0x07
 #define AD7616_REG_SEQUENCER_STACK(x)	(0x20 + (x))
 
+/* Depth of the sequencer stack */
+#define AD7616_MAX_LAYERS			32
+
 /* AD7616_REG_CONFIG */
 #define AD7616_SDEF				(1 << 7)
 #define AD7616_BURSTEN(x)			((x & 1) << 6)
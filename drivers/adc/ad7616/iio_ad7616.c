@@ -303,47 +303,43 @@ static int32_t iio_ad7616_submit_buffer(struct iio_device_data *iio_dev_data)
 {
 	struct ad7616_iio_dev *iio_dev = iio_dev_data->dev;
 	struct ad7616_dev *dev = iio_dev->ad7616_dev;
-	struct ad7616_conversion_result *results;
+	struct ad7616_conversion_result *results, *frame, *layer;
 	uint16_t data[iio_dev_data->buffer->bytes_per_scan / 2];
-	uint8_t active_mask_a;
-	uint8_t active_mask_b;
-	uint32_t index_a;
-	uint32_t index_b;
+	uint32_t active_mask = iio_dev_data->buffer->active_mask;
+	/* Result slot of every scan element: layer << 1 | channel B */
+	uint8_t slot[CHANNEL_NUMBER];
+	uint32_t nb_slots = 0;
 	int32_t ret;
 	uint32_t i;
-	uint32_t j;
 	uint32_t k;
 
+	// Scans hold the A channels first, each one read in its own layer
+	for (k = 0; k < no_os_hweight8(active_mask & 0xFF); k++)
+		slot[nb_slots++] = k << 1;
+	for (k = 0; k < no_os_hweight8((active_mask >> 8) & 0xFF); k++)
+		slot[nb_slots++] = (k << 1) | 1;
+
+	// Setup AD7616's sequencer to ask the channel found in the iio buffer active_mask
+	ret = setup_sequencer_layers_from_active_mask(dev, active_mask);
+	if (ret)
+		return ret;
+
 	results = no_os_calloc(dev->layers_nb * iio_dev_data->buffer->samples, sizeof(
 				       *results));
 	if (!results)
 		return -ENOMEM;
 
-	// Setup AD7616's sequencer to ask the channel found in the iio buffer active_mask
-	ret = setup_sequencer_layers_from_active_mask(dev,
-			iio_dev_data->buffer->active_mask);
-	if (ret)
-		goto cleanup;
-
 	ret = ad7616_read_data_serial(dev, results, iio_dev_data->buffer->samples);
 	if (ret)
 		goto cleanup;
 
 	for (i = 0; i < iio_dev_data->buffer->samples; i++) {
-		active_mask_a = iio_dev_data->buffer->active_mask & 0xFF;
-		active_mask_b = (iio_dev_data->buffer->active_mask >> 8) & 0xFF;
-		k = 0;
+		frame = &results[i * dev->layers_nb];
 
-		for (j = 0; active_mask_a; j++) {
-			index_a = no_os_find_first_set_bit(active_mask_a);
-			active_mask_a = active_mask_a & ~NO_OS_BIT(index_a);
-			data[k++] = results[i * dev->layers_nb + j].channel_a;
-		}
-
-		for (j = 0; active_mask_b; j++) {
-			index_b = no_os_find_first_set_bit(active_mask_b);
-			active_mask_b = active_mask_b & ~NO_OS_BIT(index_b);
-			data[k++] = results[i * dev->layers_nb + j].channel_b;
+		for (k = 0; k < nb_slots; k++) {
+			layer = &frame[slot[k] >> 1];
+			data[k] = (slot[k] & 1) ? layer->channel_b :
+				  layer->channel_a;
 		}
 
 		ret = iio_buffer_push_scan(iio_dev_data->buffer, &data);
@@ -351,8 +347,6 @@ static int32_t iio_ad7616_submit_buffer(struct iio_device_data *iio_dev_data)
 			goto cleanup;
 	}
 
-	return 0;
-
 cleanup:
 	no_os_free(results);
 	return ret;
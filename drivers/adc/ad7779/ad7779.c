@@ -70,6 +70,16 @@ const uint8_t pin_mode_options[16][4] = {
 	{0xFF,	0xFF,	0xFF,	0xFF},	// DEC_RATE_1024, LOW_PWR, INT_REF
 };
 
+/* Sigma-delta SPI frame: 8-bit header followed by the 24-bit result. */
+#define AD7779_SD_FIELD(ch)	{ (ch) * 32 + 8, 24, true }
+
+static const struct no_os_bitfield ad7779_sd_fields[AD7779_SD_NUM_CHANNELS] = {
+	AD7779_SD_FIELD(0), AD7779_SD_FIELD(1),
+	AD7779_SD_FIELD(2), AD7779_SD_FIELD(3),
+	AD7779_SD_FIELD(4), AD7779_SD_FIELD(5),
+	AD7779_SD_FIELD(6), AD7779_SD_FIELD(7),
+};
+
 /******************************************************************************/
 /************************** Functions Implementation **************************/
 /******************************************************************************/
@@ -270,6 +280,45 @@ int32_t ad7779_spi_sar_read_code(ad7779_dev *dev,
 	return ret;
 }
 
+/**
+ * Read the sigma-delta results of the selected channels over SPI.
+ * The frame is clocked out in one transfer, up to the last selected channel,
+ * and unpacked through a field table. The channel ID of every header is
+ * checked, then the headers are stripped from the scan.
+ * @param dev - The device structure.
+ * @param ch_mask - Bit i selects channel i.
+ * @param scan - Sign extended results of the selected channels.
+ * @return Number of unpacked channels in case of success, negative error code
+ *	   otherwise.
+ */
+int32_t ad7779_spi_sd_read_scan(ad7779_dev *dev,
+				uint8_t ch_mask,
+				int32_t *scan)
+{
+	uint8_t buf[AD7779_SD_FRAME_SIZE] = {0};
+	uint8_t last;
+	uint8_t ch;
+	int32_t ret;
+
+	if (!dev || !scan || !ch_mask || dev->spi_op_mode != AD7779_SD_CONV)
+		return -EINVAL;
+
+	last = no_os_find_last_set_bit(ch_mask);
+
+	buf[0] = AD7779_SD_READ_CMD;
+	ret = no_os_spi_write_and_read(dev->spi_desc, buf, (last + 1) * 4);
+	if (ret)
+		return ret;
+
+	for (ch = 0; ch <= last; ch++)
+		if (AD7779_SD_HDR_CH_ID(buf[ch * 4]) != ch)
+			return -EIO;
+
+	return no_os_unpack_bitfields(buf, ad7779_sd_fields,
+				      AD7779_SD_NUM_CHANNELS, ch_mask,
+				      sizeof(*scan), scan);
+}
+
 /**
  * Set SPI operation mode.
  * @param dev - The device structure.
@@ -117,6 +117,13 @@
 #define AD7779_SPI_SLAVE_MODE_EN		(1 << 4)
 #define AD7779_CLK_QUAL_DIS			(1 << 0)
 
+/* Sigma-delta data read over SPI */
+#define AD7779_SD_NUM_CHANNELS			8
+#define AD7779_SD_FRAME_SIZE			(AD7779_SD_NUM_CHANNELS * 4)
+#define AD7779_SD_READ_CMD			0x80
+#define AD7779_SD_HDR_ALERT			(1 << 7)
+#define AD7779_SD_HDR_CH_ID(x)			(((x) >> 4) & 0x7)
+
 /* AD7779_REG_DOUT_FORMAT */
 #define AD7779_DOUT_FORMAT(x)			(((x) & 0x3) << 6)
 #define AD7779_DOUT_HEADER_FORMAT		(1 << 5)
@@ -341,6 +348,10 @@ int32_t ad7779_spi_int_reg_write_mask(ad7779_dev *dev,
 int32_t ad7779_spi_sar_read_code(ad7779_dev *dev,
 				 ad7779_sar_mux mux_next_conv,
 				 uint16_t *sar_code);
+/* Read the sigma-delta results of the selected channels over SPI. */
+int32_t ad7779_spi_sd_read_scan(ad7779_dev *dev,
+				uint8_t ch_mask,
+				int32_t *scan);
 /* Set SPI operation mode. */
 int32_t ad7779_set_spi_op_mode(ad7779_dev *dev,
 			       ad7779_spi_op_mode mode);
@@ -41,6 +41,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdlib.h>
+#include <errno.h>
 #include "ad7780.h"
 #include "no_os_alloc.h"
 
@@ -69,7 +70,7 @@ int8_t ad7780_init(struct ad7780_dev **device,
 	uint8_t ad7780status;
 	int8_t init_status;
 
-	dev = (struct ad7780_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct ad7780_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
@@ -121,6 +122,9 @@ int32_t ad7780_remove(struct ad7780_dev *dev)
 {
 	int32_t ret;
 
+	if (dev->irq_ctrl)
+		ad7780_irq_acq_stop(dev);
+
 	ret = no_os_spi_remove(dev->spi_desc);
 
 	ret |= no_os_gpio_remove(dev->gpio_pdrst);
@@ -183,6 +187,146 @@ int32_t ad7780_read_sample(struct ad7780_dev *dev,
 	return conv_sample;
 }
 
+/***************************************************************************//**
+ * @brief DOUT/RDY falling edge handler, reads the conversion into the ring.
+ *
+ * @param context - The device structure.
+*******************************************************************************/
+static void ad7780_irq_handler(void *context)
+{
+	struct ad7780_dev *dev = context;
+	uint32_t sample;
+	uint8_t status, id;
+
+	/* DOUT/RDY toggles while the data is clocked out. */
+	if (no_os_irq_disable(dev->irq_ctrl, dev->gpio_miso->number))
+		return;
+
+	sample = ad7780_read_sample(dev, &status) & 0xFFFFFF;
+
+	id = status & (AD7780_STAT_ID1 | AD7780_STAT_ID0);
+	if (id != AD7780_ID_NUMBER || (status & AD7780_STAT_ERR)) {
+		dev->status_err++;
+	} else if (dev->ring_head - dev->ring_tail == AD7780_RING_SIZE) {
+		dev->ring_overrun++;
+	} else {
+		dev->ring[dev->ring_head & (AD7780_RING_SIZE - 1)] = sample;
+		dev->ring_head++;
+	}
+
+	no_os_irq_enable(dev->irq_ctrl, dev->gpio_miso->number);
+}
+
+/***************************************************************************//**
+ * @brief Starts reading the conversions from the DOUT/RDY interrupt.
+ *
+ * Each conversion is clocked out in the interrupt handler and queued in a
+ * lock-free single producer single consumer ring, so ad7780_get_sample()
+ * never waits for DOUT/RDY. Conversions whose status byte carries a wrong ID
+ * or the error flag are dropped and counted in status_err.
+ *
+ * @param dev      - The device structure.
+ * @param irq_ctrl - GPIO interrupt controller handling the DOUT/RDY pin.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7780_irq_acq_start(struct ad7780_dev *dev,
+			     struct no_os_irq_ctrl_desc *irq_ctrl)
+{
+	int32_t ret;
+
+	if (!dev || !irq_ctrl || dev->irq_ctrl)
+		return -EINVAL;
+
+	dev->irq_cb.callback = ad7780_irq_handler;
+	dev->irq_cb.ctx = dev;
+	dev->irq_cb.event = NO_OS_EVT_GPIO;
+	dev->irq_cb.peripheral = NO_OS_GPIO_IRQ;
+
+	ret = no_os_irq_register_callback(irq_ctrl, dev->gpio_miso->number,
+					  &dev->irq_cb);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_trigger_level_set(irq_ctrl, dev->gpio_miso->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_cb;
+
+	dev->irq_ctrl = irq_ctrl;
+	dev->ring_tail = dev->ring_head;
+	dev->ring_overrun = 0;
+	dev->status_err = 0;
+
+	ret = no_os_irq_enable(irq_ctrl, dev->gpio_miso->number);
+	if (ret)
+		goto error_cb;
+
+	return 0;
+
+error_cb:
+	dev->irq_ctrl = NULL;
+	no_os_irq_unregister_callback(irq_ctrl, dev->gpio_miso->number,
+				      &dev->irq_cb);
+
+	return ret;
+}
+
+/***************************************************************************//**
+ * @brief Stops the DOUT/RDY interrupt acquisition.
+ *
+ * @param dev - The device structure.
+ *
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+int32_t ad7780_irq_acq_stop(struct ad7780_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev || !dev->irq_ctrl)
+		return -EINVAL;
+
+	ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_miso->number);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_unregister_callback(dev->irq_ctrl,
+					    dev->gpio_miso->number,
+					    &dev->irq_cb);
+	if (ret)
+		return ret;
+
+	dev->irq_ctrl = NULL;
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Gets the oldest sample acquired by the DOUT/RDY interrupt.
+ *
+ * @param dev        - The device structure.
+ * @param raw_sample - The 24-bit sample (offset binary).
+ *
+ * @return 0 in case of success, -EAGAIN if no sample is queued, negative
+ *         error code otherwise.
+*******************************************************************************/
+int32_t ad7780_get_sample(struct ad7780_dev *dev, uint32_t *raw_sample)
+{
+	uint32_t tail;
+
+	if (!dev || !raw_sample)
+		return -EINVAL;
+
+	tail = dev->ring_tail;
+	if (dev->ring_head == tail)
+		return -EAGAIN;
+
+	*raw_sample = dev->ring[tail & (AD7780_RING_SIZE - 1)];
+	dev->ring_tail = tail + 1;
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Converts the 24-bit raw value to milivolts.
  *
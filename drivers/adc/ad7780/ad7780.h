@@ -45,6 +45,7 @@
 #include <stdint.h>
 #include "no_os_gpio.h"
 #include "no_os_spi.h"
+#include "no_os_irq.h"
 
 /******************************************************************************/
 /************************** AD7780 Definitions ********************************/
@@ -90,6 +91,9 @@
 
 #define AD7780_ID_NUMBER        0x08
 
+/* Number of samples buffered by the DOUT/RDY interrupt, power of two */
+#define AD7780_RING_SIZE        32
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -102,6 +106,14 @@ struct ad7780_dev {
 	struct no_os_gpio_desc	*gpio_miso;
 	struct no_os_gpio_desc	*gpio_filter;
 	struct no_os_gpio_desc	*gpio_gain;
+	/* DOUT/RDY interrupt acquisition */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	struct no_os_callback_desc	irq_cb;
+	uint32_t			ring[AD7780_RING_SIZE];
+	volatile uint32_t		ring_head;
+	volatile uint32_t		ring_tail;
+	uint32_t			ring_overrun;
+	uint32_t			status_err;
 };
 
 struct ad7780_init_param {
@@ -133,6 +145,16 @@ int8_t ad7780_wait_rdy_go_low(struct ad7780_dev *dev);
 int32_t ad7780_read_sample(struct ad7780_dev *dev,
 			   uint8_t* p_status);
 
+/*! Starts reading the conversions from the DOUT/RDY interrupt. */
+int32_t ad7780_irq_acq_start(struct ad7780_dev *dev,
+			     struct no_os_irq_ctrl_desc *irq_ctrl);
+
+/*! Stops the DOUT/RDY interrupt acquisition. */
+int32_t ad7780_irq_acq_stop(struct ad7780_dev *dev);
+
+/*! Gets the oldest sample acquired by the DOUT/RDY interrupt. */
+int32_t ad7780_get_sample(struct ad7780_dev *dev, uint32_t *raw_sample);
+
 /*! Converts the 24-bit raw value to volts. */
 float ad7780_convert_to_voltage(uint32_t raw_sample,
 				float v_ref,
@@ -820,8 +820,159 @@ static int ad9081_setup(struct ad9081_phy *phy)
 	return 0;
 }
 
+/**
+ * Issue the queued register writes, one SPI transaction per burst.
+ * @param phy - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9081_wc_flush(struct ad9081_phy *phy)
+{
+	struct ad9081_wc *wc = &phy->wc;
+	int32_t ret;
+	uint8_t i;
+
+	if (!wc->nb_msgs)
+		return 0;
+
+	ret = no_os_spi_transfer(phy->spi_desc, wc->msgs, wc->nb_msgs);
+
+	phy->hal_stats.spi_xfers += wc->nb_msgs;
+	for (i = 0; i < wc->nb_msgs; i++)
+		if (wc->msgs[i].bytes_number > 3)
+			phy->hal_stats.bursts++;
+
+	wc->nb_msgs = 0;
+	wc->len = 0;
+
+	return ret;
+}
+
+/**
+ * Queue a register write, merging it into the last burst when it targets
+ * the next streaming address.
+ * @param phy - The device structure.
+ * @param in_data - The API transfer.
+ * @param bytes_number - Length of the API transfer.
+ * @return 1 if the write was queued, 0 if the transfer has to be issued
+ * 	   directly, negative error code otherwise.
+ */
+static int32_t ad9081_wc_queue(struct ad9081_phy *phy, uint8_t *in_data,
+			       uint16_t bytes_number)
+{
+	struct ad9081_wc *wc = &phy->wc;
+	struct no_os_spi_msg *msg;
+	uint16_t addr;
+	int32_t ret;
+
+	/*
+	 * Only plain 8-bit register writes are queued. The interface
+	 * configuration registers change the SPI framing (and reset the
+	 * device), so they always go out directly.
+	 */
+	if (!wc->depth || bytes_number != 3 || (in_data[0] & 0xC0) ||
+	    phy->ad9081.hal_info.msb != SPI_MSB_FIRST)
+		return 0;
+
+	addr = no_os_get_unaligned_be16(in_data);
+	if (addr <= REG_SPI_INTFCONFB_ADDR)
+		return 0;
+
+	if (wc->nb_msgs && addr == wc->next_addr &&
+	    wc->len < AD9081_WC_BUF_SIZE) {
+		msg = &wc->msgs[wc->nb_msgs - 1];
+	} else {
+		if (wc->nb_msgs == AD9081_WC_MAX_BURSTS ||
+		    wc->len + 3 > AD9081_WC_BUF_SIZE) {
+			ret = ad9081_wc_flush(phy);
+			if (ret)
+				return ret;
+		}
+
+		msg = &wc->msgs[wc->nb_msgs++];
+		msg->tx_buff = &wc->buf[wc->len];
+		msg->rx_buff = &wc->buf[wc->len];
+		msg->bytes_number = 2;
+		msg->cs_change = 1;
+		wc->buf[wc->len++] = in_data[0];
+		wc->buf[wc->len++] = in_data[1];
+	}
+
+	wc->buf[wc->len++] = in_data[2];
+	msg->bytes_number++;
+
+	if (phy->ad9081.hal_info.addr_inc == SPI_ADDR_INC_AUTO)
+		wc->next_addr = addr + 1;
+	else
+		wc->next_addr = addr - 1;
+
+	return 1;
+}
+
+/**
+ * Start a write-combining section. Sections may be nested, the queued
+ * writes are issued at the end of the outermost one at the latest.
+ * @param phy - The device structure.
+ */
+void ad9081_hal_batch_begin(struct ad9081_phy *phy)
+{
+	if (!phy->wc.depth++)
+		phy->wc.start = phy->hal_stats;
+}
+
+/**
+ * End a write-combining section.
+ * @param phy - The device structure.
+ * @param stats - If not NULL, filled with the register accesses done since
+ * 		  the start of the outermost section.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9081_hal_batch_end(struct ad9081_phy *phy,
+			     struct ad9081_hal_stats *stats)
+{
+	int32_t ret = 0;
+
+	if (!phy->wc.depth)
+		return -EINVAL;
+
+	if (!--phy->wc.depth)
+		ret = ad9081_wc_flush(phy);
+
+	if (stats) {
+		stats->reg_writes = phy->hal_stats.reg_writes -
+				    phy->wc.start.reg_writes;
+		stats->reg_reads = phy->hal_stats.reg_reads -
+				   phy->wc.start.reg_reads;
+		stats->spi_xfers = phy->hal_stats.spi_xfers -
+				   phy->wc.start.spi_xfers;
+		stats->bursts = phy->hal_stats.bursts - phy->wc.start.bursts;
+	}
+
+	return ret;
+}
+
+/**
+ * Print the register access counters of a batch section.
+ * @param name - Name of the section.
+ * @param stats - The counters.
+ */
+static void ad9081_hal_stats_print(const char *name,
+				   const struct ad9081_hal_stats *stats)
+{
+	pr_debug("%s: %"PRIu32" writes, %"PRIu32" reads in %"PRIu32
+		 " SPI transactions (%"PRIu32" bursts)\n", name,
+		 stats->reg_writes, stats->reg_reads, stats->spi_xfers,
+		 stats->bursts);
+}
+
 static int32_t ad9081_udelay(void *user_data, uint32_t us)
 {
+	struct ad9081_phy *phy = user_data;
+	int32_t ret;
+
+	ret = ad9081_wc_flush(phy);
+	if (ret != 0)
+		return -1;
+
 	no_os_udelay(us);
 
 	return 0;
@@ -830,6 +981,11 @@ static int32_t ad9081_udelay(void *user_data, uint32_t us)
 int32_t ad9081_reset_pin_ctrl(void *user_data, uint8_t enable)
 {
 	struct ad9081_phy *phy = user_data;
+	int32_t ret;
+
+	ret = ad9081_wc_flush(phy);
+	if (ret != 0)
+		return ret;
 
 	return no_os_gpio_set_value(phy->gpio_reset, enable);
 }
@@ -838,12 +994,30 @@ static int32_t ad9081_spi_xfer(void *user_data, uint8_t *in_data,
 			       uint8_t *out_data, uint32_t size_bytes)
 {
 	struct ad9081_phy *phy = user_data;
-	uint8_t data[6];
+	uint8_t data[AD9081_SPI_XFER_MAX];
 	uint16_t bytes_number;
 	int32_t ret;
 	int32_t i;
 
 	bytes_number = (size_bytes & 0xFF);
+	if (bytes_number < 2 || bytes_number > AD9081_SPI_XFER_MAX)
+		return -1;
+
+	if (in_data[0] & 0x80)
+		phy->hal_stats.reg_reads++;
+	else
+		phy->hal_stats.reg_writes++;
+
+	ret = ad9081_wc_queue(phy, in_data, bytes_number);
+	if (ret < 0)
+		return -1;
+	if (ret)
+		return 0;
+
+	/* Keep the register accesses in order */
+	ret = ad9081_wc_flush(phy);
+	if (ret != 0)
+		return -1;
 
 	if (phy->ad9081.hal_info.msb == SPI_MSB_FIRST) {
 		for (i = 0; i < bytes_number; i++)
@@ -856,9 +1030,14 @@ static int32_t ad9081_spi_xfer(void *user_data, uint8_t *in_data,
 	}
 
 	ret = no_os_spi_write_and_read(phy->spi_desc, data, bytes_number);
+	phy->hal_stats.spi_xfers++;
 	if (ret != 0)
 		return -1;
 
+	/* Streaming writes from the API do not read back */
+	if (!out_data)
+		return 0;
+
 	if (phy->ad9081.hal_info.msb == SPI_MSB_FIRST) {
 		for (i = 0; i < bytes_number; i++)
 			out_data[i] =  data[i];
@@ -1326,7 +1505,8 @@ static int ad9081_jesd204_setup_stage2(struct jesd204_dev *jdev,
 {
 	struct ad9081_jesd204_priv *priv = jesd204_dev_priv(jdev);
 	struct ad9081_phy *phy = priv->phy;
-	int ret;
+	struct ad9081_hal_stats stats;
+	int ret, err;
 
 	if (reason != JESD204_STATE_OP_REASON_INIT)
 		return JESD204_STATE_CHANGE_DONE;
@@ -1336,9 +1516,15 @@ static int ad9081_jesd204_setup_stage2(struct jesd204_dev *jdev,
 
 	/* NCO Sync */
 
+	ad9081_hal_batch_begin(phy);
 	ret = ad9081_nco_sync(phy, jesd204_dev_is_top(jdev));
+	err = ad9081_hal_batch_end(phy, &stats);
 	if (ret != 0)
 		return ret;
+	if (err != 0)
+		return err;
+
+	ad9081_hal_stats_print(__func__, &stats);
 
 	return JESD204_STATE_CHANGE_DONE;
 }
@@ -1348,7 +1534,8 @@ static int ad9081_jesd204_setup_stage3(struct jesd204_dev *jdev,
 {
 	struct ad9081_jesd204_priv *priv = jesd204_dev_priv(jdev);
 	struct ad9081_phy *phy = priv->phy;
-	int ret;
+	struct ad9081_hal_stats stats;
+	int ret, err;
 
 	if (reason != JESD204_STATE_OP_REASON_INIT)
 		return JESD204_STATE_CHANGE_DONE;
@@ -1356,13 +1543,18 @@ static int ad9081_jesd204_setup_stage3(struct jesd204_dev *jdev,
 	pr_debug("%s:%d reason %s\n", __func__, __LINE__,
 		 jesd204_state_op_reason_str(reason));
 
+	ad9081_hal_batch_begin(phy);
 	ret = adi_ad9081_device_nco_sync_post(&phy->ad9081);
+	if (ret == 0)
+		ret = adi_ad9081_device_gpio_set_highz(&phy->ad9081,
+						       phy->sync_ms_gpio_num);
+	err = ad9081_hal_batch_end(phy, &stats);
 	if (ret != 0)
 		return ret;
+	if (err != 0)
+		return err;
 
-	ret = adi_ad9081_device_gpio_set_highz(&phy->ad9081, phy->sync_ms_gpio_num);
-	if (ret != 0)
-		return ret;
+	ad9081_hal_stats_print(__func__, &stats);
 
 	return JESD204_STATE_CHANGE_DONE;
 }
@@ -1426,6 +1618,7 @@ int32_t ad9081_init(struct ad9081_phy **dev,
 		    const struct ad9081_init_param *init_param)
 {
 	struct ad9081_jesd204_priv *priv;
+	struct ad9081_hal_stats stats;
 	adi_cms_chip_id_t chip_id;
 	struct ad9081_phy *phy;
 	uint8_t api_rev[3];
@@ -1527,6 +1720,8 @@ int32_t ad9081_init(struct ad9081_phy **dev,
 	if (ret < 0)
 		goto error_3;
 
+	ad9081_hal_batch_begin(phy);
+
 	ret = adi_ad9081_device_reset(&phy->ad9081, AD9081_HARD_RESET_AND_INIT);
 	if (ret < 0) {
 		printf("%s: reset/init failed (%"PRId32")\n", __func__, ret);
@@ -1553,6 +1748,11 @@ int32_t ad9081_init(struct ad9081_phy **dev,
 		goto error_3;
 	}
 
+	ret = ad9081_hal_batch_end(phy, &stats);
+	if (ret < 0)
+		goto error_3;
+	ad9081_hal_stats_print(__func__, &stats);
+
 	ret = jesd204_dev_register(&phy->jdev, &jesd204_ad9081_init);
 	if (ret < 0)
 		goto error_3;
@@ -56,6 +56,12 @@
 #define MAX_NUM_MAIN_DATAPATHS	4
 #define MAX_NUM_CHANNELIZER	8
 
+/* Largest transfer issued by the API, streaming NCO words included */
+#define AD9081_SPI_XFER_MAX	8
+/* Write-combining queue size, in bytes and in SPI transactions */
+#define AD9081_WC_BUF_SIZE	512
+#define AD9081_WC_MAX_BURSTS	64
+
 struct ad9081_jesd_link {
 	bool is_jrx;
 	adi_cms_jesd_param_t jesd_param;
@@ -68,6 +74,41 @@ struct ad9081_jesd_link {
 	unsigned long lane_cal_rate_kbps;
 };
 
+/**
+ * @struct ad9081_hal_stats
+ * @brief Register access counters of the HAL.
+ */
+struct ad9081_hal_stats {
+	/** Register write transfers requested by the API */
+	uint32_t	reg_writes;
+	/** Register read transfers requested by the API */
+	uint32_t	reg_reads;
+	/** SPI transactions issued on the bus */
+	uint32_t	spi_xfers;
+	/** Streaming bursts carrying more than one register write */
+	uint32_t	bursts;
+};
+
+/**
+ * @struct ad9081_wc
+ * @brief Write-combining queue. Inside a batch section, register writes
+ * are queued and writes to the next streaming address are merged into
+ * one SPI burst. The queue is flushed before reads, delays, reset pin
+ * changes and at the end of the section.
+ */
+struct ad9081_wc {
+	uint8_t			buf[AD9081_WC_BUF_SIZE];
+	struct no_os_spi_msg	msgs[AD9081_WC_MAX_BURSTS];
+	uint16_t		len;
+	uint8_t			nb_msgs;
+	/** Address that extends the last burst */
+	uint16_t		next_addr;
+	/** Batch section nesting level */
+	uint8_t			depth;
+	/** Counters at the start of the outermost section */
+	struct ad9081_hal_stats	start;
+};
+
 struct dac_settings_cache {
 	uint16_t chan_gain[MAX_NUM_CHANNELIZER];
 };
@@ -133,6 +174,9 @@ struct ad9081_phy {
 	uint8_t 	rx_fddc_select;
 	uint8_t		rx_cddc_nco_channel_select_mode[MAX_NUM_MAIN_DATAPATHS];
 	uint8_t		rx_ffh_gpio_mux_sel[6];
+	/* HAL */
+	struct ad9081_wc	wc;
+	struct ad9081_hal_stats	hal_stats;
 };
 
 struct link_init_param {
@@ -252,4 +296,9 @@ int32_t ad9081_init(struct ad9081_phy **device,
 int32_t ad9081_remove(struct ad9081_phy *device);
 /* Work function. */
 void ad9081_work_func(struct ad9081_phy *phy);
+/* Start a write-combining section. */
+void ad9081_hal_batch_begin(struct ad9081_phy *phy);
+/* End a write-combining section and get its register access counters. */
+int32_t ad9081_hal_batch_end(struct ad9081_phy *phy,
+			     struct ad9081_hal_stats *stats);
 #endif
@@ -0,0 +1,329 @@
+/***************************************************************************//**
+ *   @file   ad9081_nco_hop.c
+ *   @brief  Implementation of the AD9081 NCO hopping engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_error.h"
+#include "no_os_delay.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "adi_ad9081_hal.h"
+#include "ad9081_nco_hop.h"
+
+/******************************************************************************/
+/************************** Functions Implementation **************************/
+/******************************************************************************/
+/**
+ * Get the time elapsed since a timestamp.
+ * @param start - The timestamp.
+ * @return Elapsed time in microseconds.
+ */
+static uint32_t ad9081_nco_hop_elapsed_us(struct no_os_time start)
+{
+	struct no_os_time now = no_os_get_time();
+
+	return (now.s - start.s) * 1000000 + now.us - start.us;
+}
+
+/**
+ * Configure what applies a hop and precompute the selection registers, so
+ * a hop is two register writes and no read.
+ * @param desc - The NCO hopping engine descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9081_nco_hop_arm(struct ad9081_nco_hop_desc *desc)
+{
+	adi_ad9081_device_t *device = &desc->phy->ad9081;
+	uint8_t mode, val;
+	int32_t ret;
+
+	if (desc->path == AD9081_NCO_HOP_RX_COARSE) {
+		if (desc->trigger == AD9081_NCO_HOP_TRIG_GPIO)
+			mode = AD9081_FFH_CHAN_SEL_4GPIO_MODE;
+		else
+			mode = AD9081_FFH_CHAN_SEL_REG_MODE;
+
+		ret = adi_ad9081_adc_ddc_coarse_nco_channel_select_via_gpio_set(
+			      device, desc->mask, mode);
+		if (ret)
+			return ret;
+
+		ret = adi_ad9081_adc_ddc_coarse_trig_hop_en_set(device,
+				desc->mask,
+				desc->trigger == AD9081_NCO_HOP_TRIG_SYNC);
+		if (ret)
+			return ret;
+
+		ret = adi_ad9081_hal_reg_get(device, REG_ADC_COARSE_PAGE_ADDR,
+					     &val);
+		if (ret)
+			return ret;
+
+		desc->page_addr = REG_ADC_COARSE_PAGE_ADDR;
+		desc->page_val = (desc->mask << 4) | (val & 0x0F);
+		desc->ctrl_addr = REG_COARSE_DDC_NCO_CTRL_ADDR;
+		desc->ctrl_val = BF_COARSE_DDC0_NCO_CHAN_SEL_MODE(mode);
+
+		return 0;
+	}
+
+	if (desc->trigger == AD9081_NCO_HOP_TRIG_SYNC)
+		return -EINVAL;
+
+	ret = adi_ad9081_dac_duc_main_nco_hopf_gpio_as_hop_en_set(device,
+			desc->trigger == AD9081_NCO_HOP_TRIG_GPIO);
+	if (ret)
+		return ret;
+
+	desc->phy->tx_ffh_hopf_via_gpio_en =
+		desc->trigger == AD9081_NCO_HOP_TRIG_GPIO;
+
+	/* The hop mode bits are the same for all the selected DACs */
+	ret = adi_ad9081_dac_select_set(device, desc->mask & -desc->mask);
+	if (ret)
+		return ret;
+
+	ret = adi_ad9081_hal_reg_get(device, REG_DDSM_HOPF_CTRL0_ADDR, &val);
+	if (ret)
+		return ret;
+
+	desc->page_addr = REG_PAGEINDX_DAC_MAINDP_DAC_ADDR;
+	desc->page_val = desc->mask;
+	desc->ctrl_addr = REG_DDSM_HOPF_CTRL0_ADDR;
+	desc->ctrl_val = val & ~BF_DDSM_HOPF_SEL(0xFF);
+
+	return 0;
+}
+
+/**
+ * Load a new list of hop frequencies. The FTWs are computed once here and
+ * uploaded in a single write-combining section. The descriptor keeps the
+ * previous list unless the whole upload succeeds.
+ * @param desc - The NCO hopping engine descriptor.
+ * @param freq_hz - Hop frequencies, NCO shift in Hz.
+ * @param num_freq - Number of hop frequencies.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9081_nco_hop_load(struct ad9081_nco_hop_desc *desc,
+			    const int64_t *freq_hz, uint8_t num_freq)
+{
+	uint64_t ftw[AD9081_NCO_HOP_MAX];
+	adi_ad9081_device_t *device;
+	struct no_os_time start;
+	uint64_t adc_freq, dac_freq;
+	uint8_t i, max;
+	int32_t ret, err;
+
+	if (!desc || !freq_hz || !num_freq)
+		return -EINVAL;
+
+	if (desc->path == AD9081_NCO_HOP_RX_COARSE)
+		max = AD9081_NCO_HOP_RX_MAX;
+	else
+		max = AD9081_NCO_HOP_TX_MAX;
+	if (num_freq > max)
+		return -EINVAL;
+
+	device = &desc->phy->ad9081;
+	adc_freq = device->dev_info.adc_freq_hz;
+	dac_freq = device->dev_info.dac_freq_hz;
+	start = no_os_get_time();
+
+	for (i = 0; i < num_freq; i++) {
+		if (desc->path == AD9081_NCO_HOP_RX_COARSE)
+			ret = adi_ad9081_hal_calc_rx_nco_ftw(device, adc_freq,
+							     freq_hz[i],
+							     &ftw[i]);
+		else
+			ret = adi_ad9081_hal_calc_tx_nco_ftw32(device, dac_freq,
+							       freq_hz[i],
+							       &ftw[i]);
+		if (ret)
+			return ret;
+	}
+
+	ad9081_hal_batch_begin(desc->phy);
+
+	for (i = 0, ret = 0; i < num_freq && !ret; i++) {
+		if (desc->path == AD9081_NCO_HOP_RX_COARSE) {
+			ret = adi_ad9081_adc_ddc_coarse_nco_channel_update_index_set(
+				      device, desc->mask, i);
+			if (ret)
+				break;
+
+			ret = adi_ad9081_adc_ddc_coarse_nco_ftw_set(device,
+					desc->mask, ftw[i], 0, 0);
+		} else {
+			/* FTW0 stays the main NCO setting */
+			ret = adi_ad9081_dac_duc_main_nco_hopf_ftw_set(device,
+					desc->mask, i + 1, ftw[i]);
+		}
+	}
+
+	err = ad9081_hal_batch_end(desc->phy, &desc->load_stats);
+	if (ret)
+		return ret;
+	if (err)
+		return err;
+
+	/* Only commit the table once the device holds it */
+	for (i = 0; i < num_freq; i++) {
+		desc->ftw[i] = ftw[i];
+		desc->freq_hz[i] = freq_hz[i];
+	}
+	desc->num_freq = num_freq;
+	desc->load_time_us = ad9081_nco_hop_elapsed_us(start);
+
+	return 0;
+}
+
+/**
+ * Select a hop frequency. Depending on the trigger, the hop takes effect
+ * right away or on the next DDC trigger.
+ * @param desc - The NCO hopping engine descriptor.
+ * @param index - Index of the hop frequency.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9081_nco_hop_select(struct ad9081_nco_hop_desc *desc,
+			      uint8_t index)
+{
+	struct ad9081_hal_stats stats;
+	adi_ad9081_device_t *device;
+	struct no_os_time start;
+	uint8_t ctrl, sel;
+	uint32_t latency;
+	int32_t ret, err;
+
+	if (!desc || index >= desc->num_freq)
+		return -EINVAL;
+
+	/* The profile pins own the selection */
+	if (desc->trigger == AD9081_NCO_HOP_TRIG_GPIO)
+		return -EPERM;
+
+	device = &desc->phy->ad9081;
+	if (desc->path == AD9081_NCO_HOP_RX_COARSE) {
+		ctrl = BF_COARSE_DDC0_NCO_REGMAP_CHAN_SEL(index);
+	} else {
+		/* Hop FTW1 holds the first hop frequency */
+		sel = index + 1;
+		ctrl = BF_DDSM_HOPF_SEL(sel);
+	}
+	ctrl |= desc->ctrl_val;
+
+	start = no_os_get_time();
+
+	ad9081_hal_batch_begin(desc->phy);
+	ret = adi_ad9081_hal_reg_set(device, desc->page_addr, desc->page_val);
+	if (!ret)
+		ret = adi_ad9081_hal_reg_set(device, desc->ctrl_addr, ctrl);
+	err = ad9081_hal_batch_end(desc->phy, &stats);
+	if (ret)
+		return ret;
+	if (err)
+		return err;
+
+	latency = ad9081_nco_hop_elapsed_us(start);
+
+	desc->index = index;
+	desc->hops++;
+	desc->hop_latency_us = latency;
+	desc->hop_latency_max_us = no_os_max(desc->hop_latency_max_us, latency);
+	desc->hop_spi_xfers = stats.spi_xfers;
+
+	return 0;
+}
+
+/**
+ * Initialize the NCO hopping engine and load the hop frequencies.
+ * @param desc - The NCO hopping engine descriptor.
+ * @param init_param - The initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9081_nco_hop_init(struct ad9081_nco_hop_desc **desc,
+			    const struct ad9081_nco_hop_init_param *init_param)
+{
+	struct ad9081_nco_hop_desc *d;
+	int32_t ret;
+
+	if (!desc || !init_param || !init_param->phy || !init_param->mask)
+		return -EINVAL;
+
+	d = no_os_calloc(1, sizeof(*d));
+	if (!d)
+		return -ENOMEM;
+
+	d->phy = init_param->phy;
+	d->path = init_param->path;
+	d->mask = init_param->mask;
+	d->trigger = init_param->trigger;
+
+	ret = ad9081_nco_hop_load(d, init_param->freq_hz,
+				  init_param->num_freq);
+	if (ret)
+		goto error;
+
+	ret = ad9081_nco_hop_arm(d);
+	if (ret)
+		goto error;
+
+	*desc = d;
+
+	return 0;
+
+error:
+	no_os_free(d);
+
+	return ret;
+}
+
+/**
+ * Remove the NCO hopping engine.
+ * @param desc - The NCO hopping engine descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t ad9081_nco_hop_remove(struct ad9081_nco_hop_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc);
+
+	return 0;
+}
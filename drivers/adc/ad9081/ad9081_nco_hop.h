@@ -0,0 +1,149 @@
+/***************************************************************************//**
+ *   @file   ad9081_nco_hop.h
+ *   @brief  Header file of the AD9081 NCO hopping engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef AD9081_NCO_HOP_H_
+#define AD9081_NCO_HOP_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "ad9081.h"
+
+/******************************************************************************/
+/********************** Macros and Types Declarations *************************/
+/******************************************************************************/
+/* Coarse DDC NCO profiles */
+#define AD9081_NCO_HOP_RX_MAX	16
+/* Main DUC NCO hop frequencies, FTW1 to FTW31 */
+#define AD9081_NCO_HOP_TX_MAX	31
+#define AD9081_NCO_HOP_MAX	AD9081_NCO_HOP_TX_MAX
+
+/**
+ * @enum ad9081_nco_hop_path
+ * @brief NCOs driven by the hopping engine.
+ */
+enum ad9081_nco_hop_path {
+	/** Receive coarse DDC NCOs, one profile per hop frequency */
+	AD9081_NCO_HOP_RX_COARSE,
+	/** Transmit main DUC NCOs, one hop FTW per hop frequency */
+	AD9081_NCO_HOP_TX_MAIN,
+};
+
+/**
+ * @enum ad9081_nco_hop_trigger
+ * @brief Event that applies a hop.
+ */
+enum ad9081_nco_hop_trigger {
+	/** The hop takes effect when the selection is written over SPI */
+	AD9081_NCO_HOP_TRIG_SPI,
+	/**
+	 * The profile pins select the hop frequency, on the transmit path
+	 * the FFH strobe pin applies it.
+	 */
+	AD9081_NCO_HOP_TRIG_GPIO,
+	/**
+	 * The selection written over SPI is staged and takes effect on the
+	 * next DDC trigger, receive path only.
+	 */
+	AD9081_NCO_HOP_TRIG_SYNC,
+};
+
+/**
+ * @struct ad9081_nco_hop_init_param
+ * @brief NCO hopping engine initialization parameters.
+ */
+struct ad9081_nco_hop_init_param {
+	/** Device the NCOs belong to */
+	struct ad9081_phy		*phy;
+	enum ad9081_nco_hop_path	path;
+	/** Coarse DDC mask (AD9081_ADC_CDDC_x) or DAC mask (AD9081_DAC_x) */
+	uint8_t				mask;
+	enum ad9081_nco_hop_trigger	trigger;
+	/** Hop frequencies, NCO shift in Hz */
+	const int64_t			*freq_hz;
+	uint8_t				num_freq;
+};
+
+/**
+ * @struct ad9081_nco_hop_desc
+ * @brief NCO hopping engine descriptor.
+ */
+struct ad9081_nco_hop_desc {
+	struct ad9081_phy		*phy;
+	enum ad9081_nco_hop_path	path;
+	uint8_t				mask;
+	enum ad9081_nco_hop_trigger	trigger;
+	uint8_t				num_freq;
+	int64_t				freq_hz[AD9081_NCO_HOP_MAX];
+	uint64_t			ftw[AD9081_NCO_HOP_MAX];
+	/** Precomputed selection: page register, then control register */
+	uint16_t			page_addr;
+	uint8_t				page_val;
+	uint16_t			ctrl_addr;
+	uint8_t				ctrl_val;
+	/** Last selected hop frequency */
+	uint8_t				index;
+	/** Number of hops done over SPI */
+	uint32_t			hops;
+	/** Duration of the last hop and worst case, in microseconds */
+	uint32_t			hop_latency_us;
+	uint32_t			hop_latency_max_us;
+	/** SPI transactions of the last hop */
+	uint32_t			hop_spi_xfers;
+	/** Duration of the last table load, in microseconds */
+	uint32_t			load_time_us;
+	/** Register accesses of the last table load */
+	struct ad9081_hal_stats		load_stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Initialize the NCO hopping engine and load the hop frequencies. */
+int32_t ad9081_nco_hop_init(struct ad9081_nco_hop_desc **desc,
+			    const struct ad9081_nco_hop_init_param *init_param);
+/* Remove the NCO hopping engine. */
+int32_t ad9081_nco_hop_remove(struct ad9081_nco_hop_desc *desc);
+/* Load a new list of hop frequencies. */
+int32_t ad9081_nco_hop_load(struct ad9081_nco_hop_desc *desc,
+			    const int64_t *freq_hz, uint8_t num_freq);
+/* Select a hop frequency. */
+int32_t ad9081_nco_hop_select(struct ad9081_nco_hop_desc *desc,
+			      uint8_t index);
+
+#endif
@@ -0,0 +1,227 @@
+/***************************************************************************//**
+ *   @file   iio_ad9081_nco_hop.c
+ *   @brief  Implementation of the AD9081 NCO hopping IIO driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifdef IIO_SUPPORT
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "ad9081_nco_hop.h"
+#include "iio_ad9081_nco_hop.h"
+#include "iio.h"
+
+enum ad9081_nco_hop_iio_attr {
+	AD9081_NCO_HOP_IIO_INDEX,
+	AD9081_NCO_HOP_IIO_FREQUENCIES,
+	AD9081_NCO_HOP_IIO_TRIGGER,
+	AD9081_NCO_HOP_IIO_COUNT,
+	AD9081_NCO_HOP_IIO_LATENCY,
+	AD9081_NCO_HOP_IIO_LATENCY_MAX,
+	AD9081_NCO_HOP_IIO_SPI_XFERS,
+	AD9081_NCO_HOP_IIO_LOAD_TIME,
+	AD9081_NCO_HOP_IIO_LOAD_SPI_XFERS,
+};
+
+static const char *const ad9081_nco_hop_iio_triggers[] = {
+	[AD9081_NCO_HOP_TRIG_SPI] = "spi",
+	[AD9081_NCO_HOP_TRIG_GPIO] = "gpio",
+	[AD9081_NCO_HOP_TRIG_SYNC] = "sync",
+};
+
+/**
+ * @brief Handles the read request for the hopping engine attributes.
+ * @param dev - The NCO hopping engine descriptor.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Attribute id.
+ * @return Length of the data in buf in case of success, negative error code
+ * 	   otherwise.
+ */
+static int ad9081_nco_hop_iio_show(void *dev, char *buf, uint32_t len,
+				   const struct iio_ch_info *channel,
+				   intptr_t priv)
+{
+	struct ad9081_nco_hop_desc *desc = dev;
+	uint32_t i, n;
+	int32_t val;
+
+	switch (priv) {
+	case AD9081_NCO_HOP_IIO_INDEX:
+		val = desc->index;
+		break;
+	case AD9081_NCO_HOP_IIO_FREQUENCIES:
+		for (i = 0, n = 0; i < desc->num_freq && n < len; i++)
+			n += snprintf(buf + n, len - n, "%s%" PRId64,
+				      i ? " " : "", desc->freq_hz[i]);
+		return no_os_min(n, len);
+	case AD9081_NCO_HOP_IIO_TRIGGER:
+		return snprintf(buf, len, "%s",
+				ad9081_nco_hop_iio_triggers[desc->trigger]);
+	case AD9081_NCO_HOP_IIO_COUNT:
+		val = desc->hops;
+		break;
+	case AD9081_NCO_HOP_IIO_LATENCY:
+		val = desc->hop_latency_us;
+		break;
+	case AD9081_NCO_HOP_IIO_LATENCY_MAX:
+		val = desc->hop_latency_max_us;
+		break;
+	case AD9081_NCO_HOP_IIO_SPI_XFERS:
+		val = desc->hop_spi_xfers;
+		break;
+	case AD9081_NCO_HOP_IIO_LOAD_TIME:
+		val = desc->load_time_us;
+		break;
+	case AD9081_NCO_HOP_IIO_LOAD_SPI_XFERS:
+		val = desc->load_stats.spi_xfers;
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Handles the write request for the hopping engine attributes:
+ * select a hop frequency, load a new list of hop frequencies (in Hz,
+ * separated by spaces) or clear the worst case hop latency.
+ * @param dev - The NCO hopping engine descriptor.
+ * @param buf - Command buffer containing the value to be written.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Attribute id.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ad9081_nco_hop_iio_store(void *dev, char *buf, uint32_t len,
+				    const struct iio_ch_info *channel,
+				    intptr_t priv)
+{
+	struct ad9081_nco_hop_desc *desc = dev;
+	int64_t freq_hz[AD9081_NCO_HOP_MAX];
+	uint8_t num_freq = 0;
+	char *end;
+	int32_t val;
+
+	switch (priv) {
+	case AD9081_NCO_HOP_IIO_INDEX:
+		iio_parse_value(buf, IIO_VAL_INT, &val, NULL);
+		if (val < 0 || val > UINT8_MAX)
+			return -EINVAL;
+
+		return ad9081_nco_hop_select(desc, val);
+	case AD9081_NCO_HOP_IIO_FREQUENCIES:
+		while (num_freq < AD9081_NCO_HOP_MAX) {
+			freq_hz[num_freq] = strtoll(buf, &end, 0);
+			if (end == buf)
+				break;
+
+			num_freq++;
+			buf = end;
+		}
+
+		return ad9081_nco_hop_load(desc, freq_hz, num_freq);
+	case AD9081_NCO_HOP_IIO_LATENCY_MAX:
+		desc->hop_latency_max_us = 0;
+
+		return 0;
+	default:
+		return -EINVAL;
+	}
+}
+
+static struct iio_attribute ad9081_nco_hop_iio_attrs[] = {
+	{
+		.name = "hop_index",
+		.priv = AD9081_NCO_HOP_IIO_INDEX,
+		.show = ad9081_nco_hop_iio_show,
+		.store = ad9081_nco_hop_iio_store,
+	},
+	{
+		.name = "hop_frequencies",
+		.priv = AD9081_NCO_HOP_IIO_FREQUENCIES,
+		.show = ad9081_nco_hop_iio_show,
+		.store = ad9081_nco_hop_iio_store,
+	},
+	{
+		.name = "hop_trigger",
+		.priv = AD9081_NCO_HOP_IIO_TRIGGER,
+		.show = ad9081_nco_hop_iio_show,
+	},
+	{
+		.name = "hop_count",
+		.priv = AD9081_NCO_HOP_IIO_COUNT,
+		.show = ad9081_nco_hop_iio_show,
+	},
+	{
+		.name = "hop_latency_us",
+		.priv = AD9081_NCO_HOP_IIO_LATENCY,
+		.show = ad9081_nco_hop_iio_show,
+	},
+	{
+		.name = "hop_latency_max_us",
+		.priv = AD9081_NCO_HOP_IIO_LATENCY_MAX,
+		.show = ad9081_nco_hop_iio_show,
+		.store = ad9081_nco_hop_iio_store,
+	},
+	{
+		.name = "hop_spi_transactions",
+		.priv = AD9081_NCO_HOP_IIO_SPI_XFERS,
+		.show = ad9081_nco_hop_iio_show,
+	},
+	{
+		.name = "load_time_us",
+		.priv = AD9081_NCO_HOP_IIO_LOAD_TIME,
+		.show = ad9081_nco_hop_iio_show,
+	},
+	{
+		.name = "load_spi_transactions",
+		.priv = AD9081_NCO_HOP_IIO_LOAD_SPI_XFERS,
+		.show = ad9081_nco_hop_iio_show,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+struct iio_device ad9081_nco_hop_iio_descriptor = {
+	.attributes = ad9081_nco_hop_iio_attrs,
+};
+
+#endif /* IIO_SUPPORT */
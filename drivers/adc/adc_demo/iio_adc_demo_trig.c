@@ -66,6 +66,7 @@ struct iio_trigger adc_iio_sw_trig_desc = {
 #ifndef LINUX_PLATFORM
 struct iio_trigger adc_iio_timer_trig_desc = {
 	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable,
 };
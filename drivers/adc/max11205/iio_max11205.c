@@ -170,45 +170,73 @@ static int max11205_iio_read_sampling_frequency(void *dev, char *buf,
 }
 
 /**
- * @brief Reads the number of given samples
- *
- * @param dev     - The iio device structure.
- * @param buf     - Command buffer to be filled with requested data.
- * @param samples - Number of samples to be returned.
- * @return ret    - Result of the reading procedure. In case of success, the size of the read data is returned.
+ * @brief Drop stale samples before a buffered capture starts.
+ * @param dev  - The iio device structure.
+ * @param mask - Mask of the enabled channels.
+ * @return ret - Result of the enable procedure.
  */
-static int max11205_iio_read_samples(void* dev, int16_t* buff, uint32_t samples)
+static int max11205_iio_buffer_enable(void *dev, uint32_t mask)
 {
-	int ret;
-	bool new_data_avail = false;
-	struct max11205_iio_dev *iio_max11205;
-	uint32_t timeout = MAX11205_NEW_DATA_TIMEOUT;
-	uint32_t i;
+	struct max11205_iio_dev *iio_max11205 = dev;
 
-	if (!dev)
+	if (!iio_max11205 || !iio_max11205->max11205_dev)
 		return -EINVAL;
 
-	iio_max11205 = (struct max11205_iio_dev *)dev;
+	return max11205_flush_samples(iio_max11205->max11205_dev);
+}
 
-	if (!iio_max11205->max11205_dev)
-		return -EINVAL;
+/**
+ * @brief Fills the IIO buffer with the samples queued by the RDY interrupt.
+ * @param dev_data - The iio device data structure.
+ * @return ret     - Result of the submit procedure.
+ */
+static int max11205_iio_submit(struct iio_device_data *dev_data)
+{
+	struct max11205_iio_dev *iio_max11205 = dev_data->dev;
+	uint32_t timeout = MAX11205_NEW_DATA_TIMEOUT;
+	int16_t sample;
+	uint32_t i = 0;
+	int ret;
 
-	for (i = 0; i < samples; i++) {
-		while (!new_data_avail && timeout) {
-			ret = max11205_get_data_raw(iio_max11205->max11205_dev, &new_data_avail,
-						    &buff[i]);
-			if (ret)
-				return ret;
-			timeout --;
+	while (i < dev_data->buffer->samples) {
+		ret = max11205_get_sample(iio_max11205->max11205_dev, &sample);
+		if (ret == -EAGAIN) {
+			if (!--timeout)
+				return -EIO;
+			continue;
 		}
+		if (ret)
+			return ret;
 
-		if (!timeout)
-			return -EIO;
+		ret = iio_buffer_push_scan(dev_data->buffer, &sample);
+		if (ret)
+			return ret;
+
+		timeout = MAX11205_NEW_DATA_TIMEOUT;
+		i++;
+	}
 
-		new_data_avail = false;
+	return 0;
+}
+
+/**
+ * @brief Moves all the queued samples into the IIO buffer without waiting.
+ * @param dev_data - The iio device data structure.
+ * @return ret     - Result of the trigger handler procedure.
+ */
+static int max11205_iio_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct max11205_iio_dev *iio_max11205 = dev_data->dev;
+	int16_t sample;
+	int ret;
+
+	while (!max11205_get_sample(iio_max11205->max11205_dev, &sample)) {
+		ret = iio_buffer_push_scan(dev_data->buffer, &sample);
+		if (ret)
+			return ret;
 	}
 
-	return samples;
+	return 0;
 }
 
 static struct iio_attribute max11205_iio_adc_attrs[] = {
@@ -246,7 +274,9 @@ static struct iio_channel max11205_channels[] = {
 static struct iio_device max11205_iio_dev = {
 	.num_ch = NO_OS_ARRAY_SIZE(max11205_channels),
 	.channels = max11205_channels,
-	.read_dev = (int32_t (*)())max11205_iio_read_samples,
+	.pre_enable = (int32_t (*)())max11205_iio_buffer_enable,
+	.submit = (int32_t (*)())max11205_iio_submit,
+	.trigger_handler = (int32_t (*)())max11205_iio_trigger_handler,
 };
 
 /**
@@ -75,6 +75,15 @@ static void max11205_irq_handler(void *dev)
 	desc->adc_data_raw = (int16_t)no_os_get_unaligned_be16(data);
 	desc->data_updated = true;
 
+	/* Single producer ring, the reader only moves ring_tail. */
+	if (desc->ring_head - desc->ring_tail == MAX11205_RING_SIZE) {
+		desc->ring_overrun++;
+	} else {
+		desc->ring[desc->ring_head & (MAX11205_RING_SIZE - 1)] =
+			desc->adc_data_raw;
+		desc->ring_head++;
+	}
+
 	ret = no_os_irq_enable(desc->irq_ctrl,
 			       desc->gpio_rdy->number);
 	if (ret)
@@ -183,6 +192,49 @@ int max11205_get_data_raw(struct max11205_dev *dev, bool *new_data_avail,
 	return 0;
 }
 
+/**
+ * @brief Get the oldest sample acquired by the RDY interrupt.
+ *
+ * Never waits for a conversion, the samples are read out in the interrupt
+ * handler and queued in a lock-free single producer single consumer ring.
+ * @param dev - Device handler.
+ * @param data_raw - Pointer to raw adc value.
+ * @return 0 in case of success, -EAGAIN if no sample is queued, negative
+ * 	   error code otherwise.
+ */
+int max11205_get_sample(struct max11205_dev *dev, int16_t *data_raw)
+{
+	uint32_t tail;
+
+	if (!dev || !data_raw)
+		return -EINVAL;
+
+	tail = dev->ring_tail;
+	if (dev->ring_head == tail)
+		return -EAGAIN;
+
+	*data_raw = dev->ring[tail & (MAX11205_RING_SIZE - 1)];
+	dev->ring_tail = tail + 1;
+
+	return 0;
+}
+
+/**
+ * @brief Drop the samples queued by the RDY interrupt.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int max11205_flush_samples(struct max11205_dev *dev)
+{
+	if (!dev)
+		return -EINVAL;
+
+	dev->ring_tail = dev->ring_head;
+	dev->ring_overrun = 0;
+
+	return 0;
+}
+
 /**
  * @brief Get the converted data.
  * @param dev - Device handler.
@@ -55,6 +55,8 @@
 #define MAX11205_VREF_MAX_MV 		3600
 #define MAX11205_DATA_SIZE_BYTES 	2
 #define MAX11205_SCALE 			NO_OS_GENMASK(14,0)
+/* Number of samples buffered by the RDY interrupt, power of two */
+#define MAX11205_RING_SIZE		64
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -74,6 +76,14 @@ struct max11205_dev {
 	int16_t				adc_data_raw;
 	/** True if data was updated since last read */
 	bool				data_updated;
+	/** Samples acquired by the RDY interrupt */
+	int16_t				ring[MAX11205_RING_SIZE];
+	/** Ring write index, only updated by the RDY interrupt */
+	volatile uint32_t		ring_head;
+	/** Ring read index, only updated by the reader */
+	volatile uint32_t		ring_tail;
+	/** Number of samples lost because the ring was full */
+	uint32_t			ring_overrun;
 };
 
 struct max11205_init_param {
@@ -91,6 +101,8 @@ int max11205_init(struct max11205_dev **device,
 		  struct max11205_init_param init_param);
 int max11205_get_data_raw(struct max11205_dev *dev, bool *new_data_avail,
 			  int16_t *data_raw);
+int max11205_get_sample(struct max11205_dev *dev, int16_t *data_raw);
+int max11205_flush_samples(struct max11205_dev *dev);
 int max11205_get_data_mv(struct max11205_dev *dev, int16_t raw_data,
 			 int32_t *data_mv);
 
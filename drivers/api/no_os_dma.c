@@ -132,7 +132,7 @@ int no_os_dma_init(struct no_os_dma_desc **desc,
 
 list_err:
 	for (j = 0; j < i; j++)
-		no_os_list_remove((*desc)->channels[i].sg_list);
+		no_os_list_remove((*desc)->channels[j].sg_list);
 
 	no_os_dma_remove(*desc);
 unlock:
@@ -158,7 +158,7 @@ int no_os_dma_remove(struct no_os_dma_desc *desc)
 		return 0;
 
 	for (i = 0; i < desc->num_ch; i++) {
-		ret = no_os_list_remove(desc->channels->sg_list);
+		ret = no_os_list_remove(desc->channels[i].sg_list);
 		if (ret)
 			return ret;
 
@@ -167,13 +167,10 @@ int no_os_dma_remove(struct no_os_dma_desc *desc)
 
 	no_os_mutex_remove(desc->mutex);
 
-	ret = desc->platform_ops->dma_remove(desc);
-	if (ret)
-		return ret;
-
+	/* The platform specific remove function may free the descriptor. */
 	desc->ref--;
 
-	return 0;
+	return desc->platform_ops->dma_remove(desc);
 }
 
 /**
@@ -41,6 +41,8 @@
 #include "no_os_gpio.h"
 #include <stdlib.h>
 #include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -239,3 +241,200 @@ int32_t no_os_gpio_get_value(struct no_os_gpio_desc *desc,
 
 	return 0;
 }
+
+/**
+ * @brief Free the pins of a group driven pin by pin.
+ * @param desc - The GPIO group descriptor.
+ * @param nb_pins - Number of pins to free.
+ */
+static void no_os_gpio_group_free_pins(struct no_os_gpio_group_desc *desc,
+				       uint8_t nb_pins)
+{
+	while (nb_pins--)
+		no_os_gpio_remove(desc->pins[nb_pins]);
+
+	no_os_free(desc->pins);
+	no_os_free(desc);
+}
+
+/**
+ * @brief Obtain a GPIO group descriptor. The platform drives the pins with
+ * port wide operations when it supports them, otherwise the pins are driven
+ * one by one.
+ * @param desc - The GPIO group descriptor.
+ * @param param - GPIO group initialization parameters. All the pins must use
+ *                the same platform ops.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_group_get(struct no_os_gpio_group_desc **desc,
+			     const struct no_os_gpio_group_init_param *param)
+{
+	const struct no_os_gpio_platform_ops *ops;
+	struct no_os_gpio_group_desc *group;
+	uint8_t value;
+	int32_t ret;
+	uint8_t i;
+
+	if (!desc || !param || !param->pins || !param->nb_pins ||
+	    param->nb_pins > NO_OS_GPIO_GROUP_MAX_PINS)
+		return -EINVAL;
+
+	ops = param->pins[0].platform_ops;
+	if (!ops)
+		return -EINVAL;
+
+	for (i = 1; i < param->nb_pins; i++)
+		if (param->pins[i].platform_ops != ops)
+			return -EINVAL;
+
+	if (ops->gpio_ops_group_get) {
+		ret = ops->gpio_ops_group_get(desc, param);
+		if (ret)
+			return ret;
+
+		(*desc)->platform_ops = ops;
+
+		return 0;
+	}
+
+	group = no_os_calloc(1, sizeof(*group));
+	if (!group)
+		return -ENOMEM;
+
+	group->pins = no_os_calloc(param->nb_pins, sizeof(*group->pins));
+	if (!group->pins) {
+		no_os_free(group);
+		return -ENOMEM;
+	}
+
+	for (i = 0; i < param->nb_pins; i++) {
+		ret = no_os_gpio_get(&group->pins[i], &param->pins[i]);
+		if (ret)
+			goto free_pins;
+
+		value = !!(param->init_values & NO_OS_BIT(i));
+		if (param->out_mask & NO_OS_BIT(i))
+			ret = no_os_gpio_direction_output(group->pins[i],
+							  value);
+		else
+			ret = no_os_gpio_direction_input(group->pins[i]);
+		if (ret) {
+			i++;
+			goto free_pins;
+		}
+	}
+
+	group->nb_pins = param->nb_pins;
+	group->out_mask = param->out_mask;
+	group->platform_ops = ops;
+	*desc = group;
+
+	return 0;
+
+free_pins:
+	no_os_gpio_group_free_pins(group, i);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_gpio_group_get().
+ * @param desc - The GPIO group descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_group_remove(struct no_os_gpio_group_desc *desc)
+{
+	if (!desc)
+		return 0;
+
+	if (!desc->platform_ops)
+		return -EINVAL;
+
+	if (desc->platform_ops->gpio_ops_group_remove)
+		return desc->platform_ops->gpio_ops_group_remove(desc);
+
+	no_os_gpio_group_free_pins(desc, desc->nb_pins);
+
+	return 0;
+}
+
+/**
+ * @brief Set the level of the group outputs selected by a mask, in one port
+ * access when the platform supports it.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Pins to update, bit i selects the pin i of the group.
+ * @param values - Levels of the selected pins, bit i for the pin i.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_group_set_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t values)
+{
+	int32_t ret;
+	uint8_t i;
+
+	if (!desc || !desc->platform_ops)
+		return -EINVAL;
+
+	mask &= NO_OS_GENMASK(desc->nb_pins - 1, 0);
+	if (!mask)
+		return 0;
+
+	if (desc->platform_ops->gpio_ops_group_set_values)
+		return desc->platform_ops->
+		       gpio_ops_group_set_values(desc, mask, values);
+
+	for (i = 0; i < desc->nb_pins; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+
+		ret = no_os_gpio_set_value(desc->pins[i],
+					   !!(values & NO_OS_BIT(i)));
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the level of the group pins selected by a mask, in one port
+ * access when the platform supports it.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Pins to read, bit i selects the pin i of the group.
+ * @param values - Levels of the selected pins, bit i for the pin i. The other
+ *                 bits are cleared.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_gpio_group_get_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t *values)
+{
+	uint8_t value;
+	int32_t ret;
+	uint8_t i;
+
+	if (!desc || !desc->platform_ops || !values)
+		return -EINVAL;
+
+	mask &= NO_OS_GENMASK(desc->nb_pins - 1, 0);
+	*values = 0;
+	if (!mask)
+		return 0;
+
+	if (desc->platform_ops->gpio_ops_group_get_values)
+		return desc->platform_ops->
+		       gpio_ops_group_get_values(desc, mask, values);
+
+	for (i = 0; i < desc->nb_pins; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+
+		ret = no_os_gpio_get_value(desc->pins[i], &value);
+		if (ret)
+			return ret;
+
+		if (value == NO_OS_GPIO_HIGH)
+			*values |= NO_OS_BIT(i);
+	}
+
+	return 0;
+}
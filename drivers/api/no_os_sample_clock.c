@@ -0,0 +1,476 @@
+/***************************************************************************//**
+ *   @file   no_os_sample_clock.c
+ *   @brief  Implementation of the PWM sampling clock service.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <string.h>
+#include "no_os_sample_clock.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/**
+ * @brief Get the counter mask of a counter of the given width.
+ * @param bits - Counter width in bits, 0 for 32 bits.
+ * @return The counter mask.
+ */
+static uint32_t no_os_sample_clock_mask(uint8_t bits)
+{
+	if (!bits || bits >= 32)
+		return UINT32_MAX;
+
+	return NO_OS_GENMASK(bits - 1, 0);
+}
+
+/**
+ * @brief Read the edge counter and the time, extending both to 64 bits.
+ *
+ * Must be called at least once per wrap period of the edge and timestamp
+ * counters, which every tag and statistics read does.
+ * @param desc - The sampling clock descriptor.
+ * @param now_ns - The current time, in nanoseconds.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_sample_clock_update(struct no_os_sample_clock_desc *desc,
+				     uint64_t *now_ns)
+{
+	struct no_os_time t;
+	uint64_t ticks;
+	uint32_t raw;
+	int ret;
+
+	if (desc->edge_timer) {
+		ret = no_os_timer_counter_get(desc->edge_timer, &raw);
+		if (ret)
+			return ret;
+
+		desc->edges += (raw - desc->edge_raw) & desc->edge_mask;
+	} else {
+		raw = desc->sw_edges;
+		desc->edges += raw - desc->edge_raw;
+	}
+	desc->edge_raw = raw;
+
+	if (!desc->ts_timer) {
+		t = no_os_get_time();
+		*now_ns = (uint64_t)t.s * 1000000000ULL + (uint64_t)t.us * 1000;
+
+		return 0;
+	}
+
+	ret = no_os_timer_counter_get(desc->ts_timer, &raw);
+	if (ret)
+		return ret;
+
+	desc->ts_ticks += (raw - desc->ts_raw) & desc->ts_mask;
+	desc->ts_raw = raw;
+
+	/* Split the conversion so that it does not overflow on long runs. */
+	ticks = desc->ts_ticks;
+	*now_ns = (ticks / desc->ts_freq_hz) * 1000000000ULL +
+		  (ticks % desc->ts_freq_hz) * 1000000000ULL / desc->ts_freq_hz;
+
+	return 0;
+}
+
+/**
+ * @brief Refresh the conversion count and the effective rate.
+ * @param desc - The sampling clock descriptor.
+ * @param now_ns - The current time, in nanoseconds.
+ */
+static void no_os_sample_clock_update_rate(struct no_os_sample_clock_desc *desc,
+		uint64_t now_ns)
+{
+	uint64_t elapsed = now_ns - desc->start_ns;
+	uint64_t edges = desc->edges;
+	uint64_t rate, rem;
+	int i;
+
+	desc->stats.conversions = edges;
+	if (!elapsed)
+		return;
+
+	/*
+	 * rate_mhz = edges * 10^12 / elapsed, one decimal digit at a time so
+	 * that neither the product nor the remainder term can overflow.
+	 */
+	rate = edges / elapsed;
+	rem = edges % elapsed;
+	for (i = 0; i < 12; i++) {
+		rem *= 10;
+		rate = rate * 10 + rem / elapsed;
+		rem %= elapsed;
+	}
+
+	desc->stats.rate_mhz = rate;
+}
+
+/**
+ * @brief Initialize the sampling clock service.
+ * @param desc - The sampling clock descriptor.
+ * @param param - The initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_init(struct no_os_sample_clock_desc **desc,
+			    const struct no_os_sample_clock_init_param *param)
+{
+	struct no_os_sample_clock_desc *descriptor;
+	int ret;
+
+	if (!desc || !param || !param->pwm_init)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->edge_mask =
+		no_os_sample_clock_mask(param->edge_counter_bits);
+	descriptor->ts_mask = no_os_sample_clock_mask(param->ts_counter_bits);
+
+	ret = no_os_pwm_init(&descriptor->pwm, param->pwm_init);
+	if (ret)
+		goto free_desc;
+
+	if (param->edge_timer_init) {
+		ret = no_os_timer_init(&descriptor->edge_timer,
+				       param->edge_timer_init);
+		if (ret)
+			goto remove_pwm;
+
+		ret = no_os_timer_start(descriptor->edge_timer);
+		if (ret)
+			goto remove_edge_timer;
+	}
+
+	if (param->ts_timer_init) {
+		ret = no_os_timer_init(&descriptor->ts_timer,
+				       param->ts_timer_init);
+		if (ret)
+			goto remove_edge_timer;
+
+		ret = no_os_timer_count_clk_get(descriptor->ts_timer,
+						&descriptor->ts_freq_hz);
+		if (ret)
+			goto remove_ts_timer;
+
+		if (!descriptor->ts_freq_hz) {
+			ret = -EINVAL;
+			goto remove_ts_timer;
+		}
+
+		ret = no_os_timer_start(descriptor->ts_timer);
+		if (ret)
+			goto remove_ts_timer;
+	}
+
+	*desc = descriptor;
+
+	return 0;
+
+remove_ts_timer:
+	no_os_timer_remove(descriptor->ts_timer);
+remove_edge_timer:
+	if (descriptor->edge_timer)
+		no_os_timer_remove(descriptor->edge_timer);
+remove_pwm:
+	no_os_pwm_remove(descriptor->pwm);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by no_os_sample_clock_init().
+ * @param desc - The sampling clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_remove(struct no_os_sample_clock_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->running)
+		no_os_pwm_disable(desc->pwm);
+
+	if (desc->ts_timer)
+		no_os_timer_remove(desc->ts_timer);
+	if (desc->edge_timer)
+		no_os_timer_remove(desc->edge_timer);
+	no_os_pwm_remove(desc->pwm);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Reset the counters and start the conversion clock.
+ *
+ * Conversion 0 is the first edge generated after this call.
+ * @param desc - The sampling clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_start(struct no_os_sample_clock_desc *desc)
+{
+	uint64_t now_ns;
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->running)
+		return -EBUSY;
+
+	ret = no_os_sample_clock_update(desc, &now_ns);
+	if (ret)
+		return ret;
+
+	desc->edges = 0;
+	desc->next_index = 0;
+	desc->last_edges = 0;
+	desc->last_ns = now_ns;
+	desc->start_ns = now_ns;
+	memset(&desc->stats, 0, sizeof(desc->stats));
+	desc->stats.min_period_ns = UINT32_MAX;
+
+	ret = no_os_pwm_enable(desc->pwm);
+	if (ret)
+		return ret;
+
+	desc->running = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the conversion clock.
+ * @param desc - The sampling clock descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_stop(struct no_os_sample_clock_desc *desc)
+{
+	int ret;
+
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->running)
+		return 0;
+
+	ret = no_os_pwm_disable(desc->pwm);
+	if (ret)
+		return ret;
+
+	desc->running = false;
+
+	return 0;
+}
+
+/**
+ * @brief Set the conversion rate.
+ *
+ * The PWM duty cycle is kept unless it no longer fits in the new period, in
+ * which case it is set to half of the period.
+ * @param desc - The sampling clock descriptor.
+ * @param rate_hz - The conversion rate, in Hz.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_set_rate(struct no_os_sample_clock_desc *desc,
+				uint32_t rate_hz)
+{
+	uint32_t period_ns;
+	uint32_t duty_ns;
+	int ret;
+
+	if (!desc || !rate_hz || rate_hz > 1000000000)
+		return -EINVAL;
+
+	period_ns = NO_OS_DIV_ROUND_CLOSEST(1000000000U, rate_hz);
+
+	ret = no_os_pwm_get_duty_cycle(desc->pwm, &duty_ns);
+	if (ret)
+		return ret;
+
+	if (duty_ns >= period_ns) {
+		ret = no_os_pwm_set_duty_cycle(desc->pwm, period_ns / 2);
+		if (ret)
+			return ret;
+	}
+
+	return no_os_pwm_set_period(desc->pwm, period_ns);
+}
+
+/**
+ * @brief Get the nominal conversion rate.
+ * @param desc - The sampling clock descriptor.
+ * @param rate_hz - The conversion rate, in Hz.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_get_rate(struct no_os_sample_clock_desc *desc,
+				uint32_t *rate_hz)
+{
+	uint32_t period_ns;
+	int ret;
+
+	if (!desc || !rate_hz)
+		return -EINVAL;
+
+	ret = no_os_pwm_get_period(desc->pwm, &period_ns);
+	if (ret)
+		return ret;
+
+	if (!period_ns)
+		return -EINVAL;
+
+	*rate_hz = NO_OS_DIV_ROUND_CLOSEST(1000000000U, period_ns);
+
+	return 0;
+}
+
+/**
+ * @brief Count a conversion start edge.
+ *
+ * Used when no edge counter timer is available. Register it as the callback
+ * of the PWM or converter BUSY interrupt, with the sampling clock descriptor
+ * as context.
+ * @param ctx - The sampling clock descriptor.
+ */
+void no_os_sample_clock_edge_isr(void *ctx)
+{
+	struct no_os_sample_clock_desc *desc = ctx;
+
+	desc->sw_edges++;
+}
+
+/**
+ * @brief Tag a block of samples that was just read from the converter.
+ *
+ * The block is assumed to hold the most recent nb_samples conversions. Every
+ * conversion between the end of the previous block and the start of this one
+ * is reported as dropped.
+ * @param desc - The sampling clock descriptor.
+ * @param nb_samples - Number of samples read.
+ * @param tag - Conversion index and timestamp of the block.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_tag(struct no_os_sample_clock_desc *desc,
+			   uint32_t nb_samples, struct no_os_sample_tag *tag)
+{
+	uint64_t delta_edges;
+	uint64_t period_ns;
+	uint64_t now_ns;
+	uint64_t first;
+	int ret;
+
+	if (!desc || !nb_samples || !tag)
+		return -EINVAL;
+
+	ret = no_os_sample_clock_update(desc, &now_ns);
+	if (ret)
+		return ret;
+
+	first = desc->edges > nb_samples ? desc->edges - nb_samples : 0;
+	if (first > desc->next_index) {
+		tag->dropped = no_os_min_t(uint64_t, first - desc->next_index,
+					   UINT32_MAX);
+		desc->stats.dropped += first - desc->next_index;
+	} else {
+		/* The edge count lags the reads, keep the indexes monotonic. */
+		tag->dropped = 0;
+		first = desc->next_index;
+	}
+	desc->next_index = first + nb_samples;
+
+	tag->index = first;
+	tag->timestamp_ns = now_ns;
+	ret = no_os_pwm_get_period(desc->pwm, &tag->period_ns);
+	if (ret)
+		return ret;
+
+	delta_edges = desc->edges - desc->last_edges;
+	if (delta_edges) {
+		period_ns = (now_ns - desc->last_ns) / delta_edges;
+		period_ns = no_os_min_t(uint64_t, period_ns, UINT32_MAX);
+		if (period_ns < desc->stats.min_period_ns)
+			desc->stats.min_period_ns = period_ns;
+		if (period_ns > desc->stats.max_period_ns)
+			desc->stats.max_period_ns = period_ns;
+
+		desc->last_edges = desc->edges;
+		desc->last_ns = now_ns;
+	}
+
+	no_os_sample_clock_update_rate(desc, now_ns);
+
+	return 0;
+}
+
+/**
+ * @brief Get the sampling clock statistics.
+ *
+ * The measured period extremes are averaged over the edges seen between two
+ * consecutive tags; their difference bounds the conversion clock jitter as
+ * seen by the reader.
+ * @param desc - The sampling clock descriptor.
+ * @param stats - The statistics.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sample_clock_get_stats(struct no_os_sample_clock_desc *desc,
+				 struct no_os_sample_clock_stats *stats)
+{
+	uint64_t now_ns;
+	int ret;
+
+	if (!desc || !stats)
+		return -EINVAL;
+
+	if (desc->running) {
+		ret = no_os_sample_clock_update(desc, &now_ns);
+		if (ret)
+			return ret;
+
+		no_os_sample_clock_update_rate(desc, now_ns);
+	}
+
+	*stats = desc->stats;
+	if (stats->min_period_ns == UINT32_MAX)
+		stats->min_period_ns = 0;
+
+	return 0;
+}
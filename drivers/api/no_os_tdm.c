@@ -41,6 +41,7 @@
 #include "no_os_tdm.h"
 #include <stdlib.h>
 #include "no_os_error.h"
+#include "no_os_circular_buffer.h"
 
 /**
  * @brief Initialize the TDM communication peripheral.
@@ -129,3 +130,146 @@ int32_t  no_os_tdm_write(struct no_os_tdm_desc *desc,
 {
 	return desc->platform_ops->tdm_ops_write(desc, data, nb_samples);
 }
+
+/**
+ * @brief Start a continuous reception. The platform driver receives into
+ * param->buf with a circular DMA and reports each half of it as a block. The
+ * blocks are either pushed into param->sink or fetched with
+ * no_os_tdm_stream_get_block().
+ * @param desc - The TDM descriptor.
+ * @param param - The continuous reception parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_tdm_stream_start(struct no_os_tdm_desc *desc,
+			       const struct no_os_tdm_stream_param *param)
+{
+	struct no_os_tdm_stream *stream;
+	int32_t ret;
+
+	if (!desc || !param || !param->buf || !param->sample_size)
+		return -EINVAL;
+
+	if (!param->nb_samples || param->nb_samples % 2)
+		return -EINVAL;
+
+	if (!desc->platform_ops->tdm_ops_stream_start)
+		return -ENOSYS;
+
+	if (desc->stream.active)
+		return -EBUSY;
+
+	stream = &desc->stream;
+	stream->buf = param->buf;
+	stream->block_size = param->nb_samples / 2 * param->sample_size;
+	stream->sink = param->sink;
+	stream->produced = 0;
+	stream->consumed = 0;
+	stream->overruns = 0;
+	stream->active = true;
+
+	ret = desc->platform_ops->tdm_ops_stream_start(desc, param->buf,
+			param->nb_samples);
+	if (ret)
+		stream->active = false;
+
+	return ret;
+}
+
+/**
+ * @brief Stop a continuous reception.
+ * @param desc - The TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_tdm_stream_stop(struct no_os_tdm_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (!desc->stream.active)
+		return 0;
+
+	desc->stream.active = false;
+
+	return desc->platform_ops->tdm_ops_stop(desc);
+}
+
+/**
+ * @brief Get the oldest completed block of a continuous reception. The block
+ * stays valid until the DMA wraps around to it, i.e. for one block period.
+ * Blocks already overwritten by the DMA are skipped and counted as overruns.
+ * @param desc - The TDM descriptor.
+ * @param block - Start of the block in the DMA buffer.
+ * @return Block size in bytes, -EAGAIN if no block is available or negative
+ * error code.
+ */
+int32_t no_os_tdm_stream_get_block(struct no_os_tdm_desc *desc, void **block)
+{
+	struct no_os_tdm_stream *stream;
+	uint32_t pending;
+
+	if (!desc || !block)
+		return -EINVAL;
+
+	stream = &desc->stream;
+	if (!stream->buf)
+		return -EINVAL;
+
+	pending = stream->produced - stream->consumed;
+	if (!pending)
+		return -EAGAIN;
+
+	if (pending > 1) {
+		stream->overruns += pending - 1;
+		stream->consumed += pending - 1;
+	}
+
+	*block = stream->buf + (stream->consumed % 2) * stream->block_size;
+	stream->consumed++;
+
+	return stream->block_size;
+}
+
+/**
+ * @brief Get the number of blocks lost during a continuous reception.
+ * @param desc - The TDM descriptor.
+ * @param overruns - Number of lost blocks.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t no_os_tdm_stream_get_overruns(struct no_os_tdm_desc *desc,
+				      uint32_t *overruns)
+{
+	if (!desc || !overruns)
+		return -EINVAL;
+
+	*overruns = desc->stream.overruns;
+
+	return 0;
+}
+
+/**
+ * @brief Report a completed block of a continuous reception. When a sink is
+ * set, the block is copied to it, or dropped if it does not fit.
+ * @param desc - The TDM descriptor.
+ * @param second - True for the second half of the DMA buffer.
+ */
+void no_os_tdm_stream_block_done(struct no_os_tdm_desc *desc, bool second)
+{
+	struct no_os_tdm_stream *stream;
+	uint32_t level;
+	uint8_t *block;
+
+	if (!desc || !desc->stream.active)
+		return;
+
+	stream = &desc->stream;
+	if (stream->sink) {
+		block = stream->buf + (second ? stream->block_size : 0);
+		if (no_os_cb_size(stream->sink, &level) ||
+		    level + stream->block_size > stream->sink->size)
+			stream->overruns++;
+		else
+			no_os_cb_write(stream->sink, block, stream->block_size);
+	}
+
+	stream->produced++;
+}
@@ -0,0 +1,589 @@
+/***************************************************************************//**
+ *   @file   no_os_timer_wheel.c
+ *   @brief  Software timers multiplexed on one timer.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stddef.h>
+#include "no_os_timer_wheel.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define NO_OS_TIMER_WHEEL_MASK		(NO_OS_TIMER_WHEEL_SLOTS - 1)
+#define NO_OS_TIMER_WHEEL_SPAN(level)	\
+	(1ULL << (NO_OS_TIMER_WHEEL_BITS * (level)))
+#define NO_OS_TIMER_WHEEL_MAX_DELTA	\
+	(NO_OS_TIMER_WHEEL_SPAN(NO_OS_TIMER_WHEEL_LEVELS) - 1)
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+/**
+ * @brief Mask the tick interrupt while the wheel is modified from the main
+ * loop.
+ * @param wheel - The timer wheel.
+ */
+static void no_os_timer_wheel_lock(struct no_os_timer_wheel *wheel)
+{
+	if (wheel->irq_ctrl && !wheel->in_tick)
+		no_os_irq_disable(wheel->irq_ctrl, wheel->irq_id);
+}
+
+/**
+ * @brief Unmask the tick interrupt.
+ * @param wheel - The timer wheel.
+ */
+static void no_os_timer_wheel_unlock(struct no_os_timer_wheel *wheel)
+{
+	if (wheel->irq_ctrl && !wheel->in_tick)
+		no_os_irq_enable(wheel->irq_ctrl, wheel->irq_id);
+}
+
+/**
+ * @brief Get the tick matching the current time.
+ * @param wheel - The timer wheel.
+ * @return The tick the wheel should be at.
+ */
+static uint64_t no_os_timer_wheel_real_tick(struct no_os_timer_wheel *wheel)
+{
+	struct no_os_time t;
+	uint64_t us;
+
+	if (wheel->timer)
+		return wheel->now;
+
+	t = no_os_get_time();
+	us = (uint64_t)t.s * 1000000 + t.us;
+
+	return (us - wheel->base_us) / wheel->tick_us;
+}
+
+/**
+ * @brief Link a timer in the slot matching its expiration tick.
+ * @param wheel - The timer wheel.
+ * @param timer - The timer, expires must not be in the past.
+ */
+static void no_os_timer_wheel_insert(struct no_os_timer_wheel *wheel,
+				     struct no_os_sw_timer *timer)
+{
+	uint64_t expires = timer->expires;
+	uint64_t delta = expires - wheel->now;
+	struct no_os_sw_timer **slot;
+	uint32_t level, idx;
+
+	/* Park far away timers in the last level, they are cascaded again */
+	if (delta > NO_OS_TIMER_WHEEL_MAX_DELTA)
+		expires = wheel->now + NO_OS_TIMER_WHEEL_MAX_DELTA;
+
+	for (level = 0; level < NO_OS_TIMER_WHEEL_LEVELS - 1; level++)
+		if (delta < NO_OS_TIMER_WHEEL_SPAN(level + 1))
+			break;
+
+	idx = (expires >> (level * NO_OS_TIMER_WHEEL_BITS)) &
+	      NO_OS_TIMER_WHEEL_MASK;
+	slot = &wheel->slots[level][idx];
+	timer->next = *slot;
+	if (timer->next)
+		timer->next->pprev = &timer->next;
+	timer->pprev = slot;
+	*slot = timer;
+	wheel->nr_armed++;
+}
+
+/**
+ * @brief Unlink a timer from its wheel slot.
+ * @param wheel - The timer wheel.
+ * @param timer - The timer.
+ */
+static void no_os_timer_wheel_detach(struct no_os_timer_wheel *wheel,
+				     struct no_os_sw_timer *timer)
+{
+	if (!timer->pprev)
+		return;
+
+	*timer->pprev = timer->next;
+	if (timer->next)
+		timer->next->pprev = timer->pprev;
+	timer->next = NULL;
+	timer->pprev = NULL;
+	wheel->nr_armed--;
+}
+
+/**
+ * @brief Remove a timer from the list of pending callback runs.
+ * @param wheel - The timer wheel.
+ * @param timer - The timer.
+ */
+static void no_os_timer_wheel_unqueue(struct no_os_timer_wheel *wheel,
+				      struct no_os_sw_timer *timer)
+{
+	struct no_os_sw_timer **link = &wheel->pending_head;
+	struct no_os_sw_timer *prev = NULL;
+
+	if (!timer->pending)
+		return;
+
+	while (*link != timer) {
+		prev = *link;
+		link = &prev->pending_next;
+	}
+
+	*link = timer->pending_next;
+	if (wheel->pending_tail == timer)
+		wheel->pending_tail = prev;
+	timer->pending_next = NULL;
+	timer->pending = false;
+}
+
+/**
+ * @brief Account the delay between a deadline and the run of its callback.
+ * @param wheel - The timer wheel.
+ * @param due - The deadline tick.
+ * @param real - The current tick.
+ */
+static void no_os_timer_wheel_account(struct no_os_timer_wheel *wheel,
+				      uint64_t due, uint64_t real)
+{
+	uint64_t latency = real > due ? (real - due) * wheel->tick_us : 0;
+
+	if (latency > UINT32_MAX)
+		latency = UINT32_MAX;
+
+	wheel->stats.fired++;
+	wheel->stats.total_latency_us += latency;
+	if (latency > wheel->stats.max_latency_us)
+		wheel->stats.max_latency_us = latency;
+}
+
+/**
+ * @brief Handle an expired timer: re-arm it if periodic, then run its
+ * callback or queue it for no_os_timer_wheel_step().
+ * @param wheel - The timer wheel.
+ * @param timer - The expired timer, already unlinked.
+ * @param real - The current tick.
+ */
+static void no_os_timer_wheel_expire(struct no_os_timer_wheel *wheel,
+				     struct no_os_sw_timer *timer,
+				     uint64_t real)
+{
+	uint64_t due = timer->expires;
+	uint64_t missed;
+
+	if (timer->period) {
+		/* Keep the period phase, skip the periods already missed */
+		missed = 0;
+		if (real >= due + timer->period)
+			missed = (real - due) / timer->period;
+		wheel->stats.overruns += missed;
+		timer->expires = due + (missed + 1) * timer->period;
+		no_os_timer_wheel_insert(wheel, timer);
+	}
+
+	if (timer->flags & NO_OS_SW_TIMER_ISR) {
+		no_os_timer_wheel_account(wheel, due, real);
+		timer->callback(timer->ctx);
+		return;
+	}
+
+	if (timer->pending) {
+		/* The previous run did not happen yet, merge both */
+		wheel->stats.overruns++;
+		return;
+	}
+
+	timer->due = due;
+	timer->pending = true;
+	timer->pending_next = NULL;
+	if (wheel->pending_tail)
+		wheel->pending_tail->pending_next = timer;
+	else
+		wheel->pending_head = timer;
+	wheel->pending_tail = timer;
+}
+
+/**
+ * @brief Move the timers of a slot to the lower levels.
+ * @param wheel - The timer wheel.
+ * @param level - Level of the slot.
+ */
+static void no_os_timer_wheel_cascade(struct no_os_timer_wheel *wheel,
+		uint32_t level)
+{
+	uint32_t idx = (wheel->now >> (level * NO_OS_TIMER_WHEEL_BITS)) &
+		       NO_OS_TIMER_WHEEL_MASK;
+	struct no_os_sw_timer *timer = wheel->slots[level][idx];
+	struct no_os_sw_timer *next;
+
+	wheel->slots[level][idx] = NULL;
+	while (timer) {
+		next = timer->next;
+		timer->pprev = NULL;
+		wheel->nr_armed--;
+		no_os_timer_wheel_insert(wheel, timer);
+		timer = next;
+	}
+}
+
+/**
+ * @brief Advance the wheel by one tick and expire the timers due.
+ * @param wheel - The timer wheel.
+ * @param real - The current tick.
+ */
+static void no_os_timer_wheel_advance(struct no_os_timer_wheel *wheel,
+				      uint64_t real)
+{
+	struct no_os_sw_timer *timer;
+	struct no_os_sw_timer **slot;
+	uint32_t level;
+
+	wheel->now++;
+	for (level = 1; level < NO_OS_TIMER_WHEEL_LEVELS; level++) {
+		if (wheel->now & (NO_OS_TIMER_WHEEL_SPAN(level) - 1))
+			break;
+		no_os_timer_wheel_cascade(wheel, level);
+	}
+
+	slot = &wheel->slots[0][wheel->now & NO_OS_TIMER_WHEEL_MASK];
+	while (*slot) {
+		timer = *slot;
+		no_os_timer_wheel_detach(wheel, timer);
+		no_os_timer_wheel_expire(wheel, timer, real);
+	}
+}
+
+/**
+ * @brief Advance the wheel by one tick. Registered as the timer interrupt
+ * handler, or called from the application's own handler.
+ * @param wheel - The timer wheel.
+ */
+void no_os_timer_wheel_tick(void *wheel)
+{
+	struct no_os_timer_wheel *w = wheel;
+
+	w->in_tick = true;
+	no_os_timer_wheel_advance(w, w->now + 1);
+	w->in_tick = false;
+}
+
+/**
+ * @brief Catch up with the elapsed time when no hardware timer is used, then
+ * run the deferred callbacks whose timers expired. Called from the main loop.
+ * @param wheel - The timer wheel.
+ * @return Number of callbacks run, negative error code otherwise.
+ */
+int no_os_timer_wheel_step(struct no_os_timer_wheel *wheel)
+{
+	struct no_os_sw_timer *timer;
+	uint64_t real;
+	int count = 0;
+
+	if (!wheel)
+		return -EINVAL;
+
+	if (!wheel->timer) {
+		real = no_os_timer_wheel_real_tick(wheel);
+		if (real > wheel->now + 1)
+			wheel->stats.late_ticks += real - wheel->now - 1;
+		if (!wheel->nr_armed && real > wheel->now)
+			wheel->now = real - 1;
+		while (wheel->now < real)
+			no_os_timer_wheel_advance(wheel, real);
+	}
+
+	while (true) {
+		no_os_timer_wheel_lock(wheel);
+		real = no_os_timer_wheel_real_tick(wheel);
+		timer = wheel->pending_head;
+		if (timer) {
+			wheel->pending_head = timer->pending_next;
+			if (!wheel->pending_head)
+				wheel->pending_tail = NULL;
+			timer->pending_next = NULL;
+			timer->pending = false;
+			no_os_timer_wheel_account(wheel, timer->due, real);
+		}
+		no_os_timer_wheel_unlock(wheel);
+
+		if (!timer)
+			break;
+
+		timer->callback(timer->ctx);
+		count++;
+	}
+
+	return count;
+}
+
+/**
+ * @brief Get the time until the earliest deadline, e.g. to sleep until then.
+ * @param wheel - The timer wheel.
+ * @param us - Time until the earliest deadline, 0 if callbacks are pending.
+ * @return 0 in case of success, -ENOENT if no timer is armed, negative error
+ * code otherwise.
+ */
+int no_os_timer_wheel_next_deadline(struct no_os_timer_wheel *wheel,
+				    uint32_t *us)
+{
+	uint64_t earliest = UINT64_MAX;
+	struct no_os_sw_timer *timer;
+	uint32_t level, idx;
+	uint64_t real, delta;
+
+	if (!wheel || !us)
+		return -EINVAL;
+
+	no_os_timer_wheel_lock(wheel);
+	if (wheel->pending_head) {
+		earliest = 0;
+	} else {
+		for (level = 0; level < NO_OS_TIMER_WHEEL_LEVELS; level++)
+			for (idx = 0; idx < NO_OS_TIMER_WHEEL_SLOTS; idx++)
+				for (timer = wheel->slots[level][idx]; timer;
+				     timer = timer->next)
+					earliest = no_os_min(earliest,
+							     timer->expires);
+	}
+	no_os_timer_wheel_unlock(wheel);
+
+	if (earliest == UINT64_MAX)
+		return -ENOENT;
+
+	real = no_os_timer_wheel_real_tick(wheel);
+	delta = earliest > real ? (earliest - real) * wheel->tick_us : 0;
+	*us = no_os_min_t(uint64_t, delta, UINT32_MAX);
+
+	return 0;
+}
+
+/**
+ * @brief Get the timer wheel statistics.
+ * @param wheel - The timer wheel.
+ * @param stats - The statistics.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_timer_wheel_get_stats(struct no_os_timer_wheel *wheel,
+				struct no_os_timer_wheel_stats *stats)
+{
+	if (!wheel || !stats)
+		return -EINVAL;
+
+	no_os_timer_wheel_lock(wheel);
+	*stats = wheel->stats;
+	no_os_timer_wheel_unlock(wheel);
+
+	return 0;
+}
+
+/**
+ * @brief Arm a software timer. Re-arming an active timer restarts it.
+ * @param wheel - The timer wheel.
+ * @param timer - The timer, with the callback set.
+ * @param delay_us - Time until the first expiration, rounded up to ticks.
+ * @param period_us - Period of the next expirations, 0 for a one-shot timer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sw_timer_start(struct no_os_timer_wheel *wheel,
+			 struct no_os_sw_timer *timer, uint32_t delay_us,
+			 uint32_t period_us)
+{
+	uint32_t delay;
+
+	if (!wheel || !timer || !timer->callback)
+		return -EINVAL;
+
+	delay = NO_OS_DIV_ROUND_UP(delay_us, wheel->tick_us);
+	if (!delay)
+		delay = 1;
+
+	no_os_timer_wheel_lock(wheel);
+	no_os_timer_wheel_detach(wheel, timer);
+	no_os_timer_wheel_unqueue(wheel, timer);
+	timer->period = period_us ?
+			no_os_max(1, NO_OS_DIV_ROUND_UP(period_us,
+					wheel->tick_us)) : 0;
+	timer->expires = wheel->now + delay;
+	no_os_timer_wheel_insert(wheel, timer);
+	no_os_timer_wheel_unlock(wheel);
+
+	return 0;
+}
+
+/**
+ * @brief Disarm a software timer and drop its pending callback run.
+ * @param wheel - The timer wheel.
+ * @param timer - The timer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_sw_timer_cancel(struct no_os_timer_wheel *wheel,
+			  struct no_os_sw_timer *timer)
+{
+	if (!wheel || !timer)
+		return -EINVAL;
+
+	no_os_timer_wheel_lock(wheel);
+	no_os_timer_wheel_detach(wheel, timer);
+	no_os_timer_wheel_unqueue(wheel, timer);
+	no_os_timer_wheel_unlock(wheel);
+
+	return 0;
+}
+
+/**
+ * @brief Check whether a software timer is armed or has a pending callback
+ * run.
+ * @param timer - The timer.
+ * @return true if the timer is active, false otherwise.
+ */
+bool no_os_sw_timer_is_active(struct no_os_sw_timer *timer)
+{
+	return timer && (timer->pprev || timer->pending);
+}
+
+/**
+ * @brief Initialize a timer wheel and start its hardware timer, if any.
+ * @param wheel - The timer wheel.
+ * @param param - Initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_timer_wheel_init(struct no_os_timer_wheel **wheel,
+			   const struct no_os_timer_wheel_init_param *param)
+{
+	struct no_os_timer_wheel *w;
+	struct no_os_time t;
+	int ret;
+
+	if (!wheel || !param || !param->tick_us)
+		return -EINVAL;
+
+	w = no_os_calloc(1, sizeof(*w));
+	if (!w)
+		return -ENOMEM;
+
+	w->tick_us = param->tick_us;
+	t = no_os_get_time();
+	w->base_us = (uint64_t)t.s * 1000000 + t.us;
+
+	if (!param->timer_init) {
+		*wheel = w;
+		return 0;
+	}
+
+	ret = no_os_timer_init(&w->timer, param->timer_init);
+	if (ret)
+		goto free_wheel;
+
+	if (param->irq_ctrl) {
+		w->irq_ctrl = param->irq_ctrl;
+		w->irq_id = param->irq_id;
+		w->irq_cb.callback = no_os_timer_wheel_tick;
+		w->irq_cb.ctx = w;
+		w->irq_cb.event = NO_OS_EVT_TIM_ELAPSED;
+		w->irq_cb.peripheral = NO_OS_TIM_IRQ;
+		w->irq_cb.handle = param->irq_handle;
+
+		ret = no_os_irq_register_callback(w->irq_ctrl, w->irq_id,
+						  &w->irq_cb);
+		if (ret)
+			goto remove_timer;
+
+		ret = no_os_irq_enable(w->irq_ctrl, w->irq_id);
+		if (ret)
+			goto unregister_cb;
+	}
+
+	ret = no_os_timer_start(w->timer);
+	if (ret)
+		goto disable_irq;
+
+	*wheel = w;
+
+	return 0;
+
+disable_irq:
+	if (w->irq_ctrl)
+		no_os_irq_disable(w->irq_ctrl, w->irq_id);
+unregister_cb:
+	if (w->irq_ctrl)
+		no_os_irq_unregister_callback(w->irq_ctrl, w->irq_id,
+					      &w->irq_cb);
+remove_timer:
+	no_os_timer_remove(w->timer);
+free_wheel:
+	no_os_free(w);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the hardware timer and free the resources allocated by
+ * no_os_timer_wheel_init(). The software timers are dropped.
+ * @param wheel - The timer wheel.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_timer_wheel_remove(struct no_os_timer_wheel *wheel)
+{
+	int ret;
+
+	if (!wheel)
+		return -EINVAL;
+
+	if (wheel->timer) {
+		ret = no_os_timer_stop(wheel->timer);
+		if (ret)
+			return ret;
+
+		if (wheel->irq_ctrl) {
+			no_os_irq_disable(wheel->irq_ctrl, wheel->irq_id);
+			no_os_irq_unregister_callback(wheel->irq_ctrl,
+						      wheel->irq_id,
+						      &wheel->irq_cb);
+		}
+
+		ret = no_os_timer_remove(wheel->timer);
+		if (ret)
+			return ret;
+	}
+
+	no_os_free(wheel);
+
+	return 0;
+}
@@ -0,0 +1,464 @@
+/***************************************************************************//**
+ *   @file   no_os_trng_pool.c
+ *   @brief  TRNG entropy pool and HMAC-DRBG (SP 800-90A/B).
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "no_os_trng_pool.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Entropy needed for a seed, the security strength of HMAC-DRBG SHA-256 */
+#define NO_OS_TRNG_POOL_SEED_BITS	(NO_OS_SHA256_DIGEST_SIZE * 8)
+/* Consecutive health test failures after which the TRNG is given up on */
+#define NO_OS_TRNG_POOL_MAX_FAILURES	8
+
+/*
+ * Adaptive proportion test cutoffs for a 512 samples window and a false
+ * positive probability of 2^-20 (SP 800-90B 4.4.2), by min-entropy.
+ */
+static const uint16_t no_os_trng_pool_apt_cutoffs[8] = {
+	311, 177, 103, 62, 39, 25, 18, 13
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Run the repetition count and adaptive proportion tests on TRNG data.
+ * @param pool - The entropy pool.
+ * @param buf - TRNG output.
+ * @param len - Length of the TRNG output.
+ * @return true if the data passed both tests.
+ */
+static bool no_os_trng_pool_health(struct no_os_trng_pool *pool,
+				   const uint8_t *buf, uint32_t len)
+{
+	bool ok = true;
+	uint32_t i;
+
+	for (i = 0; i < len; i++) {
+		if (pool->rct_count && buf[i] == pool->rct_value) {
+			if (++pool->rct_count >= pool->rct_cutoff) {
+				pool->stats.rct_failures++;
+				pool->rct_count = 1;
+				ok = false;
+			}
+		} else {
+			pool->rct_value = buf[i];
+			pool->rct_count = 1;
+		}
+
+		if (!pool->apt_index) {
+			pool->apt_value = buf[i];
+			pool->apt_count = 1;
+		} else if (buf[i] == pool->apt_value &&
+			   ++pool->apt_count >= pool->apt_cutoff) {
+			pool->stats.apt_failures++;
+			pool->apt_count = 0;
+			ok = false;
+		}
+
+		if (++pool->apt_index == NO_OS_TRNG_POOL_APT_WINDOW)
+			pool->apt_index = 0;
+	}
+
+	return ok;
+}
+
+/**
+ * @brief Read a chunk from the hardware TRNG and mix it in the pool.
+ * @param pool - The entropy pool.
+ * @return 0 in case of success, -EIO if the chunk failed the health tests,
+ * negative error code otherwise.
+ */
+static int no_os_trng_pool_gather(struct no_os_trng_pool *pool)
+{
+	uint8_t buf[NO_OS_TRNG_POOL_CHUNK];
+	int ret;
+
+	ret = no_os_trng_fill_buffer(pool->trng, buf, sizeof(buf));
+	if (ret)
+		return ret;
+
+	pool->stats.hw_bytes += sizeof(buf);
+
+	if (!no_os_trng_pool_health(pool, buf, sizeof(buf))) {
+		/* Drop the entropy gathered from an untrusted source */
+		no_os_sha256_init(&pool->pool);
+		pool->pool_bits = 0;
+		ret = -EIO;
+	} else {
+		no_os_sha256_update(&pool->pool, buf, sizeof(buf));
+		pool->pool_bits += sizeof(buf) * pool->min_entropy;
+	}
+
+	memset(buf, 0, sizeof(buf));
+
+	return ret;
+}
+
+/**
+ * @brief Take a full entropy seed from the pool, reading the hardware TRNG
+ * if not enough entropy was gathered in the background.
+ * @param pool - The entropy pool.
+ * @param seed - The conditioned seed.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_seed(struct no_os_trng_pool *pool,
+				uint8_t seed[NO_OS_SHA256_DIGEST_SIZE])
+{
+	struct no_os_time start, end;
+	uint32_t failures = 0;
+	bool stalled;
+	int ret;
+
+	stalled = pool->pool_bits < NO_OS_TRNG_POOL_SEED_BITS;
+	if (stalled)
+		start = no_os_get_time();
+
+	while (pool->pool_bits < NO_OS_TRNG_POOL_SEED_BITS) {
+		ret = no_os_trng_pool_gather(pool);
+		if (ret == -EIO && ++failures < NO_OS_TRNG_POOL_MAX_FAILURES)
+			continue;
+		if (ret)
+			return ret;
+
+		failures = 0;
+	}
+
+	if (stalled) {
+		end = no_os_get_time();
+		pool->stats.stalls++;
+		pool->stats.stall_us += (uint64_t)(end.s - start.s) * 1000000 +
+					end.us - start.us;
+	}
+
+	no_os_sha256_final(&pool->pool, seed);
+	no_os_sha256_init(&pool->pool);
+	pool->pool_bits = 0;
+
+	return 0;
+}
+
+/**
+ * @brief HMAC_DRBG_Update (SP 800-90A 10.1.2.2). The provided data is the
+ * concatenation of two optional parts.
+ * @param pool - The entropy pool.
+ * @param d1 - First part of the provided data.
+ * @param l1 - Length of the first part.
+ * @param d2 - Second part of the provided data.
+ * @param l2 - Length of the second part.
+ */
+static void no_os_trng_pool_update(struct no_os_trng_pool *pool,
+				   const uint8_t *d1, uint32_t l1,
+				   const uint8_t *d2, uint32_t l2)
+{
+	uint8_t k[NO_OS_SHA256_DIGEST_SIZE];
+	uint8_t sep;
+
+	for (sep = 0; sep < 2; sep++) {
+		no_os_hmac_sha256_start(&pool->key);
+		no_os_hmac_sha256_update(&pool->key, pool->v, sizeof(pool->v));
+		no_os_hmac_sha256_update(&pool->key, &sep, 1);
+		if (l1)
+			no_os_hmac_sha256_update(&pool->key, d1, l1);
+		if (l2)
+			no_os_hmac_sha256_update(&pool->key, d2, l2);
+		no_os_hmac_sha256_final(&pool->key, k);
+
+		no_os_hmac_sha256_setkey(&pool->key, k, sizeof(k));
+		no_os_hmac_sha256_update(&pool->key, pool->v, sizeof(pool->v));
+		no_os_hmac_sha256_final(&pool->key, pool->v);
+
+		if (!l1 && !l2)
+			break;
+	}
+
+	memset(k, 0, sizeof(k));
+}
+
+/**
+ * @brief Reseed the DRBG from the entropy pool.
+ * @param pool - The entropy pool.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_reseed(struct no_os_trng_pool *pool)
+{
+	uint8_t seed[NO_OS_SHA256_DIGEST_SIZE];
+	int ret;
+
+	ret = no_os_trng_pool_seed(pool, seed);
+	if (ret)
+		return ret;
+
+	no_os_trng_pool_update(pool, seed, sizeof(seed), NULL, 0);
+	memset(seed, 0, sizeof(seed));
+
+	pool->reseed_counter = 1;
+	pool->stats.reseeds++;
+
+	return 0;
+}
+
+/**
+ * @brief HMAC_DRBG_Generate (SP 800-90A 10.1.2.5) without additional input.
+ * @param pool - The entropy pool.
+ * @param buff - Output buffer.
+ * @param len - Number of bytes, at most NO_OS_TRNG_POOL_MAX_REQUEST.
+ */
+static void no_os_trng_pool_generate(struct no_os_trng_pool *pool,
+				     uint8_t *buff, uint32_t len)
+{
+	uint32_t n;
+
+	while (len) {
+		no_os_hmac_sha256_start(&pool->key);
+		no_os_hmac_sha256_update(&pool->key, pool->v, sizeof(pool->v));
+		no_os_hmac_sha256_final(&pool->key, pool->v);
+
+		n = no_os_min(len, (uint32_t)sizeof(pool->v));
+		memcpy(buff, pool->v, n);
+		buff += n;
+		len -= n;
+	}
+
+	no_os_trng_pool_update(pool, NULL, 0, NULL, 0);
+	pool->reseed_counter++;
+}
+
+/**
+ * @brief Initialize the hardware TRNG, gather the initial seed and
+ * instantiate the DRBG.
+ * @param desc - The TRNG descriptor.
+ * @param param - TRNG parameters, extra is a no_os_trng_pool_init_param.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_init(struct no_os_trng_desc **desc,
+				const struct no_os_trng_init_param *param)
+{
+	const struct no_os_trng_pool_init_param *pparam;
+	uint8_t seed[2 * NO_OS_SHA256_DIGEST_SIZE];
+	struct no_os_trng_desc *descriptor;
+	struct no_os_trng_pool *pool;
+	int ret;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	pparam = param->extra;
+	if (!pparam->trng_init || !pparam->min_entropy ||
+	    pparam->min_entropy > 8)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	pool = no_os_calloc(1, sizeof(*pool));
+	if (!pool) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ret = no_os_trng_init(&pool->trng, pparam->trng_init);
+	if (ret)
+		goto free_pool;
+
+	pool->min_entropy = pparam->min_entropy;
+	pool->rct_cutoff = 1 + NO_OS_DIV_ROUND_UP(20, pparam->min_entropy);
+	pool->apt_cutoff = no_os_trng_pool_apt_cutoffs[pparam->min_entropy - 1];
+	pool->reseed_interval = pparam->reseed_interval ?
+				pparam->reseed_interval :
+				NO_OS_TRNG_POOL_RESEED_INTERVAL;
+	no_os_sha256_init(&pool->pool);
+
+	/* Entropy input and nonce */
+	ret = no_os_trng_pool_seed(pool, seed);
+	if (ret)
+		goto remove_trng;
+
+	ret = no_os_trng_pool_seed(pool, seed + NO_OS_SHA256_DIGEST_SIZE);
+	if (ret)
+		goto remove_trng;
+
+	/* HMAC_DRBG_Instantiate (SP 800-90A 10.1.2.3) */
+	memset(pool->v, 0, sizeof(pool->v));
+	no_os_hmac_sha256_setkey(&pool->key, pool->v, sizeof(pool->v));
+	memset(pool->v, 0x01, sizeof(pool->v));
+	no_os_trng_pool_update(pool, seed, sizeof(seed),
+			       pparam->personalization,
+			       pparam->personalization ?
+			       pparam->personalization_len : 0);
+	memset(seed, 0, sizeof(seed));
+	pool->reseed_counter = 1;
+
+	descriptor->extra = pool;
+	*desc = descriptor;
+
+	return 0;
+
+remove_trng:
+	no_os_trng_remove(pool->trng);
+free_pool:
+	no_os_free(pool);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Wipe the DRBG state and remove the hardware TRNG.
+ * @param desc - The TRNG descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_remove(struct no_os_trng_desc *desc)
+{
+	struct no_os_trng_pool *pool;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	pool = desc->extra;
+	no_os_trng_remove(pool->trng);
+	memset(pool, 0, sizeof(*pool));
+	no_os_free(pool);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Fill a buffer with DRBG output, reseeding from the pool when the
+ * reseed interval is reached.
+ * @param desc - The TRNG descriptor.
+ * @param buff - Buffer to be filled.
+ * @param len - Length of the buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int no_os_trng_pool_fill_buffer(struct no_os_trng_desc *desc,
+				       uint8_t *buff, uint32_t len)
+{
+	struct no_os_trng_pool *pool;
+	uint32_t n;
+	int ret;
+
+	if (!desc || !desc->extra || !buff)
+		return -EINVAL;
+
+	pool = desc->extra;
+	pool->stats.requests++;
+
+	while (len) {
+		if (pool->reseed_counter > pool->reseed_interval) {
+			ret = no_os_trng_pool_reseed(pool);
+			if (ret)
+				return ret;
+		}
+
+		n = no_os_min(len, (uint32_t)NO_OS_TRNG_POOL_MAX_REQUEST);
+		no_os_trng_pool_generate(pool, buff, n);
+		pool->stats.out_bytes += n;
+		buff += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Gather one chunk of entropy from the hardware TRNG into the pool.
+ *
+ * Call it from the application loop or an idle hook, in the same context as
+ * the consumers of the random data, so that reseeds find a full pool and
+ * don't wait for the TRNG. Nothing is read once a full seed is gathered.
+ * @param desc - The TRNG descriptor.
+ * @return 0 in case of success, -EIO if the chunk failed the health tests,
+ * negative error code otherwise.
+ */
+int no_os_trng_pool_step(struct no_os_trng_desc *desc)
+{
+	struct no_os_trng_pool *pool;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	pool = desc->extra;
+	if (pool->pool_bits >= NO_OS_TRNG_POOL_SEED_BITS)
+		return 0;
+
+	return no_os_trng_pool_gather(pool);
+}
+
+/**
+ * @brief Get the entropy pool counters.
+ * @param desc - The TRNG descriptor.
+ * @param stats - The counters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int no_os_trng_pool_get_stats(struct no_os_trng_desc *desc,
+			      struct no_os_trng_pool_stats *stats)
+{
+	struct no_os_trng_pool *pool;
+
+	if (!desc || !desc->extra || !stats)
+		return -EINVAL;
+
+	pool = desc->extra;
+	*stats = pool->stats;
+
+	return 0;
+}
+
+/**
+ * @brief Entropy pool TRNG platform ops
+ */
+const struct no_os_trng_platform_ops no_os_trng_pool_ops = {
+	.init = &no_os_trng_pool_init,
+	.fill_buffer = &no_os_trng_pool_fill_buffer,
+	.remove = &no_os_trng_pool_remove
+};
@@ -64,6 +64,7 @@ significant delays */
 const struct no_os_spi_platform_ops spi_eng_platform_ops = {
 	.init = &spi_engine_init,
 	.write_and_read = &spi_engine_write_and_read,
+	.transfer = &spi_engine_transfer_msgs,
 	.remove = &spi_engine_remove
 };
 
@@ -748,6 +749,209 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 	return ret;
 }
 
+/**
+ * @brief Store the words available in the SDI FIFO in the receive buffers of
+ * the messages
+ *
+ * @param xfer Transfer state
+ */
+static void spi_engine_xfer_drain_sdi(struct spi_engine_xfer *xfer)
+{
+	uint8_t			i;
+	uint8_t			shift;
+	uint8_t			word_len;
+	uint32_t		level;
+	uint32_t		data;
+	struct no_os_spi_msg	*msg;
+	struct spi_engine_desc	*eng_desc;
+
+	eng_desc = xfer->desc->extra;
+	word_len = spi_get_word_lenght(eng_desc);
+
+	spi_engine_read(eng_desc, SPI_ENGINE_REG_SDI_FIFO_LEVEL, &level);
+	while (level--) {
+		/* Empty messages do not produce any word */
+		while (xfer->rx_msg < xfer->len &&
+		       !xfer->msgs[xfer->rx_msg].bytes_number)
+			xfer->rx_msg++;
+		if (xfer->rx_msg == xfer->len)
+			return;
+
+		msg = &xfer->msgs[xfer->rx_msg];
+		spi_engine_read(eng_desc, SPI_ENGINE_REG_SDI_DATA_FIFO, &data);
+
+		for (i = 0; i < word_len && xfer->rx_byte < msg->bytes_number;
+		     i++, xfer->rx_byte++) {
+			shift = eng_desc->data_width - (i + 1) * 8;
+			if (msg->rx_buff)
+				msg->rx_buff[xfer->rx_byte] = data >> shift;
+		}
+
+		if (xfer->rx_byte == msg->bytes_number) {
+			xfer->rx_msg++;
+			xfer->rx_byte = 0;
+		}
+	}
+}
+
+/**
+ * @brief Wait until a FIFO of the engine has room. The SDI FIFO is drained
+ * meanwhile, so that the engine never stalls on it.
+ *
+ * @param xfer Transfer state
+ * @param room_reg Register holding the free space of the FIFO
+ */
+static void spi_engine_xfer_wait_room(struct spi_engine_xfer *xfer,
+				      uint32_t room_reg)
+{
+	uint32_t room;
+
+	do {
+		spi_engine_xfer_drain_sdi(xfer);
+		spi_engine_read(xfer->desc->extra, room_reg, &room);
+	} while (!room);
+}
+
+/**
+ * @brief Write a command to the engine once the command FIFO has room
+ *
+ * @param xfer Transfer state
+ * @param cmd Command to send to the engine
+ */
+static void spi_engine_xfer_cmd(struct spi_engine_xfer *xfer, uint32_t cmd)
+{
+	spi_engine_xfer_wait_room(xfer, SPI_ENGINE_REG_CMD_FIFO_ROOM);
+	spi_engine_write_cmd(xfer->desc, cmd);
+}
+
+/**
+ * @brief Queue a chunk of a message: the transfer instruction and the bytes
+ * packed into engine WORDS
+ *
+ * @param xfer Transfer state
+ * @param msg The message
+ * @param pos Offset of the chunk in the message
+ * @param bytes_number Size of the chunk, at most 255 bytes
+ */
+static void spi_engine_xfer_chunk(struct spi_engine_xfer *xfer,
+				  struct no_os_spi_msg *msg,
+				  uint32_t pos, uint8_t bytes_number)
+{
+	uint8_t			i;
+	uint8_t			word_len;
+	uint32_t		word = 0;
+	struct spi_engine_desc	*eng_desc;
+
+	eng_desc = xfer->desc->extra;
+	word_len = spi_get_word_lenght(eng_desc);
+
+	spi_engine_xfer_cmd(xfer, WRITE_READ(bytes_number));
+
+	for (i = 0; i < bytes_number; i++) {
+		if (msg->tx_buff)
+			word |= (uint32_t)msg->tx_buff[pos + i] <<
+				(eng_desc->data_width - (i % word_len + 1) * 8);
+
+		if (i % word_len == word_len - 1 || i == bytes_number - 1) {
+			spi_engine_xfer_wait_room(xfer,
+						  SPI_ENGINE_REG_SDO_FIFO_ROOM);
+			spi_engine_write(eng_desc, SPI_ENGINE_REG_SDO_DATA_FIFO,
+					 word);
+			word = 0;
+		}
+	}
+}
+
+/**
+ * @brief Transfer a list of messages in a single SPI engine program. The
+ * commands and the SDO words are streamed to the engine as its FIFOs empty,
+ * instead of running one program per message. The delays of the messages
+ * are not supported.
+ *
+ * @param desc Decriptor containing SPI interface parameters
+ * @param msgs Array of messages
+ * @param len Number of messages
+ * @return int32_t - 0 if the transfer finished
+ *		   - -EINVAL if the parameters are invalid
+ */
+int32_t spi_engine_transfer_msgs(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs,
+				 uint32_t len)
+{
+	uint8_t			max_chunk;
+	bool			cs_active = false;
+	uint32_t		i;
+	uint32_t		pos;
+	uint32_t		n;
+	uint32_t		sync_id;
+	struct spi_engine_xfer	xfer;
+	struct spi_engine_desc	*eng_desc;
+
+	if (!desc || !msgs)
+		return -EINVAL;
+
+	eng_desc = desc->extra;
+
+	/* The offload module is disabled, as in spi_engine_write_and_read() */
+	eng_desc->offload_config = OFFLOAD_DISABLED;
+	spi_engine_write(eng_desc, SPI_ENGINE_REG_OFFLOAD_CTRL(0), 0);
+
+	xfer.desc = desc;
+	xfer.msgs = msgs;
+	xfer.len = len;
+	xfer.rx_msg = 0;
+	xfer.rx_byte = 0;
+
+	/* The transfer instruction is built from an 8 bit byte count */
+	max_chunk = 255 / spi_get_word_lenght(eng_desc) *
+		    spi_get_word_lenght(eng_desc);
+
+	spi_engine_xfer_cmd(&xfer,
+			    SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CLK_DIV,
+					    eng_desc->clk_div));
+	spi_engine_xfer_cmd(&xfer,
+			    SPI_ENGINE_CMD_CONFIG(
+				    SPI_ENGINE_CMD_DATA_TRANSFER_LEN,
+				    eng_desc->data_width));
+	spi_engine_xfer_cmd(&xfer,
+			    SPI_ENGINE_CMD_CONFIG(SPI_ENGINE_CMD_REG_CONFIG,
+					    desc->mode));
+	spi_engine_xfer_cmd(&xfer, CS_HIGH);
+
+	for (i = 0; i < len; i++) {
+		if (!cs_active) {
+			spi_engine_xfer_cmd(&xfer, CS_LOW);
+			cs_active = true;
+		}
+
+		for (pos = 0; pos < msgs[i].bytes_number; pos += n) {
+			n = no_os_min(msgs[i].bytes_number - pos, max_chunk);
+			spi_engine_xfer_chunk(&xfer, &msgs[i], pos, n);
+		}
+
+		if (msgs[i].cs_change || i == len - 1) {
+			spi_engine_xfer_cmd(&xfer, CS_HIGH);
+			cs_active = false;
+		}
+	}
+
+	/* Add a sync command to signal that the transfer has finished */
+	spi_engine_xfer_cmd(&xfer, SPI_ENGINE_CMD_SYNC(_sync_id));
+
+	do {
+		spi_engine_xfer_drain_sdi(&xfer);
+		spi_engine_read(eng_desc, SPI_ENGINE_REG_SYNC_ID, &sync_id);
+	}
+	/* Wait for the end sync signal */
+	while (sync_id != _sync_id);
+	_sync_id++;
+
+	/* Read the words received after the last drain */
+	spi_engine_xfer_drain_sdi(&xfer);
+
+	return 0;
+}
+
 /**
  * @brief Initialize the SPI engine's offload module
  *
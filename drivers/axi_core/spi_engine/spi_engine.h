@@ -200,6 +200,11 @@ int32_t spi_engine_write_and_read(struct no_os_spi_desc *desc,
 				  uint8_t *data,
 				  uint16_t bytes_number);
 
+/* Transfer a list of messages in a single SPI engine program */
+int32_t spi_engine_transfer_msgs(struct no_os_spi_desc *desc,
+				 struct no_os_spi_msg *msgs,
+				 uint32_t len);
+
 /* Free the resources used by the SPI engine device */
 int32_t spi_engine_remove(struct no_os_spi_desc *desc);
 
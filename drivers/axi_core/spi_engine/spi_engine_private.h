@@ -150,4 +150,13 @@ typedef struct spi_engine_msg {
 	struct spi_engine_cmd_queue	*cmds;
 } spi_engine_msg;
 
+typedef struct spi_engine_xfer {
+	struct no_os_spi_desc		*desc;
+	struct no_os_spi_msg		*msgs;
+	uint32_t			len;
+	/* Message and byte where the next SDI word is stored */
+	uint32_t			rx_msg;
+	uint32_t			rx_byte;
+} spi_engine_xfer;
+
 #endif // SPI_ENGINE_PRIVATE_H
@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include "ad7156.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_error.h"
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -557,3 +559,93 @@ float ad7156_wait_read_channel_capacitance(struct ad7156_dev *dev,
 
 	return p_fdata;
 }
+
+/***************************************************************************//**
+ * @brief Reads the status register and the data registers of both channels
+ *        in a single I2C burst.
+ *
+ * @param dev      - The device structure.
+ * @param ch1_data - Conversion result of channel 1.
+ * @param ch2_data - Conversion result of channel 2.
+ *
+ * @return The status register. The RDY1 and RDY2 bits are cleared for the
+ *         channels with a new conversion result.
+*******************************************************************************/
+uint8_t ad7156_read_channels_data(struct ad7156_dev *dev,
+				  uint16_t *ch1_data,
+				  uint16_t *ch2_data)
+{
+	uint8_t reg_data[5] = {0, 0, 0, 0, 0};
+
+	ad7156_get_register_value(dev,
+				  reg_data,
+				  AD7156_REG_STATUS,
+				  5);
+	*ch1_data = (reg_data[1] << 8) + reg_data[2];
+	*ch2_data = (reg_data[3] << 8) + reg_data[4];
+
+	return reg_data[0];
+}
+
+/***************************************************************************//**
+ * @brief Reads consecutive conversions of both channels. Each poll of the
+ *        status register also returns the data registers, so no extra
+ *        transfer is needed once a conversion is ready. Each sample is
+ *        waited for at most AD7156_CONV_TIMEOUT_MS.
+ *
+ * @param dev        - The device structure.
+ * @param data       - Buffer of 2 * nb_samples results, channel 1 first.
+ *                     Results of disabled channels are left unchanged.
+ * @param nb_samples - Number of sample pairs.
+ *
+ * @return 0 in case of success, -ETIMEDOUT if a conversion does not complete,
+ *         negative error code otherwise.
+*******************************************************************************/
+int32_t ad7156_read_samples(struct ad7156_dev *dev,
+			    uint16_t *data,
+			    uint32_t nb_samples)
+{
+	uint8_t enabled = 0;
+	uint8_t config = 0;
+	uint8_t pending;
+	uint8_t status;
+	uint16_t ch1;
+	uint16_t ch2;
+	uint32_t timeout;
+	uint32_t i;
+
+	if (!dev || !data)
+		return -EINVAL;
+
+	/* Only wait for the channels that are converting */
+	ad7156_get_register_value(dev, &config, AD7156_REG_CONFIG, 1);
+	if (config & AD7156_CONFIG_EN_CH1)
+		enabled |= AD7156_STATUS_RDY1;
+	if (config & AD7156_CONFIG_EN_CH2)
+		enabled |= AD7156_STATUS_RDY2;
+	if (!enabled)
+		return -EINVAL;
+
+	for (i = 0; i < nb_samples; i++) {
+		pending = enabled;
+		timeout = AD7156_CONV_TIMEOUT_MS;
+		do {
+			status = ad7156_read_channels_data(dev, &ch1, &ch2);
+			if (!(status & AD7156_STATUS_RDY1)) {
+				data[2 * i] = ch1;
+				pending &= ~AD7156_STATUS_RDY1;
+			}
+			if (!(status & AD7156_STATUS_RDY2)) {
+				data[2 * i + 1] = ch2;
+				pending &= ~AD7156_STATUS_RDY2;
+			}
+			if (pending)
+				no_os_mdelay(1);
+		} while (pending && --timeout);
+
+		if (pending)
+			return -ETIMEDOUT;
+	}
+
+	return 0;
+}
@@ -87,6 +87,9 @@
 #define AD7156_STATUS_RDY2              (1 << 1)
 #define AD7156_STATUS_RDY1              (1 << 0)
 
+/*!< Longest wait for the conversions of both channels, in milliseconds */
+#define AD7156_CONV_TIMEOUT_MS          100
+
 /*!< AD7156_REG_CH1_SETUP definition */
 #define AD7156_CH1_SETUP_RANGE(x)       (((x) & 0x3) << 6)
 #define AD7156_CH1_SETUP_HYST1          (1 << 4)
@@ -248,4 +251,14 @@ float ad7156_read_channel_capacitance(struct ad7156_dev *dev,
 float ad7156_wait_read_channel_capacitance(struct ad7156_dev *dev,
 		uint8_t channel);
 
+/*!< Reads the status and the data of both channels in a single burst. */
+uint8_t ad7156_read_channels_data(struct ad7156_dev *dev,
+				  uint16_t *ch1_data,
+				  uint16_t *ch2_data);
+
+/*!< Reads consecutive conversions of both channels, interleaved. */
+int32_t ad7156_read_samples(struct ad7156_dev *dev,
+			    uint16_t *data,
+			    uint32_t nb_samples);
+
 #endif	/* __AD7156_H__ */
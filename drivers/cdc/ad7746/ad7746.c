@@ -44,6 +44,93 @@
 #include "no_os_alloc.h"
 #include "ad7746.h"
 
+/***************************************************************************//**
+ * @brief RDY interrupt handler, stores the new conversion in the ring.
+ *
+ * The data registers are read from the interrupt context, so the I2C
+ * transfer must be allowed there by the platform.
+ *
+ * @param ctx - Device descriptor pointer.
+*******************************************************************************/
+static void ad7746_rdy_irq_handler(void *ctx)
+{
+	struct ad7746_dev *dev = ctx;
+	uint32_t head = dev->ring_head;
+	uint32_t next = (head + 1) % AD7746_RING_SIZE;
+
+	if (next == dev->ring_tail) {
+		dev->overruns++;
+		return;
+	}
+
+	if (ad7746_read_data(dev, &dev->ring[head]) < 0)
+		return;
+
+	dev->ring_head = next;
+}
+
+/***************************************************************************//**
+ * @brief Set up the optional RDY pin and its interrupt. The interrupt is
+ *        enabled only while the continuous mode is running.
+ *
+ * @param dev - Device descriptor pointer.
+ * @param init_param - Pointer to the configuration of the driver.
+ * @return 0 in case of success, negative error code otherwise.
+*******************************************************************************/
+static int32_t ad7746_rdy_init(struct ad7746_dev *dev,
+			       struct ad7746_init_param *init_param)
+{
+	int32_t ret;
+
+	ret = no_os_gpio_get_optional(&dev->gpio_rdy, init_param->gpio_rdy);
+	if (ret)
+		return ret;
+
+	if (!dev->gpio_rdy)
+		return 0;
+
+	if (!init_param->irq_ctrl) {
+		ret = -EINVAL;
+		goto error_gpio;
+	}
+
+	ret = no_os_gpio_direction_input(dev->gpio_rdy);
+	if (ret)
+		goto error_gpio;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = ad7746_rdy_irq_handler,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(init_param->irq_ctrl,
+					  dev->gpio_rdy->number, &dev->irq_cb);
+	if (ret)
+		goto error_gpio;
+
+	/* RDY is an active low output */
+	ret = no_os_irq_trigger_level_set(init_param->irq_ctrl,
+					  dev->gpio_rdy->number,
+					  NO_OS_IRQ_EDGE_FALLING);
+	if (ret)
+		goto error_irq;
+
+	dev->irq_ctrl = init_param->irq_ctrl;
+
+	return 0;
+
+error_irq:
+	no_os_irq_unregister_callback(init_param->irq_ctrl,
+				      dev->gpio_rdy->number, &dev->irq_cb);
+error_gpio:
+	no_os_gpio_remove(dev->gpio_rdy);
+	dev->gpio_rdy = NULL;
+
+	return ret;
+}
+
 /***************************************************************************//**
  * @brief Initialize the ad7606 device structure.
  *
@@ -95,6 +182,10 @@ int32_t ad7746_init(struct ad7746_dev **device,
 	if (ret < 0)
 		goto error_2;
 
+	ret = ad7746_rdy_init(dev, init_param);
+	if (ret < 0)
+		goto error_2;
+
 	*device = dev;
 
 	return 0;
@@ -189,6 +280,14 @@ int32_t ad7746_remove(struct ad7746_dev *dev)
 	if (!dev)
 		return 0;
 
+	if (dev->gpio_rdy) {
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		no_os_irq_unregister_callback(dev->irq_ctrl,
+					      dev->gpio_rdy->number,
+					      &dev->irq_cb);
+		no_os_gpio_remove(dev->gpio_rdy);
+	}
+
 	no_os_i2c_remove(dev->i2c_dev);
 	dev->i2c_dev = NULL;
 	no_os_free(dev);
@@ -464,9 +563,7 @@ int32_t ad7746_get_vt_data(struct ad7746_dev *dev, uint32_t *vt_data)
 	if (ret < 0)
 		return ret;
 
-	*vt_data = ((uint32_t)dev->buf[0] << 16) |
-		   ((uint32_t)dev->buf[1] << 8) |
-		   dev->buf[0];
+	*vt_data = no_os_get_unaligned_be24(dev->buf);
 
 	if (dev->setup.config.md == AD7746_MODE_SINGLE)
 		dev->setup.config.md = AD7746_MODE_IDLE;
@@ -506,9 +603,7 @@ int32_t ad7746_get_cap_data(struct ad7746_dev *dev, uint32_t *cap_data)
 	if (ret < 0)
 		return ret;
 
-	*cap_data = ((uint32_t)dev->buf[0] << 16) |
-		    ((uint32_t)dev->buf[1] << 8) |
-		    dev->buf[0];
+	*cap_data = no_os_get_unaligned_be24(dev->buf);
 
 	if (dev->setup.config.md == AD7746_MODE_SINGLE)
 		dev->setup.config.md = AD7746_MODE_IDLE;
@@ -559,3 +654,162 @@ int32_t ad7746_calibrate(struct ad7746_dev *dev, enum ad7746_md md)
 
 	return ret;
 }
+
+/***************************************************************************//**
+ * @brief Reads the status and both data registers in a single I2C burst.
+ *
+ * When both the capacitive and the voltage/temperature channels are enabled
+ * the device converts them alternately; the RDYCAP and RDYVT bits of the
+ * returned status tell which of the values is new.
+ *
+ * @param dev - Device descriptor pointer.
+ * @param sample - Filled with the register contents and a timestamp.
+ *
+ * @return return code.
+ *         Example: -EINVAL - Wrong input values.
+ *                  -EIO - I2C Communication error.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7746_read_data(struct ad7746_dev *dev, struct ad7746_sample *sample)
+{
+	uint8_t buf[AD7746_DATA_BURST_LEN];
+	struct no_os_time t;
+	int32_t ret;
+
+	if (!dev || !sample)
+		return -EINVAL;
+
+	ret = ad7746_reg_read(dev, AD7746_REG_STATUS, buf, sizeof(buf));
+	if (ret < 0)
+		return ret;
+
+	t = no_os_get_time();
+	sample->timestamp_us = (uint64_t)t.s * 1000000 + t.us;
+	/* STATUS, CAP_DATA_HIGH..LOW, VT_DATA_HIGH..LOW */
+	sample->status = buf[0];
+	sample->cap_data = no_os_get_unaligned_be24(&buf[1]);
+	sample->vt_data = no_os_get_unaligned_be24(&buf[4]);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Starts continuous conversions on the enabled channels.
+ *
+ * If the RDY pin was provided, each conversion is read by the interrupt
+ * handler and queued until ad7746_get_sample() is called.
+ *
+ * @param dev - Device descriptor pointer.
+ *
+ * @return return code.
+ *         Example: -EINVAL - Wrong input values.
+ *                  -EIO - I2C Communication error.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7746_start_continuous(struct ad7746_dev *dev)
+{
+	struct ad7746_config c;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	c = dev->setup.config;
+	c.md = AD7746_MODE_CONT;
+	ret = ad7746_set_config(dev, c);
+	if (ret < 0)
+		return ret;
+
+	dev->ring_head = 0;
+	dev->ring_tail = 0;
+	dev->overruns = 0;
+	dev->continuous = true;
+
+	if (!dev->gpio_rdy)
+		return 0;
+
+	return no_os_irq_enable(dev->irq_ctrl, dev->gpio_rdy->number);
+}
+
+/***************************************************************************//**
+ * @brief Stops the continuous conversions.
+ *
+ * @param dev - Device descriptor pointer.
+ *
+ * @return return code.
+ *         Example: -EINVAL - Wrong input values.
+ *                  -EIO - I2C Communication error.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7746_stop_continuous(struct ad7746_dev *dev)
+{
+	struct ad7746_config c;
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (dev->gpio_rdy) {
+		ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_rdy->number);
+		if (ret)
+			return ret;
+	}
+
+	dev->continuous = false;
+
+	c = dev->setup.config;
+	c.md = AD7746_MODE_IDLE;
+
+	return ad7746_set_config(dev, c);
+}
+
+/***************************************************************************//**
+ * @brief Gets the next conversion of the continuous mode.
+ *
+ * With the RDY interrupt the oldest queued conversion is returned without
+ * any bus access, otherwise the status is polled with burst reads until a
+ * conversion is ready, for at most AD7746_CONV_TIMEOUT_MS.
+ *
+ * @param dev - Device descriptor pointer.
+ * @param sample - The conversion.
+ *
+ * @return return code.
+ *         Example: -EINVAL - Wrong input values.
+ *                  -EAGAIN - No conversion queued yet.
+ *                  -ETIMEDOUT - No conversion completed in time.
+ *                  -EIO - I2C Communication error.
+ *                  0 - No errors encountered.
+*******************************************************************************/
+int32_t ad7746_get_sample(struct ad7746_dev *dev,
+			  struct ad7746_sample *sample)
+{
+	uint32_t timeout = AD7746_CONV_TIMEOUT_MS;
+	uint32_t tail;
+	int32_t ret;
+
+	if (!dev || !sample || !dev->continuous)
+		return -EINVAL;
+
+	if (dev->gpio_rdy) {
+		tail = dev->ring_tail;
+		if (tail == dev->ring_head)
+			return -EAGAIN;
+
+		*sample = dev->ring[tail];
+		dev->ring_tail = (tail + 1) % AD7746_RING_SIZE;
+
+		return 0;
+	}
+
+	do {
+		ret = ad7746_read_data(dev, sample);
+		if (ret < 0)
+			return ret;
+		if (!(sample->status & AD7746_STATUS_RDY_MSK))
+			return 0;
+
+		no_os_mdelay(1);
+	} while (--timeout);
+
+	return -ETIMEDOUT;
+}
@@ -44,6 +44,8 @@
 #include <stdbool.h>
 #include "no_os_util.h"
 #include "no_os_i2c.h"
+#include "no_os_gpio.h"
+#include "no_os_irq.h"
 
 /* AD7746 Slave Address */
 #define AD7746_ADDRESS			0x48
@@ -74,6 +76,16 @@
 
 #define AD7746_NUM_REGISTERS		(AD7746_REG_VOLT_GAINL + 1u)
 
+/* Status and data registers, read in a single burst */
+#define AD7746_DATA_BURST_LEN		(AD7746_REG_VT_DATA_LOW + 1u)
+
+/* Number of conversions buffered by the RDY interrupt handler */
+#define AD7746_RING_SIZE		32u
+
+/* Longest wait for a conversion in continuous mode, in milliseconds: the
+ * slowest capacitive plus voltage/temperature conversions, with margin */
+#define AD7746_CONV_TIMEOUT_MS		250u
+
 /* AD7746_REG_STATUS bits */
 #define AD7746_STATUS_EXCERR_MSK	NO_OS_BIT(3)
 #define AD7746_STATUS_RDY_MSK		NO_OS_BIT(2)
@@ -180,10 +192,23 @@ struct ad7746_setup {
 	struct ad7746_config config;
 };
 
+struct ad7746_sample {
+	/* STATUS register, RDYCAP/RDYVT cleared for the fresh data */
+	uint8_t status;
+	uint32_t cap_data;
+	uint32_t vt_data;
+	/* Time at which the conversion was read, in microseconds */
+	uint64_t timestamp_us;
+};
+
 struct ad7746_init_param {
 	struct no_os_i2c_init_param i2c_init;
 	enum ad7746_id id;
 	struct ad7746_setup setup;
+	/* Optional, RDY pin used for interrupt driven continuous reads */
+	struct no_os_gpio_init_param *gpio_rdy;
+	/* Required when gpio_rdy is set */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
 };
 
 struct ad7746_dev {
@@ -191,6 +216,16 @@ struct ad7746_dev {
 	enum ad7746_id id;
 	uint8_t buf[AD7746_NUM_REGISTERS + 1u];
 	struct ad7746_setup setup;
+	struct no_os_gpio_desc *gpio_rdy;
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	struct no_os_callback_desc irq_cb;
+	/* Conversions read by the RDY interrupt handler */
+	struct ad7746_sample ring[AD7746_RING_SIZE];
+	volatile uint32_t ring_head;
+	volatile uint32_t ring_tail;
+	/* Conversions dropped because the ring was full */
+	uint32_t overruns;
+	bool continuous;
 };
 
 int32_t ad7746_init(struct ad7746_dev **device,
@@ -213,5 +248,10 @@ int32_t ad7746_set_volt_gain(struct ad7746_dev *dev, uint16_t gain);
 int32_t ad7746_get_vt_data(struct ad7746_dev *dev, uint32_t *vt_data);
 int32_t ad7746_get_cap_data(struct ad7746_dev *dev, uint32_t *cap_data);
 int32_t ad7746_calibrate(struct ad7746_dev *dev, enum ad7746_md md);
+int32_t ad7746_read_data(struct ad7746_dev *dev, struct ad7746_sample *sample);
+int32_t ad7746_start_continuous(struct ad7746_dev *dev);
+int32_t ad7746_stop_continuous(struct ad7746_dev *dev);
+int32_t ad7746_get_sample(struct ad7746_dev *dev,
+			  struct ad7746_sample *sample);
 
 #endif // _AD7746_H
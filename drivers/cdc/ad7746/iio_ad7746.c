@@ -93,6 +93,35 @@ static int32_t ad7746_store_vt_filter_rate_setup(struct ad7746_dev *chip,
 	return ad7746_set_config(chip, c);
 }
 
+// program the CAPDACs of a capacitive input, unless already done
+static int32_t ad7746_apply_capdac(struct ad7746_iio_dev *iiodev,
+				   uint32_t ch_num)
+{
+	struct ad7746_dev *desc = iiodev->ad7746_dev;
+	int32_t ret;
+	bool en;
+	uint8_t code;
+
+	if (iiodev->capdac_set == (int8_t)ch_num)
+		return 0;
+
+	en = (bool)(iiodev->capdac[ch_num][0] & AD7746_CAPDAC_DACEN_MSK);
+	code = iiodev->capdac[ch_num][0] & AD7746_CAPDAC_DACP_MSK;
+	ret = ad7746_set_cap_dac_a(desc, en, code);
+	if (ret < 0)
+		return ret;
+
+	en = (bool)(iiodev->capdac[ch_num][1] & AD7746_CAPDAC_DACEN_MSK);
+	code = iiodev->capdac[ch_num][1] & AD7746_CAPDAC_DACP_MSK;
+	ret = ad7746_set_cap_dac_b(desc, en, code);
+	if (ret < 0)
+		return ret;
+
+	iiodev->capdac_set = ch_num;
+
+	return 0;
+}
+
 // perform channel selection
 static int32_t ad7746_select_channel(void *device,
 				     const struct iio_ch_info *ch_info)
@@ -112,24 +141,9 @@ static int32_t ad7746_select_channel(void *device,
 		idx = desc->setup.config.capf;
 		delay = ad7746_cap_filter_rate_table[idx][1];
 
-		if (iiodev->capdac_set != ch_info->ch_num) {
-			bool en;
-			uint8_t code;
-
-			en = (bool)(iiodev->capdac[ch_info->ch_num][0] & AD7746_CAPDAC_DACEN_MSK);
-			code = iiodev->capdac[ch_info->ch_num][0] & AD7746_CAPDAC_DACP_MSK;
-			ret = ad7746_set_cap_dac_a(desc, en, code);
-			if (ret < 0)
-				return ret;
-
-			en = (bool)(iiodev->capdac[ch_info->ch_num][1] & AD7746_CAPDAC_DACEN_MSK);
-			code = iiodev->capdac[ch_info->ch_num][1] & AD7746_CAPDAC_DACP_MSK;
-			ret = ad7746_set_cap_dac_b(desc, en, code);
-			if (ret < 0)
-				return ret;
-
-			iiodev->capdac_set = ch_info->ch_num;
-		}
+		ret = ad7746_apply_capdac(iiodev, ch_info->ch_num);
+		if (ret < 0)
+			return ret;
 		break;
 	case IIO_VOLTAGE:
 		if (ch_info->ch_num == 1)
@@ -545,6 +559,186 @@ static int ad7746_start_gain_calib(void *device, char *buf, uint32_t len,
 	return len;
 }
 
+// enable continuous conversions on one capacitive and one voltage/temperature
+// channel at most, the device converts them alternately
+static int32_t ad7746_iio_buffer_enable(void *device, uint32_t mask)
+{
+	struct ad7746_iio_dev *iiodev = (struct ad7746_iio_dev *)device;
+	struct ad7746_dev *desc = (struct ad7746_dev *)iiodev->ad7746_dev;
+	struct ad7746_cap cap = desc->setup.cap;
+	struct ad7746_vt vt = desc->setup.vt;
+	struct iio_channel *ch;
+	int32_t ret;
+	uint32_t i;
+
+	cap.capen = false;
+	vt.vten = false;
+
+	for (i = 0; i < iiodev->iio_dev->num_ch; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+
+		ch = &iiodev->iio_dev->channels[i];
+		switch (ch->ch_type) {
+		case IIO_CAPACITANCE:
+			if (cap.capen)
+				return -EINVAL;
+
+			cap.capen = true;
+			cap.capdiff = ch->address & AD7746_CAPSETUP_CAPDIFF_MSK;
+			cap.cin2 = ch->address & AD7746_CAPSETUP_CIN2_MSK;
+			ret = ad7746_apply_capdac(iiodev, ch->channel);
+			if (ret < 0)
+				return ret;
+			break;
+		case IIO_VOLTAGE:
+		case IIO_TEMP:
+			if (vt.vten)
+				return -EINVAL;
+
+			vt.vten = true;
+			vt.vtmd = ch->address;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (!cap.capen && !vt.vten)
+		return -EINVAL;
+
+	if (_capdiff(&desc->setup.cap, &cap)) {
+		ret = ad7746_set_cap(desc, cap);
+		if (ret < 0)
+			return ret;
+	}
+
+	if (_vtdiff(&desc->setup.vt, &vt)) {
+		ret = ad7746_set_vt(desc, vt);
+		if (ret < 0)
+			return ret;
+	}
+
+	iiodev->active_mask = mask;
+
+	return ad7746_start_continuous(desc);
+}
+
+static int32_t ad7746_iio_buffer_disable(void *device)
+{
+	struct ad7746_iio_dev *iiodev = (struct ad7746_iio_dev *)device;
+
+	return ad7746_stop_continuous(iiodev->ad7746_dev);
+}
+
+// build a scan from a conversion, keeping the previous value of the channel
+// that was not converted this time
+static int32_t ad7746_iio_push_sample(struct ad7746_iio_dev *iiodev,
+				      struct iio_buffer *buffer,
+				      struct ad7746_sample *sample)
+{
+	uint64_t scan[AD7746_IIO_SCAN_WORDS] = { 0 };
+	uint8_t *data = (uint8_t *)scan;
+	struct iio_channel *ch;
+	uint32_t offset = 0;
+	uint32_t len;
+	int64_t ts;
+	uint32_t i;
+
+	if (!(sample->status & AD7746_STATUS_RDYCAP_MSK))
+		iiodev->cap_value = (sample->cap_data & 0xffffff) - 0x800000;
+	if (!(sample->status & AD7746_STATUS_RDYVT_MSK))
+		iiodev->vt_value = (sample->vt_data & 0xffffff) - 0x800000;
+	ts = (int64_t)sample->timestamp_us * 1000;
+
+	for (i = 0; i < iiodev->iio_dev->num_ch; i++) {
+		if (!(iiodev->active_mask & NO_OS_BIT(i)))
+			continue;
+
+		ch = &iiodev->iio_dev->channels[i];
+		len = ch->scan_type->storagebits / 8;
+		offset = NO_OS_DIV_ROUND_UP(offset, len) * len;
+
+		switch (ch->ch_type) {
+		case IIO_CAPACITANCE:
+			memcpy(&data[offset], &iiodev->cap_value, len);
+			break;
+		case IIO_TIMESTAMP:
+			memcpy(&data[offset], &ts, len);
+			break;
+		default:
+			memcpy(&data[offset], &iiodev->vt_value, len);
+			break;
+		}
+
+		offset += len;
+	}
+
+	return iio_buffer_push_scan(buffer, scan);
+}
+
+static int32_t ad7746_iio_submit(struct iio_device_data *dev_data)
+{
+	struct ad7746_iio_dev *iiodev = (struct ad7746_iio_dev *)dev_data->dev;
+	struct ad7746_sample sample;
+	uint32_t timeout;
+	int32_t ret;
+	uint32_t i;
+
+	for (i = 0; i < dev_data->buffer->samples; i++) {
+		/* Wait for the RDY interrupt to queue a conversion */
+		timeout = AD7746_CONV_TIMEOUT_MS;
+		do {
+			ret = ad7746_get_sample(iiodev->ad7746_dev, &sample);
+			if (ret != -EAGAIN)
+				break;
+
+			no_os_mdelay(1);
+		} while (--timeout);
+
+		if (ret == -EAGAIN)
+			return -ETIMEDOUT;
+		if (ret < 0)
+			return ret;
+
+		ret = ad7746_iio_push_sample(iiodev, dev_data->buffer, &sample);
+		if (ret < 0)
+			return ret;
+	}
+
+	return 0;
+}
+
+// RDY trigger handler, one burst read per conversion
+static int32_t ad7746_iio_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct ad7746_iio_dev *iiodev = (struct ad7746_iio_dev *)dev_data->dev;
+	struct ad7746_sample sample;
+	int32_t ret;
+
+	ret = ad7746_read_data(iiodev->ad7746_dev, &sample);
+	if (ret < 0)
+		return ret;
+
+	return ad7746_iio_push_sample(iiodev, dev_data->buffer, &sample);
+}
+
+static struct scan_type ad7746_iio_scan_type = {
+	.sign = 's',
+	.realbits = 24,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+static struct scan_type ad7746_iio_timestamp_scan_type = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false
+};
+
 static struct iio_attribute ad7746_iio_vin_attrs[] = {
 	{
 		.name = "raw",
@@ -653,6 +847,7 @@ enum ad7746_chan {
 	CIN1_DIFF,
 	CIN2,
 	CIN2_DIFF,
+	TIMESTAMP,
 };
 
 static struct iio_channel ad7746_channels[] = {
@@ -662,6 +857,8 @@ static struct iio_channel ad7746_channels[] = {
 		.channel = 0,
 		.attributes = ad7746_iio_vin_attrs,
 		.address = AD7746_VIN_EXT_VIN,
+		.scan_index = VIN,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[VIN_VDD] = {
@@ -670,6 +867,8 @@ static struct iio_channel ad7746_channels[] = {
 		.channel = 1,
 		.attributes = ad7746_iio_vin_attrs,
 		.address = AD7746_VTMD_VDD_MON,
+		.scan_index = VIN_VDD,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[TEMP_INT] = {
@@ -678,6 +877,8 @@ static struct iio_channel ad7746_channels[] = {
 		.channel = 0,
 		.attributes = ad7746_iio_temp_attrs,
 		.address = AD7746_VTMD_INT_TEMP,
+		.scan_index = TEMP_INT,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[TEMP_EXT] = {
@@ -686,6 +887,8 @@ static struct iio_channel ad7746_channels[] = {
 		.channel = 1,
 		.attributes = ad7746_iio_temp_attrs,
 		.address = AD7746_VTMD_EXT_TEMP,
+		.scan_index = TEMP_EXT,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[CIN1] = {
@@ -693,6 +896,8 @@ static struct iio_channel ad7746_channels[] = {
 		.indexed = true,
 		.channel = 0,
 		.attributes = ad7746_iio_cin_attrs,
+		.scan_index = CIN1,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[CIN1_DIFF] = {
@@ -703,6 +908,8 @@ static struct iio_channel ad7746_channels[] = {
 		.channel2 = 2,
 		.attributes = ad7746_iio_cin_attrs,
 		.address = AD7746_CAPSETUP_CAPDIFF_MSK,
+		.scan_index = CIN1_DIFF,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[CIN2] = {
@@ -711,6 +918,8 @@ static struct iio_channel ad7746_channels[] = {
 		.channel = 1,
 		.attributes = ad7746_iio_cin_attrs,
 		.address = AD7746_CAPSETUP_CIN2_MSK,
+		.scan_index = CIN2,
+		.scan_type = &ad7746_iio_scan_type,
 		.ch_out = false,
 	},
 	[CIN2_DIFF] = {
@@ -721,6 +930,14 @@ static struct iio_channel ad7746_channels[] = {
 		.channel2 = 3,
 		.attributes = ad7746_iio_cin_attrs,
 		.address = AD7746_CAPSETUP_CAPDIFF_MSK | AD7746_CAPSETUP_CIN2_MSK,
+		.scan_index = CIN2_DIFF,
+		.scan_type = &ad7746_iio_scan_type,
+		.ch_out = false,
+	},
+	[TIMESTAMP] = {
+		.ch_type = IIO_TIMESTAMP,
+		.scan_index = TIMESTAMP,
+		.scan_type = &ad7746_iio_timestamp_scan_type,
 		.ch_out = false,
 	}
 };
@@ -731,9 +948,11 @@ static struct iio_device ad7746_iio_device = {
 	.attributes = NULL,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
-	.pre_enable = NULL,
-	.post_disable = NULL,
+	.pre_enable = ad7746_iio_buffer_enable,
+	.post_disable = ad7746_iio_buffer_disable,
 	.read_dev = NULL,
+	.submit = ad7746_iio_submit,
+	.trigger_handler = ad7746_iio_trigger_handler,
 	.debug_reg_read = (int32_t (*)())_ad7746_read_register2,
 	.debug_reg_write = (int32_t (*)())_ad7746_write_register2
 };
@@ -742,21 +961,33 @@ int32_t ad7746_iio_init(struct ad7746_iio_dev **iio_dev,
 			struct ad7746_iio_init_param *init_param)
 {
 	int32_t ret;
+	uint32_t i;
 	struct ad7746_iio_dev *desc;
 
 	desc = (struct ad7746_iio_dev *)no_os_calloc(1, sizeof(*desc));
 	if (!desc)
 		return -1;
 
-	desc->iio_dev = &ad7746_iio_device;
 	desc->capdac_set = -1;
 
 	ret = ad7746_init(&desc->ad7746_dev, init_param->ad7746_initial);
 	if (ret != 0)
 		goto error_desc;
 
-	if (desc->ad7746_dev->id != ID_AD7746)
-		desc->iio_dev->num_ch -= 2;
+	desc->iio_device = ad7746_iio_device;
+	desc->iio_device.channels = desc->channels;
+	memcpy(desc->channels, ad7746_channels, sizeof(ad7746_channels));
+
+	if (desc->ad7746_dev->id != ID_AD7746) {
+		// only the AD7746 has the second capacitive input
+		desc->channels[CIN2] = desc->channels[TIMESTAMP];
+		desc->iio_device.num_ch -= 2;
+	}
+
+	for (i = 0; i < desc->iio_device.num_ch; i++)
+		desc->channels[i].scan_index = i;
+
+	desc->iio_dev = &desc->iio_device;
 
 	*iio_dev = desc;
 
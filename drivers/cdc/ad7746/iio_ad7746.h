@@ -42,6 +42,11 @@
 
 #include "iio.h"
 
+// voltage, temperature and capacitive channels, plus the timestamp
+#define AD7746_IIO_NUM_CHANNELS		9
+// capacitive and voltage/temperature values, plus the 64 bit timestamp
+#define AD7746_IIO_SCAN_WORDS		2
+
 struct ad7746_iio_dev {
 	struct ad7746_dev *ad7746_dev;
 	struct iio_device *iio_dev;
@@ -49,6 +54,14 @@ struct ad7746_iio_dev {
 	// capdac[_][0] - single-ended, capdac[_][1] - differential
 	uint8_t capdac[2][2];
 	int8_t capdac_set;
+	// per instance copy of the device, AD7745/AD7747 have less channels
+	struct iio_device iio_device;
+	struct iio_channel channels[AD7746_IIO_NUM_CHANNELS];
+	// channels enabled in the buffer
+	uint32_t active_mask;
+	// last conversion of each channel type, used for the scans
+	int32_t cap_value;
+	int32_t vt_value;
 };
 
 struct ad7746_iio_init_param {
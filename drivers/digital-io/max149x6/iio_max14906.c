@@ -40,6 +40,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 #include "no_os_error.h"
 #include "no_os_units.h"
 #include "no_os_util.h"
@@ -85,6 +86,9 @@ static int max14906_iio_read_config_iec_available(void *dev, char *buf,
 		uint32_t len, const struct iio_ch_info *channel,
 		intptr_t priv);
 
+static int max14906_iio_buffer_preenable(void *dev, uint32_t mask);
+static int32_t max14906_iio_trigger_handler(struct iio_device_data *dev_data);
+
 static int max14906_iio_reg_read(struct max14906_iio_desc *, uint32_t,
 				 uint32_t *);
 static int max14906_iio_reg_write(struct max14906_iio_desc *, uint32_t,
@@ -157,7 +161,25 @@ static struct iio_attribute max14906_in_attrs[] = {
 	END_ATTRIBUTES_ARRAY
 };
 
+static struct scan_type max14906_iio_scan_type = {
+	.sign = 'u',
+	.realbits = 16,
+	.storagebits = 16,
+	.shift = 0,
+	.is_big_endian = false
+};
+
+static struct scan_type max14906_iio_scan_type_timestamp = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false
+};
+
 static struct iio_device max14906_iio_dev = {
+	.pre_enable = (int32_t (*)())max14906_iio_buffer_preenable,
+	.trigger_handler = (int32_t (*)())max14906_iio_trigger_handler,
 	.debug_reg_read = (int32_t (*)())max14906_iio_reg_read,
 	.debug_reg_write = (int32_t (*)())max14906_iio_reg_write,
 };
@@ -489,6 +511,98 @@ static int max14906_iio_read_config_iec_available(void *dev, char *buf,
 	return length;
 }
 
+/**
+ * @brief Reset the edge detection state before a buffered capture.
+ * @param dev - The iio device structure.
+ * @param mask - Mask of the enabled scan elements.
+ * @return 0 in case of success, error code otherwise
+ */
+static int max14906_iio_buffer_preenable(void *dev, uint32_t mask)
+{
+	struct max14906_iio_desc *desc = dev;
+
+	if (!desc)
+		return -ENODEV;
+
+	desc->prev_valid = false;
+
+	return 0;
+}
+
+/**
+ * @brief Read the states and faults of all the channels in one transfer and
+ * push a timestamped sample for the enabled scan elements.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t max14906_iio_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct max14906_iio_desc *desc = dev_data->dev;
+	struct iio_buffer *buffer = dev_data->buffer;
+	/* Up to 4 16 bit words followed by the 64 bit timestamp */
+	uint64_t data[2];
+	uint8_t *scan = (uint8_t *)data;
+	struct max14906_scan regs;
+	struct no_os_time t;
+	uint32_t offset = 0;
+	uint8_t rise, fall;
+	uint16_t sample;
+	int64_t ts;
+	uint32_t i;
+	uint8_t ch;
+	int ret;
+
+	ret = max14906_scan(desc->max14906_desc, &regs);
+	if (ret)
+		return ret;
+
+	t = no_os_get_time();
+
+	if (desc->prev_valid) {
+		rise = regs.doi_level & ~desc->prev_level;
+		fall = ~regs.doi_level & desc->prev_level;
+	} else {
+		rise = 0;
+		fall = 0;
+	}
+	desc->prev_level = regs.doi_level;
+	desc->prev_valid = true;
+
+	memset(data, 0, sizeof(data));
+	for (i = 0; i < desc->scan_ch_cnt; i++) {
+		if (!(buffer->active_mask & NO_OS_BIT(i)))
+			continue;
+
+		ch = desc->scan_ch[i];
+		sample = no_os_field_prep(MAX14906_IIO_SCAN_LEVEL,
+					  (regs.doi_level >> ch) & 1) |
+			 no_os_field_prep(MAX14906_IIO_SCAN_RISE,
+					  (rise >> ch) & 1) |
+			 no_os_field_prep(MAX14906_IIO_SCAN_FALL,
+					  (fall >> ch) & 1) |
+			 no_os_field_prep(MAX14906_IIO_SCAN_OVR_LD,
+					  (regs.ovr_ld >> ch) & 1) |
+			 no_os_field_prep(MAX14906_IIO_SCAN_OPN_WIR,
+					  (regs.opn_wir >> ch) & 1) |
+			 no_os_field_prep(MAX14906_IIO_SCAN_SHD_VDD,
+					  (regs.shd_vdd >> ch) & 1) |
+			 no_os_field_prep(MAX14906_IIO_SCAN_GLOBAL_MASK,
+					  regs.global_err);
+
+		memcpy(&scan[offset], &sample, sizeof(sample));
+		offset += sizeof(sample);
+	}
+
+	/* The timestamp is aligned to its own size */
+	if (buffer->active_mask & NO_OS_BIT(desc->scan_ch_cnt)) {
+		offset = NO_OS_DIV_ROUND_UP(offset, sizeof(ts)) * sizeof(ts);
+		ts = ((int64_t)t.s * 1000000 + t.us) * 1000;
+		memcpy(&scan[offset], &ts, sizeof(ts));
+	}
+
+	return iio_buffer_push_scan(buffer, scan);
+}
+
 /**
  * @brief Configure a set if IIO channels based on the operation modes of the enabled
  * physical channels.
@@ -507,7 +621,8 @@ int max14906_iio_setup_channels(struct max14906_iio_desc *desc)
 		if (desc->channel_configs[i].enabled)
 			enabled_ch++;
 
-	max14906_iio_channels = no_os_calloc(enabled_ch,
+	/* One extra slot for the timestamp channel */
+	max14906_iio_channels = no_os_calloc(enabled_ch + 1,
 					     sizeof(*max14906_iio_channels));
 	if (!max14906_iio_channels)
 		return -ENOMEM;
@@ -522,10 +637,14 @@ int max14906_iio_setup_channels(struct max14906_iio_desc *desc)
 		}
 
 		max14906_iio_channels[ch_offset] = (struct iio_channel)MAX14906_CHANNEL(i);
+		max14906_iio_channels[ch_offset].scan_index = ch_offset;
+		desc->scan_ch[ch_offset] = i;
 
 		/* Set the direction and attributes based on configuration */
 		if (desc->channel_configs[i].function == MAX14906_IN) {
 			max14906_iio_channels[ch_offset].attributes = max14906_in_attrs;
+			max14906_iio_channels[ch_offset].scan_type =
+				&max14906_iio_scan_type;
 			max14906_iio_channels[ch_offset].ch_out = 0;
 		} else {
 			max14906_iio_channels[ch_offset].attributes = max14906_out_attrs;
@@ -539,8 +658,17 @@ int max14906_iio_setup_channels(struct max14906_iio_desc *desc)
 			goto free_channels;
 	}
 
+	max14906_iio_channels[ch_offset] = (struct iio_channel) {
+		.ch_type = IIO_TIMESTAMP,
+		.channel = ch_offset,
+		.scan_index = ch_offset,
+		.scan_type = &max14906_iio_scan_type_timestamp,
+		.ch_out = 0,
+	};
+
+	desc->scan_ch_cnt = ch_offset;
 	desc->iio_dev->channels = max14906_iio_channels;
-	desc->iio_dev->num_ch = enabled_ch;
+	desc->iio_dev->num_ch = ch_offset + 1;
 
 	return 0;
 
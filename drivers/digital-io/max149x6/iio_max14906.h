@@ -46,6 +46,18 @@
 
 #define MAX14906_FUNCTION_CNT	3
 
+/*
+ * Layout of a buffered sample, one 16 bit word per input channel, followed by
+ * a 64 bit timestamp in ns. Edges are relative to the previous scan.
+ */
+#define MAX14906_IIO_SCAN_LEVEL		NO_OS_BIT(0)
+#define MAX14906_IIO_SCAN_RISE		NO_OS_BIT(1)
+#define MAX14906_IIO_SCAN_FALL		NO_OS_BIT(2)
+#define MAX14906_IIO_SCAN_OVR_LD	NO_OS_BIT(3)
+#define MAX14906_IIO_SCAN_OPN_WIR	NO_OS_BIT(4)
+#define MAX14906_IIO_SCAN_SHD_VDD	NO_OS_BIT(5)
+#define MAX14906_IIO_SCAN_GLOBAL_MASK	NO_OS_GENMASK(15, 8)
+
 /**
  * @brief Configuration structure for a MAX14906 channel.
  */
@@ -90,6 +102,13 @@ struct max14906_iio_desc {
 	uint32_t active_channels;
 	uint32_t no_active_channels;
 	struct max14906_ch_config channel_configs[MAX14906_CHANNELS];
+	/** Physical channel behind each IIO channel */
+	uint8_t scan_ch[MAX14906_CHANNELS];
+	/** Number of physical channels exposed over IIO */
+	uint32_t scan_ch_cnt;
+	/** DoiLevel of the previous scan, used for edge detection */
+	uint8_t prev_level;
+	bool prev_valid;
 };
 
 /**
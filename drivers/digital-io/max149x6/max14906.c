@@ -83,6 +83,43 @@ int max14906_ch_set(struct max149x6_desc *desc, uint32_t ch, uint32_t val)
 				   MAX14906_HIGHO_MASK(ch) : 0);
 }
 
+/**
+ * @brief Read the channel states and all the per channel fault registers in a
+ * single SPI transfer.
+ * @param desc - device descriptor for the MAX14906
+ * @param scan - snapshot of the state and fault registers.
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max14906_scan(struct max149x6_desc *desc, struct max14906_scan *scan)
+{
+	static const uint8_t regs[] = {
+		MAX14906_DOILEVEL_REG,
+		MAX14906_INT_REG,
+		MAX14906_OVR_LD_REG,
+		MAX14906_OPN_WIR_FLT_REG,
+		MAX14906_SHD_VDD_FLT_REG,
+		MAX14906_GLOBAL_FLT_REG,
+	};
+	uint8_t val[NO_OS_ARRAY_SIZE(regs)];
+	int ret;
+
+	if (!desc || !scan)
+		return -EINVAL;
+
+	ret = max149x6_reg_read_multi(desc, regs, NO_OS_ARRAY_SIZE(regs), val);
+	if (ret)
+		return ret;
+
+	scan->doi_level = val[0];
+	scan->interrupt = val[1];
+	scan->ovr_ld = val[2];
+	scan->opn_wir = val[3];
+	scan->shd_vdd = val[4];
+	scan->global_err = val[5];
+
+	return 0;
+}
+
 /**
  * @brief Configure a channel's function.
  * @param desc - device descriptor for the MAX14906
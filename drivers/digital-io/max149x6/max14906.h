@@ -113,12 +113,27 @@ enum max14906_climit {
 	MAX14906_CL_1200,
 };
 
+/**
+ * @brief Snapshot of the channel states and fault registers.
+ */
+struct max14906_scan {
+	uint8_t doi_level;
+	uint8_t interrupt;
+	uint8_t ovr_ld;
+	uint8_t opn_wir;
+	uint8_t shd_vdd;
+	uint8_t global_err;
+};
+
 /** Read the state of a channel */
 int max14906_ch_get(struct max149x6_desc *, uint32_t, uint32_t *);
 
 /** Set the state of a channel */
 int max14906_ch_set(struct max149x6_desc *, uint32_t, uint32_t);
 
+/** Read the channel states and fault registers in one transfer */
+int max14906_scan(struct max149x6_desc *, struct max14906_scan *);
+
 /** Configure a channel's function */
 int max14906_ch_func(struct max149x6_desc *, uint32_t, enum max14906_function);
 
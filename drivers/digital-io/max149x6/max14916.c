@@ -86,6 +86,47 @@ int max14916_ch_set(struct max149x6_desc *desc, uint32_t ch, uint32_t val)
 				   MAX14916_SETOUT_MASK(ch) : 0);
 }
 
+/**
+ * @brief Read the output states and all the per channel fault registers in a
+ * single SPI transfer.
+ * @param desc - device descriptor for the MAX14916.
+ * @param scan - snapshot of the state and fault registers.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int max14916_scan(struct max149x6_desc *desc, struct max14916_scan *scan)
+{
+	static const uint8_t regs[] = {
+		MAX14916_SETOUT_REG,
+		MAX14916_INT_REG,
+		MAX14916_OVR_LD_REG,
+		MAX14916_CURR_LIM_REG,
+		MAX14916_OW_OFF_FAULT_REG,
+		MAX14916_OW_ON_FAULT_REG,
+		MAX14916_SHD_VDD_FAULT_REG,
+		MAX14916_GLOB_ERR_REG,
+	};
+	uint8_t val[NO_OS_ARRAY_SIZE(regs)];
+	int ret;
+
+	if (!desc || !scan)
+		return -EINVAL;
+
+	ret = max149x6_reg_read_multi(desc, regs, NO_OS_ARRAY_SIZE(regs), val);
+	if (ret)
+		return ret;
+
+	scan->setout = val[0];
+	scan->interrupt = val[1];
+	scan->ovr_ld = val[2];
+	scan->curr_lim = val[3];
+	scan->ow_off = val[4];
+	scan->ow_on = val[5];
+	scan->shd_vdd = val[6];
+	scan->glob_err = val[7];
+
+	return 0;
+}
+
 /**
  * @brief Read an output channel's current limit.
  * @param desc - device descriptor for the MAX14916.
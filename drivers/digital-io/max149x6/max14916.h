@@ -107,12 +107,29 @@ enum max14916_sht_vdd_thr {
 	MAX14916_SHT_VDD_THR_14V
 };
 
+/**
+ * @brief Snapshot of the output states and fault registers.
+ */
+struct max14916_scan {
+	uint8_t setout;
+	uint8_t interrupt;
+	uint8_t ovr_ld;
+	uint8_t curr_lim;
+	uint8_t ow_off;
+	uint8_t ow_on;
+	uint8_t shd_vdd;
+	uint8_t glob_err;
+};
+
 /** Read the state of a channel */
 int max14916_ch_get(struct max149x6_desc *, uint32_t, uint32_t *);
 
 /** Set the state of a channel */
 int max14916_ch_set(struct max149x6_desc *, uint32_t, uint32_t);
 
+/** Read the output states and fault registers in one transfer */
+int max14916_scan(struct max149x6_desc *, struct max14916_scan *);
+
 /** Set SLED to on/off */
 int max14916_sled_set(struct max149x6_desc *, uint32_t,
 		      enum max14916_sled_state);
@@ -166,6 +166,62 @@ int max149x6_reg_read(struct max149x6_desc *desc, uint32_t addr, uint32_t *val)
 	return 0;
 }
 
+/**
+ * @brief Read a list of device registers in a single SPI transfer. Each
+ * register is still a separate frame (CS is toggled in between), but all of
+ * them are chained in one transfer so the states and faults form a consistent
+ * snapshot and the per-call overhead is paid once.
+ * @param desc - device descriptor for the MAX149X6
+ * @param addr - addresses of the registers
+ * @param nb_regs - number of registers to read (at most MAX149X6_SCAN_MAX_REGS)
+ * @param val - values of the registers
+ * @return 0 in case of success, negative error code otherwise
+ */
+int max149x6_reg_read_multi(struct max149x6_desc *desc, const uint8_t *addr,
+			    uint32_t nb_regs, uint8_t *val)
+{
+	uint8_t frames[MAX149X6_SCAN_MAX_REGS][MAX149X6_FRAME_SIZE + 1] = {0};
+	struct no_os_spi_msg xfer[MAX149X6_SCAN_MAX_REGS] = {0};
+	uint32_t frame_size = MAX149X6_FRAME_SIZE;
+	uint32_t i;
+	int ret;
+
+	if (!nb_regs || nb_regs > MAX149X6_SCAN_MAX_REGS)
+		return -EINVAL;
+
+	if (desc->crc_en)
+		frame_size++;
+
+	for (i = 0; i < nb_regs; i++) {
+		frames[i][0] = no_os_field_prep(MAX149X6_CHIP_ADDR_MASK,
+						desc->chip_address) |
+			       no_os_field_prep(MAX149X6_ADDR_MASK, addr[i]) |
+			       no_os_field_prep(MAX149X6_RW_MASK, 0);
+
+		if (desc->crc_en)
+			frames[i][2] = max149x6_crc(frames[i], true);
+
+		xfer[i].tx_buff = frames[i];
+		xfer[i].rx_buff = frames[i];
+		xfer[i].bytes_number = frame_size;
+		xfer[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, xfer, nb_regs);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_regs; i++) {
+		if (desc->crc_en &&
+		    max149x6_crc(frames[i], false) != frames[i][2])
+			return -EINVAL;
+
+		val[i] = frames[i][1];
+	}
+
+	return 0;
+}
+
 /**
  * @brief Update the value of a device register (read/write sequence).
  * @param desc - device descriptor for the MAX149X6
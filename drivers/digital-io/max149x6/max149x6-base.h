@@ -49,6 +49,9 @@
 /* Common Frame Size */
 #define MAX149X6_FRAME_SIZE		2
 
+/* Maximum number of registers read by a single scan transfer */
+#define MAX149X6_SCAN_MAX_REGS		10
+
 /* Common Registers */
 #define MAX149X6_CHIP_ADDR_MASK		NO_OS_GENMASK(7, 6)
 #define MAX149X6_ADDR_MASK		NO_OS_GENMASK(4, 1)
@@ -87,6 +90,10 @@ int max149x6_reg_write(struct max149x6_desc *, uint32_t, uint32_t);
 /** Read the value of a device register */
 int max149x6_reg_read(struct max149x6_desc *, uint32_t, uint32_t *);
 
+/** Read a list of device registers in a single SPI transfer */
+int max149x6_reg_read_multi(struct max149x6_desc *, const uint8_t *, uint32_t,
+			    uint8_t *);
+
 /** Update the value of a device register */
 int max149x6_reg_update(struct max149x6_desc *, uint32_t, uint32_t, uint32_t);
 
@@ -371,6 +371,64 @@ int max22190_reg_read(struct max22190_desc *desc, uint32_t addr, uint32_t *val)
 	return 0;
 }
 
+/**
+ * @brief Read the input states and the fault registers in a single SPI
+ * 	  transfer, one frame per register, giving a consistent snapshot.
+ * @param desc - MAX22190 device descriptor.
+ * @param scan - Snapshot of the state and fault registers.
+ * @return 0 in case of success, negative error code otherwise.
+*/
+int max22190_scan(struct max22190_desc *desc, struct max22190_scan *scan)
+{
+	static const uint8_t regs[] = {
+		MAX22190_DIGITAL_INPUT_REG,
+		MAX22190_WIRE_BREAK_REG,
+		MAX22190_FAULT1_REG,
+		MAX22190_FAULT2_REG,
+	};
+	uint8_t frames[NO_OS_ARRAY_SIZE(regs)][MAX22190_FRAME_SIZE + 1] = {0};
+	struct no_os_spi_msg xfer[NO_OS_ARRAY_SIZE(regs)] = {0};
+	uint32_t frame_size = MAX22190_FRAME_SIZE;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !scan)
+		return -EINVAL;
+
+	if (desc->crc_en)
+		frame_size++;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(regs); i++) {
+		frames[i][0] = no_os_field_prep(MAX22190_ADDR_MASK, regs[i]) |
+			       no_os_field_prep(MAX22190_RW_MASK, 0);
+
+		if (desc->crc_en)
+			frames[i][2] = max22190_crc(frames[i]);
+
+		xfer[i].tx_buff = frames[i];
+		xfer[i].rx_buff = frames[i];
+		xfer[i].bytes_number = frame_size;
+		xfer[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, xfer, NO_OS_ARRAY_SIZE(regs));
+	if (ret)
+		return ret;
+
+	if (desc->crc_en) {
+		for (i = 0; i < NO_OS_ARRAY_SIZE(regs); i++)
+			if (max22190_crc(frames[i]) != (frames[i][2] & 0x1F))
+				return -EINVAL;
+	}
+
+	scan->digital_input = frames[0][1];
+	scan->wire_break = frames[1][1];
+	scan->fault1 = frames[2][1];
+	scan->fault2 = frames[3][1];
+
+	return 0;
+}
+
 /**
  * @brief Register write function for MAX22190
  * @param desc - MAX22190 device descriptor.
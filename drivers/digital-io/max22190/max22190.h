@@ -100,6 +100,16 @@ struct max22190_desc {
 	bool crc_en;
 };
 
+/**
+ * @brief Snapshot of the input states and fault registers.
+ */
+struct max22190_scan {
+	uint8_t digital_input;
+	uint8_t wire_break;
+	uint8_t fault1;
+	uint8_t fault2;
+};
+
 enum max22190_delay {
 	MAX22190_DELAY_50US,
 	MAX22190_DELAY_100US,
@@ -157,6 +167,9 @@ int max22190_fault_enable_get(struct max22190_desc *,
 /** Read the register of the MAX22190 device. */
 int max22190_reg_read(struct max22190_desc *, uint32_t, uint32_t *);
 
+/** Read the input states and fault registers in one transfer. */
+int max22190_scan(struct max22190_desc *, struct max22190_scan *);
+
 /** Write the register of the MAX22190 device. */
 int max22190_reg_write(struct max22190_desc *, uint32_t, uint32_t);
 
@@ -161,6 +161,65 @@ int max22196_reg_read(struct max22196_desc *desc, uint32_t reg, uint32_t *val)
 	return 0;
 }
 
+/**
+ * @brief MAX22196 scan function, reading the input states and the fault
+ * 	  registers in a single SPI transfer (one frame per register).
+ * @param desc - The device descriptor for MAX22196.
+ * @param scan - Snapshot of the state and fault registers.
+ * @return 0 in case of succes, negative error code otherwise.
+*/
+int max22196_scan(struct max22196_desc *desc, struct max22196_scan *scan)
+{
+	static const uint8_t regs[] = {
+		MAX22196_DI_STATE_REG,
+		MAX22196_FAULT1_REG,
+		MAX22196_FAULT2_REG,
+	};
+	uint8_t frames[NO_OS_ARRAY_SIZE(regs)][MAX22196_FRAME_SIZE + 1] = {0};
+	struct no_os_spi_msg xfer[NO_OS_ARRAY_SIZE(regs)] = {0};
+	uint32_t frame_size = MAX22196_FRAME_SIZE;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !scan)
+		return -EINVAL;
+
+	if (desc->crc_en)
+		frame_size++;
+
+	for (i = 0; i < NO_OS_ARRAY_SIZE(regs); i++) {
+		frames[i][0] = no_os_field_prep(MAX22196_ADDR_MASK,
+						desc->chip_address) |
+			       no_os_field_prep(MAX22196_REG_ADDR_MASK,
+						regs[i]) |
+			       no_os_field_prep(MAX22196_RW_MASK, 0);
+
+		if (desc->crc_en)
+			frames[i][2] = max22196_crc(frames[i], true);
+
+		xfer[i].tx_buff = frames[i];
+		xfer[i].rx_buff = frames[i];
+		xfer[i].bytes_number = frame_size;
+		xfer[i].cs_change = 1;
+	}
+
+	ret = no_os_spi_transfer(desc->comm_desc, xfer, NO_OS_ARRAY_SIZE(regs));
+	if (ret)
+		return ret;
+
+	if (desc->crc_en) {
+		for (i = 0; i < NO_OS_ARRAY_SIZE(regs); i++)
+			if (max22196_crc(frames[i], false) != frames[i][2])
+				return -EINVAL;
+	}
+
+	scan->di_state = frames[0][1];
+	scan->fault1 = frames[1][1];
+	scan->fault2 = frames[2][1];
+
+	return 0;
+}
+
 /**
  * @brief - MAX22196 register update function
  * @param desc - The device descriptor for MAX22196.
@@ -143,6 +143,15 @@ struct max22196_init_param {
 	enum max22196_chip_id chip_id;
 };
 
+/**
+ * @brief Snapshot of the input states and fault registers.
+ */
+struct max22196_scan {
+	uint8_t di_state;
+	uint8_t fault1;
+	uint8_t fault2;
+};
+
 struct max22196_desc {
 	uint32_t chip_address;
 	struct no_os_spi_desc *comm_desc;
@@ -160,6 +169,9 @@ int max22196_reg_write(struct max22196_desc *, uint32_t, uint32_t);
 /** Register read function for MAX22196. */
 int max22196_reg_read(struct max22196_desc *, uint32_t, uint32_t *);
 
+/** Read the input states and fault registers in one transfer. */
+int max22196_scan(struct max22196_desc *, struct max22196_scan *);
+
 /** Register update function for MAX22196. */
 int max22196_reg_update(struct max22196_desc *, uint32_t, uint32_t, uint32_t);
 
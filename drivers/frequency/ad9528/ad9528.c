@@ -43,6 +43,7 @@
 #include <stdlib.h>
 #include <limits.h>
 #include <stdio.h>
+#include <string.h>
 #include "no_os_print_log.h"
 #include "no_os_alloc.h"
 #include "no_os_error.h"
@@ -1288,6 +1289,135 @@ out:
 	return 0;
 }
 
+/***************************************************************************//**
+ * @brief Queue a single byte register write as one message of a transfer.
+ *
+ * @param msg - The message to fill.
+ * @param buf - 3-byte buffer backing the message.
+ * @param reg_addr - The address of the register.
+ * @param reg_data - The value to write to the register.
+*******************************************************************************/
+static void ad9528_queue_write(struct no_os_spi_msg *msg, uint8_t *buf,
+			       uint32_t reg_addr, uint8_t reg_data)
+{
+	buf[0] = AD9528_ADDR(reg_addr) >> 8;
+	buf[1] = AD9528_ADDR(reg_addr) & 0xFF;
+	buf[2] = reg_data;
+
+	msg->tx_buff = buf;
+	msg->rx_buff = buf;
+	msg->bytes_number = 3;
+	msg->cs_change = 1;
+}
+
+/***************************************************************************//**
+ * @brief Reconfigure the divider and phase of a set of outputs at once.
+ *
+ * The channel output registers spanning the requested channels are read
+ * into a shadow map with one streaming read, patched, and written back with
+ * one streaming write (descending address, as after reset). The new values
+ * are latched by the same IO update that asserts the channel SYNC, so all
+ * outputs restart together once SYNC is released.
+ *
+ * @param dev - The device structure.
+ * @param cfg - Channel changes. SYSREF sourced outputs are rejected, their
+ *              rate is set by the K divider.
+ * @param n - Number of entries in cfg.
+ *
+ * @return Returns 0 in case of success or negative error code.
+*******************************************************************************/
+int32_t ad9528_clk_reconfig(struct ad9528_dev *dev,
+			    const struct ad9528_chan_cfg *cfg, uint32_t n)
+{
+	uint8_t shadow[2 + 3 * AD9528_NUM_CHAN];
+	uint8_t sync_buf[4][3];
+	struct no_os_spi_msg msgs[5] = {0};
+	struct ad9528_channel_spec *spec;
+	uint32_t lo = AD9528_NUM_CHAN;
+	uint32_t top, len, reg_val;
+	uint8_t *data;
+	uint32_t hi = 0;
+	uint32_t i, j;
+	int32_t ret;
+
+	if (!dev || !cfg || !n)
+		return -EINVAL;
+
+	for (i = 0; i < n; i++) {
+		if (cfg[i].channel_num >= AD9528_NUM_CHAN ||
+		    cfg[i].channel_divider < AD9528_CLK_DIST_DIV_MIN ||
+		    cfg[i].channel_divider > AD9528_CLK_DIST_DIV_MAX ||
+		    cfg[i].divider_phase > 63)
+			return -EINVAL;
+
+		for (j = 0; j < dev->pdata->num_channels; j++) {
+			spec = &dev->pdata->channels[j];
+			if (spec->channel_num == cfg[i].channel_num &&
+			    spec->signal_source == AD9528_SYSREF)
+				return -EINVAL;
+		}
+
+		lo = no_os_min(lo, cfg[i].channel_num);
+		hi = no_os_max(hi, cfg[i].channel_num);
+	}
+
+	/* Highest byte of the span first, the address then auto-decrements */
+	top = AD9528_ADDR(AD9528_CHANNEL_OUTPUT(hi));
+	len = 3 * (hi - lo + 1);
+	data = &shadow[2];
+
+	shadow[0] = 0x80 | (top >> 8);
+	shadow[1] = top & 0xFF;
+	memset(data, 0, len);
+	ret = no_os_spi_write_and_read(dev->spi_desc, shadow, len + 2);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < n; i++) {
+		j = 3 * (hi - cfg[i].channel_num);
+		reg_val = (data[j] << 16) | (data[j + 1] << 8) | data[j + 2];
+
+		reg_val &= ~(AD9528_CLK_DIST_DIV_MASK |
+			     AD9528_CLK_DIST_DIV_PHASE(0x3F));
+		reg_val |= AD9528_CLK_DIST_DIV(cfg[i].channel_divider);
+		reg_val |= AD9528_CLK_DIST_DIV_PHASE(cfg[i].divider_phase);
+
+		data[j] = reg_val >> 16;
+		data[j + 1] = reg_val >> 8;
+		data[j + 2] = reg_val;
+	}
+
+	shadow[0] = top >> 8;
+	msgs[0].tx_buff = shadow;
+	msgs[0].rx_buff = shadow;
+	msgs[0].bytes_number = len + 2;
+	msgs[0].cs_change = 1;
+
+	ad9528_queue_write(&msgs[1], sync_buf[0], AD9528_CHANNEL_SYNC,
+			   AD9528_CHANNEL_SYNC_SET);
+	ad9528_queue_write(&msgs[2], sync_buf[1], AD9528_IO_UPDATE,
+			   AD9528_IO_UPDATE_EN);
+	ad9528_queue_write(&msgs[3], sync_buf[2], AD9528_CHANNEL_SYNC, 0);
+	ad9528_queue_write(&msgs[4], sync_buf[3], AD9528_IO_UPDATE,
+			   AD9528_IO_UPDATE_EN);
+
+	ret = no_os_spi_transfer(dev->spi_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+	if (ret)
+		return ret;
+
+	for (i = 0; i < n; i++) {
+		for (j = 0; j < dev->pdata->num_channels; j++) {
+			spec = &dev->pdata->channels[j];
+			if (spec->channel_num != cfg[i].channel_num)
+				continue;
+			spec->channel_divider = cfg[i].channel_divider;
+			spec->divider_phase = cfg[i].divider_phase;
+		}
+	}
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Performs a hard reset on the AD9528.
  *
@@ -353,6 +353,19 @@ struct ad9528_channel_spec {
 	int8_t   extended_name[16];
 };
 
+/**
+ * @struct ad9528_chan_cfg
+ * @brief One output change of a batched ad9528_clk_reconfig() call.
+ */
+struct ad9528_chan_cfg {
+	/** Output channel number. */
+	uint8_t	 channel_num;
+	/** Divider initial phase after a SYNC. Range 0..63 */
+	uint8_t	 divider_phase;
+	/** Channel divider. Range 1..256 */
+	uint16_t channel_divider;
+};
+
 /**
  * @struct ad9528_platform_data
  * @brief platform specific information
@@ -543,6 +556,8 @@ uint32_t ad9528_clk_round_rate(struct ad9528_dev *dev, uint32_t chan,
 			       uint32_t rate);
 int32_t ad9528_clk_set_rate(struct ad9528_dev *dev, uint32_t chan,
 			    uint32_t rate);
+int32_t ad9528_clk_reconfig(struct ad9528_dev *dev,
+			    const struct ad9528_chan_cfg *cfg, uint32_t n);
 int32_t ad9528_reset(struct ad9528_dev *dev);
 int32_t ad9528_remove(struct ad9528_dev *dev);
 
@@ -42,6 +42,7 @@
 /******************************************************************************/
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <limits.h>
 #include "no_os_print_log.h"
 #include "no_os_error.h"
@@ -264,6 +265,9 @@
 #define HMC7044_OUT_DIV_MIN	1
 #define HMC7044_OUT_DIV_MAX	4094
 
+/* Output control registers rewritten per channel on a reconfiguration */
+#define HMC7044_RECONFIG_REGS	4
+
 
 static const char* const pll1_fsm_states[] = {
 	"Reset",
@@ -485,6 +489,149 @@ int32_t hmc7044_clk_set_rate(struct hmc7044_dev *dev, uint32_t chan_num,
 			     HMC7044_DIV_MSB(div));
 }
 
+/**
+ * Queue a single register write as one message of a batched transfer.
+ * @param msg - The message to fill.
+ * @param buf - 3-byte buffer backing the message.
+ * @param reg - The register address.
+ * @param val - The register data.
+ */
+static void hmc7044_queue_write(struct no_os_spi_msg *msg, uint8_t *buf,
+				uint16_t reg, uint8_t val)
+{
+	uint16_t cmd;
+
+	cmd = HMC7044_WRITE | HMC7044_CNT(1) | HMC7044_ADDR(reg);
+	buf[0] = cmd >> 8;
+	buf[1] = cmd & 0xFF;
+	buf[2] = val;
+
+	msg->tx_buff = buf;
+	msg->rx_buff = buf;
+	msg->bytes_number = 3;
+	msg->cs_change = 1;
+}
+
+/**
+ * Reconfigure the divider and delays of a set of output channels at once.
+ *
+ * The changes are first staged in a shadow copy of the channel specs, so a
+ * bad entry leaves the device untouched. The output control registers of all
+ * channels are then sent as one SPI transfer, closed by a single divider FSM
+ * restart which brings every output back phase aligned. The HMC7044 does not
+ * support multi-byte access, hence one message per register.
+ * @param dev - The device structure.
+ * @param cfg - Channel changes.
+ * @param n - Number of entries in cfg.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t hmc7044_clk_reconfig(struct hmc7044_dev *dev,
+			     const struct hmc7044_chan_cfg *cfg, uint32_t n)
+{
+	struct hmc7044_chan_spec *shadow, *chan;
+	struct no_os_spi_msg *msgs;
+	uint32_t nb_msgs = 0;
+	uint8_t req_mode = 0;
+	uint8_t *buf;
+	uint32_t i, j;
+	int32_t ret;
+
+	if (!dev || !cfg || !n || n > HMC7044_NUM_CHAN)
+		return -EINVAL;
+
+	shadow = no_os_calloc(dev->num_channels, sizeof(*shadow));
+	if (!shadow)
+		return -ENOMEM;
+
+	msgs = no_os_calloc(n * HMC7044_RECONFIG_REGS + 2, sizeof(*msgs));
+	if (!msgs) {
+		ret = -ENOMEM;
+		goto free_shadow;
+	}
+
+	buf = no_os_calloc(n * HMC7044_RECONFIG_REGS + 2, 3);
+	if (!buf) {
+		ret = -ENOMEM;
+		goto free_msgs;
+	}
+
+	memcpy(shadow, dev->channels, dev->num_channels * sizeof(*shadow));
+
+	for (i = 0; i < n; i++) {
+		if (cfg[i].divider < HMC7044_OUT_DIV_MIN ||
+		    cfg[i].divider > HMC7044_OUT_DIV_MAX ||
+		    cfg[i].coarse_delay > 0x1F || cfg[i].fine_delay > 0x1F) {
+			ret = -EINVAL;
+			goto free_buf;
+		}
+
+		chan = NULL;
+		for (j = 0; j < dev->num_channels; j++) {
+			if (shadow[j].num == cfg[i].num && !shadow[j].disable) {
+				chan = &shadow[j];
+				break;
+			}
+		}
+		if (!chan || chan->num >= HMC7044_NUM_CHAN) {
+			ret = -EINVAL;
+			goto free_buf;
+		}
+
+		chan->divider = cfg[i].divider;
+		chan->coarse_delay = cfg[i].coarse_delay;
+		chan->fine_delay = cfg[i].fine_delay;
+
+		hmc7044_queue_write(&msgs[nb_msgs], &buf[3 * nb_msgs],
+				    HMC7044_REG_CH_OUT_CRTL_1(chan->num),
+				    HMC7044_DIV_LSB(chan->divider));
+		nb_msgs++;
+		hmc7044_queue_write(&msgs[nb_msgs], &buf[3 * nb_msgs],
+				    HMC7044_REG_CH_OUT_CRTL_2(chan->num),
+				    HMC7044_DIV_MSB(chan->divider));
+		nb_msgs++;
+		hmc7044_queue_write(&msgs[nb_msgs], &buf[3 * nb_msgs],
+				    HMC7044_REG_CH_OUT_CRTL_3(chan->num),
+				    chan->fine_delay);
+		nb_msgs++;
+		hmc7044_queue_write(&msgs[nb_msgs], &buf[3 * nb_msgs],
+				    HMC7044_REG_CH_OUT_CRTL_4(chan->num),
+				    chan->coarse_delay);
+		nb_msgs++;
+	}
+
+	if (dev->read_write_confirmed) {
+		ret = hmc7044_read(dev, HMC7044_REG_REQ_MODE_0, &req_mode);
+		if (ret)
+			goto free_buf;
+	}
+
+	hmc7044_queue_write(&msgs[nb_msgs], &buf[3 * nb_msgs],
+			    HMC7044_REG_REQ_MODE_0,
+			    req_mode | HMC7044_RESTART_DIV_FSM);
+	nb_msgs++;
+	hmc7044_queue_write(&msgs[nb_msgs], &buf[3 * nb_msgs],
+			    HMC7044_REG_REQ_MODE_0,
+			    req_mode & ~HMC7044_RESTART_DIV_FSM);
+	nb_msgs++;
+
+	ret = no_os_spi_transfer(dev->spi_desc, msgs, nb_msgs);
+	if (ret)
+		goto free_buf;
+
+	no_os_udelay(10000);
+
+	memcpy(dev->channels, shadow, dev->num_channels * sizeof(*shadow));
+
+free_buf:
+	no_os_free(buf);
+free_msgs:
+	no_os_free(msgs);
+free_shadow:
+	no_os_free(shadow);
+
+	return ret;
+}
+
 static int hmc7044_info(struct hmc7044_dev *dev)
 {
 	uint32_t clkin_freq, active;
@@ -67,6 +67,14 @@ struct hmc7044_chan_spec {
 	unsigned int	out_mux_mode;
 };
 
+/* One output change of a batched hmc7044_clk_reconfig() call. */
+struct hmc7044_chan_cfg {
+	unsigned int	num;
+	unsigned int	divider;
+	unsigned int	coarse_delay;
+	unsigned int	fine_delay;
+};
+
 struct hmc7044_dev {
 	struct no_os_spi_desc	*spi_desc;
 	/* CLK descriptors */
@@ -179,5 +187,8 @@ int32_t hmc7044_clk_round_rate(struct hmc7044_dev *dev, uint32_t rate,
 			       uint64_t *rounded_rate);
 int32_t hmc7044_clk_set_rate(struct hmc7044_dev *dev, uint32_t chan_num,
 			     uint64_t rate);
+/* Reconfigure several outputs with a single synchronised restart. */
+int32_t hmc7044_clk_reconfig(struct hmc7044_dev *dev,
+			     const struct hmc7044_chan_cfg *cfg, uint32_t n);
 
 #endif // HMC7044_H_
@@ -45,11 +45,13 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <string.h>
 #include "ltc6953.h"
 #include "no_os_spi.h"
 #include "no_os_error.h"
 #include "no_os_util.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 
 static const uint8_t LTC6953_LUT[2][LTC6953_NUM_REGADDR] = {
 	{
@@ -245,25 +247,20 @@ int ltc6953_power_down_vco(struct ltc6953_dev *dev, bool is_pwdn)
 }
 
 /**
- * @brief Set output divider for LTC6953 output channel
- * @param dev - The device structure.
- * @param channel - Output channel [0-10]
+ * @brief Compute the output divider register value (MP and MD fields).
  * @param divider - Divider setting
- * @return Returns 0 in case of success or negative error code.
+ * @param writeval - The OUTPUT_DIVIDER register value.
+ * @return Returns 0 in case of success, -EINVAL if the divider is not
+ *         reachable.
  */
-int ltc6953_set_output_divider(struct ltc6953_dev *dev, uint32_t channel,
-			       uint32_t divider)
+static int ltc6953_calc_divider(uint32_t divider, uint8_t *writeval)
 {
 	/*
 	 * Mx = (MPx + 1) * 2**MDx
 	 * */
-	int mp, md;
-	uint8_t writeval;
+	int mp = -1, md = 0;
 	uint32_t out_divider;
 
-	if (channel > 10)
-		return -EINVAL;
-
 	for (int i = 0; i < 32; i++) {
 		if (divider == (i + 1)) {
 			mp = i;
@@ -284,8 +281,34 @@ int ltc6953_set_output_divider(struct ltc6953_dev *dev, uint32_t channel,
 		}
 	}
 
-	writeval = no_os_field_prep(LTC6953_MP_MSK, mp) |
-		   no_os_field_prep(LTC6953_MD_MSK, md);
+	if (mp < 0)
+		return -EINVAL;
+
+	*writeval = no_os_field_prep(LTC6953_MP_MSK, mp) |
+		    no_os_field_prep(LTC6953_MD_MSK, md);
+
+	return 0;
+}
+
+/**
+ * @brief Set output divider for LTC6953 output channel
+ * @param dev - The device structure.
+ * @param channel - Output channel [0-10]
+ * @param divider - Divider setting
+ * @return Returns 0 in case of success or negative error code.
+ */
+int ltc6953_set_output_divider(struct ltc6953_dev *dev, uint32_t channel,
+			       uint32_t divider)
+{
+	uint8_t writeval;
+	int ret;
+
+	if (channel > 10)
+		return -EINVAL;
+
+	ret = ltc6953_calc_divider(divider, &writeval);
+	if (ret)
+		return ret;
 
 	return ltc6953_write(dev, LTC6953_REG_OUTPUT_DIVIDER(channel), writeval);
 }
@@ -607,3 +630,96 @@ int ltc6953_read_part(struct ltc6953_dev *dev, uint8_t *part)
 
 	return 0;
 }
+
+/**
+ * @brief Reconfigure divider and delays of a set of outputs at once.
+ *
+ * The SYNC_CONFIG register and the output register block spanning the
+ * requested channels are read into a shadow map with one auto-incrementing
+ * read. The changes are applied to the shadow and written back with one
+ * auto-incrementing write, queued in the same transfer as the SSRQ assertion.
+ * SSRQ is released after the minimum 1 ms pulse width, so every output with
+ * SRQEN set restarts aligned.
+ * @param dev - The device structure.
+ * @param cfg - Channel changes.
+ * @param n - Number of entries in cfg.
+ * @return Returns 0 in case of success or negative error code.
+ */
+int ltc6953_reconfig(struct ltc6953_dev *dev,
+		     const struct ltc6953_chan_cfg *cfg, uint32_t n)
+{
+	uint8_t shadow[2 + 4 * LTC6953_NUM_CHAN];
+	uint8_t ssrq[LTC6953_BUFF_SIZE_BYTES];
+	struct no_os_spi_msg msgs[2] = {0};
+	uint8_t divval[LTC6953_NUM_CHAN];
+	uint8_t sync_config, *data;
+	uint32_t hi = 0;
+	uint32_t i, len;
+	int ret;
+
+	if (!dev || !cfg || !n || n > LTC6953_NUM_CHAN)
+		return -EINVAL;
+
+	for (i = 0; i < n; i++) {
+		if (cfg[i].num >= LTC6953_NUM_CHAN ||
+		    cfg[i].digital_delay > 4095 || cfg[i].analog_delay > 63)
+			return -EINVAL;
+
+		ret = ltc6953_calc_divider(cfg[i].divider, &divval[i]);
+		if (ret)
+			return ret;
+
+		hi = no_os_max(hi, cfg[i].num);
+	}
+
+	/* SYNC_CONFIG directly precedes the output block of channel 0 */
+	len = 1 + 4 * (hi + 1);
+	memset(shadow, 0, len + 1);
+	shadow[0] = LTC6953_SPI_ADDR_CMD(LTC6953_REG_SYNC_CONFIG) |
+		    LTC6953_SPI_READ_CMD;
+	ret = no_os_spi_write_and_read(dev->spi_desc, shadow, len + 1);
+	if (ret)
+		return ret;
+
+	sync_config = shadow[1];
+	data = &shadow[2];
+
+	for (i = 0; i < n; i++) {
+		data[4 * cfg[i].num] = divval[i];
+		data[4 * cfg[i].num + 1] &= ~LTC6953_DDEL_HIGH_MSK;
+		data[4 * cfg[i].num + 1] |=
+			no_os_field_prep(LTC6953_DDEL_HIGH_MSK,
+					 cfg[i].digital_delay >> 8);
+		data[4 * cfg[i].num + 2] =
+			no_os_field_prep(LTC6953_DDEL_LOW_MSK,
+					 cfg[i].digital_delay);
+		data[4 * cfg[i].num + 3] &= ~LTC6953_ADEL_MSK;
+		data[4 * cfg[i].num + 3] |=
+			no_os_field_prep(LTC6953_ADEL_MSK, cfg[i].analog_delay);
+	}
+
+	/* Reuse the byte before the output block for the write command */
+	shadow[1] = LTC6953_SPI_ADDR_CMD(LTC6953_REG_OUTPUT_DIVIDER(0)) |
+		    LTC6953_SPI_WRITE_CMD;
+	msgs[0].tx_buff = &shadow[1];
+	msgs[0].rx_buff = &shadow[1];
+	msgs[0].bytes_number = len;
+	msgs[0].cs_change = 1;
+
+	ssrq[0] = LTC6953_SPI_ADDR_CMD(LTC6953_REG_SYNC_CONFIG) |
+		  LTC6953_SPI_WRITE_CMD;
+	ssrq[1] = sync_config | LTC6953_SSRQ_MSK;
+	msgs[1].tx_buff = ssrq;
+	msgs[1].rx_buff = ssrq;
+	msgs[1].bytes_number = LTC6953_BUFF_SIZE_BYTES;
+	msgs[1].cs_change = 1;
+
+	ret = no_os_spi_transfer(dev->spi_desc, msgs, NO_OS_ARRAY_SIZE(msgs));
+	if (ret)
+		return ret;
+
+	no_os_mdelay(1);
+
+	return ltc6953_write(dev, LTC6953_REG_SYNC_CONFIG,
+			     sync_config & ~LTC6953_SSRQ_MSK);
+}
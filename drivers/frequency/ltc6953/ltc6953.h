@@ -156,6 +156,17 @@ struct ltc6953_channel_spec {
 	int8_t   	extended_name[16];
 };
 
+/**
+ * @struct ltc6953_chan_cfg
+ * @brief One output change of a batched ltc6953_reconfig() call
+ */
+struct ltc6953_chan_cfg {
+	uint8_t		num;
+	uint32_t	divider;
+	uint16_t	digital_delay;
+	uint8_t		analog_delay;
+};
+
 /**
  * @struct ltc6953_init_param
  * @brief LTC6953 Initialization Parameters structure.
@@ -277,4 +288,8 @@ int ltc6953_read_rev(struct ltc6953_dev *dev, uint8_t *rev);
 /** LTC6953 Get Part Number **/
 int ltc6953_read_part(struct ltc6953_dev *dev, uint8_t *part);
 
+/** LTC6953 Batched output reconfiguration with a single SSRQ restart **/
+int ltc6953_reconfig(struct ltc6953_dev *dev,
+		     const struct ltc6953_chan_cfg *cfg, uint32_t n);
+
 #endif // __LTC6953_H__
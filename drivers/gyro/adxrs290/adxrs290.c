@@ -45,6 +45,7 @@
 #include <string.h>
 #include "no_os_error.h"
 #include "no_os_alloc.h"
+#include "no_os_delay.h"
 #include "adxrs290.h"
 
 /******************************************************************************/
@@ -244,11 +245,41 @@ int32_t adxrs290_get_temp_data(struct adxrs290_dev *dev, int16_t *temp)
 		return ret;
 
 	*temp = ((((int16_t)data[2]) << 8) | data[1]) & 0x0FFF;
-	*temp = (*temp << 4) >> 4;
+	*temp = (int16_t)(*temp << 4) >> 4;
 
 	return ret;
 }
 
+/**
+ * @brief Read the X, Y and temperature data in a single transfer. The
+ *        register address auto-increments after the first data byte.
+ * @param dev - Device handler.
+ * @param data - X, Y rate and sign extended temperature.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adxrs290_burst_read(struct adxrs290_dev *dev,
+				   int16_t data[ADXRS290_CHANNEL_COUNT])
+{
+	uint8_t buff[ADXRS290_BURST_LEN + 1] = {
+		ADXRS290_READ_REG(ADXRS290_REG_DATAX0)
+	};
+	uint8_t i;
+	int32_t ret;
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, buff, sizeof(buff));
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	for (i = 0; i < ADXRS290_CHANNEL_COUNT; i++)
+		data[i] = (int16_t)no_os_get_unaligned_le16(&buff[2 * i + 1]);
+
+	/* Sign extend the 12-bit temperature */
+	data[ADXRS290_CHANNEL_TEMP] =
+		(int16_t)(data[ADXRS290_CHANNEL_TEMP] << 4) >> 4;
+
+	return 0;
+}
+
 /**
  * @brief Get the burst data.
  * @param dev - Device handler.
@@ -259,35 +290,251 @@ int32_t adxrs290_get_temp_data(struct adxrs290_dev *dev, int16_t *temp)
 int32_t adxrs290_get_burst_data(struct adxrs290_dev *dev, int16_t *burst_data,
 				uint8_t *ch_cnt)
 {
-	int32_t		ret = 0;
-	uint8_t		data_bytes = ADXRS290_CHANNEL_COUNT*2;
-	uint8_t		data[data_bytes + 1];
-	int16_t		result;
+	int16_t		data[ADXRS290_CHANNEL_COUNT];
+	int32_t		ret;
 	uint8_t		ch_idx;
-	uint8_t		i;
 
-	for (i = 0; i < data_bytes; i++)
-		data[i] = 0x80 | (ADXRS290_REG_DATAX0 + i);
+	ret = adxrs290_burst_read(dev, data);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
 
-	data[data_bytes] = 0;
+	*ch_cnt = 0;
+	for (ch_idx = 0; ch_idx < ADXRS290_CHANNEL_COUNT; ch_idx++)
+		if ((1 << ch_idx) & dev->ch_mask)
+			burst_data[(*ch_cnt)++] = data[ch_idx];
+
+	return ret;
+}
+
+/**
+ * @brief Advance the rate integrator with a new sample.
+ * @param dev - Device handler.
+ * @param sample - New sample.
+ */
+static void adxrs290_integrate(struct adxrs290_dev *dev,
+			       const struct adxrs290_sample *sample)
+{
+	int64_t dt;
+	uint8_t i;
+
+	if (dev->last_ts) {
+		dt = sample->timestamp_us - dev->last_ts;
+		for (i = 0; i < NO_OS_ARRAY_SIZE(dev->angle); i++)
+			dev->angle[i] += ((int32_t)dev->last_rate[i] +
+					  sample->data[i]) * dt;
+	}
+
+	dev->last_rate[0] = sample->data[ADXRS290_CHANNEL_X];
+	dev->last_rate[1] = sample->data[ADXRS290_CHANNEL_Y];
+	dev->last_ts = sample->timestamp_us;
+}
+
+/**
+ * @brief Read all channels in a single burst and timestamp them. The rate
+ *        integrator, if enabled, is updated with the new data.
+ * @param dev - Device handler.
+ * @param sample - Pointer to the sample container.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_read_sample(struct adxrs290_dev *dev,
+			     struct adxrs290_sample *sample)
+{
+	struct no_os_time t;
+	int32_t ret;
 
-	ret = no_os_spi_write_and_read(dev->spi_desc, data, data_bytes + 1);
+	if (!dev || !sample)
+		return -EINVAL;
+
+	ret = adxrs290_burst_read(dev, sample->data);
 	if (NO_OS_IS_ERR_VALUE(ret))
 		return ret;
 
-	i = 1;
-	*ch_cnt = 0;
-	for (ch_idx = 0; ch_idx < ADXRS290_CHANNEL_COUNT; ch_idx++) {
-		result = (((int16_t)data[i+1]) << 8) | data[i];
-		i += 2;
-		if (ch_idx == ADXRS290_CHANNEL_TEMP)
-			result = (result << 4) >> 4;
+	t = no_os_get_time();
+	sample->timestamp_us = (uint64_t)t.s * 1000000 + t.us;
 
-		if ((1 << ch_idx) & dev->ch_mask)
-			burst_data[(*ch_cnt)++] = result;
+	if (dev->integrate)
+		adxrs290_integrate(dev, sample);
+
+	return 0;
+}
+
+/**
+ * @brief Data ready interrupt handler, stores the new sample in the ring.
+ * @param ctx - Device handler.
+ */
+static void adxrs290_rdy_irq_handler(void *ctx)
+{
+	struct adxrs290_dev *dev = ctx;
+	struct adxrs290_sample dropped;
+	uint32_t head = dev->ring_head;
+	uint32_t next = (head + 1) % ADXRS290_RING_SIZE;
+
+	if (next == dev->ring_tail) {
+		dev->overruns++;
+		/*
+		 * Still read it, the sync pin stays high until the data is read
+		 * and the integrator needs every sample.
+		 */
+		adxrs290_read_sample(dev, &dropped);
+		return;
 	}
 
-	return ret;
+	if (adxrs290_read_sample(dev, &dev->ring[head]))
+		return;
+
+	dev->ring_head = next;
+}
+
+/**
+ * @brief Start the data ready driven acquisition. If the interrupt
+ *        controller was provided, the samples are read by the interrupt
+ *        handler and queued until adxrs290_get_sample() is called.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_start_continuous(struct adxrs290_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	ret = adxrs290_set_op_mode(dev, ADXRS290_MODE_MEASUREMENT);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	dev->ring_head = 0;
+	dev->ring_tail = 0;
+	dev->overruns = 0;
+	dev->continuous = true;
+
+	if (!dev->irq_ctrl)
+		return 0;
+
+	return no_os_irq_enable(dev->irq_ctrl, dev->gpio_sync->number);
+}
+
+/**
+ * @brief Stop the data ready driven acquisition. The device is left in
+ *        measurement mode.
+ * @param dev - Device handler.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_stop_continuous(struct adxrs290_dev *dev)
+{
+	int32_t ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	if (dev->irq_ctrl) {
+		ret = no_os_irq_disable(dev->irq_ctrl, dev->gpio_sync->number);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	dev->continuous = false;
+
+	return 0;
+}
+
+/**
+ * @brief Get the next sample of the continuous acquisition. With the data
+ *        ready interrupt the oldest queued sample is returned without any
+ *        bus access, otherwise the sync pin, if any, is polled first.
+ * @param dev - Device handler.
+ * @param sample - Pointer to the sample container.
+ * @return 0 in case of success, -EAGAIN if no sample is queued yet,
+ *         negative error code otherwise.
+ */
+int32_t adxrs290_get_sample(struct adxrs290_dev *dev,
+			    struct adxrs290_sample *sample)
+{
+	uint32_t tail;
+	int32_t ret;
+	bool rdy;
+
+	if (!dev || !sample || !dev->continuous)
+		return -EINVAL;
+
+	if (dev->irq_ctrl) {
+		tail = dev->ring_tail;
+		if (tail == dev->ring_head)
+			return -EAGAIN;
+
+		*sample = dev->ring[tail];
+		dev->ring_tail = (tail + 1) % ADXRS290_RING_SIZE;
+
+		return 0;
+	}
+
+	if (dev->gpio_sync) {
+		do {
+			ret = adxrs290_get_data_ready(dev, &rdy);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				return ret;
+		} while (!rdy);
+	}
+
+	return adxrs290_read_sample(dev, sample);
+}
+
+/**
+ * @brief Enable or disable the rate integrator. Enabling it restarts the
+ *        integration from a zero angle at the next sample.
+ * @param dev - Device handler.
+ * @param enable - New state of the integrator.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_integrator_enable(struct adxrs290_dev *dev, bool enable)
+{
+	if (!dev)
+		return -EINVAL;
+
+	if (dev->irq_ctrl && dev->continuous)
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_sync->number);
+
+	dev->angle[0] = 0;
+	dev->angle[1] = 0;
+	dev->last_ts = 0;
+	dev->integrate = enable;
+
+	if (dev->irq_ctrl && dev->continuous)
+		no_os_irq_enable(dev->irq_ctrl, dev->gpio_sync->number);
+
+	return 0;
+}
+
+/**
+ * @brief Get the angle integrated from the X or Y rate since the integrator
+ *        was enabled. The integrator is fed by adxrs290_read_sample(), so
+ *        its accuracy depends on the samples being read at the output rate.
+ * @param dev - Device handler.
+ * @param ch - X or Y channel.
+ * @param angle_udeg - Pointer to the angle, in microdegrees.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t adxrs290_get_angle(struct adxrs290_dev *dev, enum adxrs290_channel ch,
+			   int64_t *angle_udeg)
+{
+	int64_t angle;
+
+	if (!dev || !angle_udeg || ch > ADXRS290_CHANNEL_Y)
+		return -EINVAL;
+
+	/* The accumulator may be updated from the data ready interrupt */
+	if (dev->irq_ctrl && dev->continuous)
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_sync->number);
+
+	angle = dev->angle[ch];
+
+	if (dev->irq_ctrl && dev->continuous)
+		no_os_irq_enable(dev->irq_ctrl, dev->gpio_sync->number);
+
+	/* 2 * LSB * us to microdegrees */
+	*angle_udeg = angle / (2 * ADXRS290_RATE_LSB_PER_DPS);
+
+	return 0;
 }
 
 /**
@@ -329,6 +576,44 @@ int32_t adxrs290_get_data_ready(struct adxrs290_dev *dev, bool *rdy)
 	return ret;
 }
 
+/**
+ * @brief Register the data ready interrupt handler on the sync pin. The
+ *        interrupt is enabled only while the continuous mode is running.
+ * @param dev - Device handler.
+ * @param irq_ctrl - Interrupt controller of the sync pin.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t adxrs290_rdy_init(struct adxrs290_dev *dev,
+				 struct no_os_irq_ctrl_desc *irq_ctrl)
+{
+	int32_t ret;
+
+	dev->irq_cb = (struct no_os_callback_desc) {
+		.callback = adxrs290_rdy_irq_handler,
+		.ctx = dev,
+		.event = NO_OS_EVT_GPIO,
+		.peripheral = NO_OS_GPIO_IRQ,
+	};
+
+	ret = no_os_irq_register_callback(irq_ctrl, dev->gpio_sync->number,
+					  &dev->irq_cb);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	/* The sync pin goes high on new data and low once it is read */
+	ret = no_os_irq_trigger_level_set(irq_ctrl, dev->gpio_sync->number,
+					  NO_OS_IRQ_EDGE_RISING);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		no_os_irq_unregister_callback(irq_ctrl, dev->gpio_sync->number,
+					      &dev->irq_cb);
+		return ret;
+	}
+
+	dev->irq_ctrl = irq_ctrl;
+
+	return 0;
+}
+
 /**
  * Initialize the device.
  * @param device - The device structure.
@@ -343,7 +628,7 @@ int32_t adxrs290_init(struct adxrs290_dev **device,
 	int32_t ret = 0;
 	uint8_t val = 0;
 
-	dev = (struct adxrs290_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct adxrs290_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
 
@@ -383,13 +668,19 @@ int32_t adxrs290_init(struct adxrs290_dev **device,
 		ret = no_os_gpio_direction_input(dev->gpio_sync);
 		if (NO_OS_IS_ERR_VALUE(ret))
 			goto error_gpio;
+
+		if (init_param->irq_ctrl) {
+			ret = adxrs290_rdy_init(dev, init_param->irq_ctrl);
+			if (NO_OS_IS_ERR_VALUE(ret))
+				goto error_gpio;
+		}
 	}
 
 	// Set adxrs290 to output on sync pin.
 	ret = adxrs290_reg_write(dev, ADXRS290_REG_DATA_READY,
 				 ADXRS290_DATA_RDY_OUT);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto error_gpio;
+		goto error_irq;
 
 	// Enable all channels by default
 	dev->ch_mask = ADXRS290_CHANNEL_MASK;
@@ -398,6 +689,11 @@ int32_t adxrs290_init(struct adxrs290_dev **device,
 
 	return ret;
 
+error_irq:
+	if (dev->irq_ctrl)
+		no_os_irq_unregister_callback(dev->irq_ctrl,
+					      dev->gpio_sync->number,
+					      &dev->irq_cb);
 error_gpio:
 	no_os_gpio_remove(dev->gpio_sync);
 
@@ -417,6 +713,12 @@ error_dev:
  */
 int32_t adxrs290_remove(struct adxrs290_dev *dev)
 {
+	if (dev->irq_ctrl) {
+		no_os_irq_disable(dev->irq_ctrl, dev->gpio_sync->number);
+		no_os_irq_unregister_callback(dev->irq_ctrl,
+					      dev->gpio_sync->number,
+					      &dev->irq_cb);
+	}
 	no_os_spi_remove(dev->spi_desc);
 	no_os_gpio_remove(dev->gpio_sync);
 	no_os_free(dev);
@@ -47,6 +47,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include "no_os_gpio.h"
+#include "no_os_irq.h"
 #include "no_os_spi.h"
 #include "no_os_util.h"
 
@@ -95,6 +96,13 @@
 #define ADXRS290_MAX_TRANSITION_TIME_MS 100
 #define ADXRS290_CHANNEL_COUNT			3
 #define ADXRS290_CHANNEL_MASK			0x07
+
+/* X, Y and temperature data registers, read in a single burst */
+#define ADXRS290_BURST_LEN	(ADXRS290_REG_TEMP1 - ADXRS290_REG_DATAX0 + 1)
+/* Number of samples buffered by the data ready interrupt handler */
+#define ADXRS290_RING_SIZE			32u
+/* Angular velocity scale, 1 LSB = 0.005 degrees/sec */
+#define ADXRS290_RATE_LSB_PER_DPS		200
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -156,6 +164,17 @@ enum adxrs290_hpf {
 	ADXRS290_HPF_11HZ30
 };
 
+/**
+ * @struct adxrs290_sample
+ * @brief One burst of all data channels
+ */
+struct adxrs290_sample {
+	/** X, Y rate and sign extended temperature, in channel order */
+	int16_t		data[ADXRS290_CHANNEL_COUNT];
+	/** Time at which the data was read, in microseconds */
+	uint64_t	timestamp_us;
+};
+
 /**
  * @struct adxrs290_init_param
  * @brief Device driver initialization structure
@@ -165,6 +184,8 @@ struct adxrs290_init_param {
 	struct no_os_spi_init_param	spi_init;
 	/** Optional. If not set adxrs290_get_data_ready will fail */
 	struct no_os_gpio_init_param	*gpio_sync;
+	/** Optional. Along with gpio_sync, read the data from its interrupt */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
 	/** Initial Mode */
 	enum adxrs290_mode	mode;
 	/** Initial lpf settings */
@@ -184,6 +205,21 @@ struct adxrs290_dev {
 	struct no_os_gpio_desc	*gpio_sync;
 	/** Active Channels */
 	uint8_t			ch_mask;
+	/** Interrupt controller of the data ready pin */
+	struct no_os_irq_ctrl_desc	*irq_ctrl;
+	struct no_os_callback_desc	irq_cb;
+	/** Samples read by the data ready interrupt handler */
+	struct adxrs290_sample	ring[ADXRS290_RING_SIZE];
+	volatile uint32_t	ring_head;
+	volatile uint32_t	ring_tail;
+	/** Samples dropped because the ring was full */
+	uint32_t		overruns;
+	bool			continuous;
+	/** Trapezoidal rate integrator of X and Y, in 2 * LSB * us */
+	bool			integrate;
+	int64_t			angle[2];
+	int16_t			last_rate[2];
+	uint64_t		last_ts;
 };
 
 /******************************************************************************/
@@ -227,6 +263,27 @@ int32_t adxrs290_get_burst_data(struct adxrs290_dev *dev, int16_t *burst_data,
 /* Set the ADXRS290 active channels */
 int32_t adxrs290_set_active_channels(struct adxrs290_dev *dev, uint32_t mask);
 
+/* Read all channels in a single burst */
+int32_t adxrs290_read_sample(struct adxrs290_dev *dev,
+			     struct adxrs290_sample *sample);
+
+/* Start the data ready driven acquisition */
+int32_t adxrs290_start_continuous(struct adxrs290_dev *dev);
+
+/* Stop the data ready driven acquisition */
+int32_t adxrs290_stop_continuous(struct adxrs290_dev *dev);
+
+/* Get the next sample of the continuous acquisition */
+int32_t adxrs290_get_sample(struct adxrs290_dev *dev,
+			    struct adxrs290_sample *sample);
+
+/* Enable or disable the rate integrator */
+int32_t adxrs290_integrator_enable(struct adxrs290_dev *dev, bool enable);
+
+/* Get the integrated angle of the X or Y axis */
+int32_t adxrs290_get_angle(struct adxrs290_dev *dev, enum adxrs290_channel ch,
+			   int64_t *angle_udeg);
+
 /* Get the data ready state */
 int32_t adxrs290_get_data_ready(struct adxrs290_dev *dev, bool *rdy);
 
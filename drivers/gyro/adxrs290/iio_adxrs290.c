@@ -46,6 +46,11 @@
 #include "no_os_error.h"
 #include "iio.h"
 
+/* Index of the timestamp channel, after the data channels */
+#define ADXRS290_IIO_TIMESTAMP		ADXRS290_CHANNEL_COUNT
+/* Microdegrees to microradians, pi / 180 scaled by 1000000 */
+#define ADXRS290_IIO_UDEG_TO_URAD	17453
+
 /*
  * Available cut-off frequencies of the low pass filter in Hz.
  * The integer part and fractional part are represented separately.
@@ -88,7 +93,7 @@ static int get_adxrs290_iio_ch_raw(void *device, char *buf, uint32_t len,
 	adxrs290_get_rate_data((struct adxrs290_dev *)device,
 			       channel->ch_num, &data);
 	if (channel->ch_num == ADXRS290_CHANNEL_TEMP)
-		data = (data << 4) >> 4;
+		data = (int16_t)(data << 4) >> 4;
 
 	return snprintf(buf, len, "%d", data);
 }
@@ -175,52 +180,125 @@ static int set_adxrs290_iio_ch_lpf(void *device, char *buf, uint32_t len,
 	return -1;
 }
 
+static int get_adxrs290_iio_ch_angle(void *device, char *buf, uint32_t len,
+				     const struct iio_ch_info *channel,
+				     intptr_t priv)
+{
+	int64_t angle;
+	uint64_t mag;
+	int32_t ret;
+
+	ret = adxrs290_get_angle((struct adxrs290_dev *)device,
+				 channel->ch_num, &angle);
+	if (ret)
+		return ret;
+
+	// Integrated angle in radians
+	angle = angle * ADXRS290_IIO_UDEG_TO_URAD / 1000000;
+	mag = angle < 0 ? -angle : angle;
+
+	return snprintf(buf, len, "%s%d.%06d", angle < 0 ? "-" : "",
+			(int)(mag / 1000000), (int)(mag % 1000000));
+}
+
+static int get_adxrs290_iio_integrator_en(void *device, char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t priv)
+{
+	struct adxrs290_dev *dev = device;
+
+	return snprintf(buf, len, "%d", dev->integrate);
+}
+
+static int set_adxrs290_iio_integrator_en(void *device, char *buf,
+		uint32_t len,
+		const struct iio_ch_info *channel,
+		intptr_t priv)
+{
+	int32_t ret;
+
+	ret = adxrs290_integrator_enable(device, strtol(buf, NULL, 0) != 0);
+	if (ret)
+		return ret;
+
+	return len;
+}
+
 static int32_t adxrs290_update_active_channels(void *device, uint32_t mask)
 {
 	struct adxrs290_dev *dev = device;
 
 	adxrs290_set_active_channels(dev, mask);
 
-	return 0;
+	return adxrs290_start_continuous(dev);
+}
+
+static int32_t adxrs290_buffer_disable(void *device)
+{
+	return adxrs290_stop_continuous(device);
 }
 
-static int32_t adxrs290_read_samples(void *device, uint16_t *buff,
-				     uint32_t nb_samples)
+static int32_t adxrs290_push_sample(struct iio_buffer *buffer,
+				    struct adxrs290_sample *sample)
 {
-	struct adxrs290_dev	*dev = device;
+	uint64_t	scan[2] = { 0 };
+	uint8_t		*data = (uint8_t *)scan;
+	uint32_t	offset = 0;
+	int64_t		ts;
+	uint8_t		i;
+
+	for (i = 0; i < ADXRS290_CHANNEL_COUNT; i++) {
+		if (!(buffer->active_mask & NO_OS_BIT(i)))
+			continue;
+
+		memcpy(&data[offset], &sample->data[i], sizeof(int16_t));
+		offset += sizeof(int16_t);
+	}
+
+	// The timestamp is aligned to its own size
+	if (buffer->active_mask & NO_OS_BIT(ADXRS290_IIO_TIMESTAMP)) {
+		offset = NO_OS_DIV_ROUND_UP(offset, sizeof(ts)) * sizeof(ts);
+		ts = (int64_t)sample->timestamp_us * 1000;
+		memcpy(&data[offset], &ts, sizeof(ts));
+	}
+
+	return iio_buffer_push_scan(buffer, scan);
+}
+
+static int32_t adxrs290_submit(struct iio_device_data *device)
+{
+	struct adxrs290_dev	*dev = device->dev;
+	struct adxrs290_sample	sample;
 	uint32_t		i;
-	uint32_t		offset;
-	int16_t			data[ADXRS290_CHANNEL_COUNT];
-	uint8_t			ch_cnt;
-	bool			rdy;
-
-	offset = 0;
-	for (i = 0; i < nb_samples; i++) {
-		/* Stop until data is available.
-		 * This will not block at first data since sync pin will
-		 * will always be high until read. */
-		while(true) {
-			adxrs290_get_data_ready(dev, &rdy);
-			if (rdy == true)
-				break;
-		}
-		adxrs290_get_burst_data(dev, data, &ch_cnt);
-		memcpy(&buff[offset], data, ch_cnt*sizeof(int16_t));
-		offset += ch_cnt;
+	int32_t			ret;
+
+	for (i = 0; i < device->buffer->samples; i++) {
+		do {
+			ret = adxrs290_get_sample(dev, &sample);
+		} while (ret == -EAGAIN);
+		if (ret)
+			return ret;
+
+		ret = adxrs290_push_sample(device->buffer, &sample);
+		if (ret)
+			return ret;
 	}
 
-	return nb_samples;
+	return 0;
 }
 
 static int32_t adxrs290_trigger_handler(struct iio_device_data *device)
 {
 	struct adxrs290_dev	*dev = device->dev;
-	int16_t			data[ADXRS290_CHANNEL_COUNT];
-	uint8_t			ch_cnt;
+	struct adxrs290_sample	sample;
+	int32_t			ret;
 
-	adxrs290_get_burst_data(dev, data, &ch_cnt);
+	ret = adxrs290_read_sample(dev, &sample);
+	if (ret)
+		return ret;
 
-	return iio_buffer_push_scan(device->buffer, data);
+	return adxrs290_push_sample(device->buffer, &sample);
 }
 
 static struct iio_attribute adxrs290_iio_vel_attrs[] = {
@@ -234,6 +312,11 @@ static struct iio_attribute adxrs290_iio_vel_attrs[] = {
 		.show = get_adxrs290_iio_ch_lpf,
 		.store = set_adxrs290_iio_ch_lpf
 	},
+	{
+		.name = "integrated_angle",
+		.show = get_adxrs290_iio_ch_angle,
+		.store = NULL
+	},
 	{
 		.name = "raw",
 		.show = get_adxrs290_iio_ch_raw,
@@ -261,6 +344,15 @@ static struct iio_attribute adxrs290_iio_temp_attrs[] = {
 	END_ATTRIBUTES_ARRAY,
 };
 
+static struct iio_attribute adxrs290_iio_dev_attrs[] = {
+	{
+		.name = "integrator_en",
+		.show = get_adxrs290_iio_integrator_en,
+		.store = set_adxrs290_iio_integrator_en
+	},
+	END_ATTRIBUTES_ARRAY,
+};
+
 static struct scan_type scan_type_gyro = {
 	.sign = 's',
 	.realbits = 16,
@@ -277,6 +369,14 @@ static struct scan_type scan_type_temp = {
 	.is_big_endian = false
 };
 
+static struct scan_type scan_type_timestamp = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false
+};
+
 static struct iio_channel adxrs290_iio_channels[] = {
 	{
 		.ch_type = IIO_ANGL_VEL,
@@ -305,18 +405,25 @@ static struct iio_channel adxrs290_iio_channels[] = {
 		.scan_type = &scan_type_temp,
 		.attributes = adxrs290_iio_temp_attrs,
 		.ch_out = false,
+	},
+	{
+		.ch_type = IIO_TIMESTAMP,
+		.channel = ADXRS290_IIO_TIMESTAMP,
+		.scan_index = ADXRS290_IIO_TIMESTAMP,
+		.scan_type = &scan_type_timestamp,
+		.ch_out = false,
 	}
 };
 
 struct iio_device adxrs290_iio_descriptor = {
-	.num_ch = 3,
+	.num_ch = NO_OS_ARRAY_SIZE(adxrs290_iio_channels),
 	.channels = adxrs290_iio_channels,
-	.attributes = NULL,
+	.attributes = adxrs290_iio_dev_attrs,
 	.debug_attributes = NULL,
 	.buffer_attributes = NULL,
 	.pre_enable = adxrs290_update_active_channels,
-	.post_disable = NULL,
-	.read_dev = (int32_t (*)())adxrs290_read_samples,
+	.post_disable = adxrs290_buffer_disable,
+	.submit = adxrs290_submit,
 	.trigger_handler = (int32_t (*)())adxrs290_trigger_handler,
 	.debug_reg_read = (int32_t (*)())adxrs290_reg_read,
 	.debug_reg_write = (int32_t (*)())adxrs290_reg_write
@@ -52,6 +52,7 @@
 /******************************************************************************/
 struct iio_trigger adxrs290_iio_trig_desc = {
 	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable
 };
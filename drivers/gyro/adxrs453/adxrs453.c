@@ -43,6 +43,8 @@
 #include <stdlib.h>
 #include "adxrs453.h"
 #include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
 
 /***************************************************************************//**
  * @brief Initializes the ADXRS453 and checks if the device is present.
@@ -63,7 +65,7 @@ int32_t adxrs453_init(struct adxrs453_dev **device,
 	int32_t status = 0;
 	uint16_t adxrs453_id = 0;
 
-	dev = (struct adxrs453_dev *)no_os_malloc(sizeof(*dev));
+	dev = (struct adxrs453_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -1;
 
@@ -132,6 +134,7 @@ uint16_t adxrs453_get_register_value(struct adxrs453_dev *dev,
 	data_buffer[7] = data_buffer[3];
 	no_os_spi_write_and_read(dev->spi_desc, data_buffer, 4);
 	no_os_spi_write_and_read(dev->spi_desc, &data_buffer[4], 4);
+	dev->streaming = false;
 	register_value = ((uint16_t)data_buffer[5] << 11) |
 			 ((uint16_t)data_buffer[6] << 3) |
 			 (data_buffer[7] >> 5);
@@ -174,6 +177,7 @@ void adxrs453_set_register_value(struct adxrs453_dev *dev,
 		data_buffer[3] |= 1;
 
 	no_os_spi_write_and_read(dev->spi_desc, data_buffer, 4);
+	dev->streaming = false;
 }
 
 /***************************************************************************//**
@@ -208,6 +212,8 @@ uint32_t adxrs453_get_sensor_data(struct adxrs453_dev *dev)
 	data_buffer[7] = data_buffer[3];
 	no_os_spi_write_and_read(dev->spi_desc, data_buffer, 4);
 	no_os_spi_write_and_read(dev->spi_desc, &data_buffer[4], 4);
+	/* The second request is still pending */
+	dev->streaming = true;
 	register_value = ((uint32_t)data_buffer[0] << 24) |
 			 ((uint32_t)data_buffer[1] << 16) |
 			 ((uint16_t)data_buffer[2] << 8) |
@@ -216,6 +222,99 @@ uint32_t adxrs453_get_sensor_data(struct adxrs453_dev *dev)
 	return register_value;
 }
 
+/***************************************************************************//**
+ * @brief Issues a sensor data request and returns the response to the
+ *        previous command.
+ *
+ * @param dev      - The device structure.
+ * @param response - The response word.
+ *
+ * @return ret - Result of the SPI transfer.
+*******************************************************************************/
+static int32_t adxrs453_sensor_data_xfer(struct adxrs453_dev *dev,
+		uint32_t *response)
+{
+	/* The sensor data command has odd parity without the P bit set. */
+	uint8_t data_buffer[4] = {ADXRS453_SENSOR_DATA, 0, 0, 0};
+	int32_t ret;
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, data_buffer, 4);
+	if (ret)
+		return ret;
+
+	*response = no_os_get_unaligned_be32(data_buffer);
+
+	return 0;
+}
+
+/***************************************************************************//**
+ * @brief Checks the odd parity of a response word.
+ *
+ * @param word - The response word.
+ *
+ * @return true if the parity is correct.
+*******************************************************************************/
+static bool adxrs453_parity_ok(uint32_t word)
+{
+	word ^= word >> 16;
+	word ^= word >> 8;
+	word ^= word >> 4;
+	word ^= word >> 2;
+	word ^= word >> 1;
+
+	return word & 1;
+}
+
+/***************************************************************************//**
+ * @brief Reads consecutive rate samples.
+ *
+ * The response to a command is returned during the next command, so the
+ * sensor data requests are pipelined: each 32-bit transfer returns one
+ * sample and requests the next one. Only the first call after a register
+ * access needs an extra priming transfer. The caller paces the reads, e.g.
+ * from a timer, since the device has no data ready output.
+ *
+ * @param dev        - The device structure.
+ * @param rate       - Raw rate samples, 1 LSB = 1/80 degrees/second.
+ * @param nb_samples - Number of samples to read.
+ *
+ * @return ret - 0 in case of success, -EIO if a response has a wrong parity
+ *               or does not hold valid sensor data, negative error code
+ *               otherwise.
+*******************************************************************************/
+int32_t adxrs453_read_rate_samples(struct adxrs453_dev *dev, int16_t *rate,
+				   uint32_t nb_samples)
+{
+	uint32_t response;
+	uint32_t i;
+	int32_t ret;
+
+	if (!dev || !rate)
+		return -EINVAL;
+
+	if (!dev->streaming && nb_samples) {
+		ret = adxrs453_sensor_data_xfer(dev, &response);
+		if (ret)
+			return ret;
+
+		dev->streaming = true;
+	}
+
+	for (i = 0; i < nb_samples; i++) {
+		ret = adxrs453_sensor_data_xfer(dev, &response);
+		if (ret)
+			return ret;
+
+		if (!adxrs453_parity_ok(response) ||
+		    ADXRS453_ST(response) != ADXRS453_ST_VALID)
+			return -EIO;
+
+		rate[i] = ADXRS453_RATE(response);
+	}
+
+	return 0;
+}
+
 /***************************************************************************//**
  * @brief Reads the rate data and converts it to degrees/second.
  *
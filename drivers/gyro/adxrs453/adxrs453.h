@@ -43,6 +43,7 @@
 /***************************** Include Files **********************************/
 /******************************************************************************/
 #include <stdint.h>
+#include <stdbool.h>
 #include "no_os_spi.h"
 
 /******************************************************************************/
@@ -63,6 +64,11 @@
 #define ADXRS453_REG_SN_HIGH    0x0E
 #define ADXRS453_REG_SN_LOW     0x10
 
+/* Sensor data response fields */
+#define ADXRS453_ST(x)          (((x) >> 26) & 0x3)
+#define ADXRS453_ST_VALID       0x1
+#define ADXRS453_RATE(x)        ((int16_t)(((x) >> 10) & 0xFFFF))
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -70,6 +76,8 @@
 struct adxrs453_dev {
 	/* SPI */
 	struct no_os_spi_desc	*spi_desc;
+	/* A sensor data request is pending, its response comes next */
+	bool			streaming;
 };
 
 struct adxrs453_init_param {
@@ -100,6 +108,10 @@ void adxrs453_set_register_value(struct adxrs453_dev *dev,
 /*! Reads the sensor data. */
 uint32_t adxrs453_get_sensor_data(struct adxrs453_dev *dev);
 
+/*! Reads consecutive rate samples with pipelined sensor data requests. */
+int32_t adxrs453_read_rate_samples(struct adxrs453_dev *dev, int16_t *rate,
+				   uint32_t nb_samples);
+
 /*! Reads the rate data and converts it to degrees/second. */
 float adxrs453_get_rate(struct adxrs453_dev *dev);
 
@@ -51,6 +51,7 @@
 
 struct iio_trigger adis_iio_trig_desc = {
 	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable
 };
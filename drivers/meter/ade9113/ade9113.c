@@ -162,6 +162,100 @@ int ade9113_read(struct ade9113_dev *dev, uint8_t reg_addr, uint8_t *reg_data,
 	return 0;
 }
 
+/**
+ * @brief Read the waveforms of all the chained devices in one frame.
+ *
+ * Every device receives a long read command in its own slot, so the frame
+ * shifted out holds one long response per device, each one protected by its
+ * own CRC. Slot 0 belongs to the device driving the host MISO line.
+ * @param dev - The device structure.
+ * @param samples - Array of nb_devices waveform samples.
+ * @param crc_err_mask - Bit i is set if the frame of device i failed the CRC
+ * 			 check. Can be NULL.
+ * @return 0 in case of success, -EPROTO if any frame failed the CRC check,
+ * 	   negative error code otherwise.
+ */
+int ade9113_read_chain(struct ade9113_dev *dev,
+		       struct ade9113_wav_sample *samples,
+		       uint8_t *crc_err_mask)
+{
+	uint32_t len, raw;
+	uint8_t *frame;
+	uint8_t err = 0;
+	uint16_t crc16;
+	uint8_t cmd[4];
+	uint8_t i;
+	int ret;
+
+	if (!dev || !samples)
+		return -EINVAL;
+
+	/* Long read of CONFIG0 keeps the waveforms coming in each response */
+	cmd[0] = ADE9113_SPI_READ | ADE9113_OP_MODE_LONG;
+	cmd[1] = ADE9113_REG_CONFIG0;
+	cmd[2] = 0;
+	cmd[3] = no_os_crc8(ade9113_crc8, cmd, 3, 0) ^ 0x55;
+
+	len = dev->nb_devices * ADE9113_LONG_FRAME_SIZE;
+	memset(dev->chain_buff, 0, len);
+	for (i = 0; i < dev->nb_devices; i++)
+		memcpy(&dev->chain_buff[i * ADE9113_LONG_FRAME_SIZE + 12], cmd,
+		       sizeof(cmd));
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, dev->chain_buff, len);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < dev->nb_devices; i++) {
+		frame = &dev->chain_buff[i * ADE9113_LONG_FRAME_SIZE];
+
+		if (dev->crc_en) {
+			crc16 = no_os_crc16(ade9113_crc16, frame,
+					    ADE9113_LONG_FRAME_SIZE - 2,
+					    ADE9113_CRC16_INIT_VAL);
+			if (crc16 != no_os_get_unaligned_le16(&frame[14])) {
+				err |= NO_OS_BIT(i);
+				continue;
+			}
+		}
+
+		raw = no_os_get_unaligned_le24(&frame[1]);
+		samples[i].i_wav = no_os_sign_extend32(raw, 23);
+		raw = no_os_get_unaligned_le24(&frame[5]);
+		samples[i].v1_wav = no_os_sign_extend32(raw, 23);
+		raw = no_os_get_unaligned_le24(&frame[9]);
+		samples[i].v2_wav = no_os_sign_extend32(raw, 23);
+	}
+
+	if (crc_err_mask)
+		*crc_err_mask = err;
+
+	return err ? -EPROTO : 0;
+}
+
+/**
+ * @brief Push one sample of every chained device into the stream ring.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ade9113_stream_push(struct ade9113_dev *dev)
+{
+	struct ade9113_wav_sample samples[ADE9113_MAX_CHAIN_DEVICES];
+	int ret;
+
+	ret = ade9113_read_chain(dev, samples, NULL);
+	if (ret == -EPROTO) {
+		/* Drop the whole scan so the ring stays aligned. */
+		dev->stream_crc_err++;
+		return ret;
+	}
+	if (ret)
+		return ret;
+
+	return no_os_cb_write(dev->stream_cb, samples,
+			      dev->nb_devices * sizeof(*samples));
+}
+
 /**
  * @brief Write device register.
  * @param dev- The device structure.
@@ -227,10 +321,18 @@ static void ade9113_irq_handler(void *dev)
 	if (ret)
 		return;
 
-	/* READ the data and place it in device structure */
-	ret = ade9113_read(dev, ADE9113_REG_CONFIG0, &reg_val, ADE9113_L_OP);
-	if (ret)
-		return;
+	if (desc->stream_cb) {
+		/* CRC errors are counted, keep the stream running */
+		ret = ade9113_stream_push(desc);
+		if (ret && ret != -EPROTO)
+			return;
+	} else {
+		/* READ the data and place it in device structure */
+		ret = ade9113_read(dev, ADE9113_REG_CONFIG0, &reg_val,
+				   ADE9113_L_OP);
+		if (ret)
+			return;
+	}
 
 	/* Reenable interrupt */
 	ret = no_os_irq_enable(desc->irq_ctrl,
@@ -254,13 +356,22 @@ int ade9113_init(struct ade9113_dev **device,
 	int ret;
 	int timeout = 0;
 
-	if (!init_param.irq_ctrl)
+	if (!init_param.irq_ctrl ||
+	    init_param.nb_devices > ADE9113_MAX_CHAIN_DEVICES)
 		return -EINVAL;
 
 	dev = (struct ade9113_dev *)no_os_calloc(1, sizeof(*dev));
 	if (!dev)
 		return -ENOMEM;
 
+	dev->nb_devices = init_param.nb_devices ? init_param.nb_devices : 1;
+	dev->chain_buff = no_os_calloc(dev->nb_devices,
+				       ADE9113_LONG_FRAME_SIZE);
+	if (!dev->chain_buff) {
+		no_os_free(dev);
+		return -ENOMEM;
+	}
+
 	struct no_os_callback_desc irq_cb = {
 		.callback = ade9113_irq_handler,
 		.ctx = dev,
@@ -383,11 +494,56 @@ error_gpio:
 error_spi:
 	no_os_spi_remove(dev->spi_desc);
 error_dev:
+	no_os_free(dev->chain_buff);
 	no_os_free(dev);
 
 	return ret;
 }
 
+/**
+ * @brief Start streaming the chained devices waveforms into a ring.
+ *
+ * On every data ready interrupt the driver IRQ handler reads all the chained
+ * devices in one frame and writes nb_devices struct ade9113_wav_sample
+ * entries into the ring. Frames failing the CRC check are dropped and counted
+ * in stream_crc_err. Not available when an external drdy_callback is used.
+ * @param dev - The device structure.
+ * @param cb - Ring receiving the samples, e.g. an IIO buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9113_stream_start(struct ade9113_dev *dev,
+			 struct no_os_circular_buffer *cb)
+{
+	if (!dev || !cb || dev->irq_cb.callback != ade9113_irq_handler)
+		return -EINVAL;
+
+	dev->stream_crc_err = 0;
+	dev->stream_cb = cb;
+
+	return ade9113_drdy_int_enable(dev);
+}
+
+/**
+ * @brief Stop streaming the chained devices waveforms.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9113_stream_stop(struct ade9113_dev *dev)
+{
+	int ret;
+
+	if (!dev)
+		return -EINVAL;
+
+	ret = ade9113_drdy_int_disable(dev);
+	if (ret)
+		return ret;
+
+	dev->stream_cb = NULL;
+
+	return 0;
+}
+
 /**
  * @brief Remove the device and release resources.
  * @param dev - The device structure.
@@ -414,6 +570,7 @@ int ade9113_remove(struct ade9113_dev *dev)
 	if (ret)
 		return ret;
 
+	no_os_free(dev->chain_buff);
 	no_os_free(dev);
 
 	return 0;
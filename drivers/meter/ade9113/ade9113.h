@@ -49,6 +49,7 @@
 #include "no_os_spi.h"
 #include "no_os_gpio.h"
 #include "no_os_irq.h"
+#include "no_os_circular_buffer.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -60,6 +61,12 @@
 /* Long/Short operation bit, set for lon read/write */
 #define ADE9113_OP_MODE_LONG			NO_OS_BIT(6)
 
+/* Size of a long operation frame */
+#define ADE9113_LONG_FRAME_SIZE			16
+
+/* Maximum number of daisy-chained devices */
+#define ADE9113_MAX_CHAIN_DEVICES		4
+
 /* ADE9113 CRC constants */
 #define ADE9113_CRC8_POLY			0x07
 #define ADE9113_CRC16_POLY			0x1021
@@ -329,6 +336,18 @@ enum ade9113_wav_e {
 	ADE9113_V2_WAV
 };
 
+/**
+ * @struct ade9113_wav_sample
+ * @brief ADE9113 waveform samples of one device in the chain.
+ */
+struct ade9113_wav_sample {
+	/* I_WAV */
+	int32_t				i_wav;
+	/* V1_WAV */
+	int32_t				v1_wav;
+	/* V2_WAV */
+	int32_t				v2_wav;
+};
 
 /**
  * @struct ade9113_init_param
@@ -346,6 +365,8 @@ struct ade9113_init_param {
 	/** External callback used to handle interrupt routine for GPIO RDY */
 	/** Set to NULL if callback defined in driver used */
 	void (*drdy_callback)(void *context);
+	/** Number of daisy-chained devices, 0 is handled as a single device */
+	uint8_t				nb_devices;
 };
 
 /**
@@ -373,6 +394,14 @@ struct ade9113_dev {
 	struct no_os_irq_ctrl_desc 	*irq_ctrl;
 	/** IRQ callback used to handle interrupt routine for GPIO RDY */
 	struct no_os_callback_desc	irq_cb;
+	/** Number of daisy-chained devices */
+	uint8_t				nb_devices;
+	/** Frame buffer holding one long frame for each chained device */
+	uint8_t				*chain_buff;
+	/** Ring receiving the streamed samples, NULL when not streaming */
+	struct no_os_circular_buffer	*stream_cb;
+	/** Number of chain frames dropped due to CRC mismatch */
+	uint32_t			stream_crc_err;
 };
 
 /******************************************************************************/
@@ -387,6 +416,18 @@ int ade9113_read(struct ade9113_dev *dev, uint8_t reg_addr,
 int ade9113_write(struct ade9113_dev *dev, uint8_t reg_addr,
 		  uint8_t reg_data, enum ade9113_operation_e op_mode);
 
+/* Read the waveforms of all the chained devices in one frame. */
+int ade9113_read_chain(struct ade9113_dev *dev,
+		       struct ade9113_wav_sample *samples,
+		       uint8_t *crc_err_mask);
+
+/* Start streaming the chained devices waveforms into a ring. */
+int ade9113_stream_start(struct ade9113_dev *dev,
+			 struct no_os_circular_buffer *cb);
+
+/* Stop streaming the chained devices waveforms. */
+int ade9113_stream_stop(struct ade9113_dev *dev);
+
 /* Initialize the device. */
 int ade9113_init(struct ade9113_dev **device,
 		 struct ade9113_init_param init_param);
@@ -46,6 +46,9 @@
 #include "no_os_delay.h"
 #include "no_os_units.h"
 #include "no_os_alloc.h"
+#include "no_os_crc16.h"
+
+NO_OS_DECLARE_CRC16_TABLE(ade9430_crc16);
 
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
@@ -280,6 +283,268 @@ int ade9430_set_egy_model(struct ade9430_dev *dev, enum ade9430_egy_model model,
 	return ade9430_write(dev, ADE9430_REG_RUN, 1);
 }
 
+/**
+ * @brief Burst read waveform buffer pages and check the SPI CRC.
+ * @param dev - The device structure.
+ * @param page - First page to be read.
+ * @param nb_pages - Number of consecutive pages to be read.
+ * @param buff - Transfer buffer, ADE9430_WFB_CMD_SIZE bytes for the command
+ * 		 followed by nb_pages * ADE9430_WFB_PAGE_SIZE bytes of data.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int ade9430_wfb_burst(struct ade9430_dev *dev, uint8_t page,
+			     uint8_t nb_pages, uint8_t *buff)
+{
+	uint32_t len = nb_pages * ADE9430_WFB_PAGE_SIZE;
+	uint16_t addr = ADE9430_WFB_PAGE_ADDR(page);
+	uint32_t crc_spi;
+	uint16_t crc;
+	int ret;
+
+	memset(buff, 0, ADE9430_WFB_CMD_SIZE + len);
+
+	/* The address auto-increments inside the waveform buffer. */
+	buff[0] = addr >> 4;
+	buff[1] = ADE9430_SPI_READ | addr << 4;
+
+	ret = no_os_spi_write_and_read(dev->spi_desc, buff,
+				       ADE9430_WFB_CMD_SIZE + len);
+	if (ret)
+		return ret;
+
+	/* CRC_SPI covers the data shifted out during the last read. */
+	ret = ade9430_read(dev, ADE9430_REG_CRC_SPI, &crc_spi);
+	if (ret)
+		return ret;
+
+	crc = no_os_crc16(ade9430_crc16, &buff[ADE9430_WFB_CMD_SIZE], len,
+			  ADE9430_CRC16_INIT_VAL);
+	if (crc != crc_spi)
+		return -EPROTO;
+
+	return 0;
+}
+
+/**
+ * @brief Burst read waveform buffer pages.
+ * @param dev - The device structure.
+ * @param page - First page to be read.
+ * @param nb_pages - Number of consecutive pages to be read.
+ * @param data - Buffer for the nb_pages * ADE9430_WFB_PAGE_WORDS words read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_read_pages(struct ade9430_dev *dev, uint8_t page,
+			   uint8_t nb_pages, uint32_t *data)
+{
+	uint32_t nb_words = nb_pages * ADE9430_WFB_PAGE_WORDS;
+	uint8_t *buff;
+	uint32_t i;
+	int ret;
+
+	if (!dev || !data || !nb_pages ||
+	    page + nb_pages > ADE9430_WFB_NB_PAGES)
+		return -EINVAL;
+
+	buff = no_os_calloc(ADE9430_WFB_CMD_SIZE + nb_words * 4,
+			    sizeof(*buff));
+	if (!buff)
+		return -ENOMEM;
+
+	ret = ade9430_wfb_burst(dev, page, nb_pages, buff);
+	if (ret)
+		goto free_buff;
+
+	for (i = 0; i < nb_words; i++)
+		data[i] = no_os_get_unaligned_be32(&buff[ADE9430_WFB_CMD_SIZE +
+							 i * 4]);
+
+free_buff:
+	no_os_free(buff);
+
+	return ret;
+}
+
+/**
+ * @brief Start streaming the waveform buffer into a ring.
+ *
+ * The buffer is filled continuously and a page full interrupt is raised every
+ * cfg->pages_per_irq pages. ade9430_wfb_service() should be called on each
+ * IRQ0 assertion, it moves the completed pages into the ring as host order
+ * 32-bit words.
+ * @param dev - The device structure.
+ * @param cfg - Streaming configuration.
+ * @param cb - Ring receiving the waveform words, e.g. an IIO buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_start(struct ade9430_dev *dev, struct ade9430_wfb_cfg *cfg,
+		      struct no_os_circular_buffer *cb)
+{
+	uint32_t pg_irqen = 0;
+	uint32_t len;
+	uint8_t i;
+	int ret;
+
+	if (!dev || !cfg || !cb || dev->wfb_buff)
+		return -EINVAL;
+
+	if (!cfg->pages_per_irq || cfg->pages_per_irq > ADE9430_WFB_NB_PAGES ||
+	    ADE9430_WFB_NB_PAGES % cfg->pages_per_irq)
+		return -EINVAL;
+
+	len = ADE9430_WFB_CMD_SIZE + cfg->pages_per_irq * ADE9430_WFB_PAGE_SIZE;
+	dev->wfb_buff = no_os_calloc(len, sizeof(*dev->wfb_buff));
+	if (!dev->wfb_buff)
+		return -ENOMEM;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_CFG, 0);
+	if (ret)
+		goto free_buff;
+
+	/* No trigger events, so the continuous fill never stops. */
+	ret = ade9430_write(dev, ADE9430_REG_WFB_TRG_CFG, 0);
+	if (ret)
+		goto free_buff;
+
+	for (i = cfg->pages_per_irq - 1; i < ADE9430_WFB_NB_PAGES;
+	     i += cfg->pages_per_irq)
+		pg_irqen |= NO_OS_BIT(i);
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_PG_IRQEN, pg_irqen);
+	if (ret)
+		goto free_buff;
+
+	ret = ade9430_write(dev, ADE9430_REG_STATUS0,
+			    ADE9430_STATUS0_PAGE_FULL);
+	if (ret)
+		goto free_buff;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_MASK0,
+				  ADE9430_MASK0_PAGE_FULL,
+				  ADE9430_MASK0_PAGE_FULL);
+	if (ret)
+		goto free_buff;
+
+	dev->wfb_cb = cb;
+	dev->wfb_pages = cfg->pages_per_irq;
+	dev->wfb_next_page = cfg->pages_per_irq - 1;
+	dev->wfb_crc_err = 0;
+	dev->wfb_overrun = 0;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_CFG,
+			    no_os_field_prep(ADE9430_WF_IN_EN, cfg->in_en) |
+			    no_os_field_prep(ADE9430_WF_SRC, cfg->src) |
+			    no_os_field_prep(ADE9430_WF_MODE, 1) |
+			    no_os_field_prep(ADE9430_BURST_CHAN,
+					     cfg->burst_chan) |
+			    ADE9430_WF_CAP_SEL | ADE9430_WF_CAP_EN);
+	if (ret)
+		goto free_buff;
+
+	return 0;
+
+free_buff:
+	no_os_free(dev->wfb_buff);
+	dev->wfb_buff = NULL;
+	dev->wfb_cb = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Move the pages signaled as full into the ring.
+ *
+ * The whole block ending with the last filled page is read in one SPI burst
+ * and validated against CRC_SPI. Blocks failing the check are dropped and
+ * counted in wfb_crc_err, blocks skipped because the service ran late are
+ * counted in wfb_overrun.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_service(struct ade9430_dev *dev)
+{
+	uint32_t status, trg_stat, word, len, i;
+	uint8_t last_page;
+	int ret;
+
+	if (!dev || !dev->wfb_buff)
+		return -EINVAL;
+
+	ret = ade9430_read(dev, ADE9430_REG_STATUS0, &status);
+	if (ret)
+		return ret;
+
+	if (!(status & ADE9430_STATUS0_PAGE_FULL))
+		return 0;
+
+	ret = ade9430_read(dev, ADE9430_REG_WFB_TRG_STAT, &trg_stat);
+	if (ret)
+		return ret;
+
+	ret = ade9430_write(dev, ADE9430_REG_STATUS0,
+			    ADE9430_STATUS0_PAGE_FULL);
+	if (ret)
+		return ret;
+
+	last_page = no_os_field_get(ADE9430_WFB_LAST_PAGE, trg_stat);
+	if (last_page != dev->wfb_next_page)
+		dev->wfb_overrun++;
+
+	dev->wfb_next_page = (last_page + dev->wfb_pages) %
+			     ADE9430_WFB_NB_PAGES;
+
+	ret = ade9430_wfb_burst(dev, last_page / dev->wfb_pages *
+				dev->wfb_pages, dev->wfb_pages,
+				dev->wfb_buff);
+	if (ret == -EPROTO)
+		dev->wfb_crc_err++;
+	if (ret)
+		return ret;
+
+	/* Convert in place, the command bytes are skipped. */
+	len = ADE9430_WFB_CMD_SIZE + dev->wfb_pages * ADE9430_WFB_PAGE_SIZE;
+	for (i = ADE9430_WFB_CMD_SIZE; i < len; i += 4) {
+		word = no_os_get_unaligned_be32(&dev->wfb_buff[i]);
+		memcpy(&dev->wfb_buff[i], &word, sizeof(word));
+	}
+
+	return no_os_cb_write(dev->wfb_cb,
+			      &dev->wfb_buff[ADE9430_WFB_CMD_SIZE],
+			      len - ADE9430_WFB_CMD_SIZE);
+}
+
+/**
+ * @brief Stop streaming the waveform buffer.
+ * @param dev - The device structure.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int ade9430_wfb_stop(struct ade9430_dev *dev)
+{
+	int ret;
+
+	if (!dev || !dev->wfb_buff)
+		return -EINVAL;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_WFB_CFG,
+				  ADE9430_WF_CAP_EN, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9430_update_bits(dev, ADE9430_REG_MASK0,
+				  ADE9430_MASK0_PAGE_FULL, 0);
+	if (ret)
+		return ret;
+
+	ret = ade9430_write(dev, ADE9430_REG_WFB_PG_IRQEN, 0);
+	if (ret)
+		return ret;
+
+	no_os_free(dev->wfb_buff);
+	dev->wfb_buff = NULL;
+	dev->wfb_cb = NULL;
+
+	return 0;
+}
+
 /**
  * @brief Initialize the device.
  * @param device - The device structure.
@@ -298,6 +563,9 @@ int ade9430_init(struct ade9430_dev **device,
 	if (!dev)
 		return -ENOMEM;
 
+	/* Create the CRC-16 lookup table used to check the SPI reads */
+	no_os_crc16_populate_msb(ade9430_crc16, ADE9430_CRC16_POLY);
+
 	/* SPI Initialization*/
 	ret = no_os_spi_init(&dev->spi_desc, init_param.spi_init);
 	if (ret)
@@ -354,6 +622,7 @@ int ade9430_remove(struct ade9430_dev *dev)
 	if (ret)
 		return ret;
 
+	no_os_free(dev->wfb_buff);
 	no_os_free(dev);
 
 	return 0;
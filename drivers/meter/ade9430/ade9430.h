@@ -47,6 +47,7 @@
 #include <string.h>
 #include "no_os_util.h"
 #include "no_os_spi.h"
+#include "no_os_circular_buffer.h"
 
 /******************************************************************************/
 /********************** Macros and Constants Definitions **********************/
@@ -766,7 +767,7 @@
 /* ADE9430_REG_WFB_CFG Bit Definition */
 #define ADE9430_WF_IN_EN		NO_OS_BIT(12)
 #define ADE9430_WF_SRC			NO_OS_GENMASK(9, 8)
-#define ADE9430_WF_MODE			NO_OS_BIT(7, 6)
+#define ADE9430_WF_MODE			NO_OS_GENMASK(7, 6)
 #define ADE9430_WF_CAP_SEL		NO_OS_BIT(5)
 #define ADE9430_WF_CAP_EN		NO_OS_BIT(4)
 #define ADE9430_BURST_CHAN		NO_OS_GENMASK(3, 0)
@@ -786,6 +787,19 @@
 #define ADE9430_WFB_LAST_PAGE		NO_OS_GENMASK(15, 12)
 #define ADE9430_WFB_TRIG_ADDR		NO_OS_GENMASK(10, 0)
 
+/* ADE9430 Waveform Buffer */
+#define ADE9430_REG_WF_BUFF		0x0800
+#define ADE9430_WFB_NB_PAGES		16
+#define ADE9430_WFB_PAGE_WORDS		128
+#define ADE9430_WFB_PAGE_SIZE		(ADE9430_WFB_PAGE_WORDS * 4)
+#define ADE9430_WFB_PAGE_ADDR(x)	(ADE9430_REG_WF_BUFF + \
+					 (x) * ADE9430_WFB_PAGE_WORDS)
+#define ADE9430_WFB_CMD_SIZE		2
+
+/* ADE9430 SPI CRC constants */
+#define ADE9430_CRC16_POLY		0x1021
+#define ADE9430_CRC16_INIT_VAL		0xFFFF
+
 /* ADE9430_CONFIG2 Bit Definition */
 #define ADE9430_UPERIOD_SEL		NO_OS_BIT(12)
 #define ADE9430_HPF_CRN			NO_OS_GENMASK(12, 9)
@@ -875,6 +889,31 @@ enum ade9430_egy_model {
 	ADE9430_EGY_NR_SAMPLES
 };
 
+/**
+ * @enum ade9430_wf_src
+ * @brief ADE9430 waveform buffer data sources.
+ */
+enum ade9430_wf_src {
+	ADE9430_WF_SRC_SINC4,
+	ADE9430_WF_SRC_SINC4_IIR_LPF = 2,
+	ADE9430_WF_SRC_DSP
+};
+
+/**
+ * @struct ade9430_wfb_cfg
+ * @brief ADE9430 waveform streaming configuration.
+ */
+struct ade9430_wfb_cfg {
+	/** Waveform buffer data source */
+	enum ade9430_wf_src		src;
+	/** Burst channel selection, 0 stores all the channels */
+	uint8_t				burst_chan;
+	/** Store the neutral current channel as well */
+	bool				in_en;
+	/** Pages read per page full interrupt: 1, 2, 4, 8 or 16 */
+	uint8_t				pages_per_irq;
+};
+
 /**
  * @struct ade9430_init_param
  * @brief ADE9430 Device initialization parameters.
@@ -901,6 +940,18 @@ struct ade9430_dev {
 	uint32_t			vrms_val;
 	/** Variable storing the temperature value in degrees */
 	int32_t				temp_deg;
+	/** Ring receiving the streamed waveform buffer words */
+	struct no_os_circular_buffer	*wfb_cb;
+	/** Burst read buffer: command followed by the page words */
+	uint8_t				*wfb_buff;
+	/** Pages read per page full interrupt */
+	uint8_t				wfb_pages;
+	/** Last page expected to be signaled as full */
+	uint8_t				wfb_next_page;
+	/** Number of bursts dropped due to SPI CRC mismatch */
+	uint32_t			wfb_crc_err;
+	/** Number of page blocks overwritten before being read */
+	uint32_t			wfb_overrun;
 };
 
 /******************************************************************************/
@@ -929,6 +980,20 @@ int ade9430_read_data_ph(struct ade9430_dev *dev, enum ade9430_phase phase);
 int ade9430_set_egy_model(struct ade9430_dev *dev, enum ade9430_egy_model model,
 			  uint16_t value);
 
+/* Burst read waveform buffer pages. */
+int ade9430_wfb_read_pages(struct ade9430_dev *dev, uint8_t page,
+			   uint8_t nb_pages, uint32_t *data);
+
+/* Start streaming the waveform buffer into a ring. */
+int ade9430_wfb_start(struct ade9430_dev *dev, struct ade9430_wfb_cfg *cfg,
+		      struct no_os_circular_buffer *cb);
+
+/* Move the pages signaled as full into the ring. */
+int ade9430_wfb_service(struct ade9430_dev *dev);
+
+/* Stop streaming the waveform buffer. */
+int ade9430_wfb_stop(struct ade9430_dev *dev);
+
 /* Initialize the device. */
 int ade9430_init(struct ade9430_dev **device,
 		 struct ade9430_init_param init_param);
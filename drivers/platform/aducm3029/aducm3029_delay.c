@@ -62,6 +62,18 @@ static struct no_os_timer_desc *dummy_timer;
 /** Used for counting milliseconds */
 static struct no_os_timer_desc *ms_timer;
 
+/** Free running microseconds counter used by no_os_get_time() */
+static struct no_os_timer_desc *time_timer;
+
+/** Free running milliseconds counter used by no_os_get_time() */
+static struct no_os_timer_desc *time_ms_timer;
+
+/** Last value of time_ms_timer, to detect its wrap around */
+static uint32_t time_last_ms;
+
+/** Milliseconds accumulated by the wraps of time_ms_timer */
+static uint64_t time_epoch_ms;
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -84,7 +96,7 @@ static uint32_t initialize_timer(struct no_os_timer_desc **timer,
 	param.ticks_count = 0;
 	param.platform_ops = &aducm_timer_ops;
 
-	if (is_us) {
+	if (is_us && !dummy_timer) {
 		if (0 != no_os_timer_init(&dummy_timer, &param))
 			return 0;
 		no_os_timer_start(dummy_timer);
@@ -136,3 +148,41 @@ void no_os_mdelay(uint32_t msecs)
 			return ;
 	start_and_wait(ms_timer, msecs);
 }
+
+/**
+ * @brief Get current time. The counters are started by the first call. The
+ * microseconds counter wraps around after about 71 minutes, so it only refines
+ * a milliseconds counter, extended to 64 bits on each wrap around. The time
+ * stays monotonic as long as the function is called at least every 49 days.
+ * @return Current time structure from the first call (seconds, microseconds).
+ */
+struct no_os_time no_os_get_time(void)
+{
+	struct no_os_time t = {0};
+	uint64_t time_us;
+	uint32_t ms, us;
+
+	if (!time_timer) {
+		if (!time_ms_timer && !initialize_timer(&time_ms_timer, 0))
+			return t;
+		if (!initialize_timer(&time_timer, 1))
+			return t;
+		no_os_timer_start(time_ms_timer);
+		no_os_timer_start(time_timer);
+	}
+
+	no_os_timer_counter_get(time_ms_timer, &ms);
+	no_os_timer_counter_get(time_timer, &us);
+	if (ms < time_last_ms)
+		time_epoch_ms += 1ULL << 32;
+	time_last_ms = ms;
+
+	/* Both counters run from the same base, add the sub-ms part */
+	time_us = (time_epoch_ms + ms) * 1000;
+	time_us += (int32_t)(us - (uint32_t)time_us);
+
+	t.s = time_us / 1000000;
+	t.us = time_us % 1000000;
+
+	return t;
+}
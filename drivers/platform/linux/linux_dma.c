@@ -0,0 +1,506 @@
+/***************************************************************************//**
+ *   @file   linux_dma.c
+ *   @brief  Source file for the Linux memcpy based DMA emulation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <pthread.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_dma.h"
+#include "no_os_irq.h"
+#include "linux_irq.h"
+#include "linux_dma.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+struct linux_dma_desc;
+
+/**
+ * @struct linux_dma_ch_state
+ * @brief State of an emulated DMA channel
+ */
+struct linux_dma_ch_state {
+	/** Controller the channel belongs to */
+	struct linux_dma_desc *ldesc;
+	/** Currently configured transfer */
+	struct no_os_dma_xfer_desc *xfer;
+	/** Transfer started, waiting for the engine */
+	bool armed;
+	/** Transfer handled by the engine */
+	bool busy;
+	/** Transfer aborted while handled by the engine */
+	bool aborted;
+};
+
+/**
+ * @struct linux_dma_desc
+ * @brief Linux platform specific DMA controller descriptor
+ */
+struct linux_dma_desc {
+	/** Generic descriptor of the controller */
+	struct no_os_dma_desc *desc;
+	/** Thread acting as the DMA engine */
+	pthread_t thread;
+	bool running;
+	/** Protects the channel states and statistics */
+	pthread_mutex_t lock;
+	/** Signaled when a transfer is started */
+	pthread_cond_t cond;
+	/** Timing model */
+	struct linux_dma_init_param model;
+	/** Next channel to be serviced, for round robin arbitration */
+	uint32_t next;
+	struct linux_dma_ch_state *ch;
+	struct linux_dma_stats stats;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Compute the modelled duration of a transfer.
+ * @param ldesc - The Linux DMA controller descriptor.
+ * @param length - Transfer length in bytes.
+ * @return Duration in nanoseconds.
+ */
+static uint64_t linux_dma_xfer_ns(struct linux_dma_desc *ldesc,
+				  uint32_t length)
+{
+	uint64_t ns = ldesc->model.setup_ns;
+
+	if (ldesc->model.bytes_per_sec)
+		ns += (uint64_t)length * 1000000000 /
+		      ldesc->model.bytes_per_sec;
+
+	return ns;
+}
+
+/**
+ * @brief DMA engine thread. Services the started channels in a round robin
+ * fashion and raises the channel interrupt once a transfer completes.
+ * @param arg - The Linux DMA controller descriptor.
+ * @return NULL
+ */
+static void *linux_dma_engine(void *arg)
+{
+	struct linux_dma_desc *ldesc = arg;
+	struct no_os_dma_desc *desc = ldesc->desc;
+	struct no_os_dma_xfer_desc *xfer;
+	struct linux_dma_ch_state *st;
+	struct timespec deadline;
+	uint64_t ns;
+	uint32_t i, n;
+
+	pthread_mutex_lock(&ldesc->lock);
+	while (ldesc->running) {
+		for (n = 0; n < desc->num_ch; n++) {
+			i = (ldesc->next + n) % desc->num_ch;
+			if (ldesc->ch[i].armed)
+				break;
+		}
+
+		if (n == desc->num_ch) {
+			pthread_cond_wait(&ldesc->cond, &ldesc->lock);
+			continue;
+		}
+
+		st = &ldesc->ch[i];
+		xfer = st->xfer;
+		st->armed = false;
+		st->busy = true;
+		ldesc->next = i + 1;
+		pthread_mutex_unlock(&ldesc->lock);
+
+		clock_gettime(CLOCK_MONOTONIC, &deadline);
+		memcpy(xfer->dst, xfer->src, xfer->length);
+
+		ns = linux_dma_xfer_ns(ldesc, xfer->length);
+		deadline.tv_sec += ns / 1000000000;
+		deadline.tv_nsec += ns % 1000000000;
+		if (deadline.tv_nsec >= 1000000000) {
+			deadline.tv_nsec -= 1000000000;
+			deadline.tv_sec++;
+		}
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME,
+				       &deadline, NULL) == EINTR)
+			;
+
+		pthread_mutex_lock(&ldesc->lock);
+		st->busy = false;
+		if (st->aborted) {
+			st->aborted = false;
+			ldesc->stats.aborts++;
+			continue;
+		}
+
+		ldesc->stats.xfers++;
+		ldesc->stats.bytes += xfer->length;
+		ldesc->stats.busy_ns += ns;
+		pthread_mutex_unlock(&ldesc->lock);
+
+		/*
+		 * The completion is signaled outside of the lock, since the
+		 * handler will start the next transfer from the SG list.
+		 */
+		if (desc->irq_ctrl)
+			linux_irq_trigger(desc->irq_ctrl,
+					  desc->channels[i].irq_num);
+		else
+			desc->channels[i].free = true;
+
+		pthread_mutex_lock(&ldesc->lock);
+	}
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize an emulated DMA controller.
+ * @param desc - Descriptor to be initialized.
+ * @param param - Initialization parameter for the descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_init(struct no_os_dma_desc **desc,
+			  struct no_os_dma_init_param *param)
+{
+	struct no_os_dma_desc *descriptor;
+	struct linux_dma_desc *ldesc;
+	uint32_t i;
+	int ret;
+
+	struct no_os_irq_init_param irq_param = {
+		.irq_ctrl_id = param->id,
+		.platform_ops = &linux_irq_ops,
+		.extra = NULL
+	};
+
+	if (!param->num_ch || param->num_ch > LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->channels = no_os_calloc(param->num_ch,
+					    sizeof(*descriptor->channels));
+	if (!descriptor->channels) {
+		ret = -ENOMEM;
+		goto free_descriptor;
+	}
+
+	ldesc = no_os_calloc(1, sizeof(*ldesc));
+	if (!ldesc) {
+		ret = -ENOMEM;
+		goto free_channels;
+	}
+
+	ldesc->ch = no_os_calloc(param->num_ch, sizeof(*ldesc->ch));
+	if (!ldesc->ch) {
+		ret = -ENOMEM;
+		goto free_ldesc;
+	}
+
+	if (param->extra)
+		ldesc->model = *(struct linux_dma_init_param *)param->extra;
+
+	ret = no_os_irq_ctrl_init(&descriptor->irq_ctrl, &irq_param);
+	if (ret)
+		goto free_ch;
+
+	descriptor->id = param->id;
+	descriptor->num_ch = param->num_ch;
+	descriptor->extra = ldesc;
+	descriptor->sg_handler = param->sg_handler;
+	for (i = 0; i < param->num_ch; i++) {
+		ldesc->ch[i].ldesc = ldesc;
+		descriptor->channels[i].id = i;
+		descriptor->channels[i].irq_num = i;
+		descriptor->channels[i].extra = &ldesc->ch[i];
+		descriptor->channels[i].free = true;
+	}
+
+	ldesc->desc = descriptor;
+	ldesc->running = true;
+	pthread_mutex_init(&ldesc->lock, NULL);
+	pthread_cond_init(&ldesc->cond, NULL);
+
+	ret = pthread_create(&ldesc->thread, NULL, linux_dma_engine, ldesc);
+	if (ret) {
+		ret = -ret;
+		goto remove_irq;
+	}
+
+	*desc = descriptor;
+
+	return 0;
+
+remove_irq:
+	pthread_cond_destroy(&ldesc->cond);
+	pthread_mutex_destroy(&ldesc->lock);
+	no_os_irq_ctrl_remove(descriptor->irq_ctrl);
+free_ch:
+	no_os_free(ldesc->ch);
+free_ldesc:
+	no_os_free(ldesc);
+free_channels:
+	no_os_free(descriptor->channels);
+free_descriptor:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the DMA engine and free the resources of the controller.
+ * @param desc - Descriptor to be freed.
+ * @return 0
+ */
+static int linux_dma_remove(struct no_os_dma_desc *desc)
+{
+	struct linux_dma_desc *ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->running = false;
+	pthread_cond_signal(&ldesc->cond);
+	pthread_mutex_unlock(&ldesc->lock);
+	pthread_join(ldesc->thread, NULL);
+
+	no_os_irq_ctrl_remove(desc->irq_ctrl);
+
+	pthread_cond_destroy(&ldesc->cond);
+	pthread_mutex_destroy(&ldesc->lock);
+	no_os_free(ldesc->ch);
+	no_os_free(ldesc);
+	no_os_free(desc->channels);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Get a free channel and mark it as busy.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The index of the acquired channel.
+ * @return 0 if a channel was acquired
+ * 	   -EBUSY if there are no free channels
+ */
+static int linux_dma_acquire_ch(struct no_os_dma_desc *desc, uint32_t *ch)
+{
+	struct linux_dma_desc *ldesc = desc->extra;
+	uint32_t i;
+	int ret = -EBUSY;
+
+	pthread_mutex_lock(&ldesc->lock);
+	for (i = 0; i < desc->num_ch; i++) {
+		if (!desc->channels[i].free || desc->channels[i].sync_lock ||
+		    ldesc->ch[i].armed || ldesc->ch[i].busy)
+			continue;
+
+		desc->channels[i].free = false;
+		*ch = i;
+		ret = 0;
+		break;
+	}
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Release a DMA channel, dropping its pending transfer.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The index of the channel.
+ * @return 0
+ */
+static int linux_dma_release_ch(struct no_os_dma_desc *desc, uint32_t ch)
+{
+	struct linux_dma_desc *ldesc = desc->extra;
+	struct linux_dma_ch_state *st = &ldesc->ch[ch];
+
+	pthread_mutex_lock(&ldesc->lock);
+	st->armed = false;
+	st->aborted = st->busy;
+	st->xfer = NULL;
+	desc->channels[ch].free = true;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Configure a DMA channel for a transfer.
+ * @param channel - The DMA channel descriptor.
+ * @param xfer - Descriptor for the transfer.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_config_xfer(struct no_os_dma_ch *channel,
+				 struct no_os_dma_xfer_desc *xfer)
+{
+	struct linux_dma_ch_state *st = channel->extra;
+
+	if (!xfer || !xfer->src || !xfer->dst)
+		return -EINVAL;
+
+	switch (xfer->xfer_type) {
+	case MEM_TO_MEM:
+	case MEM_TO_DEV:
+	case DEV_TO_MEM:
+		break;
+	default:
+		return -EINVAL;
+	}
+
+	pthread_mutex_lock(&st->ldesc->lock);
+	st->xfer = xfer;
+	pthread_mutex_unlock(&st->ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Hand the configured transfer of a channel to the DMA engine.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The DMA channel.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_dma_xfer_start(struct no_os_dma_desc *desc,
+				struct no_os_dma_ch *ch)
+{
+	struct linux_dma_desc *ldesc = desc->extra;
+	struct linux_dma_ch_state *st = ch->extra;
+	int ret = 0;
+
+	pthread_mutex_lock(&ldesc->lock);
+	if (!st->xfer) {
+		ret = -EINVAL;
+	} else {
+		st->armed = true;
+		pthread_cond_signal(&ldesc->cond);
+	}
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Abort the transfer of a channel. A transfer already handled by the
+ * engine completes, but its interrupt is not raised.
+ * @param desc - Descriptor for the DMA controller.
+ * @param ch - The DMA channel.
+ * @return 0
+ */
+static int linux_dma_xfer_abort(struct no_os_dma_desc *desc,
+				struct no_os_dma_ch *ch)
+{
+	struct linux_dma_desc *ldesc = desc->extra;
+	struct linux_dma_ch_state *st = ch->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	st->armed = false;
+	st->aborted = st->busy;
+	st->xfer = NULL;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Whether or not the channel has an ongoing DMA transfer.
+ * @param desc - DMA controller descriptor.
+ * @param ch - The channel for which we want to do the checking.
+ * @return true if the channel is busy, false otherwise.
+ */
+static bool linux_dma_in_progress(struct no_os_dma_desc *desc,
+				  struct no_os_dma_ch *ch)
+{
+	struct linux_dma_desc *ldesc = desc->extra;
+	struct linux_dma_ch_state *st = ch->extra;
+	bool ret;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ret = st->armed || st->busy;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return ret;
+}
+
+/**
+ * @brief Get the transfer statistics of a DMA controller.
+ * @param desc - DMA controller descriptor.
+ * @param stats - Filled with the controller statistics.
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int linux_dma_get_stats(struct no_os_dma_desc *desc,
+			struct linux_dma_stats *stats)
+{
+	struct linux_dma_desc *ldesc;
+
+	if (!desc || !desc->extra || !stats)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	*stats = ldesc->stats;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Linux platform specific callbacks for the DMA API
+ */
+struct no_os_dma_platform_ops linux_dma_ops = {
+	.dma_init = linux_dma_init,
+	.dma_remove = linux_dma_remove,
+	.dma_acquire_ch = linux_dma_acquire_ch,
+	.dma_release_ch = linux_dma_release_ch,
+	.dma_config_xfer = linux_dma_config_xfer,
+	.dma_xfer_start = linux_dma_xfer_start,
+	.dma_xfer_abort = linux_dma_xfer_abort,
+	.dma_ch_in_progress = linux_dma_in_progress,
+};
@@ -0,0 +1,92 @@
+/***************************************************************************//**
+ *   @file   linux_dma.h
+ *   @brief  Header file for the Linux memcpy based DMA emulation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_DMA_H_
+#define LINUX_DMA_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "no_os_dma.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_dma_init_param
+ * @brief Timing model of the emulated DMA controller. Passed through the
+ * extra field of the no_os_dma_init_param structure, may be NULL in which
+ * case the transfers complete as fast as memcpy() allows.
+ */
+struct linux_dma_init_param {
+	/** Modelled throughput in bytes per second, 0 for no limit */
+	uint32_t bytes_per_sec;
+	/** Fixed latency added to each transfer, in nanoseconds */
+	uint32_t setup_ns;
+};
+
+/**
+ * @struct linux_dma_stats
+ * @brief Statistics of the emulated DMA controller.
+ */
+struct linux_dma_stats {
+	/** Number of completed transfers */
+	uint32_t xfers;
+	/** Number of aborted transfers */
+	uint32_t aborts;
+	/** Number of bytes copied */
+	uint64_t bytes;
+	/** Total modelled bus time, in nanoseconds */
+	uint64_t busy_ns;
+};
+
+/**
+ * @brief Linux specific DMA platform ops structure
+ */
+extern struct no_os_dma_platform_ops linux_dma_ops;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Get the transfer statistics of a DMA controller. */
+int linux_dma_get_stats(struct no_os_dma_desc *desc,
+			struct linux_dma_stats *stats);
+
+#endif // LINUX_DMA_H_
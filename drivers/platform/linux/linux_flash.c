@@ -0,0 +1,352 @@
+/***************************************************************************//**
+ *   @file   linux_flash.c
+ *   @brief  Source file for the Linux file backed flash emulation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_flash.h"
+#include "linux_flash.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Value of an erased flash byte */
+#define LINUX_FLASH_ERASED	0xFF
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_flash_dev
+ * @brief Linux platform specific flash descriptor
+ */
+struct linux_flash_dev {
+	/** Backing file descriptor */
+	int fd;
+	/** One page worth of erased bytes */
+	uint8_t *erased_page;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Write a buffer to the backing file.
+ * @param fd - Backing file descriptor.
+ * @param buf - Data to be written.
+ * @param len - Number of bytes.
+ * @param offset - Offset in the backing file.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_flash_pwrite(int fd, const void *buf, uint32_t len,
+				  uint32_t offset)
+{
+	ssize_t ret;
+
+	while (len) {
+		ret = pwrite(fd, buf, len, offset);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return -errno;
+		}
+
+		buf = (const uint8_t *)buf + ret;
+		len -= ret;
+		offset += ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Read a buffer from the backing file.
+ * @param fd - Backing file descriptor.
+ * @param buf - Container for the read data.
+ * @param len - Number of bytes.
+ * @param offset - Offset in the backing file.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_flash_pread(int fd, void *buf, uint32_t len,
+				 uint32_t offset)
+{
+	ssize_t ret;
+
+	while (len) {
+		ret = pread(fd, buf, len, offset);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return -errno;
+		}
+		if (!ret)
+			return -EIO;
+
+		buf = (uint8_t *)buf + ret;
+		len -= ret;
+		offset += ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Initialize the flash emulation. The backing file is extended to the
+ * flash size and the added area is erased.
+ * @param device - Pointer to the driver handler.
+ * @param init_param - Pointer to the initialization structure.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t no_os_flash_init(struct no_os_flash_dev **device,
+			 struct no_os_flash_init_param *init_param)
+{
+	struct linux_flash_init_param *linux_param;
+	struct linux_flash_dev *linux_dev;
+	struct no_os_flash_dev *dev;
+	struct stat st;
+	uint32_t offset;
+	int32_t ret;
+
+	if (!device || !init_param || !init_param->extra ||
+	    !init_param->flash_page_size ||
+	    init_param->flash_size % init_param->flash_page_size)
+		return -EINVAL;
+
+	linux_param = init_param->extra;
+
+	dev = no_os_calloc(1, sizeof(*dev));
+	if (!dev)
+		return -ENOMEM;
+
+	linux_dev = no_os_calloc(1, sizeof(*linux_dev));
+	if (!linux_dev) {
+		ret = -ENOMEM;
+		goto error_dev;
+	}
+
+	linux_dev->erased_page = no_os_malloc(init_param->flash_page_size);
+	if (!linux_dev->erased_page) {
+		ret = -ENOMEM;
+		goto error_linux_dev;
+	}
+	memset(linux_dev->erased_page, LINUX_FLASH_ERASED,
+	       init_param->flash_page_size);
+
+	linux_dev->fd = open(linux_param->path, O_RDWR | O_CREAT | O_CLOEXEC,
+			     0644);
+	if (linux_dev->fd < 0) {
+		ret = -errno;
+		goto error_page;
+	}
+
+	if (fstat(linux_dev->fd, &st)) {
+		ret = -errno;
+		goto error_fd;
+	}
+
+	dev->id = init_param->id;
+	dev->flash_size = init_param->flash_size;
+	dev->page_size = init_param->flash_page_size;
+	dev->extra = linux_dev;
+
+	/* Erase the pages which are not yet present in the backing file. */
+	offset = st.st_size - st.st_size % dev->page_size;
+	for (; offset < dev->flash_size; offset += dev->page_size) {
+		ret = linux_flash_pwrite(linux_dev->fd, linux_dev->erased_page,
+					 dev->page_size, offset);
+		if (ret)
+			goto error_fd;
+	}
+
+	*device = dev;
+
+	return 0;
+
+error_fd:
+	close(linux_dev->fd);
+error_page:
+	no_os_free(linux_dev->erased_page);
+error_linux_dev:
+	no_os_free(linux_dev);
+error_dev:
+	no_os_free(dev);
+
+	return ret;
+}
+
+/**
+ * @brief Free memory allocated by no_os_flash_init().
+ * @param dev - Pointer to the driver handler.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t no_os_flash_remove(struct no_os_flash_dev *dev)
+{
+	struct linux_flash_dev *linux_dev;
+
+	if (!dev)
+		return -EINVAL;
+
+	linux_dev = dev->extra;
+
+	fsync(linux_dev->fd);
+	close(linux_dev->fd);
+	no_os_free(linux_dev->erased_page);
+	no_os_free(linux_dev);
+	no_os_free(dev);
+
+	return 0;
+}
+
+/**
+ * @brief Erase a flash page.
+ * @param dev - Pointer to the flash device handler.
+ * @param page_no - Page number.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t no_os_flash_clear_page(struct no_os_flash_dev *dev, int32_t page_no)
+{
+	struct linux_flash_dev *linux_dev;
+
+	if (!dev || page_no < 0 ||
+	    (uint32_t)page_no >= dev->flash_size / dev->page_size)
+		return -EINVAL;
+
+	linux_dev = dev->extra;
+
+	return linux_flash_pwrite(linux_dev->fd, linux_dev->erased_page,
+				  dev->page_size, page_no * dev->page_size);
+}
+
+/**
+ * @brief Write a page in flash memory.
+ * @param dev - Pointer to the flash device handler.
+ * @param page_no - Page number.
+ * @param data - Pointer to the data to be written, one page in size.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t no_os_flash_write_page(struct no_os_flash_dev *dev, int32_t page_no,
+			       uint32_t *data)
+{
+	struct linux_flash_dev *linux_dev;
+
+	if (!dev || !data || page_no < 0 ||
+	    (uint32_t)page_no >= dev->flash_size / dev->page_size)
+		return -EINVAL;
+
+	linux_dev = dev->extra;
+
+	return linux_flash_pwrite(linux_dev->fd, data, dev->page_size,
+				  page_no * dev->page_size);
+}
+
+/**
+ * @brief Read a page from flash memory.
+ * @param dev - Pointer to the flash device handler.
+ * @param page_no - Page number.
+ * @param data - Container for the read data, one page in size.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t flash_read_page(struct no_os_flash_dev *dev, int32_t page_no,
+			uint32_t *data)
+{
+	struct linux_flash_dev *linux_dev;
+
+	if (!dev || !data || page_no < 0 ||
+	    (uint32_t)page_no >= dev->flash_size / dev->page_size)
+		return -EINVAL;
+
+	linux_dev = dev->extra;
+
+	return linux_flash_pread(linux_dev->fd, data, dev->page_size,
+				 page_no * dev->page_size);
+}
+
+/**
+ * @brief Write data in flash memory.
+ * @param dev - Pointer to the flash device handler.
+ * @param flash_addr - Start address of the write.
+ * @param array - Pointer to the data to be written.
+ * @param array_size - Size of the written data in 32-bit words.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t no_os_flash_write(struct no_os_flash_dev *dev, uint32_t flash_addr,
+			  uint32_t *array, uint32_t array_size)
+{
+	struct linux_flash_dev *linux_dev;
+	uint32_t len = array_size * sizeof(uint32_t);
+
+	if (!dev || !array || flash_addr & 0x3 ||
+	    flash_addr + len > dev->flash_size)
+		return -EINVAL;
+
+	linux_dev = dev->extra;
+
+	return linux_flash_pwrite(linux_dev->fd, array, len, flash_addr);
+}
+
+/**
+ * @brief Read data from the flash memory.
+ * @param dev - Pointer to the flash device handler.
+ * @param flash_addr - Start address of the read.
+ * @param array - Pointer to the container for the read data.
+ * @param size - Size of the read data in 32-bit words.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t no_os_flash_read(struct no_os_flash_dev *dev, uint32_t flash_addr,
+			 uint32_t *array, uint32_t size)
+{
+	struct linux_flash_dev *linux_dev;
+	uint32_t len = size * sizeof(uint32_t);
+
+	if (!dev || !array || flash_addr & 0x3 ||
+	    flash_addr + len > dev->flash_size)
+		return -EINVAL;
+
+	linux_dev = dev->extra;
+
+	return linux_flash_pread(linux_dev->fd, array, len, flash_addr);
+}
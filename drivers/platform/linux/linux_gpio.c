@@ -50,8 +50,10 @@
 #include <fcntl.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 #include <sys/ioctl.h>
+#include <linux/gpio.h>
 
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
@@ -68,6 +70,15 @@ struct linux_gpio_desc {
 	int value_fd;
 };
 
+/**
+ * @struct linux_gpio_group_desc
+ * @brief Linux platform specific GPIO group descriptor
+ */
+struct linux_gpio_group_desc {
+	/** Line request file descriptor */
+	int line_fd;
+};
+
 /******************************************************************************/
 /************************ Functions Definitions *******************************/
 /******************************************************************************/
@@ -370,6 +381,168 @@ int32_t linux_gpio_get_direction(struct no_os_gpio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Obtain a GPIO group descriptor. The lines are requested through the
+ * GPIO character device, port selects /dev/gpiochip<port> and number is the
+ * line offset in the chip. All the pins must belong to the same chip and must
+ * not be exported through sysfs.
+ * @param desc - The GPIO group descriptor.
+ * @param param - GPIO group initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_group_get(struct no_os_gpio_group_desc **desc,
+			     const struct no_os_gpio_group_init_param *param)
+{
+	struct linux_gpio_group_desc *linux_desc;
+	struct no_os_gpio_group_desc *descriptor;
+	struct gpio_v2_line_config_attribute *attrs;
+	struct gpio_v2_line_request req;
+	char path[32];
+	int chip_fd;
+	int ret;
+	uint8_t i;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	memset(&req, 0, sizeof(req));
+	for (i = 0; i < param->nb_pins; i++) {
+		if (param->pins[i].port != param->pins[0].port)
+			return -EINVAL;
+		req.offsets[i] = param->pins[i].number;
+	}
+	req.num_lines = param->nb_pins;
+	strncpy(req.consumer, "no-os", sizeof(req.consumer) - 1);
+	req.config.flags = GPIO_V2_LINE_FLAG_INPUT;
+	if (param->out_mask) {
+		attrs = req.config.attrs;
+		attrs[0].attr.id = GPIO_V2_LINE_ATTR_ID_FLAGS;
+		attrs[0].attr.flags = GPIO_V2_LINE_FLAG_OUTPUT;
+		attrs[0].mask = param->out_mask;
+		attrs[1].attr.id = GPIO_V2_LINE_ATTR_ID_OUTPUT_VALUES;
+		attrs[1].attr.values = param->init_values;
+		attrs[1].mask = param->out_mask;
+		req.config.num_attrs = 2;
+	}
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	linux_desc = no_os_calloc(1, sizeof(*linux_desc));
+	if (!linux_desc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	sprintf(path, "/dev/gpiochip%d", (int)param->pins[0].port);
+	chip_fd = open(path, O_RDONLY);
+	if (chip_fd < 0) {
+		ret = -errno;
+		printf("%s: Can't open %s\n\r", __func__, path);
+		goto free_linux_desc;
+	}
+
+	ret = ioctl(chip_fd, GPIO_V2_GET_LINE_IOCTL, &req);
+	if (ret < 0) {
+		ret = -errno;
+		printf("%s: Can't request the lines\n\r", __func__);
+		close(chip_fd);
+		goto free_linux_desc;
+	}
+	close(chip_fd);
+
+	linux_desc->line_fd = req.fd;
+	descriptor->nb_pins = param->nb_pins;
+	descriptor->out_mask = param->out_mask;
+	descriptor->extra = linux_desc;
+	*desc = descriptor;
+
+	return 0;
+
+free_linux_desc:
+	no_os_free(linux_desc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the resources allocated by linux_gpio_group_get().
+ * @param desc - The GPIO group descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_group_remove(struct no_os_gpio_group_desc *desc)
+{
+	struct linux_gpio_group_desc *linux_desc;
+
+	if (!desc)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+	close(linux_desc->line_fd);
+
+	no_os_free(linux_desc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Set the level of the group outputs selected by a mask, with a single
+ * GPIO_V2_LINE_SET_VALUES_IOCTL.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Pins to update, bit i selects the pin i of the group.
+ * @param values - Levels of the selected pins, bit i for the pin i.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_group_set_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t values)
+{
+	struct linux_gpio_group_desc *linux_desc;
+	struct gpio_v2_line_values lv;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+	lv.bits = values;
+	lv.mask = mask;
+	if (ioctl(linux_desc->line_fd, GPIO_V2_LINE_SET_VALUES_IOCTL, &lv) < 0)
+		return -errno;
+
+	return 0;
+}
+
+/**
+ * @brief Get the level of the group pins selected by a mask, with a single
+ * GPIO_V2_LINE_GET_VALUES_IOCTL.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Pins to read, bit i selects the pin i of the group.
+ * @param values - Levels of the selected pins, bit i for the pin i.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t linux_gpio_group_get_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t *values)
+{
+	struct linux_gpio_group_desc *linux_desc;
+	struct gpio_v2_line_values lv;
+
+	if (!desc || !desc->extra || !values)
+		return -EINVAL;
+
+	linux_desc = desc->extra;
+	lv.bits = 0;
+	lv.mask = mask;
+	if (ioctl(linux_desc->line_fd, GPIO_V2_LINE_GET_VALUES_IOCTL, &lv) < 0)
+		return -errno;
+
+	*values = lv.bits & mask;
+
+	return 0;
+}
+
 /**
  * @brief Linux platform specific GPIO platform ops structure
  */
@@ -382,4 +555,8 @@ const struct no_os_gpio_platform_ops linux_gpio_ops = {
 	.gpio_ops_get_direction = &linux_gpio_get_direction,
 	.gpio_ops_set_value = &linux_gpio_set_value,
 	.gpio_ops_get_value = &linux_gpio_get_value,
+	.gpio_ops_group_get = &linux_gpio_group_get,
+	.gpio_ops_group_remove = &linux_gpio_group_remove,
+	.gpio_ops_group_set_values = &linux_gpio_group_set_values,
+	.gpio_ops_group_get_values = &linux_gpio_group_get_values,
 };
@@ -0,0 +1,670 @@
+/***************************************************************************//**
+ *   @file   linux_irq.c
+ *   @brief  Source file for the Linux IRQ controller emulation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_irq.h"
+#include "linux_irq.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_line
+ * @brief State of an emulated interrupt line
+ */
+struct linux_irq_line {
+	/** Handler registered for the line */
+	void (*callback)(void *context);
+	/** Handler parameter */
+	void *ctx;
+	/** Priority level, lower values are serviced first */
+	uint32_t priority;
+	/** Trigger level, kept for the sources that can emulate it */
+	enum no_os_irq_trig_level trig;
+	/** timerfd used as a periodic source, -1 if not used */
+	int timer_fd;
+	/** Statistics */
+	atomic_uint raised;
+	atomic_uint handled;
+	atomic_uint coalesced;
+};
+
+/**
+ * @struct linux_irq_desc
+ * @brief Linux platform specific IRQ controller descriptor
+ */
+struct linux_irq_desc {
+	/** eventfd used to wake up the dispatcher thread */
+	int event_fd;
+	/** Dispatcher thread, the emulated interrupt context */
+	pthread_t thread;
+	atomic_bool running;
+	/** Protects the line configuration */
+	pthread_mutex_t lock;
+	/**
+	 * Recursive mutex held by the dispatcher while a handler runs and by
+	 * the application while interrupts are globally disabled.
+	 */
+	pthread_mutex_t global_lock;
+	/** Pending and enabled line bitmasks */
+	atomic_uint_fast64_t pending;
+	atomic_uint_fast64_t enabled;
+	struct linux_irq_line lines[LINUX_IRQ_MAX_LINES];
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Wake up the dispatcher thread.
+ * @param ldesc - The Linux IRQ controller descriptor.
+ */
+static void linux_irq_kick(struct linux_irq_desc *ldesc)
+{
+	uint64_t one = 1;
+	ssize_t ret;
+
+	ret = write(ldesc->event_fd, &one, sizeof(one));
+	(void)ret;
+}
+
+/**
+ * @brief Mark a line as pending, without waking up the dispatcher.
+ * @param ldesc - The Linux IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param events - Number of events signaled on the line.
+ */
+static void linux_irq_raise(struct linux_irq_desc *ldesc, uint32_t irq_id,
+			    uint32_t events)
+{
+	struct linux_irq_line *line = &ldesc->lines[irq_id];
+	uint64_t bit = (uint64_t)1 << irq_id;
+	uint64_t prev;
+
+	prev = atomic_fetch_or(&ldesc->pending, bit);
+	atomic_fetch_add(&line->raised, events);
+	if (prev & bit)
+		atomic_fetch_add(&line->coalesced, events);
+	else if (events > 1)
+		atomic_fetch_add(&line->coalesced, events - 1);
+}
+
+/**
+ * @brief Call the handlers of the pending and enabled lines, highest priority
+ * first.
+ * @param ldesc - The Linux IRQ controller descriptor.
+ */
+static void linux_irq_service(struct linux_irq_desc *ldesc)
+{
+	struct linux_irq_line *line;
+	void (*callback)(void *);
+	uint64_t active;
+	uint32_t best;
+	uint32_t i;
+	void *ctx;
+	struct linux_irq_line *lines = ldesc->lines;
+
+	while (atomic_load(&ldesc->running)) {
+		pthread_mutex_lock(&ldesc->global_lock);
+
+		active = atomic_load(&ldesc->pending) &
+			 atomic_load(&ldesc->enabled);
+		if (!active) {
+			pthread_mutex_unlock(&ldesc->global_lock);
+			return;
+		}
+
+		pthread_mutex_lock(&ldesc->lock);
+		best = LINUX_IRQ_MAX_LINES;
+		for (i = 0; i < LINUX_IRQ_MAX_LINES; i++) {
+			if (!(active & ((uint64_t)1 << i)))
+				continue;
+			if (best == LINUX_IRQ_MAX_LINES ||
+			    lines[i].priority < lines[best].priority)
+				best = i;
+		}
+		line = &lines[best];
+		callback = line->callback;
+		ctx = line->ctx;
+		pthread_mutex_unlock(&ldesc->lock);
+
+		atomic_fetch_and(&ldesc->pending, ~((uint64_t)1 << best));
+		if (callback) {
+			callback(ctx);
+			atomic_fetch_add(&line->handled, 1);
+		}
+
+		pthread_mutex_unlock(&ldesc->global_lock);
+	}
+}
+
+/**
+ * @brief Dispatcher thread. Waits for software triggers and periodic sources
+ * and runs the interrupt handlers.
+ * @param arg - The Linux IRQ controller descriptor.
+ * @return NULL
+ */
+static void *linux_irq_dispatch(void *arg)
+{
+	struct pollfd fds[LINUX_IRQ_MAX_LINES + 1];
+	uint32_t fd_line[LINUX_IRQ_MAX_LINES + 1];
+	struct linux_irq_desc *ldesc = arg;
+	uint64_t val;
+	uint32_t nfds;
+	uint32_t i;
+	int ret;
+
+	while (atomic_load(&ldesc->running)) {
+		fds[0].fd = ldesc->event_fd;
+		fds[0].events = POLLIN;
+		nfds = 1;
+
+		pthread_mutex_lock(&ldesc->lock);
+		for (i = 0; i < LINUX_IRQ_MAX_LINES; i++) {
+			if (ldesc->lines[i].timer_fd < 0)
+				continue;
+			fds[nfds].fd = ldesc->lines[i].timer_fd;
+			fds[nfds].events = POLLIN;
+			fd_line[nfds] = i;
+			nfds++;
+		}
+		pthread_mutex_unlock(&ldesc->lock);
+
+		ret = poll(fds, nfds, -1);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		if (fds[0].revents & POLLIN)
+			ret = read(ldesc->event_fd, &val, sizeof(val));
+
+		for (i = 1; i < nfds; i++) {
+			if (!(fds[i].revents & POLLIN))
+				continue;
+			if (read(fds[i].fd, &val, sizeof(val)) != sizeof(val))
+				continue;
+			linux_irq_raise(ldesc, fd_line[i], val);
+		}
+
+		linux_irq_service(ldesc);
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief Initialize an emulated interrupt controller.
+ * @param desc - The IRQ controller descriptor.
+ * @param param - The structure that contains the IRQ parameters.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_ctrl_init(struct no_os_irq_ctrl_desc **desc,
+				   const struct no_os_irq_init_param *param)
+{
+	struct no_os_irq_ctrl_desc *descriptor;
+	struct linux_irq_desc *ldesc;
+	pthread_mutexattr_t attr;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ldesc = no_os_calloc(1, sizeof(*ldesc));
+	if (!ldesc) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ldesc->event_fd = eventfd(0, EFD_CLOEXEC);
+	if (ldesc->event_fd < 0) {
+		ret = -errno;
+		goto free_ldesc;
+	}
+
+	pthread_mutexattr_init(&attr);
+	pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+	pthread_mutex_init(&ldesc->global_lock, &attr);
+	pthread_mutexattr_destroy(&attr);
+	pthread_mutex_init(&ldesc->lock, NULL);
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++)
+		ldesc->lines[i].timer_fd = -1;
+
+	atomic_store(&ldesc->running, true);
+	ret = pthread_create(&ldesc->thread, NULL, linux_irq_dispatch, ldesc);
+	if (ret) {
+		ret = -ret;
+		goto close_fd;
+	}
+
+	descriptor->irq_ctrl_id = param->irq_ctrl_id;
+	descriptor->extra = ldesc;
+
+	*desc = descriptor;
+
+	return 0;
+
+close_fd:
+	pthread_mutex_destroy(&ldesc->lock);
+	pthread_mutex_destroy(&ldesc->global_lock);
+	close(ldesc->event_fd);
+free_ldesc:
+	no_os_free(ldesc);
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Stop the dispatcher and free the resources of the controller.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_ctrl_remove(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc *ldesc;
+	uint32_t i;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	atomic_store(&ldesc->running, false);
+	linux_irq_kick(ldesc);
+	pthread_join(ldesc->thread, NULL);
+
+	for (i = 0; i < LINUX_IRQ_MAX_LINES; i++)
+		if (ldesc->lines[i].timer_fd >= 0)
+			close(ldesc->lines[i].timer_fd);
+
+	close(ldesc->event_fd);
+	pthread_mutex_destroy(&ldesc->lock);
+	pthread_mutex_destroy(&ldesc->global_lock);
+	no_os_free(ldesc);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Register a handler for an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param cb - Callback descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_register_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !cb || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->lines[irq_id].callback = cb->callback;
+	ldesc->lines[irq_id].ctx = cb->ctx;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Unregister the handler of an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param cb - Callback descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_unregister_callback(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		struct no_os_callback_desc *cb)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->lines[irq_id].callback = NULL;
+	ldesc->lines[irq_id].ctx = NULL;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Allow the dispatcher to run the interrupt handlers. Must be called
+ * from the thread that disabled the interrupts.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_global_enable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	/* Enabling without a previous disable is not an error. */
+	pthread_mutex_unlock(&ldesc->global_lock);
+	linux_irq_kick(ldesc);
+
+	return 0;
+}
+
+/**
+ * @brief Block the interrupt handlers. Waits for a running handler to return.
+ * @param desc - The IRQ controller descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_global_disable(struct no_os_irq_ctrl_desc *desc)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	return -pthread_mutex_lock(&ldesc->global_lock);
+}
+
+/**
+ * @brief Set the trigger level of an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param trig - Trigger level.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_trigger_level_set(struct no_os_irq_ctrl_desc *desc,
+		uint32_t irq_id,
+		enum no_os_irq_trig_level trig)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	ldesc->lines[irq_id].trig = trig;
+
+	return 0;
+}
+
+/**
+ * @brief Enable an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_enable(struct no_os_irq_ctrl_desc *desc,
+				uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+	uint64_t bit;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	bit = (uint64_t)1 << irq_id;
+
+	atomic_fetch_or(&ldesc->enabled, bit);
+	if (atomic_load(&ldesc->pending) & bit)
+		linux_irq_kick(ldesc);
+
+	return 0;
+}
+
+/**
+ * @brief Disable an interrupt line. Events raised while disabled stay pending.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_disable(struct no_os_irq_ctrl_desc *desc,
+				 uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	atomic_fetch_and(&ldesc->enabled, ~((uint64_t)1 << irq_id));
+
+	return 0;
+}
+
+/**
+ * @brief Set the priority of an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param priority_level - Priority, lower values are serviced first.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_set_priority(struct no_os_irq_ctrl_desc *desc,
+				      uint32_t irq_id,
+				      uint32_t priority_level)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	pthread_mutex_lock(&ldesc->lock);
+	ldesc->lines[irq_id].priority = priority_level;
+	pthread_mutex_unlock(&ldesc->lock);
+
+	return 0;
+}
+
+/**
+ * @brief Clear a pending interrupt.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int32_t linux_irq_clear_pending(struct no_os_irq_ctrl_desc *desc,
+				       uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	atomic_fetch_and(&ldesc->pending, ~((uint64_t)1 << irq_id));
+
+	return 0;
+}
+
+/**
+ * @brief Raise an interrupt line. It is safe to call this from any thread or
+ * from a signal handler.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t linux_irq_trigger(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id)
+{
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	linux_irq_raise(ldesc, irq_id, 1);
+	linux_irq_kick(ldesc);
+
+	return 0;
+}
+
+/**
+ * @brief Raise an interrupt line periodically, using a timerfd source.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param period_ns - Period in nanoseconds, 0 to stop the source.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t linux_irq_set_period(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     uint64_t period_ns)
+{
+	struct itimerspec its = {0};
+	struct linux_irq_desc *ldesc;
+	bool new_source = false;
+	int ret = 0;
+	int fd;
+
+	if (!desc || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+
+	its.it_interval.tv_sec = period_ns / 1000000000;
+	its.it_interval.tv_nsec = period_ns % 1000000000;
+	its.it_value = its.it_interval;
+
+	pthread_mutex_lock(&ldesc->lock);
+
+	fd = ldesc->lines[irq_id].timer_fd;
+	if (fd < 0) {
+		if (!period_ns)
+			goto unlock;
+
+		fd = timerfd_create(CLOCK_MONOTONIC, TFD_CLOEXEC);
+		if (fd < 0) {
+			ret = -errno;
+			goto unlock;
+		}
+
+		ldesc->lines[irq_id].timer_fd = fd;
+		new_source = true;
+	}
+
+	if (timerfd_settime(fd, 0, &its, NULL))
+		ret = -errno;
+
+unlock:
+	pthread_mutex_unlock(&ldesc->lock);
+
+	/* Let the dispatcher add the new source to its poll set. */
+	if (new_source)
+		linux_irq_kick(ldesc);
+
+	return ret;
+}
+
+/**
+ * @brief Get the dispatch statistics of an interrupt line.
+ * @param desc - The IRQ controller descriptor.
+ * @param irq_id - Interrupt line.
+ * @param stats - Filled with the line statistics.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+int32_t linux_irq_get_stats(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			    struct linux_irq_stats *stats)
+{
+	struct linux_irq_line *line;
+	struct linux_irq_desc *ldesc;
+
+	if (!desc || !stats || irq_id >= LINUX_IRQ_MAX_LINES)
+		return -EINVAL;
+
+	ldesc = desc->extra;
+	line = &ldesc->lines[irq_id];
+
+	stats->raised = atomic_load(&line->raised);
+	stats->handled = atomic_load(&line->handled);
+	stats->coalesced = atomic_load(&line->coalesced);
+
+	return 0;
+}
+
+/**
+ * @brief Linux platform specific IRQ platform ops structure
+ */
+const struct no_os_irq_platform_ops linux_irq_ops = {
+	.init = &linux_irq_ctrl_init,
+	.register_callback = &linux_irq_register_callback,
+	.unregister_callback = &linux_irq_unregister_callback,
+	.global_enable = &linux_irq_global_enable,
+	.global_disable = &linux_irq_global_disable,
+	.trigger_level_set = &linux_irq_trigger_level_set,
+	.enable = &linux_irq_enable,
+	.disable = &linux_irq_disable,
+	.set_priority = &linux_irq_set_priority,
+	.clear_pending = &linux_irq_clear_pending,
+	.remove = &linux_irq_ctrl_remove
+};
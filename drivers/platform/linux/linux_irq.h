@@ -0,0 +1,90 @@
+/***************************************************************************//**
+ *   @file   linux_irq.h
+ *   @brief  Header file for the Linux IRQ controller emulation.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef LINUX_IRQ_H_
+#define LINUX_IRQ_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include "no_os_irq.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+/** Number of interrupt lines of an emulated controller */
+#define LINUX_IRQ_MAX_LINES	64
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct linux_irq_stats
+ * @brief Per line dispatch statistics of the emulated controller.
+ */
+struct linux_irq_stats {
+	/** Number of times the line was raised */
+	uint32_t raised;
+	/** Number of times the registered handler was called */
+	uint32_t handled;
+	/** Number of events merged into an already pending interrupt */
+	uint32_t coalesced;
+};
+
+/**
+ * @brief Linux specific IRQ platform ops structure
+ */
+extern const struct no_os_irq_platform_ops linux_irq_ops;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Raise an interrupt line. Async-signal-safe. */
+int32_t linux_irq_trigger(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id);
+
+/* Periodically raise an interrupt line, a period of 0 stops it. */
+int32_t linux_irq_set_period(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			     uint64_t period_ns);
+
+/* Get the dispatch statistics of an interrupt line. */
+int32_t linux_irq_get_stats(struct no_os_irq_ctrl_desc *desc, uint32_t irq_id,
+			    struct linux_irq_stats *stats);
+
+#endif // LINUX_IRQ_H_
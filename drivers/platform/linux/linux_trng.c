@@ -0,0 +1,128 @@
+/***************************************************************************//**
+ *   @file   linux_trng.c
+ *   @brief  Source file for the Linux TRNG platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <errno.h>
+#include <sys/random.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_trng.h"
+#include "linux_trng.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize the TRNG descriptor.
+ * @param desc - The TRNG descriptor.
+ * @param param - The structure that contains the TRNG initial parameters.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_trng_init(struct no_os_trng_desc **desc,
+			   const struct no_os_trng_init_param *param)
+{
+	struct no_os_trng_desc *descriptor;
+
+	if (!desc)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Free the TRNG descriptor.
+ * @param desc - The TRNG descriptor.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_trng_remove(struct no_os_trng_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Fill a buffer with random bytes from the kernel entropy source.
+ * @param desc - The TRNG descriptor.
+ * @param buff - Buffer to be filled.
+ * @param len - Length of the buffer.
+ * @return 0 in case of success, negative errno error codes otherwise.
+ */
+static int linux_trng_fill_buffer(struct no_os_trng_desc *desc, uint8_t *buff,
+				  uint32_t len)
+{
+	ssize_t ret;
+
+	if (!buff)
+		return -EINVAL;
+
+	while (len) {
+		ret = getrandom(buff, len, 0);
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+			return -errno;
+		}
+
+		buff += ret;
+		len -= ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Linux platform specific TRNG platform ops structure
+ */
+const struct no_os_trng_platform_ops linux_trng_ops = {
+	.init = &linux_trng_init,
+	.fill_buffer = &linux_trng_fill_buffer,
+	.remove = &linux_trng_remove
+};
@@ -0,0 +1,348 @@
+/***************************************************************************//**
+ *   @file   sim_ad74413r.c
+ *   @brief  Simulation model of the AD74413R/AD74412R I/O device.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_crc8.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "sim_ad74413r.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define SIM_AD74413R_NUM_REGS		0x80
+#define SIM_AD74413R_FRAME_SIZE		4
+#define SIM_AD74413R_CRC_POLYNOMIAL	0x07
+
+#define SIM_AD74413R_REG_NOP		0x00
+#define SIM_AD74413R_REG_ADC_CONFIG(x)	(0x05 + (x))
+#define SIM_AD74413R_REG_ADC_CONV_CTRL	0x23
+#define SIM_AD74413R_REG_ADC_RESULT(x)	(0x26 + (x))
+#define SIM_AD74413R_REG_DIAG_RESULT(x)	(0x2A + (x))
+#define SIM_AD74413R_REG_ADC_RESULT_D	SIM_AD74413R_REG_ADC_RESULT(3)
+#define SIM_AD74413R_REG_DIAG_RESULT_D	SIM_AD74413R_REG_DIAG_RESULT(3)
+#define SIM_AD74413R_REG_ALERT_STATUS	0x2E
+#define SIM_AD74413R_REG_LIVE_STATUS	0x2F
+#define SIM_AD74413R_REG_READ_SELECT	0x41
+#define SIM_AD74413R_REG_CMD_KEY	0x44
+#define SIM_AD74413R_REG_SILICON_REV	0x46
+
+#define SIM_AD74413R_KEY_RESET_1	0x15FA
+#define SIM_AD74413R_KEY_RESET_2	0xAF51
+#define SIM_AD74413R_SPI_CRC_ERR	NO_OS_BIT(13)
+#define SIM_AD74413R_RESET_OCCURRED	NO_OS_BIT(0)
+#define SIM_AD74413R_ADC_DATA_RDY	NO_OS_BIT(14)
+#define SIM_AD74413R_READ_ADDR_MASK	NO_OS_GENMASK(7, 0)
+#define SIM_AD74413R_CONV_SEQ_MASK	NO_OS_GENMASK(9, 8)
+#define SIM_AD74413R_CONV_SINGLE	1
+#define SIM_AD74413R_CONV_CONT		2
+#define SIM_AD74413R_REJECTION_MASK	NO_OS_GENMASK(4, 3)
+#define SIM_AD74413R_SILICON_REV	0x08
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad74413r
+ * @brief State of the AD74413R model.
+ */
+struct sim_ad74413r {
+	struct sim_device dev;
+	uint16_t regs[SIM_AD74413R_NUM_REGS];
+	/** Completed conversion sequences */
+	struct sim_fifo seq;
+	struct sim_gen adc[SIM_AD74413R_N_CHANNELS];
+	struct sim_gen diag[SIM_AD74413R_N_CHANNELS];
+	uint8_t crc_table[NO_OS_CRC8_TABLE_SIZE];
+	/** Frame clocked in by the controller */
+	uint8_t rx[SIM_AD74413R_FRAME_SIZE];
+	/** Frame clocked out by the device */
+	uint8_t tx[SIM_AD74413R_FRAME_SIZE];
+	/** The first reset key was written */
+	bool reset_armed;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/** Conversion time of a channel by rejection setting, in microseconds */
+static const uint32_t sim_ad74413r_conv_us[] = { 50000, 208, 100000, 833 };
+
+/**
+ * @brief Load the power-on values of the registers.
+ * @param sim - The model.
+ */
+static void sim_ad74413r_defaults(struct sim_ad74413r *sim)
+{
+	memset(sim->regs, 0, sizeof(sim->regs));
+	sim->regs[SIM_AD74413R_REG_ALERT_STATUS] = SIM_AD74413R_RESET_OCCURRED;
+	sim->regs[SIM_AD74413R_REG_SILICON_REV] = SIM_AD74413R_SILICON_REV;
+	memset(&sim->seq, 0, sizeof(sim->seq));
+	sim->seq.depth = 1;
+	sim->reset_armed = false;
+}
+
+/**
+ * @brief Restart the conversion sequence after a change of ADC_CONV_CTRL.
+ * @param sim - The model.
+ */
+static void sim_ad74413r_start_seq(struct sim_ad74413r *sim)
+{
+	uint16_t ctrl = sim->regs[SIM_AD74413R_REG_ADC_CONV_CTRL];
+	uint32_t seq_us = 0;
+	uint32_t odr = 0;
+	uint32_t rej;
+	uint16_t cfg;
+	int ch;
+
+	for (ch = 0; ch < SIM_AD74413R_N_CHANNELS; ch++) {
+		if (!(ctrl & NO_OS_BIT(ch)))
+			continue;
+
+		cfg = sim->regs[SIM_AD74413R_REG_ADC_CONFIG(ch)];
+		rej = no_os_field_get(SIM_AD74413R_REJECTION_MASK, cfg);
+		seq_us += sim_ad74413r_conv_us[rej];
+	}
+
+	switch (no_os_field_get(SIM_AD74413R_CONV_SEQ_MASK, ctrl)) {
+	case SIM_AD74413R_CONV_SINGLE:
+	case SIM_AD74413R_CONV_CONT:
+		if (seq_us)
+			odr = no_os_max(1000000 / seq_us, 1u);
+		break;
+	default:
+		break;
+	}
+
+	sim->seq.level = 0;
+	sim_fifo_set_odr(&sim->seq, odr, sim_device_time_ns(&sim->dev));
+}
+
+/**
+ * @brief Read a register, with the side effects of the data registers.
+ * @param sim - The model.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+static uint16_t sim_ad74413r_reg_get(struct sim_ad74413r *sim, uint32_t addr)
+{
+	uint32_t ch;
+
+	if (addr >= SIM_AD74413R_NUM_REGS)
+		return 0;
+
+	sim_fifo_update(&sim->seq, sim_device_time_ns(&sim->dev));
+
+	switch (addr) {
+	case SIM_AD74413R_REG_ADC_RESULT(0) ... SIM_AD74413R_REG_ADC_RESULT_D:
+		ch = addr - SIM_AD74413R_REG_ADC_RESULT(0);
+		if (sim->seq.produced)
+			sim->regs[addr] = sim_gen_next(&sim->adc[ch]);
+		break;
+	case SIM_AD74413R_REG_DIAG_RESULT(0) ... SIM_AD74413R_REG_DIAG_RESULT_D:
+		ch = addr - SIM_AD74413R_REG_DIAG_RESULT(0);
+		sim->regs[addr] = sim_gen_next(&sim->diag[ch]);
+		break;
+	case SIM_AD74413R_REG_LIVE_STATUS:
+		if (sim->seq.level)
+			sim->regs[addr] |= SIM_AD74413R_ADC_DATA_RDY;
+		break;
+	default:
+		break;
+	}
+
+	return sim->regs[addr];
+}
+
+/**
+ * @brief Write a register.
+ * @param sim - The model.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+static void sim_ad74413r_reg_set(struct sim_ad74413r *sim, uint32_t addr,
+				 uint16_t val)
+{
+	if (addr >= SIM_AD74413R_NUM_REGS)
+		return;
+
+	switch (addr) {
+	case SIM_AD74413R_REG_NOP:
+		return;
+	case SIM_AD74413R_REG_ALERT_STATUS:
+	case SIM_AD74413R_REG_LIVE_STATUS:
+		/* Write 1 to clear */
+		sim->regs[addr] &= ~val;
+		if (val & SIM_AD74413R_ADC_DATA_RDY)
+			sim_fifo_pop(&sim->seq);
+		return;
+	case SIM_AD74413R_REG_CMD_KEY:
+		if (sim->reset_armed && val == SIM_AD74413R_KEY_RESET_2) {
+			sim_ad74413r_defaults(sim);
+			return;
+		}
+		sim->reset_armed = val == SIM_AD74413R_KEY_RESET_1;
+		return;
+	case SIM_AD74413R_REG_SILICON_REV:
+		return;
+	default:
+		break;
+	}
+
+	sim->regs[addr] = val;
+	if (addr == SIM_AD74413R_REG_ADC_CONV_CTRL)
+		sim_ad74413r_start_seq(sim);
+}
+
+/**
+ * @brief Chip select asserted, prepare the readback frame selected by the
+ * previous frame.
+ * @param dev - The simulated device.
+ */
+static void sim_ad74413r_spi_begin(struct sim_device *dev)
+{
+	struct sim_ad74413r *sim = dev->priv;
+	uint16_t sel = sim->regs[SIM_AD74413R_REG_READ_SELECT];
+	uint8_t addr = sel & SIM_AD74413R_READ_ADDR_MASK;
+
+	sim->tx[0] = addr;
+	no_os_put_unaligned_be16(sim_ad74413r_reg_get(sim, addr), &sim->tx[1]);
+	sim->tx[3] = no_os_crc8(sim->crc_table, sim->tx, 3, 0);
+}
+
+/**
+ * @brief Exchange one byte of the 32 bit frame.
+ * @param dev - The simulated device.
+ * @param tx - Byte sent by the controller.
+ * @return Byte sent by the device.
+ */
+static uint8_t sim_ad74413r_spi_byte(struct sim_device *dev, uint8_t tx)
+{
+	struct sim_ad74413r *sim = dev->priv;
+	uint8_t rx = 0;
+
+	if (dev->pos < SIM_AD74413R_FRAME_SIZE) {
+		sim->rx[dev->pos] = tx;
+		rx = sim->tx[dev->pos];
+	}
+	dev->pos++;
+
+	return rx;
+}
+
+/**
+ * @brief Chip select deasserted, execute the frame if its CRC is valid.
+ * @param dev - The simulated device.
+ */
+static void sim_ad74413r_spi_end(struct sim_device *dev)
+{
+	struct sim_ad74413r *sim = dev->priv;
+
+	if (dev->pos != SIM_AD74413R_FRAME_SIZE)
+		return;
+
+	if (no_os_crc8(sim->crc_table, sim->rx, 3, 0) != sim->rx[3]) {
+		sim->regs[SIM_AD74413R_REG_ALERT_STATUS] |=
+			SIM_AD74413R_SPI_CRC_ERR;
+		return;
+	}
+
+	sim_ad74413r_reg_set(sim, sim->rx[0],
+			     no_os_get_unaligned_be16(&sim->rx[1]));
+}
+
+/**
+ * @brief Free the model.
+ * @param dev - The simulated device.
+ */
+static void sim_ad74413r_remove(struct sim_device *dev)
+{
+	no_os_free(dev->priv);
+}
+
+static const struct sim_device_ops sim_ad74413r_ops = {
+	.spi_begin = sim_ad74413r_spi_begin,
+	.spi_byte = sim_ad74413r_spi_byte,
+	.spi_end = sim_ad74413r_spi_end,
+	.remove = sim_ad74413r_remove,
+};
+
+/**
+ * @brief Create an AD74413R model. Each transaction is a CRC protected
+ * 32 bit frame, and the readback of a register is returned in the frame
+ * following the write of READ_SELECT.
+ * @param dev - The simulated device.
+ * @param param - Model parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_ad74413r_init(struct sim_device **dev,
+		      const struct sim_ad74413r_init_param *param)
+{
+	struct sim_ad74413r *sim;
+	int ret;
+
+	if (!dev || !param)
+		return -EINVAL;
+
+	sim = no_os_calloc(1, sizeof(*sim));
+	if (!sim)
+		return -ENOMEM;
+
+	ret = sim_device_init(&sim->dev, "ad74413r", &sim_ad74413r_ops,
+			      &param->timing);
+	if (ret) {
+		no_os_free(sim);
+		return ret;
+	}
+
+	sim->dev.priv = sim;
+	memcpy(sim->adc, param->adc, sizeof(sim->adc));
+	memcpy(sim->diag, param->diag, sizeof(sim->diag));
+	no_os_crc8_populate_msb(sim->crc_table, SIM_AD74413R_CRC_POLYNOMIAL);
+	sim_ad74413r_defaults(sim);
+
+	*dev = &sim->dev;
+
+	return 0;
+}
@@ -0,0 +1,306 @@
+/***************************************************************************//**
+ *   @file   sim_ad77681.c
+ *   @brief  Simulation model of the AD7768-1 ADC.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "sim_ad77681.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define SIM_AD77681_NUM_REGS		0x60
+#define SIM_AD77681_MCLK_HZ		16384000
+
+#define SIM_AD77681_REG_CHIP_TYPE	0x03
+#define SIM_AD77681_REG_PROD_ID_L	0x04
+#define SIM_AD77681_REG_PROD_ID_H	0x05
+#define SIM_AD77681_REG_VENDOR_L	0x0C
+#define SIM_AD77681_REG_VENDOR_H	0x0D
+#define SIM_AD77681_REG_INTERFACE	0x14
+#define SIM_AD77681_REG_POWER_CLOCK	0x15
+#define SIM_AD77681_REG_DIGITAL_FILTER	0x19
+#define SIM_AD77681_REG_SYNC_RESET	0x1D
+#define SIM_AD77681_REG_ADC_DATA	0x2C
+#define SIM_AD77681_REG_MASTER_STATUS	0x2D
+
+#define SIM_AD77681_STATUS_EN		NO_OS_BIT(4)
+#define SIM_AD77681_CONVLEN_16		NO_OS_BIT(3)
+#define SIM_AD77681_MCLK_DIV_MASK	NO_OS_GENMASK(5, 4)
+#define SIM_AD77681_DEC_RATE_MASK	NO_OS_GENMASK(2, 0)
+#define SIM_AD77681_SPI_RESET_MASK	NO_OS_GENMASK(1, 0)
+#define SIM_AD77681_SPI_RESET_1		0x3
+#define SIM_AD77681_SPI_RESET_2		0x2
+#define SIM_AD77681_SYNC_RESET_DEF	0x80
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_ad77681
+ * @brief State of the AD7768-1 model.
+ */
+struct sim_ad77681 {
+	struct sim_device dev;
+	uint8_t regs[SIM_AD77681_NUM_REGS];
+	uint32_t mclk_hz;
+	/** Conversions not read yet, only the newest one is kept */
+	struct sim_fifo conv;
+	struct sim_gen adc;
+	/** Conversion result being read, with the status byte */
+	uint8_t data[4];
+	/** Read position in data */
+	uint8_t data_pos;
+	/** The first reset key was written */
+	bool reset_armed;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Load the power-on values of the registers.
+ * @param sim - The model.
+ */
+static void sim_ad77681_defaults(struct sim_ad77681 *sim)
+{
+	memset(sim->regs, 0, sizeof(sim->regs));
+	sim->regs[SIM_AD77681_REG_CHIP_TYPE] = 0x07;
+	sim->regs[SIM_AD77681_REG_PROD_ID_L] = 0x0F;
+	sim->regs[SIM_AD77681_REG_VENDOR_L] = 0x56;
+	sim->regs[SIM_AD77681_REG_VENDOR_H] = 0x04;
+	sim->regs[SIM_AD77681_REG_DIGITAL_FILTER] = 0x45;
+	sim->regs[SIM_AD77681_REG_SYNC_RESET] = SIM_AD77681_SYNC_RESET_DEF;
+	sim->reset_armed = false;
+}
+
+/**
+ * @brief Apply the output data rate set by the clock divider and the
+ * decimation rate of the SINC5/FIR filter.
+ * @param sim - The model.
+ */
+static void sim_ad77681_set_odr(struct sim_ad77681 *sim)
+{
+	uint8_t clock = sim->regs[SIM_AD77681_REG_POWER_CLOCK];
+	uint8_t filter = sim->regs[SIM_AD77681_REG_DIGITAL_FILTER];
+	uint32_t div;
+	uint32_t dec;
+
+	div = 16 >> no_os_field_get(SIM_AD77681_MCLK_DIV_MASK, clock);
+	dec = no_os_field_get(SIM_AD77681_DEC_RATE_MASK, filter);
+	/* x32 to x1024 */
+	dec = 32 << no_os_min(dec, 5u);
+
+	sim_fifo_set_odr(&sim->conv, sim->mclk_hz / div / dec,
+			 sim_device_time_ns(&sim->dev));
+}
+
+/**
+ * @brief Get the next byte of the ADC_DATA register.
+ * @param sim - The model.
+ * @return Byte value.
+ */
+static uint8_t sim_ad77681_data_byte(struct sim_ad77681 *sim)
+{
+	uint8_t format = sim->regs[SIM_AD77681_REG_INTERFACE];
+	int32_t val;
+
+	if (!sim->data_pos) {
+		sim_fifo_update(&sim->conv, sim_device_time_ns(&sim->dev));
+		sim_fifo_pop(&sim->conv);
+		val = sim_gen_next(&sim->adc);
+		if (format & SIM_AD77681_CONVLEN_16) {
+			no_os_put_unaligned_be16(val, sim->data);
+			sim->data[2] = sim->regs[SIM_AD77681_REG_MASTER_STATUS];
+		} else {
+			no_os_put_unaligned_be24(val, sim->data);
+			sim->data[3] = sim->regs[SIM_AD77681_REG_MASTER_STATUS];
+		}
+	}
+
+	if (sim->data_pos == sizeof(sim->data))
+		return 0;
+
+	return sim->data[sim->data_pos++];
+}
+
+/**
+ * @brief Register read side effects.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+static uint8_t sim_ad77681_reg_read(struct sim_device *dev, uint32_t addr)
+{
+	struct sim_ad77681 *sim = dev->priv;
+
+	if (addr == SIM_AD77681_REG_ADC_DATA)
+		return sim_ad77681_data_byte(sim);
+
+	if (addr >= SIM_AD77681_NUM_REGS)
+		return 0;
+
+	return sim->regs[addr];
+}
+
+/**
+ * @brief Register write side effects.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+static void sim_ad77681_reg_write(struct sim_device *dev, uint32_t addr,
+				  uint8_t val)
+{
+	struct sim_ad77681 *sim = dev->priv;
+	uint8_t key;
+
+	switch (addr) {
+	case SIM_AD77681_REG_POWER_CLOCK:
+	case SIM_AD77681_REG_DIGITAL_FILTER:
+		sim_ad77681_set_odr(sim);
+		break;
+	case SIM_AD77681_REG_SYNC_RESET:
+		key = no_os_field_get(SIM_AD77681_SPI_RESET_MASK, val);
+		if (sim->reset_armed && key == SIM_AD77681_SPI_RESET_2) {
+			sim_ad77681_defaults(sim);
+			sim_ad77681_set_odr(sim);
+			break;
+		}
+		sim->reset_armed = key == SIM_AD77681_SPI_RESET_1;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief The ADC_DATA register keeps its address during bursts.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @return true for ADC_DATA.
+ */
+static bool sim_ad77681_addr_hold(struct sim_device *dev, uint32_t addr)
+{
+	return addr == SIM_AD77681_REG_ADC_DATA;
+}
+
+/**
+ * @brief Chip select asserted, a new conversion result is latched on the
+ * first read of ADC_DATA.
+ * @param dev - The simulated device.
+ */
+static void sim_ad77681_spi_begin(struct sim_device *dev)
+{
+	struct sim_ad77681 *sim = dev->priv;
+
+	sim->data_pos = 0;
+}
+
+/**
+ * @brief Free the model.
+ * @param dev - The simulated device.
+ */
+static void sim_ad77681_remove(struct sim_device *dev)
+{
+	no_os_free(dev->priv);
+}
+
+static const struct sim_device_ops sim_ad77681_ops = {
+	.spi_begin = sim_ad77681_spi_begin,
+	.reg_read = sim_ad77681_reg_read,
+	.reg_write = sim_ad77681_reg_write,
+	.addr_hold = sim_ad77681_addr_hold,
+	.remove = sim_ad77681_remove,
+};
+
+/**
+ * @brief Create an AD7768-1 model. Register accesses use a one byte header
+ * with the read flag in bit 6, without CRC. The continuous read mode is not
+ * modelled.
+ * @param dev - The simulated device.
+ * @param param - Model parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_ad77681_init(struct sim_device **dev,
+		     const struct sim_ad77681_init_param *param)
+{
+	struct sim_ad77681 *sim;
+	int ret;
+
+	if (!dev || !param)
+		return -EINVAL;
+
+	sim = no_os_calloc(1, sizeof(*sim));
+	if (!sim)
+		return -ENOMEM;
+
+	ret = sim_device_init(&sim->dev, "ad7768-1", &sim_ad77681_ops,
+			      &param->timing);
+	if (ret) {
+		no_os_free(sim);
+		return ret;
+	}
+
+	sim->dev.priv = sim;
+	sim->dev.regmap = (struct sim_regmap) {
+		.regs = sim->regs,
+		.size = SIM_AD77681_NUM_REGS,
+		.hdr_bytes = 1,
+		.rd_mask = 0x40,
+		.rd_val = 0x40,
+		.addr_mask = 0x3F,
+		.addr_shift = 0,
+		.addr_step = 1,
+	};
+	sim->mclk_hz = param->mclk_hz ? : SIM_AD77681_MCLK_HZ;
+	sim->adc = param->adc;
+	sim->conv.depth = 1;
+	sim_ad77681_defaults(sim);
+	sim_ad77681_set_odr(sim);
+
+	*dev = &sim->dev;
+
+	return 0;
+}
@@ -0,0 +1,362 @@
+/***************************************************************************//**
+ *   @file   sim_adxl355.c
+ *   @brief  Simulation model of the ADXL355/ADXL359 accelerometer.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "no_os_alloc.h"
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "sim_adxl355.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define SIM_ADXL355_NUM_REGS		0x60
+#define SIM_ADXL355_PARTID		0xED
+
+#define SIM_ADXL355_REG_PARTID		0x02
+#define SIM_ADXL355_REG_STATUS		0x04
+#define SIM_ADXL355_REG_FIFO_ENTRIES	0x05
+#define SIM_ADXL355_REG_TEMP2		0x06
+#define SIM_ADXL355_REG_TEMP1		0x07
+#define SIM_ADXL355_REG_XDATA3		0x08
+#define SIM_ADXL355_REG_ZDATA1		0x10
+#define SIM_ADXL355_REG_FIFO_DATA	0x11
+#define SIM_ADXL355_REG_FILTER		0x28
+#define SIM_ADXL355_REG_FIFO_SAMPLES	0x29
+#define SIM_ADXL355_REG_POWER_CTL	0x2D
+#define SIM_ADXL355_REG_RESET		0x2F
+
+#define SIM_ADXL355_DATA_RDY		NO_OS_BIT(0)
+#define SIM_ADXL355_FIFO_FULL		NO_OS_BIT(1)
+#define SIM_ADXL355_FIFO_OVR		NO_OS_BIT(2)
+#define SIM_ADXL355_STANDBY		NO_OS_BIT(0)
+#define SIM_ADXL355_ODR_MASK		NO_OS_GENMASK(3, 0)
+#define SIM_ADXL355_RESET_CODE		0x52
+#define SIM_ADXL355_MAX_ODR_HZ		4000
+/* FIFO depth, in X/Y/Z sample sets */
+#define SIM_ADXL355_FIFO_DEPTH		32
+/* FIFO entry markers */
+#define SIM_ADXL355_FIFO_X_AXIS		NO_OS_BIT(0)
+#define SIM_ADXL355_FIFO_EMPTY		NO_OS_BIT(1)
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_adxl355
+ * @brief State of the ADXL355 model.
+ */
+struct sim_adxl355 {
+	struct sim_device dev;
+	uint8_t regs[SIM_ADXL355_NUM_REGS];
+	struct sim_fifo fifo;
+	struct sim_gen accel[3];
+	struct sim_gen temp;
+	/** A sample set was produced since STATUS was last read */
+	bool data_rdy;
+	/** FIFO entry being read, as 3 axes of 3 bytes */
+	uint8_t entry[9];
+	/** Read position in entry, 9 when a new set must be popped */
+	uint8_t entry_pos;
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Load the power-on values of the registers.
+ * @param sim - The model.
+ */
+static void sim_adxl355_defaults(struct sim_adxl355 *sim)
+{
+	static const uint8_t shadow[] = { 0x3C, 0x51, 0xA7, 0x0E, 0x95 };
+	uint8_t part_id = sim->regs[SIM_ADXL355_REG_PARTID];
+
+	memset(sim->regs, 0, sizeof(sim->regs));
+	sim->regs[0x00] = 0xAD;
+	sim->regs[0x01] = 0x1D;
+	sim->regs[SIM_ADXL355_REG_PARTID] = part_id;
+	sim->regs[0x03] = 0x01;
+	sim->regs[0x27] = 0x01;
+	sim->regs[SIM_ADXL355_REG_FIFO_SAMPLES] = 0x60;
+	sim->regs[0x2C] = 0x81;
+	sim->regs[SIM_ADXL355_REG_POWER_CTL] = SIM_ADXL355_STANDBY;
+	memcpy(&sim->regs[0x50], shadow, sizeof(shadow));
+
+	memset(&sim->fifo, 0, sizeof(sim->fifo));
+	sim->fifo.depth = SIM_ADXL355_FIFO_DEPTH;
+	sim->data_rdy = false;
+	sim->entry_pos = sizeof(sim->entry);
+}
+
+/**
+ * @brief Store a 20 bit sample in the left aligned 24 bit register format.
+ * @param buf - Destination, 3 bytes.
+ * @param val - Sample value.
+ * @param marker - Bits stored in the 4 LSBs.
+ */
+static void sim_adxl355_put_sample(uint8_t *buf, int32_t val, uint8_t marker)
+{
+	uint32_t raw = ((uint32_t)val & NO_OS_GENMASK(19, 0)) << 4 | marker;
+
+	buf[0] = raw >> 16;
+	buf[1] = raw >> 8;
+	buf[2] = raw;
+}
+
+/**
+ * @brief Update the FIFO and the data ready flag to the current time.
+ * @param sim - The model.
+ */
+static void sim_adxl355_sync(struct sim_adxl355 *sim)
+{
+	uint64_t produced = sim->fifo.produced;
+
+	sim_fifo_update(&sim->fifo, sim_device_time_ns(&sim->dev));
+	if (sim->fifo.produced != produced)
+		sim->data_rdy = true;
+}
+
+/**
+ * @brief Apply the output data rate and the measurement mode.
+ * @param sim - The model.
+ */
+static void sim_adxl355_set_odr(struct sim_adxl355 *sim)
+{
+	uint8_t filter = sim->regs[SIM_ADXL355_REG_FILTER];
+	uint32_t odr = 0;
+
+	if (!(sim->regs[SIM_ADXL355_REG_POWER_CTL] & SIM_ADXL355_STANDBY))
+		odr = SIM_ADXL355_MAX_ODR_HZ >>
+		      (filter & SIM_ADXL355_ODR_MASK);
+
+	sim_fifo_set_odr(&sim->fifo, odr, sim_device_time_ns(&sim->dev));
+}
+
+/**
+ * @brief Get the next byte of the FIFO_DATA port.
+ * @param sim - The model.
+ * @return Byte value.
+ */
+static uint8_t sim_adxl355_fifo_byte(struct sim_adxl355 *sim)
+{
+	int32_t val;
+	int i;
+
+	if (sim->entry_pos == sizeof(sim->entry)) {
+		if (sim_fifo_pop(&sim->fifo)) {
+			for (i = 0; i < 3; i++) {
+				val = sim_gen_next(&sim->accel[i]);
+				sim_adxl355_put_sample(&sim->entry[i * 3], val,
+						       i ? 0 :
+						       SIM_ADXL355_FIFO_X_AXIS);
+			}
+		} else {
+			for (i = 0; i < 3; i++)
+				sim_adxl355_put_sample(&sim->entry[i * 3], 0,
+						       SIM_ADXL355_FIFO_EMPTY);
+		}
+		sim->entry_pos = 0;
+	}
+
+	return sim->entry[sim->entry_pos++];
+}
+
+/**
+ * @brief Register read side effects.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+static uint8_t sim_adxl355_reg_read(struct sim_device *dev, uint32_t addr)
+{
+	struct sim_adxl355 *sim = dev->priv;
+	uint32_t entries;
+	int32_t temp;
+	uint8_t val;
+	int i;
+
+	if (addr >= SIM_ADXL355_NUM_REGS)
+		return 0;
+
+	sim_adxl355_sync(sim);
+
+	switch (addr) {
+	case SIM_ADXL355_REG_STATUS:
+		val = sim->data_rdy ? SIM_ADXL355_DATA_RDY : 0;
+		entries = sim->fifo.level * 3;
+		if (entries >= sim->regs[SIM_ADXL355_REG_FIFO_SAMPLES])
+			val |= SIM_ADXL355_FIFO_FULL;
+		if (sim->fifo.overrun)
+			val |= SIM_ADXL355_FIFO_OVR;
+		sim->data_rdy = false;
+		sim->fifo.overrun = false;
+		return val;
+	case SIM_ADXL355_REG_FIFO_ENTRIES:
+		entries = sim->fifo.level * 3;
+		/* Axes left of a partially read set */
+		if (sim->entry_pos < sizeof(sim->entry))
+			entries += (sizeof(sim->entry) - sim->entry_pos) / 3;
+		return entries;
+	case SIM_ADXL355_REG_TEMP2:
+		temp = sim_gen_next(&sim->temp);
+		sim->regs[SIM_ADXL355_REG_TEMP1] = temp;
+		return (temp >> 8) & NO_OS_GENMASK(3, 0);
+	case SIM_ADXL355_REG_XDATA3:
+		for (i = 0; i < 3; i++)
+			sim_adxl355_put_sample(&sim->regs[addr + i * 3],
+					       sim_gen_next(&sim->accel[i]), 0);
+		break;
+	case SIM_ADXL355_REG_FIFO_DATA:
+		return sim_adxl355_fifo_byte(sim);
+	default:
+		break;
+	}
+
+	return sim->regs[addr];
+}
+
+/**
+ * @brief Register write side effects.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+static void sim_adxl355_reg_write(struct sim_device *dev, uint32_t addr,
+				  uint8_t val)
+{
+	struct sim_adxl355 *sim = dev->priv;
+
+	switch (addr) {
+	case SIM_ADXL355_REG_FILTER:
+	case SIM_ADXL355_REG_POWER_CTL:
+		sim_adxl355_set_odr(sim);
+		break;
+	case SIM_ADXL355_REG_RESET:
+		if (val == SIM_ADXL355_RESET_CODE)
+			sim_adxl355_defaults(sim);
+		else
+			sim->regs[addr] = 0;
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief The FIFO_DATA register keeps its address during bursts.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @return true for FIFO_DATA.
+ */
+static bool sim_adxl355_addr_hold(struct sim_device *dev, uint32_t addr)
+{
+	return addr == SIM_ADXL355_REG_FIFO_DATA;
+}
+
+/**
+ * @brief Free the model.
+ * @param dev - The simulated device.
+ */
+static void sim_adxl355_remove(struct sim_device *dev)
+{
+	no_os_free(dev->priv);
+}
+
+static const struct sim_device_ops sim_adxl355_ops = {
+	.reg_read = sim_adxl355_reg_read,
+	.reg_write = sim_adxl355_reg_write,
+	.addr_hold = sim_adxl355_addr_hold,
+	.remove = sim_adxl355_remove,
+};
+
+/**
+ * @brief Create an ADXL355 model. The SPI header is the register address
+ * shifted left by one with the read flag in bit 0, the I2C protocol uses the
+ * generic register pointer.
+ * @param dev - The simulated device.
+ * @param param - Model parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_adxl355_init(struct sim_device **dev,
+		     const struct sim_adxl355_init_param *param)
+{
+	struct sim_adxl355 *sim;
+	int ret;
+
+	if (!dev || !param)
+		return -EINVAL;
+
+	sim = no_os_calloc(1, sizeof(*sim));
+	if (!sim)
+		return -ENOMEM;
+
+	ret = sim_device_init(&sim->dev, "adxl355", &sim_adxl355_ops,
+			      &param->timing);
+	if (ret) {
+		no_os_free(sim);
+		return ret;
+	}
+
+	sim->dev.priv = sim;
+	sim->dev.regmap = (struct sim_regmap) {
+		.regs = sim->regs,
+		.size = SIM_ADXL355_NUM_REGS,
+		.hdr_bytes = 1,
+		.rd_mask = 0x01,
+		.rd_val = 0x01,
+		.addr_mask = 0xFE,
+		.addr_shift = 1,
+		.addr_step = 1,
+	};
+	memcpy(sim->accel, param->accel, sizeof(sim->accel));
+	sim->temp = param->temp;
+
+	sim->regs[SIM_ADXL355_REG_PARTID] = param->part_id ? :
+					    SIM_ADXL355_PARTID;
+	sim_adxl355_defaults(sim);
+
+	*dev = &sim->dev;
+
+	return 0;
+}
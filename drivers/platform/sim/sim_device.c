@@ -0,0 +1,464 @@
+/***************************************************************************//**
+ *   @file   sim_device.c
+ *   @brief  Simulated SPI/I2C device model framework.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "no_os_error.h"
+#include "sim_device.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define SIM_NS_PER_SEC		1000000000ull
+#define SIM_DEFAULT_CLK_HZ	1000000
+#define SIM_SINE_LUT_SIZE	512
+
+extern const uint16_t no_os_sine_lut_16[SIM_SINE_LUT_SIZE];
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Get the host monotonic time.
+ * @return Time in nanoseconds.
+ */
+static uint64_t sim_host_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64_t)ts.tv_sec * SIM_NS_PER_SEC + ts.tv_nsec;
+}
+
+/**
+ * @brief Initialize the common part of a simulated device. The model sets up
+ * the register map and its private data afterwards.
+ * @param dev - The simulated device.
+ * @param name - Model name.
+ * @param ops - Model callbacks.
+ * @param timing - Bus timing model, may be NULL.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_device_init(struct sim_device *dev, const char *name,
+		    const struct sim_device_ops *ops,
+		    const struct sim_timing *timing)
+{
+	if (!dev || !ops)
+		return -EINVAL;
+
+	memset(dev, 0, sizeof(*dev));
+	dev->name = name;
+	dev->ops = ops;
+	if (timing)
+		dev->timing = *timing;
+	dev->start_ns = sim_host_ns();
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources of a simulated device.
+ * @param dev - The simulated device.
+ */
+void sim_device_remove(struct sim_device *dev)
+{
+	if (dev && dev->ops->remove)
+		dev->ops->remove(dev);
+}
+
+/**
+ * @brief Current time of the device.
+ * @param dev - The simulated device.
+ * @return Time in nanoseconds.
+ */
+uint64_t sim_device_time_ns(struct sim_device *dev)
+{
+	if (dev->timing.realtime)
+		return sim_host_ns() - dev->start_ns;
+
+	return dev->time_ns;
+}
+
+/**
+ * @brief Advance the modelled time.
+ * @param dev - The simulated device.
+ * @param ns - Number of nanoseconds.
+ */
+void sim_device_advance(struct sim_device *dev, uint64_t ns)
+{
+	dev->time_ns += ns;
+}
+
+/**
+ * @brief Get the traffic counters.
+ * @param dev - The simulated device.
+ * @param stats - Filled with the counters.
+ */
+void sim_device_stats_get(struct sim_device *dev, struct sim_stats *stats)
+{
+	*stats = dev->stats;
+}
+
+/**
+ * @brief Clear the traffic counters.
+ * @param dev - The simulated device.
+ */
+void sim_device_stats_reset(struct sim_device *dev)
+{
+	memset(&dev->stats, 0, sizeof(dev->stats));
+}
+
+/**
+ * @brief Print the traffic of a driver call.
+ * @param call - Name of the call.
+ * @param stats - Traffic counters.
+ */
+void sim_stats_print(const char *call, const struct sim_stats *stats)
+{
+	printf("%-32s %6" PRIu32 " xfers %8" PRIu32 " bytes %10" PRIu64 " ns\n",
+	       call, stats->transactions, stats->bytes, stats->bus_ns);
+}
+
+/**
+ * @brief Account for a completed transaction.
+ * @param dev - The simulated device.
+ * @param clk_hz - Bus clock, 0 to use the one of the timing model.
+ * @param bits - Clock cycles per byte.
+ */
+static void sim_device_account(struct sim_device *dev, uint32_t clk_hz,
+			       uint32_t bits)
+{
+	uint64_t ns;
+
+	if (!clk_hz)
+		clk_hz = dev->timing.clk_hz ? : SIM_DEFAULT_CLK_HZ;
+
+	ns = dev->timing.xfer_overhead_ns;
+	ns += (uint64_t)dev->xfer_bytes * bits * SIM_NS_PER_SEC / clk_hz;
+
+	dev->stats.transactions++;
+	dev->stats.bytes += dev->xfer_bytes;
+	dev->stats.bus_ns += ns;
+	dev->time_ns += ns;
+}
+
+/**
+ * @brief Read a register of the generic register map.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @return The register value.
+ */
+uint8_t sim_regmap_read(struct sim_device *dev, uint32_t addr)
+{
+	if (dev->ops->reg_read)
+		return dev->ops->reg_read(dev, addr);
+
+	if (addr >= dev->regmap.size)
+		return 0;
+
+	return dev->regmap.regs[addr];
+}
+
+/**
+ * @brief Write a register of the generic register map. The value is stored
+ * before the model is notified.
+ * @param dev - The simulated device.
+ * @param addr - Register address.
+ * @param val - Register value.
+ */
+void sim_regmap_write(struct sim_device *dev, uint32_t addr, uint8_t val)
+{
+	if (addr < dev->regmap.size)
+		dev->regmap.regs[addr] = val;
+
+	if (dev->ops->reg_write)
+		dev->ops->reg_write(dev, addr, val);
+}
+
+/**
+ * @brief Move to the next address of a burst.
+ * @param dev - The simulated device.
+ */
+static void sim_regmap_next(struct sim_device *dev)
+{
+	if (dev->ops->addr_hold && dev->ops->addr_hold(dev, dev->addr))
+		return;
+
+	dev->addr += dev->regmap.addr_step;
+}
+
+/**
+ * @brief Chip select asserted.
+ * @param dev - The simulated device.
+ */
+void sim_device_spi_begin(struct sim_device *dev)
+{
+	dev->xfer_bytes = 0;
+	dev->pos = 0;
+	dev->hdr = 0;
+	dev->read = false;
+
+	if (dev->ops->spi_begin)
+		dev->ops->spi_begin(dev);
+}
+
+/**
+ * @brief Exchange one byte with the device.
+ * @param dev - The simulated device.
+ * @param tx - Byte sent by the controller.
+ * @return Byte sent by the device.
+ */
+uint8_t sim_device_spi_byte(struct sim_device *dev, uint8_t tx)
+{
+	struct sim_regmap *map = &dev->regmap;
+	uint8_t rx = 0;
+
+	dev->xfer_bytes++;
+
+	if (dev->ops->spi_byte)
+		return dev->ops->spi_byte(dev, tx);
+
+	if (dev->pos < map->hdr_bytes) {
+		dev->hdr = (dev->hdr << 8) | tx;
+		if (++dev->pos == map->hdr_bytes) {
+			dev->read = (dev->hdr & map->rd_mask) == map->rd_val;
+			dev->addr = (dev->hdr & map->addr_mask) >>
+				    map->addr_shift;
+		}
+
+		return 0;
+	}
+
+	if (dev->read)
+		rx = sim_regmap_read(dev, dev->addr);
+	else
+		sim_regmap_write(dev, dev->addr, tx);
+	sim_regmap_next(dev);
+
+	return rx;
+}
+
+/**
+ * @brief Chip select deasserted.
+ * @param dev - The simulated device.
+ * @param clk_hz - SCLK frequency, 0 to use the one of the timing model.
+ */
+void sim_device_spi_end(struct sim_device *dev, uint32_t clk_hz)
+{
+	if (dev->ops->spi_end)
+		dev->ops->spi_end(dev);
+
+	sim_device_account(dev, clk_hz, 8);
+}
+
+/**
+ * @brief START condition addressing the device.
+ * @param dev - The simulated device.
+ * @param read - Read transfer.
+ */
+void sim_device_i2c_start(struct sim_device *dev, bool read)
+{
+	/* Count the address byte */
+	dev->xfer_bytes = 1;
+	if (!read)
+		dev->pos = 0;
+}
+
+/**
+ * @brief Byte written to the device.
+ * @param dev - The simulated device.
+ * @param val - Byte value.
+ * @return 0 if the byte was acknowledged, negative error code otherwise.
+ */
+int sim_device_i2c_write_byte(struct sim_device *dev, uint8_t val)
+{
+	dev->xfer_bytes++;
+
+	if (dev->ops->i2c_write_byte)
+		return dev->ops->i2c_write_byte(dev, val);
+
+	/* The first byte sets the register pointer */
+	if (!dev->pos++) {
+		dev->addr = val;
+		return 0;
+	}
+
+	sim_regmap_write(dev, dev->addr, val);
+	sim_regmap_next(dev);
+
+	return 0;
+}
+
+/**
+ * @brief Byte read from the device.
+ * @param dev - The simulated device.
+ * @return Byte value.
+ */
+uint8_t sim_device_i2c_read_byte(struct sim_device *dev)
+{
+	uint8_t val;
+
+	dev->xfer_bytes++;
+
+	if (dev->ops->i2c_read_byte)
+		return dev->ops->i2c_read_byte(dev);
+
+	val = sim_regmap_read(dev, dev->addr);
+	sim_regmap_next(dev);
+
+	return val;
+}
+
+/**
+ * @brief STOP condition, or end of the transfer before a repeated START.
+ * @param dev - The simulated device.
+ * @param clk_hz - SCL frequency, 0 to use the one of the timing model.
+ */
+void sim_device_i2c_stop(struct sim_device *dev, uint32_t clk_hz)
+{
+	/* 8 data bits and the acknowledge bit per byte */
+	sim_device_account(dev, clk_hz, 9);
+}
+
+/**
+ * @brief Get the next sample of a generator.
+ * @param gen - The generator.
+ * @return Sample value.
+ */
+int32_t sim_gen_next(struct sim_gen *gen)
+{
+	uint32_t period = gen->period ? : 1;
+	uint32_t phase = gen->index % period;
+	int32_t lut;
+	int32_t val;
+
+	switch (gen->type) {
+	case SIM_GEN_RAMP:
+		val = gen->offset + gen->amplitude * (int32_t)gen->index;
+		break;
+	case SIM_GEN_SQUARE:
+		if (phase < period / 2)
+			val = gen->offset + gen->amplitude;
+		else
+			val = gen->offset - gen->amplitude;
+		break;
+	case SIM_GEN_SINE:
+		lut = no_os_sine_lut_16[(uint64_t)phase * SIM_SINE_LUT_SIZE /
+							period];
+		lut -= 0x8000;
+		val = gen->offset +
+		      (int32_t)((int64_t)lut * gen->amplitude / 0x7FFF);
+		break;
+	case SIM_GEN_CUSTOM:
+		val = gen->custom ? gen->custom(gen->ctx, gen->index) : 0;
+		break;
+	case SIM_GEN_CONST:
+	default:
+		val = gen->offset;
+		break;
+	}
+
+	gen->index++;
+
+	return val;
+}
+
+/**
+ * @brief Change the output data rate of a FIFO.
+ * @param fifo - The FIFO model.
+ * @param odr_hz - New rate, 0 to stop producing samples.
+ * @param now_ns - Current time of the device.
+ */
+void sim_fifo_set_odr(struct sim_fifo *fifo, uint32_t odr_hz, uint64_t now_ns)
+{
+	sim_fifo_update(fifo, now_ns);
+
+	fifo->odr_hz = odr_hz;
+	fifo->produced = 0;
+	fifo->start_ns = now_ns;
+}
+
+/**
+ * @brief Account for the sample sets produced up to now_ns.
+ * @param fifo - The FIFO model.
+ * @param now_ns - Current time of the device.
+ */
+void sim_fifo_update(struct sim_fifo *fifo, uint64_t now_ns)
+{
+	uint64_t elapsed;
+	uint64_t total;
+	uint64_t fresh;
+
+	if (!fifo->odr_hz || now_ns < fifo->start_ns)
+		return;
+
+	elapsed = now_ns - fifo->start_ns;
+	total = elapsed / SIM_NS_PER_SEC * fifo->odr_hz +
+		elapsed % SIM_NS_PER_SEC * fifo->odr_hz / SIM_NS_PER_SEC;
+	fresh = total - fifo->produced;
+	fifo->produced = total;
+
+	if (fifo->level + fresh > fifo->depth) {
+		fifo->level = fifo->depth;
+		fifo->overrun = true;
+	} else {
+		fifo->level += fresh;
+	}
+}
+
+/**
+ * @brief Remove a sample set from a FIFO.
+ * @param fifo - The FIFO model.
+ * @return true if a sample set was available, false otherwise.
+ */
+bool sim_fifo_pop(struct sim_fifo *fifo)
+{
+	if (!fifo->level)
+		return false;
+
+	fifo->level--;
+
+	return true;
+}
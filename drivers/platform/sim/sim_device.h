@@ -0,0 +1,274 @@
+/***************************************************************************//**
+ *   @file   sim_device.h
+ *   @brief  Simulated SPI/I2C device model framework.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef SIM_DEVICE_H_
+#define SIM_DEVICE_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/**
+ * @brief Run a driver call and store the bus traffic it generated.
+ * @param dev - The simulated device.
+ * @param stats - Filled with the traffic of the call.
+ * @param ret - Receives the return value of the call.
+ * @param call - Driver API call.
+ */
+#define SIM_PROFILE(dev, stats, ret, call)		\
+	do {						\
+		sim_device_stats_reset(dev);		\
+		(ret) = (call);				\
+		sim_device_stats_get(dev, stats);	\
+	} while (0)
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+struct sim_device;
+
+/**
+ * @enum sim_gen_type
+ * @brief Waveforms of the sample generators
+ */
+enum sim_gen_type {
+	SIM_GEN_CONST,
+	SIM_GEN_RAMP,
+	SIM_GEN_SQUARE,
+	SIM_GEN_SINE,
+	SIM_GEN_CUSTOM,
+};
+
+/**
+ * @struct sim_gen
+ * @brief Sample generator used to feed the data registers and FIFOs.
+ */
+struct sim_gen {
+	enum sim_gen_type type;
+	/** DC offset of the waveform */
+	int32_t offset;
+	/** Peak amplitude, or increment per sample for the ramp */
+	int32_t amplitude;
+	/** Samples per period, for the square and sine waveforms */
+	uint32_t period;
+	/** Custom generator, called with the sample index */
+	int32_t (*custom)(void *ctx, uint32_t index);
+	/** Parameter of the custom generator */
+	void *ctx;
+	/** Index of the next sample */
+	uint32_t index;
+};
+
+/**
+ * @struct sim_fifo
+ * @brief Models a FIFO filled at the device output data rate.
+ */
+struct sim_fifo {
+	/** Capacity, in sample sets */
+	uint32_t depth;
+	/** Output data rate in Hz, 0 while the device is not converting */
+	uint32_t odr_hz;
+	/** Number of sample sets available */
+	uint32_t level;
+	/** Set once a sample set was lost because the FIFO was full */
+	bool overrun;
+	/** Sample sets produced since the rate was last changed */
+	uint64_t produced;
+	/** Modelled time at which the rate was last changed */
+	uint64_t start_ns;
+};
+
+/**
+ * @struct sim_stats
+ * @brief Bus traffic counters.
+ */
+struct sim_stats {
+	/** Chip select assertions or I2C START conditions */
+	uint32_t transactions;
+	/** Bytes clocked on the bus */
+	uint32_t bytes;
+	/** Modelled bus time, in nanoseconds */
+	uint64_t bus_ns;
+};
+
+/**
+ * @struct sim_timing
+ * @brief Bus timing model of a device.
+ */
+struct sim_timing {
+	/** Bus clock in Hz, overridden by the bus descriptor when set there */
+	uint32_t clk_hz;
+	/** Fixed cost of a transaction (CS setup/hold, START/STOP), in ns */
+	uint32_t xfer_overhead_ns;
+	/** Use the host clock instead of the modelled bus time */
+	bool realtime;
+};
+
+/**
+ * @struct sim_regmap
+ * @brief Byte wide register map, with the decoding of the SPI header.
+ */
+struct sim_regmap {
+	/** Register storage, one byte per address */
+	uint8_t *regs;
+	/** Number of registers */
+	uint32_t size;
+	/** Number of SPI header bytes (1 or 2) */
+	uint8_t hdr_bytes;
+	/** The access is a read when (header & rd_mask) == rd_val */
+	uint16_t rd_mask;
+	uint16_t rd_val;
+	/** Register address field of the header */
+	uint16_t addr_mask;
+	uint8_t addr_shift;
+	/** Address update after each data byte (1, -1 or 0) */
+	int8_t addr_step;
+};
+
+/**
+ * @struct sim_device_ops
+ * @brief Model callbacks. The byte level callbacks default to the generic
+ * register map implementation.
+ */
+struct sim_device_ops {
+	/** Called when the chip select is asserted */
+	void (*spi_begin)(struct sim_device *dev);
+	/** Exchange one byte while the chip select is asserted */
+	uint8_t (*spi_byte)(struct sim_device *dev, uint8_t tx);
+	/** Called when the chip select is deasserted */
+	void (*spi_end)(struct sim_device *dev);
+	/** Byte written after a START condition */
+	int (*i2c_write_byte)(struct sim_device *dev, uint8_t val);
+	/** Byte read after a START condition */
+	uint8_t (*i2c_read_byte)(struct sim_device *dev);
+	/** Register read side effects, returns the register value */
+	uint8_t (*reg_read)(struct sim_device *dev, uint32_t addr);
+	/** Register write side effects */
+	void (*reg_write)(struct sim_device *dev, uint32_t addr, uint8_t val);
+	/** Whether an address keeps its value during bursts (FIFO ports) */
+	bool (*addr_hold)(struct sim_device *dev, uint32_t addr);
+	/** Free the model specific resources */
+	void (*remove)(struct sim_device *dev);
+};
+
+/**
+ * @struct sim_device
+ * @brief State of a simulated device.
+ */
+struct sim_device {
+	/** Model name, used in reports */
+	const char *name;
+	const struct sim_device_ops *ops;
+	struct sim_regmap regmap;
+	struct sim_timing timing;
+	/** Traffic since the last reset of the statistics */
+	struct sim_stats stats;
+	/** Modelled time, in nanoseconds */
+	uint64_t time_ns;
+	/** Host time at init, used in realtime mode */
+	uint64_t start_ns;
+	/** Generic register map transfer state */
+	uint32_t pos;
+	uint32_t hdr;
+	uint32_t addr;
+	bool read;
+	/** Bytes of the current transaction */
+	uint32_t xfer_bytes;
+	/** Model specific data */
+	void *priv;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Initialize the common part of a simulated device. */
+int sim_device_init(struct sim_device *dev, const char *name,
+		    const struct sim_device_ops *ops,
+		    const struct sim_timing *timing);
+
+/* Free the resources of a simulated device. */
+void sim_device_remove(struct sim_device *dev);
+
+/* Current time of the device, in nanoseconds. */
+uint64_t sim_device_time_ns(struct sim_device *dev);
+
+/* Advance the modelled time, e.g. to account for idle periods. */
+void sim_device_advance(struct sim_device *dev, uint64_t ns);
+
+/* Get the traffic counters. */
+void sim_device_stats_get(struct sim_device *dev, struct sim_stats *stats);
+
+/* Clear the traffic counters. */
+void sim_device_stats_reset(struct sim_device *dev);
+
+/* Print the traffic of a driver call. */
+void sim_stats_print(const char *call, const struct sim_stats *stats);
+
+/* Bus level entry points, used by the SPI and I2C platform drivers. */
+void sim_device_spi_begin(struct sim_device *dev);
+uint8_t sim_device_spi_byte(struct sim_device *dev, uint8_t tx);
+void sim_device_spi_end(struct sim_device *dev, uint32_t clk_hz);
+void sim_device_i2c_start(struct sim_device *dev, bool read);
+int sim_device_i2c_write_byte(struct sim_device *dev, uint8_t val);
+uint8_t sim_device_i2c_read_byte(struct sim_device *dev);
+void sim_device_i2c_stop(struct sim_device *dev, uint32_t clk_hz);
+
+/* Generic register map accessors. */
+uint8_t sim_regmap_read(struct sim_device *dev, uint32_t addr);
+void sim_regmap_write(struct sim_device *dev, uint32_t addr, uint8_t val);
+
+/* Get the next sample of a generator. */
+int32_t sim_gen_next(struct sim_gen *gen);
+
+/* Change the output data rate of a FIFO. */
+void sim_fifo_set_odr(struct sim_fifo *fifo, uint32_t odr_hz, uint64_t now_ns);
+
+/* Account for the sample sets produced up to now_ns. */
+void sim_fifo_update(struct sim_fifo *fifo, uint64_t now_ns);
+
+/* Remove a sample set, returns false if the FIFO is empty. */
+bool sim_fifo_pop(struct sim_fifo *fifo);
+
+#endif // SIM_DEVICE_H_
@@ -0,0 +1,159 @@
+/***************************************************************************//**
+ *   @file   sim_i2c.c
+ *   @brief  Simulated I2C platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdlib.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_i2c.h"
+#include "sim_device.h"
+#include "sim_i2c.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize an I2C descriptor connected to a device model.
+ * @param desc - The I2C descriptor.
+ * @param param - The structure that contains the I2C parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_init(struct no_os_i2c_desc **desc,
+			    const struct no_os_i2c_init_param *param)
+{
+	struct no_os_i2c_desc *descriptor;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->device_id = param->device_id;
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->slave_address = param->slave_address;
+	descriptor->extra = param->extra;
+
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by sim_i2c_init().
+ * @param desc - The I2C descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_remove(struct no_os_i2c_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Write data to the model.
+ * @param desc - The I2C descriptor.
+ * @param data - Data to be written.
+ * @param bytes_number - Number of bytes.
+ * @param stop_bit - Unused, every call is accounted as one transaction.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_write(struct no_os_i2c_desc *desc, uint8_t *data,
+			     uint8_t bytes_number, uint8_t stop_bit)
+{
+	struct sim_device *dev;
+	int32_t ret = 0;
+	uint8_t i;
+
+	if (!desc || (!data && bytes_number))
+		return -EINVAL;
+
+	dev = desc->extra;
+
+	sim_device_i2c_start(dev, false);
+	for (i = 0; i < bytes_number && !ret; i++)
+		ret = sim_device_i2c_write_byte(dev, data[i]);
+	sim_device_i2c_stop(dev, desc->max_speed_hz);
+
+	return ret;
+}
+
+/**
+ * @brief Read data from the model.
+ * @param desc - The I2C descriptor.
+ * @param data - Container for the read data.
+ * @param bytes_number - Number of bytes.
+ * @param stop_bit - Unused, every call is accounted as one transaction.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_i2c_read(struct no_os_i2c_desc *desc, uint8_t *data,
+			    uint8_t bytes_number, uint8_t stop_bit)
+{
+	struct sim_device *dev;
+	uint8_t i;
+
+	if (!desc || (!data && bytes_number))
+		return -EINVAL;
+
+	dev = desc->extra;
+
+	sim_device_i2c_start(dev, true);
+	for (i = 0; i < bytes_number; i++)
+		data[i] = sim_device_i2c_read_byte(dev);
+	sim_device_i2c_stop(dev, desc->max_speed_hz);
+
+	return 0;
+}
+
+/**
+ * @brief Simulated I2C platform ops
+ */
+const struct no_os_i2c_platform_ops sim_i2c_ops = {
+	.i2c_ops_init = &sim_i2c_init,
+	.i2c_ops_write = &sim_i2c_write,
+	.i2c_ops_read = &sim_i2c_read,
+	.i2c_ops_remove = &sim_i2c_remove
+};
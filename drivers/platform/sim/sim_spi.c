@@ -0,0 +1,207 @@
+/***************************************************************************//**
+ *   @file   sim_spi.c
+ *   @brief  Simulated SPI platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdlib.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_spi.h"
+#include "sim_device.h"
+#include "sim_spi.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize a SPI descriptor connected to a device model.
+ * @param desc - The SPI descriptor.
+ * @param param - The structure that contains the SPI parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_init(struct no_os_spi_desc **desc,
+			    const struct no_os_spi_init_param *param)
+{
+	struct no_os_spi_desc *descriptor;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	descriptor->device_id = param->device_id;
+	descriptor->max_speed_hz = param->max_speed_hz;
+	descriptor->chip_select = param->chip_select;
+	descriptor->mode = param->mode;
+	descriptor->bit_order = param->bit_order;
+	descriptor->extra = param->extra;
+
+	*desc = descriptor;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by sim_spi_init().
+ * @param desc - The SPI descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_remove(struct no_os_spi_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Exchange a buffer with the model in a single transaction.
+ * @param desc - The SPI descriptor.
+ * @param data - Data to be sent, replaced by the received data.
+ * @param bytes_number - Number of bytes.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_write_and_read(struct no_os_spi_desc *desc,
+				      uint8_t *data, uint16_t bytes_number)
+{
+	struct sim_device *dev;
+	uint16_t i;
+
+	if (!desc || !data)
+		return -EINVAL;
+
+	dev = desc->extra;
+
+	sim_device_spi_begin(dev);
+	for (i = 0; i < bytes_number; i++)
+		data[i] = sim_device_spi_byte(dev, data[i]);
+	sim_device_spi_end(dev, desc->max_speed_hz);
+
+	return 0;
+}
+
+/**
+ * @brief Send a list of messages. The chip select stays asserted between
+ * messages unless cs_change is set.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_transfer(struct no_os_spi_desc *desc,
+				struct no_os_spi_msg *msgs, uint32_t len)
+{
+	struct sim_device *dev;
+	bool cs_active = false;
+	uint32_t i, j;
+	uint8_t tx, rx;
+
+	if (!desc || !msgs)
+		return -EINVAL;
+
+	dev = desc->extra;
+
+	for (i = 0; i < len; i++) {
+		if (!cs_active) {
+			sim_device_spi_begin(dev);
+			cs_active = true;
+		}
+
+		for (j = 0; j < msgs[i].bytes_number; j++) {
+			tx = msgs[i].tx_buff ? msgs[i].tx_buff[j] : 0;
+			rx = sim_device_spi_byte(dev, tx);
+			if (msgs[i].rx_buff)
+				msgs[i].rx_buff[j] = rx;
+		}
+
+		if (msgs[i].cs_change) {
+			sim_device_spi_end(dev, desc->max_speed_hz);
+			cs_active = false;
+		}
+	}
+
+	if (cs_active)
+		sim_device_spi_end(dev, desc->max_speed_hz);
+
+	return 0;
+}
+
+/**
+ * @brief Send a list of messages and invoke a callback once done.
+ * @param desc - The SPI descriptor.
+ * @param msgs - Array of messages.
+ * @param len - Number of messages.
+ * @param callback - Completion callback.
+ * @param ctx - Callback parameter.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_spi_dma_transfer_async(struct no_os_spi_desc *desc,
+		struct no_os_spi_msg *msgs,
+		uint32_t len,
+		void (*callback)(void *),
+		void *ctx)
+{
+	int32_t ret;
+
+	ret = sim_spi_transfer(desc, msgs, len);
+	if (ret)
+		return ret;
+
+	if (callback)
+		callback(ctx);
+
+	return 0;
+}
+
+/**
+ * @brief Simulated SPI platform ops
+ */
+const struct no_os_spi_platform_ops sim_spi_ops = {
+	.init = &sim_spi_init,
+	.write_and_read = &sim_spi_write_and_read,
+	.transfer = &sim_spi_transfer,
+	.dma_transfer_sync = &sim_spi_transfer,
+	.dma_transfer_async = &sim_spi_dma_transfer_async,
+	.remove = &sim_spi_remove
+};
@@ -0,0 +1,346 @@
+/***************************************************************************//**
+ *   @file   sim_tdm.c
+ *   @brief  Implementation of the simulated TDM platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_tdm.h"
+#include "sim_device.h"
+#include "sim_tdm.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Initialize a simulated TDM descriptor.
+ * @param desc - The TDM descriptor.
+ * @param param - The structure that contains the TDM parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_init(struct no_os_tdm_desc **desc,
+			    const struct no_os_tdm_init_param *param)
+{
+	struct sim_tdm_init_param *sinit;
+	struct no_os_tdm_desc *tdm_desc;
+	struct sim_tdm_desc *sdesc;
+
+	if (!desc || !param || !param->extra)
+		return -EINVAL;
+
+	if (param->mode != NO_OS_TDM_MASTER_RX &&
+	    param->mode != NO_OS_TDM_SLAVE_RX)
+		return -ENOTSUP;
+
+	if (!param->data_size || param->data_size > 32 ||
+	    !param->slots_per_frame)
+		return -EINVAL;
+
+	sinit = param->extra;
+	if (!sinit->slot_gen)
+		return -EINVAL;
+
+	tdm_desc = no_os_calloc(1, sizeof(*tdm_desc));
+	if (!tdm_desc)
+		return -ENOMEM;
+
+	sdesc = no_os_calloc(1, sizeof(*sdesc));
+	if (!sdesc) {
+		no_os_free(tdm_desc);
+		return -ENOMEM;
+	}
+
+	sdesc->slot_gen = sinit->slot_gen;
+	sdesc->slots_per_frame = param->slots_per_frame;
+	sdesc->data_size = param->data_size;
+	if (param->data_size <= 8)
+		sdesc->sample_size = 1;
+	else if (param->data_size <= 16)
+		sdesc->sample_size = 2;
+	else
+		sdesc->sample_size = 4;
+	sdesc->rx_complete_callback = param->rx_complete_callback;
+	sdesc->rx_half_complete_callback = param->rx_half_complete_callback;
+
+	tdm_desc->irq_id = param->irq_id;
+	tdm_desc->extra = sdesc;
+
+	*desc = tdm_desc;
+
+	return 0;
+}
+
+/**
+ * @brief Free the resources allocated by sim_tdm_init().
+ * @param desc - The TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_remove(struct no_os_tdm_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	no_os_free(desc->extra);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Store the next sample of the frame at the given sample index.
+ * @param sdesc - The simulated TDM descriptor.
+ * @param buf - Destination buffer.
+ * @param idx - Sample index in buf.
+ */
+static void sim_tdm_put_sample(struct sim_tdm_desc *sdesc, uint8_t *buf,
+			       uint32_t idx)
+{
+	uint32_t val;
+	uint16_t val16;
+
+	val = (uint32_t)sim_gen_next(&sdesc->slot_gen[sdesc->slot]);
+	if (sdesc->data_size < 32)
+		val &= (1u << sdesc->data_size) - 1;
+
+	switch (sdesc->sample_size) {
+	case 1:
+		buf[idx] = val;
+		break;
+	case 2:
+		val16 = val;
+		memcpy(buf + idx * 2, &val16, sizeof(val16));
+		break;
+	default:
+		memcpy(buf + idx * 4, &val, sizeof(val));
+		break;
+	}
+
+	sdesc->slot = (sdesc->slot + 1) % sdesc->slots_per_frame;
+}
+
+/**
+ * @brief Read samples. Without irq_id, the samples are generated right away.
+ * Otherwise a single shot DMA transfer is started and completed by
+ * sim_tdm_run().
+ * @param desc - The TDM descriptor.
+ * @param data - The buffer to fill with the received data.
+ * @param nb_samples - Number of samples to read.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_read(struct no_os_tdm_desc *desc, void *data,
+			    uint16_t nb_samples)
+{
+	struct sim_tdm_desc *sdesc;
+	uint16_t i;
+
+	if (!desc || !desc->extra || !data)
+		return -EINVAL;
+
+	sdesc = desc->extra;
+	if (sdesc->active)
+		return -EBUSY;
+
+	if (!desc->irq_id) {
+		for (i = 0; i < nb_samples; i++)
+			sim_tdm_put_sample(sdesc, data, i);
+
+		return 0;
+	}
+
+	sdesc->buf = data;
+	sdesc->nb_samples = nb_samples;
+	sdesc->pos = 0;
+	sdesc->circular = false;
+	sdesc->paused = false;
+	sdesc->active = nb_samples != 0;
+
+	return 0;
+}
+
+/**
+ * @brief Start a circular DMA transfer, completed block by block by
+ * sim_tdm_run().
+ * @param desc - The TDM descriptor.
+ * @param data - The DMA buffer.
+ * @param nb_samples - Number of samples in the DMA buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_stream_start(struct no_os_tdm_desc *desc, void *data,
+				    uint16_t nb_samples)
+{
+	struct sim_tdm_desc *sdesc;
+	int32_t ret;
+
+	if (!desc || !desc->irq_id)
+		return -ENOSYS;
+
+	ret = sim_tdm_read(desc, data, nb_samples);
+	if (ret)
+		return ret;
+
+	sdesc = desc->extra;
+	sdesc->circular = true;
+
+	return 0;
+}
+
+/**
+ * @brief Stop the DMA transfer in progress.
+ * @param desc - The TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_stop(struct no_os_tdm_desc *desc)
+{
+	struct sim_tdm_desc *sdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	sdesc = desc->extra;
+	sdesc->active = false;
+	sdesc->paused = false;
+
+	return 0;
+}
+
+/**
+ * @brief Pause the DMA transfer in progress. Frames clocked while paused are
+ * lost, as on the hardware.
+ * @param desc - The TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_pause(struct no_os_tdm_desc *desc)
+{
+	struct sim_tdm_desc *sdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	sdesc = desc->extra;
+	sdesc->paused = true;
+
+	return 0;
+}
+
+/**
+ * @brief Resume a paused DMA transfer.
+ * @param desc - The TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t sim_tdm_resume(struct no_os_tdm_desc *desc)
+{
+	struct sim_tdm_desc *sdesc;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	sdesc = desc->extra;
+	sdesc->paused = false;
+
+	return 0;
+}
+
+/**
+ * @brief Clock frames into the DMA transfer in progress. The half and full
+ * transfer callbacks are called as the transfer crosses these points, and a
+ * circular transfer wraps around to the start of the buffer.
+ * @param desc - The TDM descriptor.
+ * @param nb_frames - Number of frames to clock.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int sim_tdm_run(struct no_os_tdm_desc *desc, uint32_t nb_frames)
+{
+	struct sim_tdm_desc *sdesc;
+	uint32_t nb_slots;
+	uint16_t half;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	sdesc = desc->extra;
+	nb_slots = nb_frames * sdesc->slots_per_frame;
+	half = sdesc->nb_samples / 2;
+
+	while (nb_slots--) {
+		if (!sdesc->active || sdesc->paused) {
+			/* The slot is clocked, but not captured */
+			sim_gen_next(&sdesc->slot_gen[sdesc->slot]);
+			sdesc->slot++;
+			sdesc->slot %= sdesc->slots_per_frame;
+			continue;
+		}
+
+		sim_tdm_put_sample(sdesc, sdesc->buf, sdesc->pos++);
+
+		if (sdesc->pos == half) {
+			if (sdesc->circular)
+				no_os_tdm_stream_block_done(desc, false);
+			if (sdesc->rx_half_complete_callback)
+				sdesc->rx_half_complete_callback(desc);
+		}
+
+		if (sdesc->pos == sdesc->nb_samples) {
+			sdesc->pos = 0;
+			if (sdesc->circular)
+				no_os_tdm_stream_block_done(desc, true);
+			else
+				sdesc->active = false;
+			if (sdesc->rx_complete_callback)
+				sdesc->rx_complete_callback(desc);
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Simulated TDM platform ops
+ */
+const struct no_os_tdm_platform_ops sim_tdm_ops = {
+	.tdm_ops_init = &sim_tdm_init,
+	.tdm_ops_read = &sim_tdm_read,
+	.tdm_ops_stop = &sim_tdm_stop,
+	.tdm_ops_pause = &sim_tdm_pause,
+	.tdm_ops_resume = &sim_tdm_resume,
+	.tdm_ops_stream_start = &sim_tdm_stream_start,
+	.tdm_ops_remove = &sim_tdm_remove
+};
@@ -0,0 +1,109 @@
+/***************************************************************************//**
+ *   @file   sim_tdm.h
+ *   @brief  Header file of the simulated TDM platform driver.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef SIM_TDM_H_
+#define SIM_TDM_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdbool.h>
+#include <stdint.h>
+#include "no_os_tdm.h"
+#include "sim_device.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct sim_tdm_init_param
+ * @brief Simulated TDM specific initialization parameters.
+ */
+struct sim_tdm_init_param {
+	/** Sample generator of each slot, slots_per_frame entries */
+	struct sim_gen *slot_gen;
+};
+
+/**
+ * @struct sim_tdm_desc
+ * @brief Simulated TDM specific descriptor.
+ */
+struct sim_tdm_desc {
+	/** Sample generator of each slot */
+	struct sim_gen *slot_gen;
+	/** Number of slots in a frame */
+	uint8_t slots_per_frame;
+	/** Useful data size in a slot, in bits */
+	uint8_t data_size;
+	/** Size of a sample in memory, in bytes */
+	uint8_t sample_size;
+	/** Slot of the next sample */
+	uint8_t slot;
+	/** Destination of the current DMA transfer */
+	uint8_t *buf;
+	/** Number of samples of the current DMA transfer */
+	uint16_t nb_samples;
+	/** Index of the next sample of the current DMA transfer */
+	uint16_t pos;
+	/** Set for a circular DMA transfer */
+	bool circular;
+	/** Set while a DMA transfer is in progress */
+	bool active;
+	/** Set while the DMA transfer is paused */
+	bool paused;
+	/** User Rx complete callback */
+	void (*rx_complete_callback)(void *rx_arg);
+	/** User Rx half complete callback */
+	void (*rx_half_complete_callback)(void *rx_arg);
+};
+
+/**
+ * @brief Simulated TDM platform ops. The extra field of the init parameter
+ * must point to a struct sim_tdm_init_param. A non zero irq_id selects the
+ * DMA mode, in which the samples are produced by sim_tdm_run().
+ */
+extern const struct no_os_tdm_platform_ops sim_tdm_ops;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Clock frames into the DMA transfer in progress, firing its callbacks. */
+int sim_tdm_run(struct no_os_tdm_desc *desc, uint32_t nb_frames);
+
+#endif // SIM_TDM_H_
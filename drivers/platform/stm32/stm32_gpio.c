@@ -389,6 +389,174 @@ int32_t stm32_gpio_get_value(struct no_os_gpio_desc *desc,
 	return 0;
 }
 
+/**
+ * @brief Free the resources allocated by stm32_gpio_group_get().
+ * @param desc - The GPIO group descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_gpio_group_remove(struct no_os_gpio_group_desc *desc)
+{
+	uint8_t i;
+
+	if (!desc)
+		return -EINVAL;
+
+	for (i = 0; i < desc->nb_pins; i++)
+		stm32_gpio_remove(desc->pins[i]);
+
+	no_os_free(desc->extra);
+	no_os_free(desc->pins);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Obtain a GPIO group descriptor, the pins sharing a port are driven
+ * through a single register access.
+ * @param desc - The GPIO group descriptor.
+ * @param param - GPIO group initialization parameters.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_gpio_group_get(struct no_os_gpio_group_desc **desc,
+			     const struct no_os_gpio_group_init_param *param)
+{
+	struct no_os_gpio_group_desc *group;
+	struct stm32_gpio_group_desc *extra;
+	struct stm32_gpio_desc *pin;
+	uint8_t value;
+	int32_t ret;
+	uint8_t i, j;
+
+	if (!desc || !param)
+		return -EINVAL;
+
+	group = no_os_calloc(1, sizeof(*group));
+	if (!group)
+		return -ENOMEM;
+
+	group->pins = no_os_calloc(param->nb_pins, sizeof(*group->pins));
+	if (!group->pins) {
+		ret = -ENOMEM;
+		goto error;
+	}
+
+	extra = no_os_calloc(1, sizeof(*extra));
+	if (!extra) {
+		ret = -ENOMEM;
+		goto error;
+	}
+	group->extra = extra;
+
+	for (i = 0; i < param->nb_pins; i++) {
+		ret = stm32_gpio_get(&group->pins[i], &param->pins[i]);
+		if (ret)
+			goto error;
+		group->nb_pins++;
+
+		value = !!(param->init_values & NO_OS_BIT(i));
+		if (param->out_mask & NO_OS_BIT(i))
+			ret = stm32_gpio_direction_output(group->pins[i],
+							  value);
+		else
+			ret = stm32_gpio_direction_input(group->pins[i]);
+		if (ret)
+			goto error;
+
+		pin = group->pins[i]->extra;
+		for (j = 0; j < extra->nb_ports; j++)
+			if (extra->ports[j] == pin->port)
+				break;
+		if (j == extra->nb_ports)
+			extra->ports[extra->nb_ports++] = pin->port;
+		extra->port_idx[i] = j;
+	}
+
+	group->out_mask = param->out_mask;
+	*desc = group;
+
+	return 0;
+error:
+	stm32_gpio_group_remove(group);
+
+	return ret;
+}
+
+/**
+ * @brief Set the level of the group outputs selected by a mask, with one
+ * BSRR write per port.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Pins to update, bit i selects the pin i of the group.
+ * @param values - Levels of the selected pins, bit i for the pin i.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_gpio_group_set_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t values)
+{
+	struct stm32_gpio_group_desc *extra;
+	uint32_t bsrr;
+	uint8_t i, p;
+
+	if (!desc || !desc->extra)
+		return -EINVAL;
+
+	extra = desc->extra;
+	for (p = 0; p < extra->nb_ports; p++) {
+		bsrr = 0;
+		for (i = 0; i < desc->nb_pins; i++) {
+			if (!(mask & NO_OS_BIT(i)) || extra->port_idx[i] != p)
+				continue;
+
+			/* Lower half sets the pin, upper half resets it */
+			if (values & NO_OS_BIT(i))
+				bsrr |= NO_OS_BIT(desc->pins[i]->number);
+			else
+				bsrr |= NO_OS_BIT(desc->pins[i]->number + 16);
+		}
+
+		if (bsrr)
+			extra->ports[p]->BSRR = bsrr;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Get the level of the group pins selected by a mask, with one IDR
+ * read per port.
+ * @param desc - The GPIO group descriptor.
+ * @param mask - Pins to read, bit i selects the pin i of the group.
+ * @param values - Levels of the selected pins, bit i for the pin i.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_gpio_group_get_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t *values)
+{
+	struct stm32_gpio_group_desc *extra;
+	uint32_t idr[NO_OS_GPIO_GROUP_MAX_PINS];
+	uint32_t pin_mask;
+	uint8_t i;
+
+	if (!desc || !desc->extra || !values)
+		return -EINVAL;
+
+	extra = desc->extra;
+	for (i = 0; i < extra->nb_ports; i++)
+		idr[i] = extra->ports[i]->IDR;
+
+	*values = 0;
+	for (i = 0; i < desc->nb_pins; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+
+		pin_mask = NO_OS_BIT(desc->pins[i]->number);
+		if (idr[extra->port_idx[i]] & pin_mask)
+			*values |= NO_OS_BIT(i);
+	}
+
+	return 0;
+}
+
 /**
  * @brief stm32 platform specific GPIO platform ops structure
  */
@@ -401,4 +569,8 @@ const struct no_os_gpio_platform_ops stm32_gpio_ops = {
 	.gpio_ops_get_direction = &stm32_gpio_get_direction,
 	.gpio_ops_set_value = &stm32_gpio_set_value,
 	.gpio_ops_get_value = &stm32_gpio_get_value,
+	.gpio_ops_group_get = &stm32_gpio_group_get,
+	.gpio_ops_group_remove = &stm32_gpio_group_remove,
+	.gpio_ops_group_set_values = &stm32_gpio_group_set_values,
+	.gpio_ops_group_get_values = &stm32_gpio_group_get_values,
 };
@@ -42,6 +42,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "stm32_hal.h"
+#include "no_os_gpio.h"
 
 /**
  * @struct stm32_gpio_init_param
@@ -67,6 +68,19 @@ struct stm32_gpio_desc {
 	GPIO_InitTypeDef gpio_config;
 };
 
+/**
+ * @struct stm32_gpio_group_desc
+ * @brief stm32 platform specific gpio group descriptor
+ */
+struct stm32_gpio_group_desc {
+	/** Ports used by the group */
+	GPIO_TypeDef *ports[NO_OS_GPIO_GROUP_MAX_PINS];
+	/** Number of ports used by the group */
+	uint8_t nb_ports;
+	/** Index in ports of the port of each pin */
+	uint8_t port_idx[NO_OS_GPIO_GROUP_MAX_PINS];
+};
+
 /**
  * @brief stm32 platform specific gpio platform ops structure
  */
@@ -57,9 +57,42 @@ const struct no_os_tdm_platform_ops stm32_tdm_platform_ops = {
 	.tdm_ops_stop = &stm32_stop_tdm_transfer,
 	.tdm_ops_pause = &stm32_pause_tdm_transfer,
 	.tdm_ops_resume = &stm32_resume_tdm_transfer,
+	.tdm_ops_stream_start = &stm32_tdm_stream_start,
 	.tdm_ops_remove = &stm32_tdm_remove
 };
 
+/**
+ * @brief DMA receive complete handler. Reports the second block of a
+ * continuous reception, then calls the user callback.
+ * @param ctx - The TDM descriptor.
+ */
+static void stm32_tdm_rx_cplt_handler(void *ctx)
+{
+	struct no_os_tdm_desc *desc = ctx;
+	struct stm32_tdm_desc *tdesc = desc->extra;
+
+	no_os_tdm_stream_block_done(desc, true);
+
+	if (tdesc->rx_complete_callback)
+		tdesc->rx_complete_callback(desc);
+}
+
+/**
+ * @brief DMA receive half complete handler. Reports the first block of a
+ * continuous reception, then calls the user callback.
+ * @param ctx - The TDM descriptor.
+ */
+static void stm32_tdm_rx_half_cplt_handler(void *ctx)
+{
+	struct no_os_tdm_desc *desc = ctx;
+	struct stm32_tdm_desc *tdesc = desc->extra;
+
+	no_os_tdm_stream_block_done(desc, false);
+
+	if (tdesc->rx_half_complete_callback)
+		tdesc->rx_half_complete_callback(desc);
+}
+
 /**
  * @brief Initialize the TDM communication peripheral.
  * @param desc - The TDM descriptor.
@@ -170,7 +203,12 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 		ret = lf256fifo_init(&tdm_desc->rx_fifo);
 		if (ret < 0)
 			goto error;
+	}
+
+	tdesc->rx_complete_callback = param->rx_complete_callback;
+	tdesc->rx_half_complete_callback = param->rx_half_complete_callback;
 
+	if (param->irq_id) {
 		struct no_os_irq_init_param nvic_rx_cplt = {
 			.platform_ops = &stm32_irq_ops
 		};
@@ -179,7 +217,7 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 		if (ret < 0)
 			goto error;
 
-		tdesc->rx_callback.callback = param->rx_complete_callback;
+		tdesc->rx_callback.callback = stm32_tdm_rx_cplt_handler;
 		tdesc->rx_callback.ctx = tdm_desc;
 		tdesc->rx_callback.event = NO_OS_EVT_DMA_RX_COMPLETE;
 		tdesc->rx_callback.peripheral = NO_OS_TDM_DMA_IRQ;
@@ -195,7 +233,7 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 			goto error;
 	}
 
-	if(param->rx_half_complete_callback) {
+	if (param->irq_id) {
 		struct no_os_irq_init_param nvic_rx_half_cplt = {
 			.platform_ops = &stm32_irq_ops
 		};
@@ -204,7 +242,7 @@ int32_t stm32_tdm_init(struct no_os_tdm_desc **desc,
 		if (ret < 0)
 			goto error;
 
-		tdesc->rx_half_callback.callback = param->rx_half_complete_callback;
+		tdesc->rx_half_callback.callback = stm32_tdm_rx_half_cplt_handler;
 		tdesc->rx_half_callback.ctx = tdm_desc;
 		tdesc->rx_half_callback.event = NO_OS_EVT_DMA_RX_HALF_COMPLETE;
 		tdesc->rx_half_callback.peripheral = NO_OS_TDM_DMA_IRQ;
@@ -286,6 +324,26 @@ int32_t stm32_tdm_read(struct no_os_tdm_desc *desc,
 	return ret;
 }
 
+/**
+ * @brief Restore the Rx DMA mode used before a stream was started.
+ * @param tdesc - The stm32 TDM descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t stm32_tdm_restore_dma_mode(struct stm32_tdm_desc *tdesc)
+{
+	DMA_HandleTypeDef *hdma = tdesc->hsai.hdmarx;
+
+	if (!tdesc->dma_mode_saved)
+		return 0;
+
+	tdesc->dma_mode_saved = false;
+	hdma->Init.Mode = tdesc->saved_dma_mode;
+	if (HAL_DMA_Init(hdma) != HAL_OK)
+		return -EIO;
+
+	return 0;
+}
+
 /**
  * @brief Stop SAI DMA transfer
  * @param desc - The TDM descriptor.
@@ -308,8 +366,7 @@ int32_t stm32_stop_tdm_transfer(struct no_os_tdm_desc *desc)
 	if (ret)
 		return ret;
 
-
-	return 0;
+	return stm32_tdm_restore_dma_mode(tdesc);
 }
 
 /**
@@ -361,3 +418,47 @@ int32_t stm32_resume_tdm_transfer(struct no_os_tdm_desc *desc)
 
 	return 0;
 }
+
+/**
+ * @brief Start a circular DMA reception, for continuous streaming. The half
+ * and full transfer interrupts report the two halves of data as blocks.
+ * @param desc - The TDM descriptor.
+ * @param data - The DMA buffer.
+ * @param nb_samples - Number of samples in the DMA buffer.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_tdm_stream_start(struct no_os_tdm_desc *desc, void *data,
+			       uint16_t nb_samples)
+{
+	struct stm32_tdm_desc *tdesc;
+	DMA_HandleTypeDef *hdma;
+
+	if (!desc || !desc->extra || !data)
+		return -EINVAL;
+
+	/* The half/full transfer interrupts are required to report blocks */
+	if (!desc->irq_id)
+		return -ENOSYS;
+
+	tdesc = desc->extra;
+	hdma = tdesc->hsai.hdmarx;
+	if (!hdma)
+		return -ENOTSUP;
+
+	if (hdma->Init.Mode != DMA_CIRCULAR) {
+		tdesc->saved_dma_mode = hdma->Init.Mode;
+		tdesc->dma_mode_saved = true;
+		hdma->Init.Mode = DMA_CIRCULAR;
+		if (HAL_DMA_Init(hdma) != HAL_OK) {
+			stm32_tdm_restore_dma_mode(tdesc);
+			return -EIO;
+		}
+	}
+
+	if (HAL_SAI_Receive_DMA(&tdesc->hsai, data, nb_samples) != HAL_OK) {
+		stm32_tdm_restore_dma_mode(tdesc);
+		return -EIO;
+	}
+
+	return 0;
+}
@@ -71,6 +71,14 @@ struct stm32_tdm_desc {
 	struct no_os_callback_desc rx_half_callback;
 	/** Rx complete callback */
 	struct no_os_callback_desc rx_callback;
+	/** User Rx complete callback */
+	void (*rx_complete_callback)(void *rx_arg);
+	/** User Rx half complete callback */
+	void (*rx_half_complete_callback)(void *rx_arg);
+	/** Rx DMA mode to restore when the stream stops */
+	uint32_t saved_dma_mode;
+	/** Whether the Rx DMA mode was switched to circular for a stream */
+	bool dma_mode_saved;
 };
 
 /**
@@ -99,5 +107,9 @@ int32_t stm32_pause_tdm_transfer(struct no_os_tdm_desc *desc);
 /* Resume TDM DMA Data transfer */
 int32_t stm32_resume_tdm_transfer(struct no_os_tdm_desc *desc);
 
+/* Start a circular DMA reception. */
+int32_t stm32_tdm_stream_start(struct no_os_tdm_desc *desc, void *data,
+			       uint16_t nb_samples);
+
 
 #endif // STM32_TDM_H_
@@ -38,10 +38,12 @@
 *******************************************************************************/
 #include <errno.h>
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_uart.h"
 #include "no_os_irq.h"
 #include "no_os_lf256fifo.h"
 #include "no_os_alloc.h"
+#include "no_os_util.h"
 #include "stm32_irq.h"
 #include "stm32_uart.h"
 #include "stm32_hal.h"
@@ -55,6 +57,326 @@ void uart_rx_callback(void *context)
 	HAL_UART_Receive_IT(((struct stm32_uart_desc *)d->extra)->huart, &c, 1);
 }
 
+/* UARTs in ring buffer mode, used to find the descriptor in HAL callbacks */
+static struct stm32_uart_desc *ring_descs[UART_MAX_NUMBER];
+
+/**
+ * @brief Find the descriptor of a UART in ring buffer mode.
+ * @param huart - HAL UART handle.
+ * @return The descriptor, NULL if not found.
+ */
+static struct stm32_uart_desc *stm32_uart_ring_find(UART_HandleTypeDef *huart)
+{
+	uint32_t i;
+
+	for (i = 0; i < UART_MAX_NUMBER; i++)
+		if (ring_descs[i] && ring_descs[i]->huart == huart)
+			return ring_descs[i];
+
+	return NULL;
+}
+
+/**
+ * @brief Start the circular DMA reception into the RX ring. The DMA writes
+ * from index 0 again, so the counters are moved to the next lap of the ring
+ * and the unread bytes are dropped as overruns.
+ * @param sud - The stm32 UART descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t stm32_uart_rx_start(struct stm32_uart_desc *sud)
+{
+	sud->stats.rx_overruns += sud->rx_count - sud->rx_read;
+	sud->rx_count = (sud->rx_count + sud->rx_size - 1) &
+			~(sud->rx_size - 1);
+	sud->rx_read = sud->rx_count;
+	sud->rx_pos = 0;
+	if (HAL_UARTEx_ReceiveToIdle_DMA(sud->huart, sud->rx_ring,
+					 sud->rx_size) != HAL_OK)
+		return -EIO;
+
+	return 0;
+}
+
+/**
+ * @brief RX DMA half/full transfer and idle line handler. Accounts for the
+ * bytes written by the DMA since the previous event.
+ * @param huart - HAL UART handle.
+ * @param pos - Position of the DMA in the RX ring.
+ */
+static void stm32_uart_rx_event(UART_HandleTypeDef *huart, uint16_t pos)
+{
+	struct stm32_uart_desc *sud = stm32_uart_ring_find(huart);
+	uint32_t mask;
+
+	if (!sud)
+		return;
+
+	mask = sud->rx_size - 1;
+	sud->rx_count += (pos - sud->rx_pos) & mask;
+	sud->rx_pos = pos & mask;
+	sud->stats.rx_events++;
+}
+
+/**
+ * @brief Start a TX DMA transfer with the oldest contiguous data of the TX
+ * ring, if none is in progress. Runs with the UART interrupt masked.
+ * @param sud - The stm32 UART descriptor.
+ */
+static void stm32_uart_tx_kick(struct stm32_uart_desc *sud)
+{
+	uint32_t idx, len;
+
+	if (sud->tx_busy || sud->tx_head == sud->tx_tail)
+		return;
+
+	idx = sud->tx_tail & (sud->tx_size - 1);
+	len = no_os_min(sud->tx_head - sud->tx_tail, sud->tx_size - idx);
+	if (HAL_UART_Transmit_DMA(sud->huart, &sud->tx_ring[idx],
+				  len) != HAL_OK) {
+		sud->stats.errors++;
+		return;
+	}
+
+	sud->tx_len = len;
+	sud->tx_busy = true;
+	sud->stats.tx_transfers++;
+}
+
+/**
+ * @brief TX DMA transfer complete handler. Starts the next transfer, or
+ * reports that the TX ring is drained.
+ * @param huart - HAL UART handle.
+ */
+static void stm32_uart_tx_cplt(UART_HandleTypeDef *huart)
+{
+	struct stm32_uart_desc *sud = stm32_uart_ring_find(huart);
+
+	if (!sud)
+		return;
+
+	sud->tx_tail += sud->tx_len;
+	sud->stats.tx_bytes += sud->tx_len;
+	sud->tx_busy = false;
+
+	stm32_uart_tx_kick(sud);
+	if (!sud->tx_busy && sud->tx_done_callback)
+		sud->tx_done_callback(sud->tx_done_ctx);
+}
+
+/**
+ * @brief UART error handler. The HAL aborts the transfers on errors: the
+ * reception is restarted and the data of an aborted transmission is dropped
+ * before the rest of the TX ring is sent.
+ * @param huart - HAL UART handle.
+ */
+static void stm32_uart_error(UART_HandleTypeDef *huart)
+{
+	struct stm32_uart_desc *sud = stm32_uart_ring_find(huart);
+
+	if (!sud)
+		return;
+
+	sud->stats.errors++;
+	if (sud->rx_ring && huart->RxState == HAL_UART_STATE_READY)
+		stm32_uart_rx_start(sud);
+
+	if (sud->tx_busy && huart->gState == HAL_UART_STATE_READY) {
+		sud->tx_tail += sud->tx_len;
+		sud->tx_busy = false;
+
+		stm32_uart_tx_kick(sud);
+		if (!sud->tx_busy && sud->tx_done_callback)
+			sud->tx_done_callback(sud->tx_done_ctx);
+	}
+}
+
+/**
+ * @brief Set up the ring buffer mode: allocate the rings, register the HAL
+ * callbacks and start the reception.
+ * @param sud - The stm32 UART descriptor.
+ * @param suip - The stm32 UART initialization parameters.
+ * @param irq_id - The UART interrupt, masked while the rings are updated.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t stm32_uart_ring_init(struct stm32_uart_desc *sud,
+				    struct stm32_uart_init_param *suip,
+				    uint32_t irq_id)
+{
+	DMA_HandleTypeDef *hdma = sud->huart->hdmarx;
+	uint32_t i;
+	int32_t ret;
+
+	/* The ring indexes are free running, hence the power of 2 sizes */
+	if (suip->rx_ring_size &&
+	    (!hdma || suip->rx_ring_size > 32768 ||
+	     no_os_hweight32(suip->rx_ring_size) != 1))
+		return -EINVAL;
+
+	if (suip->tx_ring_size &&
+	    (!sud->huart->hdmatx ||
+	     no_os_hweight32(suip->tx_ring_size) != 1))
+		return -EINVAL;
+
+	if ((suip->rx_ring_size || suip->tx_ring_size) && !irq_id)
+		return -EINVAL;
+
+	for (i = 0; i < UART_MAX_NUMBER; i++)
+		if (!ring_descs[i])
+			break;
+	if (i == UART_MAX_NUMBER)
+		return -ENOMEM;
+
+	if (suip->rx_ring_size) {
+		sud->rx_ring = no_os_calloc(1, suip->rx_ring_size);
+		if (!sud->rx_ring)
+			return -ENOMEM;
+		sud->rx_size = suip->rx_ring_size;
+	}
+
+	if (suip->tx_ring_size) {
+		sud->tx_ring = no_os_calloc(1, suip->tx_ring_size);
+		if (!sud->tx_ring) {
+			ret = -ENOMEM;
+			goto error;
+		}
+		sud->tx_size = suip->tx_ring_size;
+		sud->tx_done_callback = suip->tx_done_callback;
+		sud->tx_done_ctx = suip->tx_done_ctx;
+	}
+
+	ring_descs[i] = sud;
+	sud->start_tick = HAL_GetTick();
+
+	if (HAL_UART_RegisterCallback(sud->huart, HAL_UART_TX_COMPLETE_CB_ID,
+				      stm32_uart_tx_cplt) != HAL_OK ||
+	    HAL_UART_RegisterCallback(sud->huart, HAL_UART_ERROR_CB_ID,
+				      stm32_uart_error) != HAL_OK ||
+	    HAL_UART_RegisterRxEventCallback(sud->huart,
+					     stm32_uart_rx_event) != HAL_OK) {
+		ret = -EFAULT;
+		goto error_slot;
+	}
+
+	if (sud->rx_ring) {
+		if (hdma->Init.Mode != DMA_CIRCULAR) {
+			hdma->Init.Mode = DMA_CIRCULAR;
+			if (HAL_DMA_Init(hdma) != HAL_OK) {
+				ret = -EIO;
+				goto error_slot;
+			}
+		}
+
+		ret = stm32_uart_rx_start(sud);
+		if (ret)
+			goto error_slot;
+	}
+
+	return 0;
+
+error_slot:
+	ring_descs[i] = NULL;
+error:
+	no_os_free(sud->tx_ring);
+	no_os_free(sud->rx_ring);
+	sud->tx_ring = NULL;
+	sud->rx_ring = NULL;
+
+	return ret;
+}
+
+/**
+ * @brief Stop the ring buffer mode and free the rings.
+ * @param sud - The stm32 UART descriptor.
+ */
+static void stm32_uart_ring_remove(struct stm32_uart_desc *sud)
+{
+	uint32_t i;
+
+	HAL_UART_DMAStop(sud->huart);
+	HAL_UART_UnRegisterCallback(sud->huart, HAL_UART_TX_COMPLETE_CB_ID);
+	HAL_UART_UnRegisterCallback(sud->huart, HAL_UART_ERROR_CB_ID);
+	HAL_UART_UnRegisterRxEventCallback(sud->huart);
+
+	for (i = 0; i < UART_MAX_NUMBER; i++)
+		if (ring_descs[i] == sud)
+			ring_descs[i] = NULL;
+
+	no_os_free(sud->tx_ring);
+	no_os_free(sud->rx_ring);
+}
+
+/**
+ * @brief Read the bytes available in the RX ring. Bytes overwritten by the
+ * DMA before being read are skipped and counted as overruns. The UART
+ * interrupt is masked since the error handler realigns the read index.
+ * @param desc - The UART descriptor.
+ * @param data - Buffer where to store the data.
+ * @param len - Maximum number of bytes to read.
+ * @return Number of bytes read, -EAGAIN if the ring is empty.
+ */
+static int32_t stm32_uart_ring_read(struct no_os_uart_desc *desc,
+				    uint8_t *data, uint32_t len)
+{
+	struct stm32_uart_desc *sud = desc->extra;
+	uint32_t avail, idx, first, n;
+
+	NVIC_DisableIRQ(desc->irq_id);
+
+	avail = sud->rx_count - sud->rx_read;
+	if (avail > sud->rx_size) {
+		sud->stats.rx_overruns += avail - sud->rx_size;
+		sud->rx_read += avail - sud->rx_size;
+		avail = sud->rx_size;
+	}
+
+	if (!avail) {
+		NVIC_EnableIRQ(desc->irq_id);
+		return -EAGAIN;
+	}
+
+	n = no_os_min(len, avail);
+	idx = sud->rx_read & (sud->rx_size - 1);
+	first = no_os_min(n, sud->rx_size - idx);
+	memcpy(data, &sud->rx_ring[idx], first);
+	memcpy(data + first, sud->rx_ring, n - first);
+	sud->rx_read += n;
+	sud->stats.rx_bytes += n;
+
+	NVIC_EnableIRQ(desc->irq_id);
+
+	return n;
+}
+
+/**
+ * @brief Queue data in the TX ring and start sending it.
+ * @param desc - The UART descriptor.
+ * @param data - Data to be sent.
+ * @param len - Number of bytes.
+ * @return Number of bytes queued, -EAGAIN if the ring is full.
+ */
+static int32_t stm32_uart_ring_write(struct no_os_uart_desc *desc,
+				     const uint8_t *data, uint32_t len)
+{
+	struct stm32_uart_desc *sud = desc->extra;
+	uint32_t idx, first, n;
+
+	n = no_os_min(len, sud->tx_size - (sud->tx_head - sud->tx_tail));
+	if (!n)
+		return -EAGAIN;
+
+	idx = sud->tx_head & (sud->tx_size - 1);
+	first = no_os_min(n, sud->tx_size - idx);
+	memcpy(&sud->tx_ring[idx], data, first);
+	memcpy(sud->tx_ring, data + first, n - first);
+
+	NVIC_DisableIRQ(desc->irq_id);
+	sud->tx_head += n;
+	stm32_uart_tx_kick(sud);
+	NVIC_EnableIRQ(desc->irq_id);
+
+	return n;
+}
+
 /**
  * @brief Initialize the UART communication peripheral.
  * @param desc - The UART descriptor.
@@ -127,9 +449,16 @@ static int32_t stm32_uart_init(struct no_os_uart_desc **desc,
 	}
 
 	sud->timeout = suip->timeout ? suip->timeout : HAL_MAX_DELAY;
+	sud->async_rx = param->asynchronous_rx;
+
+	if (suip->rx_ring_size || suip->tx_ring_size) {
+		ret = stm32_uart_ring_init(sud, suip, param->irq_id);
+		if (ret)
+			goto error;
+	}
 
 	// nonblocking uart_read
-	if(param->asynchronous_rx) {
+	if(param->asynchronous_rx && !sud->rx_ring) {
 		ret = lf256fifo_init(&descriptor->rx_fifo);
 		if (ret < 0)
 			goto error;
@@ -196,6 +525,8 @@ static int32_t stm32_uart_remove(struct no_os_uart_desc *desc)
 		return -EINVAL;
 
 	sud = desc->extra;
+	if (sud->rx_ring || sud->tx_ring)
+		stm32_uart_ring_remove(sud);
 	HAL_UART_DeInit(sud->huart);
 	if (desc->rx_fifo) {
 		no_os_irq_disable(sud->nvic, desc->irq_id);
@@ -222,6 +553,8 @@ static int32_t stm32_uart_write(struct no_os_uart_desc *desc,
 				uint32_t bytes_number)
 {
 	struct stm32_uart_desc *sud;
+	uint32_t sent = 0;
+	uint32_t start;
 	int32_t ret;
 
 	if (!desc || !desc->extra || !data)
@@ -231,6 +564,23 @@ static int32_t stm32_uart_write(struct no_os_uart_desc *desc,
 		return 0;
 
 	sud = desc->extra;
+	if (sud->tx_ring) {
+		start = HAL_GetTick();
+		while (sent < bytes_number) {
+			ret = stm32_uart_ring_write(desc, data + sent,
+						    bytes_number - sent);
+			if (ret > 0) {
+				sent += ret;
+				continue;
+			}
+
+			if (HAL_GetTick() - start > sud->timeout)
+				return -ETIMEDOUT;
+		}
+
+		return bytes_number;
+	}
+
 	ret = HAL_UART_Transmit(sud->huart, (uint8_t *)data, bytes_number,
 				sud->timeout);
 
@@ -260,6 +610,7 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 {
 	struct stm32_uart_desc *sud;
 	uint32_t i = 0;
+	uint32_t start;
 	int32_t ret;
 
 	if (!desc || !desc->extra || !data)
@@ -270,6 +621,27 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 
 	sud = desc->extra;
 
+	if (sud->rx_ring) {
+		if (sud->async_rx)
+			return stm32_uart_ring_read(desc, data, bytes_number);
+
+		/* Wait for the whole count, like HAL_UART_Receive() */
+		start = HAL_GetTick();
+		while (i < bytes_number) {
+			ret = stm32_uart_ring_read(desc, data + i,
+						   bytes_number - i);
+			if (ret > 0) {
+				i += ret;
+				continue;
+			}
+
+			if (HAL_GetTick() - start > sud->timeout)
+				return -ETIMEDOUT;
+		}
+
+		return bytes_number;
+	}
+
 	if (desc->rx_fifo) {
 		while(i < bytes_number) {
 			ret = lf256fifo_read(desc->rx_fifo, &data[i]);
@@ -297,6 +669,81 @@ static int32_t stm32_uart_read(struct no_os_uart_desc *desc, uint8_t *data,
 	return bytes_number;
 }
 
+/**
+ * @brief Read the data available in the RX ring or software FIFO.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Maximum number of bytes to read.
+ * @return Number of bytes read, -EAGAIN if none is available, negative error
+ * code otherwise.
+ */
+static int32_t stm32_uart_read_nonblocking(struct no_os_uart_desc *desc,
+		uint8_t *data,
+		uint32_t bytes_number)
+{
+	struct stm32_uart_desc *sud;
+
+	if (!desc || !desc->extra || !data)
+		return -EINVAL;
+
+	sud = desc->extra;
+	if (sud->rx_ring)
+		return stm32_uart_ring_read(desc, data, bytes_number);
+
+	if (!desc->rx_fifo)
+		return -ENOSYS;
+
+	return stm32_uart_read(desc, data, bytes_number);
+}
+
+/**
+ * @brief Queue data in the TX ring, without waiting for the transmission.
+ * @param desc - Instance of UART.
+ * @param data - Pointer to buffer containing data.
+ * @param bytes_number - Number of bytes to write.
+ * @return Number of bytes queued, -EAGAIN if the ring is full, negative error
+ * code otherwise.
+ */
+static int32_t stm32_uart_write_nonblocking(struct no_os_uart_desc *desc,
+		const uint8_t *data,
+		uint32_t bytes_number)
+{
+	struct stm32_uart_desc *sud;
+
+	if (!desc || !desc->extra || !data)
+		return -EINVAL;
+
+	sud = desc->extra;
+	if (!sud->tx_ring)
+		return -ENOSYS;
+
+	if (!bytes_number)
+		return 0;
+
+	return stm32_uart_ring_write(desc, data, bytes_number);
+}
+
+/**
+ * @brief Get the statistics of the ring buffer mode.
+ * @param desc - Instance of UART.
+ * @param stats - Filled with the statistics.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t stm32_uart_get_stats(struct no_os_uart_desc *desc,
+			     struct stm32_uart_stats *stats)
+{
+	struct stm32_uart_desc *sud;
+
+	if (!desc || !desc->extra || !stats)
+		return -EINVAL;
+
+	sud = desc->extra;
+	*stats = sud->stats;
+	stats->elapsed_ms = HAL_GetTick() - sud->start_tick;
+
+	return 0;
+}
+
 /**
  * @brief STM32 platform specific UART platform ops structure
  */
@@ -304,5 +751,7 @@ const struct no_os_uart_platform_ops stm32_uart_ops = {
 	.init = &stm32_uart_init,
 	.read = &stm32_uart_read,
 	.write = &stm32_uart_write,
+	.read_nonblocking = &stm32_uart_read_nonblocking,
+	.write_nonblocking = &stm32_uart_write_nonblocking,
 	.remove = &stm32_uart_remove
 };
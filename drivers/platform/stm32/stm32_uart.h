@@ -54,6 +54,44 @@ struct stm32_uart_init_param {
 	UART_HandleTypeDef *huart;
 	/** UART transaction timeout (HAL_IncTick() units) */
 	uint32_t timeout;
+	/**
+	 * Size of the RX ring in bytes (power of 2, at most 32768). When set,
+	 * the ring is filled by a circular DMA, with idle line detection,
+	 * instead of one interrupt per byte. Requires huart->hdmarx and the
+	 * UART interrupt in no_os_uart_init_param irq_id.
+	 */
+	uint32_t rx_ring_size;
+	/**
+	 * Size of the TX ring in bytes (power of 2). When set, writes are
+	 * queued in the ring and sent by DMA. Requires huart->hdmatx and the
+	 * UART interrupt in no_os_uart_init_param irq_id.
+	 */
+	uint32_t tx_ring_size;
+	/** Called from interrupt context once the TX ring is drained */
+	void (*tx_done_callback)(void *ctx);
+	/** Parameter of tx_done_callback */
+	void *tx_done_ctx;
+};
+
+/**
+ * @struct stm32_uart_stats
+ * @brief Throughput and error statistics of the ring buffer mode.
+ */
+struct stm32_uart_stats {
+	/** Bytes read from the RX ring */
+	uint32_t rx_bytes;
+	/** Bytes sent from the TX ring */
+	uint32_t tx_bytes;
+	/** Bytes lost because the RX ring was full or after an error */
+	uint32_t rx_overruns;
+	/** RX DMA half, full and idle line events */
+	uint32_t rx_events;
+	/** TX DMA transfers */
+	uint32_t tx_transfers;
+	/** UART errors, the reception is restarted after each of them */
+	uint32_t errors;
+	/** Time since initialization, in milliseconds */
+	uint32_t elapsed_ms;
 };
 
 /**
@@ -69,6 +107,38 @@ struct stm32_uart_desc {
 	struct no_os_irq_ctrl_desc *nvic;
 	/** RX complete callback */
 	struct no_os_callback_desc rx_callback;
+	/** RX ring, written by the circular DMA */
+	uint8_t *rx_ring;
+	/** Size of rx_ring */
+	uint32_t rx_size;
+	/** DMA position reported by the last RX event */
+	uint32_t rx_pos;
+	/** Bytes written in rx_ring since initialization */
+	volatile uint32_t rx_count;
+	/** Bytes read from rx_ring since initialization */
+	uint32_t rx_read;
+	/** TX ring */
+	uint8_t *tx_ring;
+	/** Size of tx_ring */
+	uint32_t tx_size;
+	/** Bytes queued in tx_ring since initialization */
+	volatile uint32_t tx_head;
+	/** Bytes sent from tx_ring since initialization */
+	volatile uint32_t tx_tail;
+	/** Length of the TX DMA transfer in progress */
+	volatile uint32_t tx_len;
+	/** Set while a TX DMA transfer is in progress */
+	volatile bool tx_busy;
+	/** Called once the TX ring is drained */
+	void (*tx_done_callback)(void *ctx);
+	/** Parameter of tx_done_callback */
+	void *tx_done_ctx;
+	/** Ring buffer mode statistics */
+	struct stm32_uart_stats stats;
+	/** HAL tick at initialization */
+	uint32_t start_tick;
+	/** Whether reads return the available data instead of waiting */
+	bool async_rx;
 };
 
 /**
@@ -76,4 +146,8 @@ struct stm32_uart_desc {
  */
 extern const struct no_os_uart_platform_ops stm32_uart_ops;
 
+/* Get the statistics of the ring buffer mode. */
+int32_t stm32_uart_get_stats(struct no_os_uart_desc *desc,
+			     struct stm32_uart_stats *stats);
+
 #endif
@@ -1437,6 +1437,207 @@ static int find_table_index(struct ad9361_rf_phy *phy, int gain)
 	return -EINVAL;
 }
 
+/* SPI messages handed to the platform per batched transfer */
+#define AD9361_SPI_PROG_BATCH	64
+
+/**
+ * Make room for a register write program.
+ * @param prog The program.
+ * @param size The number of bytes the program needs.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_spi_prog_alloc(struct ad9361_spi_prog *prog,
+				     uint32_t size)
+{
+	prog->len = 0;
+	if (prog->size >= size)
+		return 0;
+
+	no_os_free(prog->buf);
+	prog->buf = no_os_malloc(size);
+	if (!prog->buf) {
+		prog->size = 0;
+		return -ENOMEM;
+	}
+	prog->size = size;
+
+	return 0;
+}
+
+/**
+ * Free a register write program.
+ * @param prog The program.
+ */
+static void ad9361_spi_prog_free(struct ad9361_spi_prog *prog)
+{
+	no_os_free(prog->buf);
+	prog->buf = NULL;
+	prog->len = 0;
+	prog->size = 0;
+}
+
+/**
+ * Append a multiple bytes register write to a program.
+ * @param prog The program.
+ * @param reg The register address.
+ * @param tbuf The data buffer, written to reg, reg - 1, ...
+ * @param num The number of bytes to write.
+ */
+static void ad9361_spi_prog_writem(struct ad9361_spi_prog *prog,
+				   uint32_t reg, const uint8_t *tbuf,
+				   uint32_t num)
+{
+	uint8_t *frame = &prog->buf[prog->len];
+	uint16_t cmd;
+
+	cmd = AD_WRITE | AD_CNT(num) | AD_ADDR(reg);
+	frame[0] = num + 2;
+	frame[1] = cmd >> 8;
+	frame[2] = cmd & 0xFF;
+	memcpy(&frame[3], tbuf, num);
+
+	prog->len += num + 3;
+}
+
+/**
+ * Append a register write to a program.
+ * @param prog The program.
+ * @param reg The register address.
+ * @param val The value of the register.
+ */
+static void ad9361_spi_prog_write(struct ad9361_spi_prog *prog,
+				  uint32_t reg, uint8_t val)
+{
+	ad9361_spi_prog_writem(prog, reg, &val, 1);
+}
+
+/**
+ * Replay a register write program.
+ * @param spi
+ * @param prog The program.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_spi_prog_run(struct no_os_spi_desc *spi,
+				   struct ad9361_spi_prog *prog)
+{
+	uint8_t buf[MAX_MBYTE_SPI + 2];
+	struct no_os_spi_msg *msgs;
+	uint32_t pos = 0, n;
+	int32_t ret = 0;
+
+	if (!spi->platform_ops->transfer) {
+		/* write_and_read() overwrites its buffer, replay from a copy */
+		while (pos < prog->len) {
+			n = prog->buf[pos++];
+			memcpy(buf, &prog->buf[pos], n);
+			ret = no_os_spi_write_and_read(spi, buf, n);
+			if (ret < 0)
+				goto error;
+			pos += n;
+		}
+
+		return 0;
+	}
+
+	msgs = no_os_calloc(AD9361_SPI_PROG_BATCH, sizeof(*msgs));
+	if (!msgs)
+		return -ENOMEM;
+
+	while (pos < prog->len) {
+		for (n = 0; n < AD9361_SPI_PROG_BATCH && pos < prog->len; n++) {
+			msgs[n].tx_buff = &prog->buf[pos + 1];
+			msgs[n].bytes_number = prog->buf[pos];
+			msgs[n].cs_change = 1;
+			pos += prog->buf[pos] + 1;
+		}
+
+		ret = no_os_spi_transfer(spi, msgs, n);
+		if (ret < 0)
+			break;
+	}
+
+	no_os_free(msgs);
+error:
+	if (ret < 0)
+		dev_err(&spi->dev, "Write Error %"PRId32, ret);
+
+	return ret;
+}
+
+/**
+ * Compile the gain table upload sequence for a band.
+ * Each row takes one burst write of the index and the three data words
+ * (registers 0x130..0x133 are contiguous), the write strobe and the two
+ * dummy writes that provide the required delay.
+ * @param phy The AD9361 state structure.
+ * @param prog The program.
+ * @param band The gain table band.
+ * @param dest The destination [GT_RX1, GT_RX2].
+ * @param lna The external LNA control bit added to every row.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int32_t ad9361_gt_prog_compile(struct ad9361_rf_phy *phy,
+				      struct ad9361_spi_prog *prog,
+				      uint32_t band, uint32_t dest,
+				      uint32_t lna)
+{
+	uint8_t (*tab)[3] = phy->gt_info[band].tab;
+	uint32_t index_max = phy->gt_info[band].max_index;
+	uint8_t row[4];
+	uint32_t i;
+	int32_t ret;
+
+	/* 6 + 3 * 3 bytes plus length prefixes per row, 5 framing writes */
+	ret = ad9361_spi_prog_alloc(prog, index_max * 19 + 5 * 4);
+	if (ret < 0)
+		return ret;
+
+	/* Start Gain Table Clock */
+	ad9361_spi_prog_write(prog, REG_GAIN_TABLE_CONFIG,
+			      START_GAIN_TABLE_CLOCK | RECEIVER_SELECT(dest));
+
+	for (i = 0; i < index_max; i++) {
+		row[0] = tab[i][2]; /* DC Cal bit & Dig Gain Word */
+		row[1] = tab[i][1]; /* TIA & LPF Word */
+		/* Ext LNA, Int LNA, & Mixer Gain Word */
+		row[2] = tab[i][0] | lna;
+		row[3] = i; /* Gain Table Index */
+		ad9361_spi_prog_writem(prog, REG_GAIN_TABLE_WRITE_DATA3,
+				       row, sizeof(row));
+		ad9361_spi_prog_write(prog, REG_GAIN_TABLE_CONFIG,
+				      START_GAIN_TABLE_CLOCK |
+				      WRITE_GAIN_TABLE |
+				      RECEIVER_SELECT(dest));
+		/* Dummy Writes to delay 3 ADCCLK/16 cycles */
+		ad9361_spi_prog_write(prog, REG_GAIN_TABLE_READ_DATA1, 0);
+		ad9361_spi_prog_write(prog, REG_GAIN_TABLE_READ_DATA1, 0);
+	}
+
+	ad9361_spi_prog_write(prog, REG_GAIN_TABLE_CONFIG,
+			      START_GAIN_TABLE_CLOCK |
+			      RECEIVER_SELECT(dest)); /* Clear Write Bit */
+	ad9361_spi_prog_write(prog, REG_GAIN_TABLE_READ_DATA1, 0);
+	ad9361_spi_prog_write(prog, REG_GAIN_TABLE_READ_DATA1, 0);
+	ad9361_spi_prog_write(prog, REG_GAIN_TABLE_CONFIG,
+			      0); /* Stop Gain Table Clock */
+
+	prog->key = dest | (lna << 8);
+
+	return 0;
+}
+
+/**
+ * Free the cached gain table upload programs.
+ * @param phy The AD9361 state structure.
+ */
+void ad9361_free_table_cache(struct ad9361_rf_phy *phy)
+{
+	uint32_t i;
+
+	for (i = 0; i < AD9361_GT_PROG_NUM; i++)
+		ad9361_spi_prog_free(&phy->gt_prog[i]);
+}
+
 /**
  * Load the gain table for the selected frequency range and receiver.
  * @param phy The AD9361 state structure.
@@ -1448,6 +1649,7 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 			      uint32_t dest)
 {
 	struct no_os_spi_desc *spi = phy->spi;
+	struct ad9361_spi_prog tmp = { 0 }, *prog;
 	uint8_t (*tab)[3];
 	uint32_t band, index_max, i, lna, lpf_tia_mask, set_gain;
 	int32_t ret, rx1_gain, rx2_gain;
@@ -1499,9 +1701,6 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 	lna = phy->pdata->elna_ctrl.elna_in_gaintable_all_index_en ?
 	      EXT_LNA_CTRL : 0;
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
-			 RECEIVER_SELECT(dest)); /* Start Gain Table Clock */
-
 	/* TX QUAD Calibration */
 	if (phy->pdata->split_gt)
 		lpf_tia_mask = 0x20;
@@ -1510,35 +1709,22 @@ static int32_t ad9361_load_gt(struct ad9361_rf_phy *phy, uint64_t freq,
 
 	phy->tx_quad_lpf_tia_match = -EINVAL;
 
-	for (i = 0; i < index_max; i++) {
-		ad9361_spi_write(spi, REG_GAIN_TABLE_ADDRESS, i); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA1,
-				 tab[i][0] | lna); /* Ext LNA, Int LNA, & Mixer Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA2,
-				 tab[i][1]); /* TIA & LPF Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_WRITE_DATA3,
-				 tab[i][2]); /* DC Cal bit & Dig Gain Word */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG,
-				 START_GAIN_TABLE_CLOCK |
-				 WRITE_GAIN_TABLE |
-				 RECEIVER_SELECT(dest)); /* Gain Table Index */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-				 0); /* Dummy Write to delay 3 ADCCLK/16 cycles */
-		ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-				 0); /* Dummy Write to delay ~1u */
-
+	for (i = 0; i < index_max; i++)
 		if ((tab[i][1] & lpf_tia_mask) == 0x20)
 			phy->tx_quad_lpf_tia_match = i;
 
+	/* Reuse the upload program compiled the last time this band was set */
+	prog = (band < AD9361_GT_PROG_NUM) ? &phy->gt_prog[band] : &tmp;
+	if (!prog->len || prog->key != (dest | (lna << 8))) {
+		ret = ad9361_gt_prog_compile(phy, prog, band, dest, lna);
+		if (ret < 0)
+			return ret;
 	}
 
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, START_GAIN_TABLE_CLOCK |
-			 RECEIVER_SELECT(dest)); /* Clear Write Bit */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-			 0); /* Dummy Write to delay ~1u */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_READ_DATA1,
-			 0); /* Dummy Write to delay ~1u */
-	ad9361_spi_write(spi, REG_GAIN_TABLE_CONFIG, 0); /* Stop Gain Table Clock */
+	ret = ad9361_spi_prog_run(spi, prog);
+	ad9361_spi_prog_free(&tmp);
+	if (ret < 0)
+		return ret;
 
 	phy->current_table = band;
 
@@ -5835,7 +6021,9 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 				    uint32_t ntaps, int16_t *coef)
 {
 	struct no_os_spi_desc *spi = phy->spi;
+	struct ad9361_spi_prog prog = { 0 };
 	uint32_t val, offs = 0, fir_conf = 0, fir_enable = 0;
+	uint8_t tap[3];
 	int32_t ret;
 
 	dev_dbg(&phy->spi->dev, "%s: TAPS %"PRIu32", gain %"PRId32", dest %d",
@@ -5876,26 +6064,42 @@ int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 
 	fir_conf |= FIR_NUM_TAPS(val) | FIR_SELECT(dest) | FIR_START_CLK;
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	/*
+	 * The coefficient address and data registers are contiguous, so each
+	 * tap takes one burst write, the write strobe and two dummy writes.
+	 */
+	ret = ad9361_spi_prog_alloc(&prog, ntaps * 18 + 3 * 4);
+	if (ret < 0)
+		goto out;
 
-	for (val = 0; val < ntaps; val++) {
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_ADDR + offs, val);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_WRITE_DATA_1 + offs,
-				 coef[val] & 0xFF);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_WRITE_DATA_2 + offs,
-				 coef[val] >> 8);
-		ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs,
-				 fir_conf | FIR_WRITE);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
-		ad9361_spi_write(spi, REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
-	}
+	ad9361_spi_prog_write(&prog, REG_TX_FILTER_CONF + offs, fir_conf);
 
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	for (val = 0; val < ntaps; val++) {
+		tap[0] = coef[val] >> 8;
+		tap[1] = coef[val] & 0xFF;
+		tap[2] = val;
+		ad9361_spi_prog_writem(&prog,
+				       REG_TX_FILTER_COEF_WRITE_DATA_2 + offs,
+				       tap, sizeof(tap));
+		ad9361_spi_prog_write(&prog, REG_TX_FILTER_CONF + offs,
+				      fir_conf | FIR_WRITE);
+		ad9361_spi_prog_write(&prog,
+				      REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
+		ad9361_spi_prog_write(&prog,
+				      REG_TX_FILTER_COEF_READ_DATA_2 + offs, 0);
+	}
+
+	ad9361_spi_prog_write(&prog, REG_TX_FILTER_CONF + offs, fir_conf);
 	fir_conf &= ~FIR_START_CLK;
-	ad9361_spi_write(spi, REG_TX_FILTER_CONF + offs, fir_conf);
+	ad9361_spi_prog_write(&prog, REG_TX_FILTER_CONF + offs, fir_conf);
 
-	ret = ad9361_verify_fir_filter_coef(phy, dest, ntaps, coef);
+	ret = ad9361_spi_prog_run(spi, &prog);
+	ad9361_spi_prog_free(&prog);
+	if (ret < 0)
+		goto out;
 
+	ret = ad9361_verify_fir_filter_coef(phy, dest, ntaps, coef);
+out:
 	if (dest & FIR_IS_RX)
 		ad9361_spi_writef(phy->spi, REG_RX_ENABLE_FILTER_CTRL,
 				  RX_FIR_ENABLE_DECIMATION(~0), fir_enable);
@@ -2889,6 +2889,20 @@ struct gain_table_info {
 	uint8_t (*tab)[3];
 };
 
+/* Gain table upload programs cached per band (full and split tables) */
+#define AD9361_GT_PROG_NUM		(2 * RXGAIN_TBLS_END)
+
+/*
+ * Register write sequence compiled once and replayed as batched SPI
+ * transfers. Each frame in buf is prefixed by its length in bytes.
+ */
+struct ad9361_spi_prog {
+	uint8_t *buf;
+	uint32_t len;
+	uint32_t size;
+	uint32_t key;
+};
+
 enum fir_dest {
 	FIR_TX1 = 0x01,
 	FIR_TX2 = 0x02,
@@ -3365,6 +3379,7 @@ struct ad9361_rf_phy {
 	int32_t			tx_quad_lpf_tia_match;
 	uint32_t		current_table;
 	struct gain_table_info  *gt_info;
+	struct ad9361_spi_prog	gt_prog[AD9361_GT_PROG_NUM];
 	bool 			ensm_pin_ctl_en;
 
 	bool			auto_cal_en;
@@ -3484,6 +3499,7 @@ int32_t ad9361_set_gain_ctrl_mode(struct ad9361_rf_phy *phy,
 int32_t ad9361_load_fir_filter_coef(struct ad9361_rf_phy *phy,
 				    enum fir_dest dest, int32_t gain_dB,
 				    uint32_t ntaps, short *coef);
+void ad9361_free_table_cache(struct ad9361_rf_phy *phy);
 int32_t ad9361_validate_enable_fir(struct ad9361_rf_phy *phy);
 int32_t ad9361_set_tx_atten(struct ad9361_rf_phy *phy, uint32_t atten_mdb,
 			    bool tx1, bool tx2, bool immed);
@@ -580,6 +580,7 @@ int32_t ad9361_init (struct ad9361_rf_phy **ad9361_phy,
 	return 0;
 
 out_clk:
+	ad9361_free_table_cache(phy);
 	ad9361_unregister_clocks(phy);
 out:
 #ifndef AXI_ADC_NOT_PRESENT
@@ -601,6 +602,7 @@ out:
  */
 int32_t ad9361_remove(struct ad9361_rf_phy *phy)
 {
+	ad9361_free_table_cache(phy);
 	ad9361_unregister_clocks(phy);
 	no_os_spi_remove(phy->spi);
 	no_os_gpio_remove(phy->gpio_desc_resetb);
@@ -432,3 +432,35 @@ int max31865_read_rtd(struct max31865_dev *device, uint16_t *rtd_reg)
 
 	return max31865_enable_bias(device, false);
 }
+
+/**
+ * @brief Read the latest RTD result in auto-convert mode, without starting
+ * a conversion. Both RTD registers are read in a single transfer.
+ * @param device - MAX31865 descriptor
+ * @param rtd_reg - RTD ADC code
+ * @return 0 in case of success, -EIO if the fault bit is set, negative error
+ * code otherwise
+ */
+int max31865_read_rtd_auto(struct max31865_dev *device, uint16_t *rtd_reg)
+{
+	uint8_t raw_array[3] = { MAX31865_RTDMSB_REG };
+	int ret;
+	struct no_os_spi_msg temp_xfer = {
+		.rx_buff = raw_array,
+		.tx_buff = raw_array,
+		.bytes_number = 3,
+		.cs_change = 1,
+	};
+
+	ret = no_os_spi_transfer(device->comm_desc, &temp_xfer, 1);
+	if (ret)
+		return ret;
+
+	*rtd_reg = no_os_get_unaligned_be16(&raw_array[1]);
+	if (*rtd_reg & NO_OS_BIT(0))
+		ret = -EIO;
+
+	*rtd_reg >>= 1;
+
+	return ret;
+}
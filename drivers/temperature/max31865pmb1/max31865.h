@@ -140,4 +140,7 @@ int max31865_set_wires(struct max31865_dev *, bool);
 /** Read RTD **/
 int max31865_read_rtd(struct max31865_dev *, uint16_t *);
 
+/** Read RTD result of the auto-convert mode **/
+int max31865_read_rtd_auto(struct max31865_dev *, uint16_t *);
+
 #endif // __MAX31865_H__
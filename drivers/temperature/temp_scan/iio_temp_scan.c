@@ -0,0 +1,297 @@
+/***************************************************************************//**
+ *   @file   iio_temp_scan.c
+ *   @brief  Implementation of the temperature scan engine IIO interface.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "iio_temp_scan.h"
+#include "temp_scan.h"
+#include "iio.h"
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+static int temp_scan_iio_read_raw(void *dev, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv);
+static int temp_scan_iio_read_scale(void *dev, char *buf, uint32_t len,
+				    const struct iio_ch_info *channel,
+				    intptr_t priv);
+static int32_t temp_scan_iio_submit(struct iio_device_data *dev_data);
+static int32_t temp_scan_iio_trigger_handler(struct iio_device_data *dev_data);
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+static struct iio_attribute temp_scan_attrs[] = {
+	{
+		.name = "raw",
+		.show = temp_scan_iio_read_raw,
+	},
+	{
+		.name = "scale",
+		.show = temp_scan_iio_read_scale,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+/* Milli-degrees Celsius, the IIO unit of temperature */
+static struct scan_type temp_scan_scan = {
+	.sign = 's',
+	.realbits = 32,
+	.storagebits = 32,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+static struct scan_type temp_scan_timestamp_scan = {
+	.sign = 's',
+	.realbits = 64,
+	.storagebits = 64,
+	.shift = 0,
+	.is_big_endian = false,
+};
+
+static struct iio_device temp_scan_iio_dev = {
+	.submit = temp_scan_iio_submit,
+	.trigger_handler = temp_scan_iio_trigger_handler,
+};
+
+/**
+ * @brief Read the raw attribute for a specific channel, from the latest
+ * snapshot.
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int temp_scan_iio_read_raw(void *dev, char *buf, uint32_t len,
+				  const struct iio_ch_info *channel,
+				  intptr_t priv)
+{
+	struct temp_scan_iio_desc *desc = dev;
+	struct temp_scan_snapshot snapshot;
+	int32_t val;
+	int ret;
+
+	ret = temp_scan_get_snapshot(desc->temp_scan_desc, &snapshot);
+	if (ret)
+		return ret;
+
+	if (snapshot.fault_mask & NO_OS_BIT(channel->ch_num))
+		return -EIO;
+
+	val = snapshot.temp[channel->ch_num];
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Read the scale attribute for a specific channel
+ * @param dev - The iio device structure.
+ * @param buf - Buffer to be filled with requested data.
+ * @param len - Length of the received command buffer in bytes.
+ * @param channel - Command channel info.
+ * @param priv - Private descriptor
+ * @return 0 in case of success, error code otherwise
+ */
+static int temp_scan_iio_read_scale(void *dev, char *buf, uint32_t len,
+				    const struct iio_ch_info *channel,
+				    intptr_t priv)
+{
+	int32_t val = 1;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, &val);
+}
+
+/**
+ * @brief Push the latest snapshot as a scan of the enabled channels.
+ * @param desc - The iio descriptor.
+ * @param buffer - The iio buffer.
+ * @return 0 in case of success, error code otherwise
+ */
+static int temp_scan_iio_push(struct temp_scan_iio_desc *desc,
+			      struct iio_buffer *buffer)
+{
+	uint64_t scan[TEMP_SCAN_MAX_SENSORS / 2 + 1] = { 0 };
+	struct temp_scan_snapshot snapshot;
+	uint32_t nb_sensors = desc->temp_scan_desc->nb_sensors;
+	uint32_t *data = (uint32_t *)scan;
+	uint32_t cnt = 0;
+	int64_t ts;
+	uint32_t i;
+	int ret;
+
+	ret = temp_scan_get_snapshot(desc->temp_scan_desc, &snapshot);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < nb_sensors; i++)
+		if (buffer->active_mask & NO_OS_BIT(i))
+			data[cnt++] = snapshot.temp[i];
+
+	/* The timestamp is aligned to its own size */
+	if (buffer->active_mask & NO_OS_BIT(nb_sensors)) {
+		ts = (int64_t)snapshot.timestamp_us * 1000;
+		memcpy(&scan[NO_OS_DIV_ROUND_UP(cnt, 2)], &ts, sizeof(ts));
+	}
+
+	return iio_buffer_push_scan(buffer, scan);
+}
+
+/**
+ * @brief Run a scan pass per requested sample and push the snapshots.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t temp_scan_iio_submit(struct iio_device_data *dev_data)
+{
+	struct temp_scan_iio_desc *desc = dev_data->dev;
+	uint32_t i;
+	int ret;
+
+	for (i = 0; i < dev_data->buffer->samples; i++) {
+		ret = temp_scan_run(desc->temp_scan_desc);
+		if (ret)
+			return ret;
+
+		ret = temp_scan_iio_push(desc, dev_data->buffer);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Trigger handler, the trigger sets the scan schedule. Each trigger
+ * runs a pass and pushes its snapshot.
+ * @param dev_data - The iio device data structure.
+ * @return 0 in case of success, error code otherwise
+ */
+static int32_t temp_scan_iio_trigger_handler(struct iio_device_data *dev_data)
+{
+	struct temp_scan_iio_desc *desc = dev_data->dev;
+	int ret;
+
+	ret = temp_scan_run(desc->temp_scan_desc);
+	if (ret)
+		return ret;
+
+	return temp_scan_iio_push(desc, dev_data->buffer);
+}
+
+/**
+ * @brief Initializes the temperature scan IIO descriptor, with a channel per
+ * scanned sensor.
+ * @param desc - The iio device descriptor.
+ * @param init_param - The structure that contains the scan engine parameters.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int temp_scan_iio_init(struct temp_scan_iio_desc **desc,
+		       struct temp_scan_iio_init_param *init_param)
+{
+	struct temp_scan_iio_desc *descriptor;
+	struct iio_channel *ch;
+	uint32_t nb_sensors;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !init_param || !init_param->temp_scan_init_param)
+		return -EINVAL;
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	ret = temp_scan_init(&descriptor->temp_scan_desc,
+			     init_param->temp_scan_init_param);
+	if (ret)
+		goto free_desc;
+
+	nb_sensors = descriptor->temp_scan_desc->nb_sensors;
+	for (i = 0; i < nb_sensors; i++) {
+		ch = &descriptor->channels[i];
+		ch->ch_type = IIO_TEMP;
+		ch->channel = i;
+		ch->indexed = true;
+		ch->scan_index = i;
+		ch->scan_type = &temp_scan_scan;
+		ch->attributes = temp_scan_attrs;
+	}
+
+	ch = &descriptor->channels[nb_sensors];
+	ch->ch_type = IIO_TIMESTAMP;
+	ch->channel = nb_sensors;
+	ch->scan_index = nb_sensors;
+	ch->scan_type = &temp_scan_timestamp_scan;
+
+	descriptor->iio_device = temp_scan_iio_dev;
+	descriptor->iio_device.channels = descriptor->channels;
+	descriptor->iio_device.num_ch = nb_sensors + 1;
+	descriptor->iio_dev = &descriptor->iio_device;
+
+	*desc = descriptor;
+
+	return 0;
+
+free_desc:
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free an iio descriptor.
+ * @param desc - The descriptor to be freed.
+ * @return 0 in case of success, an error code otherwise.
+ */
+int temp_scan_iio_remove(struct temp_scan_iio_desc *desc)
+{
+	int ret;
+
+	ret = temp_scan_remove(desc->temp_scan_desc);
+	if (ret)
+		return ret;
+
+	no_os_free(desc);
+
+	return 0;
+}
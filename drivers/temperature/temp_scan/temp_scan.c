@@ -0,0 +1,212 @@
+/***************************************************************************//**
+ *   @file   temp_scan.c
+ *   @brief  Multi-sensor temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_alloc.h"
+#include "no_os_delay.h"
+#include "no_os_util.h"
+#include "temp_scan.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Undo the setup of the first nb_sensors sensors.
+ * @param desc - The scan engine descriptor.
+ * @param nb_sensors - Number of sensors to disable.
+ */
+static void temp_scan_disable(struct temp_scan_desc *desc, uint32_t nb_sensors)
+{
+	struct temp_scan_sensor *sensor;
+	uint32_t i;
+
+	for (i = 0; i < nb_sensors; i++) {
+		sensor = &desc->sensors[i];
+		if (sensor->ops->disable)
+			sensor->ops->disable(sensor);
+	}
+}
+
+/**
+ * @brief Initialize the scan engine. Each sensor is set up for back-to-back
+ * reads, so that a pass only reads the latest conversions.
+ * @param desc - The scan engine descriptor.
+ * @param init_param - The sensors to scan.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int temp_scan_init(struct temp_scan_desc **desc,
+		   const struct temp_scan_init_param *init_param)
+{
+	struct temp_scan_desc *descriptor;
+	const struct temp_scan_sensor *cfg;
+	struct temp_scan_sensor *sensor;
+	uint32_t i;
+	int ret;
+
+	if (!desc || !init_param || !init_param->sensors ||
+	    !init_param->nb_sensors ||
+	    init_param->nb_sensors > TEMP_SCAN_MAX_SENSORS)
+		return -EINVAL;
+
+	for (i = 0; i < init_param->nb_sensors; i++) {
+		cfg = &init_param->sensors[i];
+		if (!cfg->ops || !cfg->ops->read || !cfg->dev)
+			return -EINVAL;
+	}
+
+	descriptor = no_os_calloc(1, sizeof(*descriptor));
+	if (!descriptor)
+		return -ENOMEM;
+
+	memcpy(descriptor->sensors, init_param->sensors,
+	       init_param->nb_sensors * sizeof(*init_param->sensors));
+	descriptor->nb_sensors = init_param->nb_sensors;
+
+	for (i = 0; i < descriptor->nb_sensors; i++) {
+		sensor = &descriptor->sensors[i];
+		if (!sensor->divider)
+			sensor->divider = 1;
+
+		if (sensor->ops->enable) {
+			ret = sensor->ops->enable(sensor);
+			if (ret)
+				goto disable;
+		}
+	}
+
+	*desc = descriptor;
+
+	return 0;
+
+disable:
+	temp_scan_disable(descriptor, i);
+	no_os_free(descriptor);
+
+	return ret;
+}
+
+/**
+ * @brief Free the scan engine. The sensor descriptors are left to their
+ * owners.
+ * @param desc - The scan engine descriptor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int temp_scan_remove(struct temp_scan_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	temp_scan_disable(desc, desc->nb_sensors);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Run a scan pass. The sensors due in this pass are read and the
+ * others keep their previous value. The result is published as a whole, so
+ * readers never see a partially updated snapshot.
+ * @param desc - The scan engine descriptor.
+ * @return 0 in case of success, negative error code otherwise. A failed
+ * sensor read is reported in the fault mask of the snapshot.
+ */
+int temp_scan_run(struct temp_scan_desc *desc)
+{
+	struct temp_scan_snapshot *next;
+	struct temp_scan_sensor *sensor;
+	struct no_os_time t;
+	uint32_t seq;
+	uint32_t i;
+	int32_t val;
+
+	if (!desc)
+		return -EINVAL;
+
+	seq = desc->seq;
+	next = &desc->snapshot[(seq + 1) & 1];
+	*next = desc->snapshot[seq & 1];
+
+	for (i = 0; i < desc->nb_sensors; i++) {
+		sensor = &desc->sensors[i];
+		if (desc->pass % sensor->divider)
+			continue;
+
+		if (sensor->ops->read(sensor, &val)) {
+			next->fault_mask |= NO_OS_BIT(i);
+			continue;
+		}
+
+		next->temp[i] = val;
+		next->fault_mask &= ~NO_OS_BIT(i);
+	}
+
+	t = no_os_get_time();
+	next->timestamp_us = (uint64_t)t.s * 1000000 + t.us;
+
+	desc->pass++;
+	desc->seq = seq + 1;
+
+	return 0;
+}
+
+/**
+ * @brief Get a copy of the latest snapshot. A pass may run from an interrupt
+ * meanwhile, the copy is retried if the snapshot was replaced.
+ * @param desc - The scan engine descriptor.
+ * @param snapshot - The copy.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int temp_scan_get_snapshot(struct temp_scan_desc *desc,
+			   struct temp_scan_snapshot *snapshot)
+{
+	uint32_t seq;
+
+	if (!desc || !snapshot)
+		return -EINVAL;
+
+	do {
+		seq = desc->seq;
+		*snapshot = desc->snapshot[seq & 1];
+	} while (seq != desc->seq);
+
+	return 0;
+}
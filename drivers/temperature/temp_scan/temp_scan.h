@@ -0,0 +1,157 @@
+/***************************************************************************//**
+ *   @file   temp_scan.h
+ *   @brief  Multi-sensor temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __TEMP_SCAN_H__
+#define __TEMP_SCAN_H__
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define TEMP_SCAN_MAX_SENSORS		16
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+struct temp_scan_sensor;
+
+/**
+ * @struct temp_scan_sensor_ops
+ * @brief Sensor specific access, selected once per sensor at setup.
+ */
+struct temp_scan_sensor_ops {
+	/** Set the sensor up for back-to-back reads, optional */
+	int (*enable)(struct temp_scan_sensor *sensor);
+	/** Read the latest conversion, in milli-degrees Celsius */
+	int (*read)(struct temp_scan_sensor *sensor, int32_t *mdeg);
+	/** Undo enable, optional */
+	int (*disable)(struct temp_scan_sensor *sensor);
+};
+
+/**
+ * @struct temp_scan_sensor
+ * @brief One scanned temperature sensor.
+ */
+struct temp_scan_sensor {
+	/** One of the temp_scan_*_ops below */
+	const struct temp_scan_sensor_ops *ops;
+	/** Initialized driver descriptor of the sensor */
+	void *dev;
+	/** Read the sensor every divider passes, 0 and 1 mean every pass */
+	uint32_t divider;
+	/** MAX31865 only, reference resistor in milliohms */
+	uint32_t rref_mohm;
+	/** MAX31865 only, RTD resistance at 0 degrees Celsius in milliohms */
+	uint32_t r0_mohm;
+};
+
+/**
+ * @struct temp_scan_snapshot
+ * @brief Result of a scan pass.
+ */
+struct temp_scan_snapshot {
+	/** Temperatures in milli-degrees Celsius, in sensor order */
+	int32_t temp[TEMP_SCAN_MAX_SENSORS];
+	/** Sensors whose last read failed, their temperature is stale */
+	uint32_t fault_mask;
+	/** Time at the end of the pass, in microseconds */
+	uint64_t timestamp_us;
+};
+
+/**
+ * @struct temp_scan_init_param
+ * @brief Scan engine initialization parameters.
+ */
+struct temp_scan_init_param {
+	/** Sensors to scan, copied at init */
+	const struct temp_scan_sensor *sensors;
+	uint32_t nb_sensors;
+};
+
+/**
+ * @struct temp_scan_desc
+ * @brief Scan engine descriptor.
+ */
+struct temp_scan_desc {
+	struct temp_scan_sensor sensors[TEMP_SCAN_MAX_SENSORS];
+	uint32_t nb_sensors;
+	/** Number of completed passes */
+	uint32_t pass;
+	/** Published snapshot is snapshot[seq & 1] */
+	volatile uint32_t seq;
+	struct temp_scan_snapshot snapshot[2];
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/** MAX31855 thermocouple, NIST type K corrected */
+extern const struct temp_scan_sensor_ops temp_scan_max31855_ops;
+
+/** MAX31865 platinum RTD, kept in auto-convert mode */
+extern const struct temp_scan_sensor_ops temp_scan_max31865_ops;
+
+/** ADT7420/ADT7320 */
+extern const struct temp_scan_sensor_ops temp_scan_adt7420_ops;
+
+/** ADT75 */
+extern const struct temp_scan_sensor_ops temp_scan_adt75_ops;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/** Initialize the scan engine and set the sensors up */
+int temp_scan_init(struct temp_scan_desc **desc,
+		   const struct temp_scan_init_param *init_param);
+
+/** Free the scan engine, the sensor descriptors are not removed */
+int temp_scan_remove(struct temp_scan_desc *desc);
+
+/** Run a scan pass and publish its snapshot */
+int temp_scan_run(struct temp_scan_desc *desc);
+
+/** Get a consistent copy of the latest snapshot */
+int temp_scan_get_snapshot(struct temp_scan_desc *desc,
+			   struct temp_scan_snapshot *snapshot);
+
+#endif /* __TEMP_SCAN_H__ */
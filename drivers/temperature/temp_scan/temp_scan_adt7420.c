@@ -0,0 +1,80 @@
+/***************************************************************************//**
+ *   @file   temp_scan_adt7420.c
+ *   @brief  ADT7420/ADT7320 access of the temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "adt7420.h"
+#include "temp_scan.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read the temperature register, 1 LSB = 1/128 degrees in both the 13
+ * and 16-bit resolutions.
+ * @param sensor - The sensor.
+ * @param mdeg - Temperature in milli-degrees Celsius.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int temp_scan_adt7420_read(struct temp_scan_sensor *sensor,
+				  int32_t *mdeg)
+{
+	struct adt7420_dev *dev = sensor->dev;
+	uint16_t temp;
+	int ret;
+
+	if (adt7420_is_spi(dev))
+		ret = adt7420_reg_read(dev, ADT7320_REG_TEMP, &temp);
+	else
+		ret = adt7420_reg_read(dev, ADT7420_REG_TEMP_MSB, &temp);
+	if (ret)
+		return ret;
+
+	/* The three LSBs are flags in the 13-bit resolution */
+	if (!dev->resolution_setting)
+		temp &= ~0x7;
+
+	*mdeg = (int32_t)(int16_t)temp * 125 / 16;
+
+	return 0;
+}
+
+const struct temp_scan_sensor_ops temp_scan_adt7420_ops = {
+	.read = temp_scan_adt7420_read,
+};
@@ -0,0 +1,193 @@
+/***************************************************************************//**
+ *   @file   temp_scan_lut.c
+ *   @brief  Fixed-point linearisation tables of the temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_util.h"
+#include "temp_scan_lut.h"
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/*
+ * The tables are sampled on a uniform grid from the NIST ITS-90 type K
+ * polynomials and the IEC 60751 Callendar-Van Dusen equation, so a lookup
+ * is a shift and a single linear interpolation.
+ */
+
+/*
+ * Type K EMF in uV, from -64 to 128 degrees Celsius in steps of 8 degrees.
+ * The abscissa is in 1/16 degrees, as the MAX31855 cold junction.
+ * Interpolation error below 2 uV.
+ */
+static const int32_t k_emf_uv[] = {
+	-2382, -2103, -1818, -1527, -1231, -930,
+	-624, -314, 0, 317, 637, 960,
+	1285, 1612, 1941, 2271, 2602, 2934,
+	3267, 3599, 3931, 4262, 4591, 4920,
+	5247,
+};
+
+/*
+ * Type K temperature in milli-degrees Celsius, from -6144 to 55296 uV in
+ * steps of 256 uV. Interpolation error below 0.04 degrees from -100 degrees
+ * up, 0.35 degrees at -200 degrees.
+ */
+static const int32_t k_temp_mdeg[] = {
+	-218746, -199777, -184433, -171081, -159041, -147952,
+	-137589, -127805, -118494, -109578, -100998, -92706,
+	-84665, -76843, -69215, -61759, -54455, -47289,
+	-40247, -33316, -26487, -19750, -13097, -6517,
+	0, 6464, 12880, 19253, 25586, 31884,
+	38150, 44389, 50604, 56800, 62981, 69151,
+	75315, 81477, 87642, 93813, 99994, 106190,
+	112404, 118637, 124891, 131169, 137470, 143795,
+	150140, 156506, 162889, 169285, 175691, 182104,
+	188519, 194932, 201339, 207738, 214126, 220500,
+	226859, 233202, 239527, 245836, 252127, 258402,
+	264660, 270903, 277131, 283346, 289547, 295737,
+	301916, 308085, 314243, 320393, 326534, 332667,
+	338793, 344911, 351022, 357127, 363225, 369317,
+	375403, 381483, 387557, 393625, 399689, 405747,
+	411800, 417849, 423893, 429933, 435968, 442000,
+	448027, 454052, 460073, 466091, 472106, 478119,
+	484130, 490139, 496146, 502151, 508156, 514159,
+	520162, 526165, 532167, 538170, 544174, 550178,
+	556183, 562189, 568197, 574207, 580219, 586234,
+	592251, 598272, 604295, 610322, 616353, 622388,
+	628427, 634471, 640519, 646572, 652631, 658695,
+	664765, 670840, 676922, 683010, 689104, 695205,
+	701313, 707429, 713551, 719681, 725818, 731964,
+	738117, 744278, 750447, 756625, 762811, 769006,
+	775209, 781422, 787643, 793873, 800113, 806361,
+	812619, 818887, 825164, 831450, 837746, 844052,
+	850368, 856693, 863029, 869374, 875729, 882095,
+	888470, 894856, 901252, 907659, 914075, 920503,
+	926940, 933389, 939848, 946317, 952798, 959289,
+	965791, 972305, 978829, 985365, 991912, 998471,
+	1005042, 1011624, 1018218, 1024824, 1031442, 1038073,
+	1044716, 1051373, 1058042, 1064724, 1071420, 1078130,
+	1084853, 1091591, 1098343, 1105110, 1111892, 1118689,
+	1125503, 1132332, 1139177, 1146039, 1152919, 1159815,
+	1166730, 1173663, 1180614, 1187584, 1194574, 1201583,
+	1208613, 1215663, 1222734, 1229827, 1236941, 1244077,
+	1251235, 1258417, 1265621, 1272849, 1280100, 1287375,
+	1294674, 1301997, 1309344, 1316716, 1324111, 1331531,
+	1338974, 1346442, 1353932, 1361445, 1368981, 1376538,
+	1384116,
+};
+
+/*
+ * Platinum RTD temperature in milli-degrees Celsius, from R/R0 = 0.1875 to
+ * 3.90625 in steps of 1/32. The abscissa is R/R0 in Q16. Interpolation error
+ * below 0.006 degrees.
+ */
+static const int32_t rtd_temp_mdeg[] = {
+	-199468, -192215, -184918, -177580, -170201, -162783,
+	-155327, -147834, -140305, -132742, -125146, -117519,
+	-109860, -102172, -94456, -86713, -78943, -71148,
+	-63329, -55487, -47623, -39736, -31829, -23901,
+	-15953, -7986, 0, 8005, 16030, 24073,
+	32136, 40218, 48320, 56441, 64583, 72744,
+	80926, 89128, 97350, 105593, 113857, 122141,
+	130447, 138774, 147123, 155493, 163885, 172298,
+	180734, 189192, 197673, 206176, 214702, 223251,
+	231824, 240419, 249038, 257681, 266348, 275039,
+	283755, 292495, 301259, 310049, 318864, 327705,
+	336571, 345463, 354381, 363325, 372296, 381294,
+	390318, 399370, 408450, 417557, 426693, 435857,
+	445049, 454270, 463520, 472800, 482109, 491449,
+	500818, 510218, 519649, 529111, 538605, 548130,
+	557688, 567278, 576900, 586556, 596245, 605969,
+	615726, 625517, 635344, 645206, 655103, 665037,
+	675007, 685013, 695057, 705139, 715259, 725417,
+	735614, 745851, 756128, 766444, 776802, 787201,
+	797642, 808125, 818651, 829221, 839834, 850492,
+};
+
+const struct temp_scan_lut temp_scan_k_emf_lut = {
+	.x0 = -1024,
+	.shift = 7,
+	.size = NO_OS_ARRAY_SIZE(k_emf_uv),
+	.y = k_emf_uv,
+};
+
+const struct temp_scan_lut temp_scan_k_temp_lut = {
+	.x0 = -6144,
+	.shift = 8,
+	.size = NO_OS_ARRAY_SIZE(k_temp_mdeg),
+	.y = k_temp_mdeg,
+};
+
+const struct temp_scan_lut temp_scan_rtd_lut = {
+	.x0 = 12288,
+	.shift = 11,
+	.size = NO_OS_ARRAY_SIZE(rtd_temp_mdeg),
+	.y = rtd_temp_mdeg,
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Evaluate a table by linear interpolation. Values outside of the
+ * table are extrapolated from the first or last segment.
+ * @param lut - The table.
+ * @param x - Abscissa, in the units of the table.
+ * @return The interpolated value.
+ */
+int32_t temp_scan_lut_eval(const struct temp_scan_lut *lut, int32_t x)
+{
+	int32_t pos = x - lut->x0;
+	uint32_t idx;
+	int32_t frac;
+	int64_t dy;
+
+	if (pos < 0)
+		idx = 0;
+	else
+		idx = no_os_min((uint32_t)pos >> lut->shift, lut->size - 2u);
+
+	frac = pos - (int32_t)(idx << lut->shift);
+	dy = (int64_t)(lut->y[idx + 1] - lut->y[idx]) * frac;
+
+	return lut->y[idx] + (int32_t)(dy >> lut->shift);
+}
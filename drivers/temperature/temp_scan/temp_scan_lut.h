@@ -0,0 +1,85 @@
+/***************************************************************************//**
+ *   @file   temp_scan_lut.h
+ *   @brief  Fixed-point linearisation tables of the temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef __TEMP_SCAN_LUT_H__
+#define __TEMP_SCAN_LUT_H__
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct temp_scan_lut
+ * @brief Piecewise-linear table sampled on a uniform grid.
+ */
+struct temp_scan_lut {
+	/** Abscissa of the first entry */
+	int32_t x0;
+	/** Log2 of the abscissa step */
+	uint8_t shift;
+	/** Number of entries */
+	uint32_t size;
+	/** Values at x0 + (i << shift) */
+	const int32_t *y;
+};
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+
+/** Type K EMF (uV) of a temperature in 1/16 degrees Celsius */
+extern const struct temp_scan_lut temp_scan_k_emf_lut;
+
+/** Type K temperature (milli-degrees Celsius) of an EMF in uV */
+extern const struct temp_scan_lut temp_scan_k_temp_lut;
+
+/** Platinum RTD temperature (milli-degrees Celsius) of R/R0 in Q16 */
+extern const struct temp_scan_lut temp_scan_rtd_lut;
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/** Evaluate a table by linear interpolation */
+int32_t temp_scan_lut_eval(const struct temp_scan_lut *lut, int32_t x);
+
+#endif /* __TEMP_SCAN_LUT_H__ */
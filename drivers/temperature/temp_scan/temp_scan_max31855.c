@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ *   @file   temp_scan_max31855.c
+ *   @brief  MAX31855 access of the temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_util.h"
+#include "max31855.h"
+#include "temp_scan.h"
+#include "temp_scan_lut.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* The MAX31855 assumes a linear 41.276 uV/degree type K characteristic */
+#define TEMP_SCAN_MAX31855_NV_PER_DEG		41276
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Read a MAX31855 and correct its linear approximation: the measured
+ * thermocouple voltage and the NIST EMF of the cold junction are added, then
+ * converted back with the NIST table.
+ * @param sensor - The sensor.
+ * @param mdeg - Thermocouple temperature in milli-degrees Celsius.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int temp_scan_max31855_read(struct temp_scan_sensor *sensor,
+				   int32_t *mdeg)
+{
+	int32_t tc, cj, uv;
+	uint32_t raw;
+	int ret;
+
+	ret = max31855_read_raw(sensor->dev, &raw);
+	if (ret)
+		return ret;
+
+	/* Both in 1/16 degrees */
+	tc = no_os_sign_extend32(MAX31855_GET_THERMOCOUPLE_TEMP(raw),
+				 MAX31855_THERMOCOUPLE_TEMP_SIGN_POS) * 4;
+	cj = no_os_sign_extend32(MAX31855_GET_INTERNAL_TEMP(raw),
+				 MAX31855_INTERNAL_TEMP_SIGN_POS);
+
+	uv = (tc - cj) * TEMP_SCAN_MAX31855_NV_PER_DEG / 16000;
+	uv += temp_scan_lut_eval(&temp_scan_k_emf_lut, cj);
+	*mdeg = temp_scan_lut_eval(&temp_scan_k_temp_lut, uv);
+
+	return 0;
+}
+
+const struct temp_scan_sensor_ops temp_scan_max31855_ops = {
+	.read = temp_scan_max31855_read,
+};
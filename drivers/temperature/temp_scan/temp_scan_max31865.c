@@ -0,0 +1,118 @@
+/***************************************************************************//**
+ *   @file   temp_scan_max31865.c
+ *   @brief  MAX31865 access of the temperature scan engine.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include "no_os_error.h"
+#include "max31865.h"
+#include "temp_scan.h"
+#include "temp_scan_lut.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Keep the bias on and the converter in auto-convert mode, so a read
+ * does not wait for a one-shot conversion.
+ * @param sensor - The sensor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int temp_scan_max31865_enable(struct temp_scan_sensor *sensor)
+{
+	int ret;
+
+	if (!sensor->rref_mohm || !sensor->r0_mohm)
+		return -EINVAL;
+
+	ret = max31865_clear_fault(sensor->dev);
+	if (ret)
+		return ret;
+
+	ret = max31865_enable_bias(sensor->dev, true);
+	if (ret)
+		return ret;
+
+	return max31865_auto_convert(sensor->dev, true);
+}
+
+/**
+ * @brief Read the latest RTD conversion and linearise it.
+ * @param sensor - The sensor.
+ * @param mdeg - RTD temperature in milli-degrees Celsius.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int temp_scan_max31865_read(struct temp_scan_sensor *sensor,
+				   int32_t *mdeg)
+{
+	uint16_t code;
+	uint64_t ratio;
+	int ret;
+
+	ret = max31865_read_rtd_auto(sensor->dev, &code);
+	if (ret)
+		return ret;
+
+	/* R / R0 in Q16, R = code * Rref / 2^15 */
+	ratio = (uint64_t)code * sensor->rref_mohm * 2 / sensor->r0_mohm;
+	*mdeg = temp_scan_lut_eval(&temp_scan_rtd_lut, (int32_t)ratio);
+
+	return 0;
+}
+
+/**
+ * @brief Stop the conversions and the bias.
+ * @param sensor - The sensor.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+static int temp_scan_max31865_disable(struct temp_scan_sensor *sensor)
+{
+	int ret;
+
+	ret = max31865_auto_convert(sensor->dev, false);
+	if (ret)
+		return ret;
+
+	return max31865_enable_bias(sensor->dev, false);
+}
+
+const struct temp_scan_sensor_ops temp_scan_max31865_ops = {
+	.enable = temp_scan_max31865_enable,
+	.read = temp_scan_max31865_read,
+	.disable = temp_scan_max31865_disable,
+};
@@ -77,6 +77,8 @@
 #define REG_ACCESS_ATTRIBUTE	"direct_reg_access"
 #define IIOD_CONN_BUFFER_SIZE	0x1000
 #define NO_TRIGGER				(uint32_t)-1
+/* Maximum number of asynchronous trigger events replayed from iio_step */
+#define IIO_TRIG_MAX_BACKLOG	16
 
 #define NO_OS_STRINGIFY(x) #x
 #define NO_OS_TOSTRING(x) NO_OS_STRINGIFY(x)
@@ -129,6 +131,7 @@ static const char * const iio_chan_type_string[] = {
 	[IIO_COUNT] = "count",
 	[IIO_DELTA_ANGL] = "deltaangl",
 	[IIO_DELTA_VELOCITY] = "deltavelocity",
+	[IIO_TIMESTAMP] = "timestamp",
 };
 
 static const char * const iio_modifier_names[] = {
@@ -186,6 +189,8 @@ struct iio_dev_priv {
 	struct iio_buffer_priv buffer;
 	/* Set to -1 when no trigger is set*/
 	uint32_t		trig_idx;
+	/* Asynchronous events of the trigger already processed */
+	uint32_t		trig_handled;
 };
 
 /**
@@ -202,8 +207,16 @@ struct iio_trig_priv {
 	void	*instance;
 	/** Trigger descriptor(describes type of trigger and its attributes) */
 	struct iio_trigger *descriptor;
-	/** Set to true when the triggering condition is met */
-	bool	triggered;
+	/** Devices with a trigger handler currently attached to the trigger */
+	struct iio_dev_priv **devs;
+	/** Number of entries in devs */
+	volatile uint32_t nb_devs;
+	/** Trigger events signaled from interrupt context */
+	volatile uint32_t events;
+	/** Set while the trigger is enabled */
+	bool	enabled;
+	/** Asynchronous trigger events dropped because of backlog overflow */
+	uint32_t overruns;
 };
 
 struct iio_desc {
@@ -218,6 +231,8 @@ struct iio_desc {
 	uint32_t		nb_devs;
 	struct iio_trig_priv	*trigs;
 	uint32_t		nb_trigs;
+	/* Storage for the per trigger device lists */
+	struct iio_dev_priv	**trig_devs;
 	struct no_os_uart_desc	*uart_desc;
 	int (*recv)(void *conn, uint8_t *buf, uint32_t len);
 	int (*send)(void *conn, uint8_t *buf, uint32_t len);
@@ -955,6 +970,40 @@ static uint32_t iio_get_trig_idx_by_name(struct iio_desc *desc,
 	return NO_TRIGGER;
 }
 
+/**
+ * @brief Rebuild the list of devices dispatched by a trigger.
+ * The list only holds devices having a trigger handler, so that the interrupt
+ * path does not have to walk and filter every registered device. An enabled
+ * trigger is disabled meanwhile, so that its interrupt does not walk a half
+ * updated list.
+ * @param desc     - IIO descriptor.
+ * @param trig_idx - Trigger index. NO_TRIGGER is ignored.
+ */
+static void iio_trig_update_devs(struct iio_desc *desc, uint32_t trig_idx)
+{
+	struct iio_trig_priv *trig;
+	struct iio_dev_priv *dev;
+	uint32_t i, n = 0;
+
+	if (trig_idx == NO_TRIGGER)
+		return;
+
+	trig = &desc->trigs[trig_idx];
+	if (trig->enabled && trig->descriptor->disable)
+		trig->descriptor->disable(trig->instance);
+
+	for (i = 0; i < desc->nb_devs; i++) {
+		dev = desc->devs + i;
+		if (dev->trig_idx == trig_idx &&
+		    dev->dev_descriptor->trigger_handler)
+			trig->devs[n++] = dev;
+	}
+	trig->nb_devs = n;
+
+	if (trig->enabled && trig->descriptor->enable)
+		trig->descriptor->enable(trig->instance);
+}
+
 /**
  * @brief Searches for active trigger of the given device and returns trigger name.
  * @param ctx     - IIO instance and conn instance.
@@ -1005,7 +1054,7 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 {
 	struct iio_dev_priv	*dev;
 	struct iio_trig_priv	*trig;
-	uint32_t i;
+	uint32_t i, old_idx;
 	struct iio_desc *desc = ctx->instance;
 
 	if (!desc->nb_trigs)
@@ -1021,7 +1070,9 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 		return -ENODEV;
 
 	if (trigger[0] == '\0') {
+		i = dev->trig_idx;
 		dev->trig_idx = NO_TRIGGER;
+		iio_trig_update_devs(desc, i);
 		return 0;
 	}
 
@@ -1029,72 +1080,165 @@ static int iio_set_trigger(struct iiod_ctx *ctx, const char *device,
 	if (i == NO_TRIGGER)
 		return -EINVAL;
 
+	old_idx = dev->trig_idx;
 	dev->trig_idx = i;
+	dev->trig_handled = desc->trigs[i].events;
+	iio_trig_update_devs(desc, old_idx);
+	iio_trig_update_devs(desc, i);
 
 	return len;
 }
 
+/**
+ * @brief Call the trigger handler of every device attached to a trigger.
+ * @param trig - Trigger instance.
+ */
+static void iio_trig_dispatch(struct iio_trig_priv *trig)
+{
+	struct iio_dev_priv *dev;
+	uint32_t i;
+
+	for (i = 0; i < trig->nb_devs; i++) {
+		dev = trig->devs[i];
+		dev->dev_descriptor->trigger_handler(&dev->dev_data);
+	}
+}
+
 /**
  * @brief Asynchronous trigger processing routine.
+ * Every event counted since the last call is replayed to each attached
+ * device, up to IIO_TRIG_MAX_BACKLOG events per device. Older events are
+ * dropped and accounted once as overruns of the trigger, however many devices
+ * missed them.
  * @param desc - IIO descriptor.
  */
 static void iio_process_async_triggers(struct iio_desc *desc)
 {
+	struct iio_trig_priv *trig;
 	struct iio_dev_priv *dev;
-	uint32_t i;
+	int32_t (*handler)(struct iio_device_data *dev);
+	uint32_t pending, events, max_pending;
+	uint32_t i, j;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == NO_TRIGGER)
-			continue;
-
-		if (!desc->trigs[dev->trig_idx].triggered)
+	for (i = 0; i < desc->nb_trigs; i++) {
+		trig = desc->trigs + i;
+		if (trig->descriptor->is_synchronous)
 			continue;
 
-		if (dev->dev_descriptor->trigger_handler) {
-			dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			desc->trigs[i].triggered = 0;
+		events = trig->events;
+		max_pending = 0;
+		for (j = 0; j < trig->nb_devs; j++) {
+			dev = trig->devs[j];
+			pending = events - dev->trig_handled;
+			dev->trig_handled = events;
+			/*
+			 * All the devices drop the oldest events of the same
+			 * backlog, the device furthest behind drops them all.
+			 */
+			max_pending = no_os_max(max_pending, pending);
+			pending = no_os_min(pending, IIO_TRIG_MAX_BACKLOG);
+
+			handler = dev->dev_descriptor->trigger_handler;
+			while (pending--)
+				handler(&dev->dev_data);
 		}
+
+		if (max_pending > IIO_TRIG_MAX_BACKLOG)
+			trig->overruns += max_pending - IIO_TRIG_MAX_BACKLOG;
 	}
 }
 
 /**
- * @brief Searches for trigger name and processes the trigger based on its
- * type (sync or async with the interrupt).
- * @param desc         - IIO descriptor.
- * @param trigger_name - Trigger name.
+ * @brief Get the index of a trigger, to be used with iio_trigger_event().
+ * @param desc - IIO descriptor.
+ * @param name - Trigger name.
+ * @param idx  - Trigger index.
  *
- * @return ret - Result of the processing procedure.
+ * @return 0 in case of success, -EINVAL if the trigger is not found.
  */
-int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+int iio_get_trigger_idx(struct iio_desc *desc, const char *name,
+			uint32_t *idx)
 {
 	uint32_t i;
-	uint32_t trig_id;
-	struct iio_trig_priv *trig;
 
-	trig_id = iio_get_trig_idx_by_name(desc, trigger_name);
+	if (!desc || !idx)
+		return -EINVAL;
 
-	if (trig_id == NO_TRIGGER)
+	i = iio_get_trig_idx_by_name(desc, name);
+	if (i == NO_TRIGGER)
 		return -EINVAL;
 
-	struct iio_dev_priv *dev;
+	*idx = i;
 
-	for (i = 0; i < desc->nb_devs; i++) {
-		dev = desc->devs + i;
-		if (dev->trig_idx == trig_id) {
-			trig = &desc->trigs[trig_id];
-			if (trig->descriptor->is_synchronous) {
-				if (dev->dev_descriptor->trigger_handler)
-					dev->dev_descriptor->trigger_handler(&dev->dev_data);
-			} else {
-				trig->triggered = 1;
-			}
-		}
-	}
+	return 0;
+}
+
+/**
+ * @brief Signal a trigger event by trigger index. Synchronous triggers call
+ * the handlers of the attached devices right away, asynchronous ones count
+ * the event for iio_step().
+ * @param desc     - IIO descriptor.
+ * @param trig_idx - Trigger index, as returned by iio_get_trigger_idx().
+ *
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int iio_trigger_event(struct iio_desc *desc, uint32_t trig_idx)
+{
+	struct iio_trig_priv *trig;
+
+	if (!desc || trig_idx >= desc->nb_trigs)
+		return -EINVAL;
+
+	trig = &desc->trigs[trig_idx];
+	if (trig->descriptor->is_synchronous)
+		iio_trig_dispatch(trig);
+	else
+		trig->events++;
 
 	return 0;
 }
 
+/**
+ * @brief Get the number of asynchronous events dropped by a trigger. The
+ * handlers of synchronous triggers run from iio_trigger_event() and never
+ * drop events, so the count is always 0 for them.
+ * @param desc     - IIO descriptor.
+ * @param trig_idx - Trigger index.
+ * @param overruns - Number of dropped events.
+ *
+ * @return 0 in case of success, -EINVAL otherwise.
+ */
+int iio_trigger_get_overruns(struct iio_desc *desc, uint32_t trig_idx,
+			     uint32_t *overruns)
+{
+	if (!desc || !overruns || trig_idx >= desc->nb_trigs)
+		return -EINVAL;
+
+	*overruns = desc->trigs[trig_idx].overruns;
+
+	return 0;
+}
+
+/**
+ * @brief Searches for trigger name and processes the trigger based on its
+ * type (sync or async with the interrupt).
+ * @param desc         - IIO descriptor.
+ * @param trigger_name - Trigger name.
+ *
+ * @return ret - Result of the processing procedure.
+ */
+int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name)
+{
+	uint32_t trig_idx;
+	int ret;
+
+	ret = iio_get_trigger_idx(desc, trigger_name, &trig_idx);
+	if (ret)
+		return ret;
+
+	return iio_trigger_event(desc, trig_idx);
+}
+
 static uint32_t bytes_per_scan(struct iio_channel *channels, uint32_t mask)
 {
 	uint32_t cnt, i, length, largest = 1;
@@ -1207,8 +1351,12 @@ static int iio_open_dev(struct iiod_ctx *ctx, const char *device,
 	desc = ctx->instance;
 	if (dev->trig_idx != NO_TRIGGER) {
 		trig = &desc->trigs[dev->trig_idx];
+		/* Drop events counted while the buffer was disabled */
+		dev->trig_handled = trig->events;
 		if (trig->descriptor->enable)
 			ret = trig->descriptor->enable(trig->instance);
+		if (!ret)
+			trig->enabled = true;
 	}
 
 	return ret;
@@ -1248,6 +1396,7 @@ static int iio_close_dev(struct iiod_ctx *ctx, const char *device)
 			if (ret)
 				return ret;
 		}
+		trig->enabled = false;
 	}
 
 	dev->buffer.public.active_mask = 0;
@@ -1824,6 +1973,20 @@ static int32_t iio_init_devs(struct iio_desc *desc,
 		}
 	}
 
+	if (!desc->nb_trigs || !n)
+		return 0;
+
+	desc->trig_devs = (struct iio_dev_priv **)
+			  no_os_calloc(desc->nb_trigs * n,
+				       sizeof(*desc->trig_devs));
+	if (!desc->trig_devs)
+		return -ENOMEM;
+
+	for (i = 0; i < desc->nb_trigs; i++) {
+		desc->trigs[i].devs = desc->trig_devs + i * n;
+		iio_trig_update_devs(desc, i);
+	}
+
 	return 0;
 }
 
@@ -1885,11 +2048,11 @@ int iio_init(struct iio_desc **desc, struct iio_init_param *init_param)
 
 	ret = iio_init_trigs(ldesc, init_param->trigs, init_param->nb_trigs);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_devs;
+		goto free_desc;
 
 	ret = iio_init_devs(ldesc, init_param->devs, init_param->nb_devs);
 	if (NO_OS_IS_ERR_VALUE(ret))
-		goto free_desc;
+		goto free_trigs;
 
 	ret = iio_init_xml(ldesc);
 	if (NO_OS_IS_ERR_VALUE(ret))
@@ -1989,8 +2152,8 @@ free_iiod:
 free_xml:
 	no_os_free(ldesc->xml_desc);
 free_trigs:
+	no_os_free(ldesc->trig_devs);
 	no_os_free(ldesc->trigs);
-free_devs:
 	no_os_free(ldesc->devs);
 free_desc:
 	no_os_free(ldesc);
@@ -2024,6 +2187,7 @@ int iio_remove(struct iio_desc *desc)
 	no_os_cb_remove(desc->conns);
 	iiod_remove(desc->iiod);
 	no_os_free(desc->devs);
+	no_os_free(desc->trig_devs);
 	no_os_free(desc->trigs);
 	no_os_free(desc->xml_desc);
 	no_os_free(desc);
@@ -140,6 +140,15 @@ int iio_step(struct iio_desc *desc);
    (is_synchronous = true) or will be called from iio_step if trigger is
    asynchronous (is_synchronous = false) */
 int iio_process_trigger_type(struct iio_desc *desc, char *trigger_name);
+/* Get the index of a trigger, to be used with iio_trigger_event(). */
+int iio_get_trigger_idx(struct iio_desc *desc, const char *name,
+			uint32_t *idx);
+/* Same as iio_process_trigger_type(), without the trigger name lookup. */
+int iio_trigger_event(struct iio_desc *desc, uint32_t trig_idx);
+/* Get the number of asynchronous trigger events dropped by iio_step(),
+   always 0 for synchronous triggers. */
+int iio_trigger_get_overruns(struct iio_desc *desc, uint32_t trig_idx,
+			     uint32_t *overruns);
 
 int32_t iio_parse_value(char *buf, enum iio_val fmt,
 			int32_t *val, int32_t *val2);
@@ -0,0 +1,198 @@
+/***************************************************************************//**
+ *   @file   iio_sample_clock.c
+ *   @brief  Implementation of the sampling clock IIO device.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#include <inttypes.h>
+#include <stdio.h>
+#include "iio.h"
+#include "iio_sample_clock.h"
+#include "no_os_error.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+enum iio_sample_clock_attr {
+	IIO_SAMPLE_CLOCK_RATE,
+	IIO_SAMPLE_CLOCK_EFFECTIVE_RATE,
+	IIO_SAMPLE_CLOCK_CONVERSIONS,
+	IIO_SAMPLE_CLOCK_DROPPED,
+	IIO_SAMPLE_CLOCK_PERIOD_MIN,
+	IIO_SAMPLE_CLOCK_PERIOD_MAX,
+	IIO_SAMPLE_CLOCK_JITTER,
+};
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+/**
+ * @brief Handles the read request for the sampling clock attributes.
+ * @param device  - The sampling clock descriptor.
+ * @param buf     - Command buffer to be filled with the data.
+ * @param len     - Length of the received command buffer in bytes.
+ * @param channel - Command channel info (is NULL).
+ * @param priv    - Command attribute id.
+ * @return Number of bytes written in buf or negative error code.
+ */
+static int iio_sample_clock_attr_show(void *device, char *buf, uint32_t len,
+				      const struct iio_ch_info *channel,
+				      intptr_t priv)
+{
+	struct no_os_sample_clock_stats stats;
+	int32_t vals[2];
+	uint32_t rate;
+	int ret;
+
+	if (!device)
+		return -EINVAL;
+
+	if (priv == IIO_SAMPLE_CLOCK_RATE) {
+		ret = no_os_sample_clock_get_rate(device, &rate);
+		if (ret)
+			return ret;
+
+		return snprintf(buf, len, "%"PRIu32"", rate);
+	}
+
+	ret = no_os_sample_clock_get_stats(device, &stats);
+	if (ret)
+		return ret;
+
+	switch (priv) {
+	case IIO_SAMPLE_CLOCK_EFFECTIVE_RATE:
+		vals[0] = stats.rate_mhz / 1000;
+		vals[1] = (stats.rate_mhz % 1000) * 1000;
+
+		return iio_format_value(buf, len, IIO_VAL_INT_PLUS_MICRO, 2,
+					vals);
+	case IIO_SAMPLE_CLOCK_CONVERSIONS:
+		return snprintf(buf, len, "%"PRIu64"", stats.conversions);
+	case IIO_SAMPLE_CLOCK_DROPPED:
+		return snprintf(buf, len, "%"PRIu64"", stats.dropped);
+	case IIO_SAMPLE_CLOCK_PERIOD_MIN:
+		return snprintf(buf, len, "%"PRIu32"", stats.min_period_ns);
+	case IIO_SAMPLE_CLOCK_PERIOD_MAX:
+		return snprintf(buf, len, "%"PRIu32"", stats.max_period_ns);
+	case IIO_SAMPLE_CLOCK_JITTER:
+		return snprintf(buf, len, "%"PRIu32"",
+				stats.max_period_ns - stats.min_period_ns);
+	default:
+		return -EINVAL;
+	}
+}
+
+/**
+ * @brief Handles the write request for the sampling clock attributes.
+ * @param device  - The sampling clock descriptor.
+ * @param buf     - Command buffer holding the value to be written.
+ * @param len     - Length of the received command buffer in bytes.
+ * @param channel - Command channel info (is NULL).
+ * @param priv    - Command attribute id.
+ * @return Number of bytes consumed or negative error code.
+ */
+static int iio_sample_clock_attr_store(void *device, char *buf, uint32_t len,
+				       const struct iio_ch_info *channel,
+				       intptr_t priv)
+{
+	int32_t val;
+	int ret;
+
+	if (!device)
+		return -EINVAL;
+
+	if (priv != IIO_SAMPLE_CLOCK_RATE)
+		return -EINVAL;
+
+	ret = iio_parse_value(buf, IIO_VAL_INT, &val, NULL);
+	if (ret)
+		return ret;
+
+	if (val <= 0)
+		return -EINVAL;
+
+	ret = no_os_sample_clock_set_rate(device, val);
+	if (ret)
+		return ret;
+
+	return len;
+}
+
+/******************************************************************************/
+/************************ Variable Declarations *******************************/
+/******************************************************************************/
+static struct iio_attribute iio_sample_clock_attrs[] = {
+	{
+		.name = "sampling_frequency",
+		.priv = IIO_SAMPLE_CLOCK_RATE,
+		.show = iio_sample_clock_attr_show,
+		.store = iio_sample_clock_attr_store,
+	},
+	{
+		.name = "effective_sampling_frequency",
+		.priv = IIO_SAMPLE_CLOCK_EFFECTIVE_RATE,
+		.show = iio_sample_clock_attr_show,
+	},
+	{
+		.name = "conversions",
+		.priv = IIO_SAMPLE_CLOCK_CONVERSIONS,
+		.show = iio_sample_clock_attr_show,
+	},
+	{
+		.name = "dropped_conversions",
+		.priv = IIO_SAMPLE_CLOCK_DROPPED,
+		.show = iio_sample_clock_attr_show,
+	},
+	{
+		.name = "period_min_ns",
+		.priv = IIO_SAMPLE_CLOCK_PERIOD_MIN,
+		.show = iio_sample_clock_attr_show,
+	},
+	{
+		.name = "period_max_ns",
+		.priv = IIO_SAMPLE_CLOCK_PERIOD_MAX,
+		.show = iio_sample_clock_attr_show,
+	},
+	{
+		.name = "jitter_ns",
+		.priv = IIO_SAMPLE_CLOCK_JITTER,
+		.show = iio_sample_clock_attr_show,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
+struct iio_device iio_sample_clock_device = {
+	.attributes = iio_sample_clock_attrs,
+};
@@ -106,6 +106,30 @@ error:
 	return ret;
 }
 
+/**
+ * @brief Resolve the trigger name to its index in the IIO descriptor, so that
+ * the interrupt handler does not have to look it up on every event.
+ *
+ * @param desc - Trigger structure.
+ *
+ * @return ret - Result of the bind procedure.
+*/
+static int iio_hw_trig_bind(struct iio_hw_trig *desc)
+{
+	int ret;
+
+	if (desc->bound)
+		return 0;
+
+	ret = iio_get_trigger_idx(desc->iio_desc, desc->name, &desc->trig_idx);
+	if (ret)
+		return ret;
+
+	desc->bound = true;
+
+	return 0;
+}
+
 /**
  * @brief Enable system interrupt which is linked to the given trigger.
  *
@@ -119,6 +143,11 @@ int iio_trig_enable(void *trig)
 		return -EINVAL;
 
 	struct iio_hw_trig *desc = trig;
+	int ret;
+
+	ret = iio_hw_trig_bind(desc);
+	if (ret)
+		return ret;
 
 	return no_os_irq_enable(desc->irq_ctrl, desc->irq_id);
 }
@@ -153,9 +182,62 @@ void iio_hw_trig_handler(void *trig)
 
 	struct iio_hw_trig *desc = trig;
 
-	iio_process_trigger_type(desc->iio_desc, desc->name);
+	if (iio_hw_trig_bind(desc))
+		return;
+
+	iio_trigger_event(desc->iio_desc, desc->trig_idx);
+}
+
+/**
+ * @brief Handles the read request for the overruns attribute, reporting the
+ * number of asynchronous trigger events that had to be dropped. Only
+ * asynchronous triggers (is_synchronous = false) can drop events, the
+ * attribute always reads 0 for synchronous ones.
+ *
+ * @param trig    - The iio trigger structure.
+ * @param buf     - Command buffer to be filled with the data read.
+ * @param len     - Length of the received command buffer in bytes.
+ * @param channel - Command channel info (is NULL).
+ * @param priv    - Command attribute id.
+ *
+ * @return ret    - Number of bytes written in buf or negative error code.
+*/
+int iio_hw_trig_overruns_show(void *trig, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel,
+			      intptr_t priv)
+{
+	struct iio_hw_trig *desc = trig;
+	uint32_t overruns;
+	int ret;
+
+	if (!trig)
+		return -EINVAL;
+
+	ret = iio_hw_trig_bind(desc);
+	if (ret)
+		return ret;
+
+	ret = iio_trigger_get_overruns(desc->iio_desc, desc->trig_idx,
+				       &overruns);
+	if (ret)
+		return ret;
+
+	return iio_format_value(buf, len, IIO_VAL_INT, 1, (int32_t *)&overruns);
 }
 
+/**
+ * @brief Attributes of hardware triggers, to be set as the attributes of
+ * their iio_trigger. The overruns count only applies to asynchronous
+ * triggers.
+ */
+struct iio_attribute iio_hw_trig_attrs[] = {
+	{
+		.name = "overruns",
+		.show = iio_hw_trig_overruns_show,
+	},
+	END_ATTRIBUTES_ARRAY
+};
+
 /**
  * @brief Free the resources allocated by iio_hw_trig_init().
  *
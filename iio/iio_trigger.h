@@ -70,6 +70,10 @@ struct iio_hw_trig {
 	enum no_os_irq_trig_level irq_trig_lvl;
 	/** Device trigger name */
 	char name[TRIG_MAX_NAME_SIZE + 1];
+	/** Trigger index in the IIO descriptor, valid when bound is set */
+	uint32_t trig_idx;
+	/** Set once the trigger name was resolved to trig_idx */
+	bool bound;
 };
 
 /**
@@ -136,8 +140,15 @@ int iio_trig_enable(void *trig);
 int iio_trig_disable(void *trig);
 /** API for hardware trigger handler */
 void iio_hw_trig_handler(void *trig);
+/** API to read the number of events dropped by a hardware trigger */
+int iio_hw_trig_overruns_show(void *trig, char *buf, uint32_t len,
+			      const struct iio_ch_info *channel,
+			      intptr_t priv);
 /** API to remove a hardware trigger */
 int iio_hw_trig_remove(struct iio_hw_trig *trig);
+/** Attributes of hardware triggers, reporting the events dropped by
+ *  asynchronous triggers */
+extern struct iio_attribute iio_hw_trig_attrs[];
 #endif
 
 /** API to initialize a software trigger */
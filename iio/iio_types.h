@@ -84,6 +84,7 @@ enum iio_chan_type {
 	IIO_COUNT,
 	IIO_DELTA_ANGL,
 	IIO_DELTA_VELOCITY,
+	IIO_TIMESTAMP,
 };
 
 /**
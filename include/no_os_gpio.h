@@ -53,6 +53,9 @@
 #define NO_OS_GPIO_OUT	0x01
 #define NO_OS_GPIO_IN		0x00
 
+/* Maximum number of pins in a GPIO group, one bit per pin in the masks */
+#define NO_OS_GPIO_GROUP_MAX_PINS	32
+
 /******************************************************************************/
 /*************************** Types Declarations *******************************/
 /******************************************************************************/
@@ -112,6 +115,38 @@ struct no_os_gpio_desc {
 	void		*extra;
 };
 
+/**
+ * @struct no_os_gpio_group_init_param
+ * @brief Structure holding the parameters for GPIO group initialization.
+ */
+struct no_os_gpio_group_init_param {
+	/** Pins of the group, bit i of the group masks maps to pins[i] */
+	const struct no_os_gpio_init_param *pins;
+	/** Number of pins, at most NO_OS_GPIO_GROUP_MAX_PINS */
+	uint8_t nb_pins;
+	/** Pins configured as outputs, the others are inputs */
+	uint32_t out_mask;
+	/** Initial level of the outputs */
+	uint32_t init_values;
+};
+
+/**
+ * @struct no_os_gpio_group_desc
+ * @brief Structure holding the GPIO group descriptor.
+ */
+struct no_os_gpio_group_desc {
+	/** Pin descriptors, NULL if the platform drives the group as a whole */
+	struct no_os_gpio_desc **pins;
+	/** Number of pins */
+	uint8_t nb_pins;
+	/** Pins configured as outputs */
+	uint32_t out_mask;
+	/** GPIO platform specific functions */
+	const struct no_os_gpio_platform_ops *platform_ops;
+	/** GPIO group extra parameters (platform specific) */
+	void *extra;
+};
+
 /**
  * @enum no_os_gpio_values
  * @brief Enum that holds the possible output states of a GPIO.
@@ -149,6 +184,18 @@ struct no_os_gpio_platform_ops {
 	int32_t (*gpio_ops_set_value)(struct no_os_gpio_desc *, uint8_t);
 	/** gpio get value function pointer */
 	int32_t (*gpio_ops_get_value)(struct no_os_gpio_desc *, uint8_t *);
+	/** gpio group initialization function pointer */
+	int32_t (*gpio_ops_group_get)(
+		struct no_os_gpio_group_desc **,
+		const struct no_os_gpio_group_init_param *);
+	/** gpio group remove function pointer */
+	int32_t (*gpio_ops_group_remove)(struct no_os_gpio_group_desc *);
+	/** gpio group set values function pointer */
+	int32_t (*gpio_ops_group_set_values)(struct no_os_gpio_group_desc *,
+					     uint32_t, uint32_t);
+	/** gpio group get values function pointer */
+	int32_t (*gpio_ops_group_get_values)(struct no_os_gpio_group_desc *,
+					     uint32_t, uint32_t *);
 };
 
 /******************************************************************************/
@@ -185,4 +232,19 @@ int32_t no_os_gpio_set_value(struct no_os_gpio_desc *desc,
 int32_t no_os_gpio_get_value(struct no_os_gpio_desc *desc,
 			     uint8_t *value);
 
+/* Obtain a GPIO group descriptor. */
+int32_t no_os_gpio_group_get(struct no_os_gpio_group_desc **desc,
+			     const struct no_os_gpio_group_init_param *param);
+
+/* Free the resources allocated by no_os_gpio_group_get(). */
+int32_t no_os_gpio_group_remove(struct no_os_gpio_group_desc *desc);
+
+/* Set the level of the group outputs selected by a mask. */
+int32_t no_os_gpio_group_set_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t values);
+
+/* Get the level of the group pins selected by a mask. */
+int32_t no_os_gpio_group_get_values(struct no_os_gpio_group_desc *desc,
+				    uint32_t mask, uint32_t *values);
+
 #endif // _NO_OS_GPIO_H_
@@ -0,0 +1,187 @@
+/***************************************************************************//**
+ *   @file   no_os_sample_clock.h
+ *   @brief  Header file of the PWM sampling clock service.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_SAMPLE_CLOCK_H_
+#define _NO_OS_SAMPLE_CLOCK_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_pwm.h"
+#include "no_os_timer.h"
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct no_os_sample_clock_init_param
+ * @brief Sampling clock service initialization parameters.
+ */
+struct no_os_sample_clock_init_param {
+	/** PWM driving the converter conversion start (CNV) input */
+	struct no_os_pwm_init_param *pwm_init;
+	/**
+	 * Timer counting the conversion start edges (clocked by the PWM
+	 * output). NULL if the edges are counted in software by calling
+	 * no_os_sample_clock_edge_isr() from the PWM or BUSY interrupt.
+	 */
+	struct no_os_timer_init_param *edge_timer_init;
+	/** Width of the edge counter in bits (0 for 32 bits) */
+	uint8_t edge_counter_bits;
+	/**
+	 * Free running timer used for the timestamps. NULL to timestamp
+	 * with no_os_get_time().
+	 */
+	struct no_os_timer_init_param *ts_timer_init;
+	/** Width of the timestamp counter in bits (0 for 32 bits) */
+	uint8_t ts_counter_bits;
+};
+
+/**
+ * @struct no_os_sample_tag
+ * @brief Conversion index and timestamp of a block of samples.
+ *
+ * Sample k of a block of n samples is conversion index + k and was started
+ * at about timestamp_ns - (n - 1 - k) * period_ns.
+ */
+struct no_os_sample_tag {
+	/** Index of the first conversion of the block */
+	uint64_t index;
+	/** Time of the last conversion of the block, in nanoseconds */
+	uint64_t timestamp_ns;
+	/** Nominal conversion period, in nanoseconds */
+	uint32_t period_ns;
+	/** Conversions missed between the previous block and this one */
+	uint32_t dropped;
+};
+
+/**
+ * @struct no_os_sample_clock_stats
+ * @brief Sampling clock statistics, reset on every start.
+ */
+struct no_os_sample_clock_stats {
+	/** Conversion start edges counted */
+	uint64_t conversions;
+	/** Conversions that were never read */
+	uint64_t dropped;
+	/** Effective conversion rate, in mHz */
+	uint64_t rate_mhz;
+	/** Shortest measured conversion period, in nanoseconds */
+	uint32_t min_period_ns;
+	/** Longest measured conversion period, in nanoseconds */
+	uint32_t max_period_ns;
+};
+
+/**
+ * @struct no_os_sample_clock_desc
+ * @brief Sampling clock service descriptor.
+ */
+struct no_os_sample_clock_desc {
+	/** Conversion start PWM */
+	struct no_os_pwm_desc *pwm;
+	/** Edge counter, NULL when counting in software */
+	struct no_os_timer_desc *edge_timer;
+	/** Timestamp timer, NULL when using no_os_get_time() */
+	struct no_os_timer_desc *ts_timer;
+	/** Edge counter mask */
+	uint32_t edge_mask;
+	/** Timestamp counter mask */
+	uint32_t ts_mask;
+	/** Timestamp counter frequency */
+	uint32_t ts_freq_hz;
+	/** Edges counted by no_os_sample_clock_edge_isr() */
+	volatile uint32_t sw_edges;
+	/** Last raw edge counter value */
+	uint32_t edge_raw;
+	/** Last raw timestamp counter value */
+	uint32_t ts_raw;
+	/** Extended timestamp counter */
+	uint64_t ts_ticks;
+	/** Edges counted since start */
+	uint64_t edges;
+	/** Index of the first conversion not read yet */
+	uint64_t next_index;
+	/** Edge count at the previous tag */
+	uint64_t last_edges;
+	/** Time of the previous tag */
+	uint64_t last_ns;
+	/** Time of the start */
+	uint64_t start_ns;
+	/** Statistics */
+	struct no_os_sample_clock_stats stats;
+	/** Whether the clock is running */
+	bool running;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Initialize the sampling clock service. */
+int no_os_sample_clock_init(struct no_os_sample_clock_desc **desc,
+			    const struct no_os_sample_clock_init_param *param);
+
+/* Free the resources allocated by no_os_sample_clock_init(). */
+int no_os_sample_clock_remove(struct no_os_sample_clock_desc *desc);
+
+/* Reset the counters and start the conversion clock. */
+int no_os_sample_clock_start(struct no_os_sample_clock_desc *desc);
+
+/* Stop the conversion clock. */
+int no_os_sample_clock_stop(struct no_os_sample_clock_desc *desc);
+
+/* Set the conversion rate. */
+int no_os_sample_clock_set_rate(struct no_os_sample_clock_desc *desc,
+				uint32_t rate_hz);
+
+/* Get the nominal conversion rate. */
+int no_os_sample_clock_get_rate(struct no_os_sample_clock_desc *desc,
+				uint32_t *rate_hz);
+
+/* Count a conversion start edge, called from interrupt context. */
+void no_os_sample_clock_edge_isr(void *ctx);
+
+/* Tag a block of samples that was just read from the converter. */
+int no_os_sample_clock_tag(struct no_os_sample_clock_desc *desc,
+			   uint32_t nb_samples, struct no_os_sample_tag *tag);
+
+/* Get the sampling clock statistics. */
+int no_os_sample_clock_get_stats(struct no_os_sample_clock_desc *desc,
+				 struct no_os_sample_clock_stats *stats);
+
+#endif /* _NO_OS_SAMPLE_CLOCK_H_ */
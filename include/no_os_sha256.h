@@ -0,0 +1,91 @@
+/***************************************************************************//**
+ *   @file   no_os_sha256.h
+ *   @brief  SHA-256 and HMAC-SHA-256 header.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_SHA256_H_
+#define _NO_OS_SHA256_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define NO_OS_SHA256_DIGEST_SIZE	32
+#define NO_OS_SHA256_BLOCK_SIZE		64
+
+/**
+ * @struct no_os_sha256_ctx
+ * @brief SHA-256 hashing context.
+ */
+struct no_os_sha256_ctx {
+	/** Intermediate hash value */
+	uint32_t state[8];
+	/** Number of bytes hashed so far */
+	uint64_t len;
+	/** Partial block */
+	uint8_t block[NO_OS_SHA256_BLOCK_SIZE];
+};
+
+/**
+ * @struct no_os_hmac_sha256_ctx
+ * @brief HMAC-SHA-256 context. The keyed inner and outer states are kept so
+ * that several messages can be authenticated with the same key at the cost
+ * of the message blocks only.
+ */
+struct no_os_hmac_sha256_ctx {
+	/** State after the inner padded key block */
+	struct no_os_sha256_ctx inner;
+	/** State after the outer padded key block */
+	struct no_os_sha256_ctx outer;
+	/** Running inner hash of the current message */
+	struct no_os_sha256_ctx msg;
+};
+
+void no_os_sha256_init(struct no_os_sha256_ctx *ctx);
+void no_os_sha256_update(struct no_os_sha256_ctx *ctx, const uint8_t *data,
+			 size_t len);
+void no_os_sha256_final(struct no_os_sha256_ctx *ctx,
+			uint8_t digest[NO_OS_SHA256_DIGEST_SIZE]);
+void no_os_sha256(const uint8_t *data, size_t len,
+		  uint8_t digest[NO_OS_SHA256_DIGEST_SIZE]);
+
+void no_os_hmac_sha256_setkey(struct no_os_hmac_sha256_ctx *ctx,
+			      const uint8_t *key, size_t key_len);
+void no_os_hmac_sha256_start(struct no_os_hmac_sha256_ctx *ctx);
+void no_os_hmac_sha256_update(struct no_os_hmac_sha256_ctx *ctx,
+			      const uint8_t *data, size_t len);
+void no_os_hmac_sha256_final(struct no_os_hmac_sha256_ctx *ctx,
+			     uint8_t mac[NO_OS_SHA256_DIGEST_SIZE]);
+
+#endif // _NO_OS_SHA256_H_
@@ -49,6 +49,8 @@
  */
 struct no_os_tdm_platform_ops;
 
+struct no_os_circular_buffer;
+
 enum no_os_tdm_mode {
 	NO_OS_TDM_MASTER_TX,
 	NO_OS_TDM_MASTER_RX,
@@ -91,6 +93,42 @@ struct no_os_tdm_init_param {
 	void *extra;
 };
 
+/**
+ * @struct no_os_tdm_stream_param
+ * @brief Structure holding the parameters of a continuous reception
+ */
+struct no_os_tdm_stream_param {
+	/** Circular DMA buffer, split in two blocks (ping-pong) */
+	void *buf;
+	/** Number of samples in buf, must be even */
+	uint16_t nb_samples;
+	/** Size of a sample in bytes */
+	uint8_t sample_size;
+	/** Optional circular buffer (e.g. of an IIO buffer) fed with blocks */
+	struct no_os_circular_buffer *sink;
+};
+
+/**
+ * @struct no_os_tdm_stream
+ * @brief Continuous reception state, updated from the DMA callbacks
+ */
+struct no_os_tdm_stream {
+	/** Circular DMA buffer */
+	uint8_t *buf;
+	/** Size of one block (half of buf) in bytes */
+	uint32_t block_size;
+	/** Circular buffer fed with each completed block */
+	struct no_os_circular_buffer *sink;
+	/** Number of completed blocks */
+	volatile uint32_t produced;
+	/** Number of blocks returned by no_os_tdm_stream_get_block() */
+	uint32_t consumed;
+	/** Number of blocks lost (not consumed or not fitting in the sink) */
+	volatile uint32_t overruns;
+	/** Set while the continuous reception is running */
+	volatile bool active;
+};
+
 /**
  * @struct no_os_tdm_desc
  * @brief Structure holding TDM descriptor.
@@ -98,6 +136,8 @@ struct no_os_tdm_init_param {
 struct no_os_tdm_desc {
 	/* IRQ ID */
 	uint32_t irq_id;
+	/** Continuous reception state */
+	struct no_os_tdm_stream stream;
 	/** Platform operation function pointers */
 	const struct no_os_tdm_platform_ops *platform_ops;
 	/** Software FIFO. */
@@ -125,6 +165,9 @@ struct no_os_tdm_platform_ops {
 	int32_t (*tdm_ops_resume)(struct no_os_tdm_desc *);
 	/** Stop TDM DMA transfer */
 	int32_t (*tdm_ops_stop)(struct no_os_tdm_desc *);
+	/** Start a circular DMA reception, reporting each half buffer */
+	int32_t (*tdm_ops_stream_start)(struct no_os_tdm_desc *, void *,
+					uint16_t);
 	/** TDM remove operation function pointer */
 	int32_t (*tdm_ops_remove)(struct no_os_tdm_desc *);
 };
@@ -155,4 +198,22 @@ int32_t  no_os_tdm_resume(struct no_os_tdm_desc *desc);
 /* Stop TDM DMA Transfer */
 int32_t  no_os_tdm_stop(struct no_os_tdm_desc *desc);
 
+/* Start a continuous (circular DMA) reception. */
+int32_t no_os_tdm_stream_start(struct no_os_tdm_desc *desc,
+			       const struct no_os_tdm_stream_param *param);
+
+/* Stop a continuous reception. */
+int32_t no_os_tdm_stream_stop(struct no_os_tdm_desc *desc);
+
+/* Get the oldest completed block of a continuous reception. */
+int32_t no_os_tdm_stream_get_block(struct no_os_tdm_desc *desc, void **block);
+
+/* Get the number of blocks lost during a continuous reception. */
+int32_t no_os_tdm_stream_get_overruns(struct no_os_tdm_desc *desc,
+				      uint32_t *overruns);
+
+/* Report a completed block, called by the platform drivers from the DMA
+ * half/full transfer callbacks. */
+void no_os_tdm_stream_block_done(struct no_os_tdm_desc *desc, bool second);
+
 #endif // _NO_OS_TDM_H_
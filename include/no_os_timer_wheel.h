@@ -0,0 +1,204 @@
+/***************************************************************************//**
+ *   @file   no_os_timer_wheel.h
+ *   @brief  Software timers multiplexed on one timer.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#ifndef _NO_OS_TIMER_WHEEL_H_
+#define _NO_OS_TIMER_WHEEL_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_timer.h"
+#include "no_os_irq.h"
+#include "no_os_util.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+#define NO_OS_TIMER_WHEEL_BITS		6
+#define NO_OS_TIMER_WHEEL_SLOTS		(1 << NO_OS_TIMER_WHEEL_BITS)
+#define NO_OS_TIMER_WHEEL_LEVELS	4
+
+/* Run the callback from the tick context instead of no_os_timer_wheel_step() */
+#define NO_OS_SW_TIMER_ISR		NO_OS_BIT(0)
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct no_os_sw_timer
+ * @brief Software timer. The callback, ctx and flags fields are set by the
+ * user, the others are managed by the timer wheel.
+ */
+struct no_os_sw_timer {
+	/** Function called when the timer expires */
+	void (*callback)(void *ctx);
+	/** Parameter passed to the callback */
+	void *ctx;
+	/** NO_OS_SW_TIMER_* flags */
+	uint32_t flags;
+	/** Tick at which the timer expires */
+	uint64_t expires;
+	/** Deadline of the pending callback run */
+	uint64_t due;
+	/** Period in ticks, 0 for a one-shot timer */
+	uint32_t period;
+	/** Next timer in the same wheel slot */
+	struct no_os_sw_timer *next;
+	/** Link pointing to this timer in the wheel slot */
+	struct no_os_sw_timer **pprev;
+	/** Next timer waiting for no_os_timer_wheel_step() */
+	struct no_os_sw_timer *pending_next;
+	/** Whether the timer waits for no_os_timer_wheel_step() */
+	bool pending;
+};
+
+/**
+ * @struct no_os_timer_wheel_init_param
+ * @brief Timer wheel initialization parameters.
+ */
+struct no_os_timer_wheel_init_param {
+	/**
+	 * Hardware timer generating the ticks, configured for a tick_us
+	 * period. NULL to derive the ticks from no_os_get_time() in
+	 * no_os_timer_wheel_step().
+	 */
+	struct no_os_timer_init_param *timer_init;
+	/**
+	 * Interrupt controller of the hardware timer. When set, the tick
+	 * handler is registered on it and the timer interrupt is masked while
+	 * the wheel is modified from the main loop. Leave it NULL when calling
+	 * no_os_timer_wheel_tick() from the application's own handler.
+	 */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** Interrupt id of the hardware timer */
+	uint32_t irq_id;
+	/** Platform specific handle of the timer interrupt, if needed */
+	void *irq_handle;
+	/** Tick period, in microseconds */
+	uint32_t tick_us;
+};
+
+/**
+ * @struct no_os_timer_wheel_stats
+ * @brief Timer wheel statistics.
+ */
+struct no_os_timer_wheel_stats {
+	/** Callbacks run */
+	uint32_t fired;
+	/** Periods skipped because a callback ran too late */
+	uint32_t overruns;
+	/** Ticks processed after their time by no_os_timer_wheel_step() */
+	uint32_t late_ticks;
+	/** Largest delay between a deadline and its callback, in us */
+	uint32_t max_latency_us;
+	/** Sum of the callback delays, in us */
+	uint64_t total_latency_us;
+};
+
+/**
+ * @struct no_os_timer_wheel
+ * @brief Timer wheel descriptor.
+ */
+struct no_os_timer_wheel {
+	/** Hardware timer, NULL when ticking from no_os_get_time() */
+	struct no_os_timer_desc *timer;
+	/** Interrupt controller of the hardware timer */
+	struct no_os_irq_ctrl_desc *irq_ctrl;
+	/** Interrupt id of the hardware timer */
+	uint32_t irq_id;
+	/** Tick callback registered on the interrupt controller */
+	struct no_os_callback_desc irq_cb;
+	/** Tick period, in microseconds */
+	uint32_t tick_us;
+	/** Time of tick 0, when ticking from no_os_get_time() */
+	uint64_t base_us;
+	/** Current tick */
+	volatile uint64_t now;
+	/** Whether the tick handler is running */
+	bool in_tick;
+	/** Timers in the wheel */
+	uint32_t nr_armed;
+	/** Slots of every level */
+	struct no_os_sw_timer *slots[NO_OS_TIMER_WHEEL_LEVELS]
+	[NO_OS_TIMER_WHEEL_SLOTS];
+	/** First expired timer waiting for no_os_timer_wheel_step() */
+	struct no_os_sw_timer *pending_head;
+	/** Last expired timer waiting for no_os_timer_wheel_step() */
+	struct no_os_sw_timer *pending_tail;
+	/** Statistics */
+	struct no_os_timer_wheel_stats stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+/* Initialize a timer wheel. */
+int no_os_timer_wheel_init(struct no_os_timer_wheel **wheel,
+			   const struct no_os_timer_wheel_init_param *param);
+
+/* Free the resources allocated by no_os_timer_wheel_init(). */
+int no_os_timer_wheel_remove(struct no_os_timer_wheel *wheel);
+
+/* Advance the wheel by one tick, called from the timer interrupt. */
+void no_os_timer_wheel_tick(void *wheel);
+
+/* Catch up with the elapsed time and run the expired deferred callbacks. */
+int no_os_timer_wheel_step(struct no_os_timer_wheel *wheel);
+
+/* Get the time until the earliest deadline. */
+int no_os_timer_wheel_next_deadline(struct no_os_timer_wheel *wheel,
+				    uint32_t *us);
+
+/* Get the timer wheel statistics. */
+int no_os_timer_wheel_get_stats(struct no_os_timer_wheel *wheel,
+				struct no_os_timer_wheel_stats *stats);
+
+/* Arm a one-shot (period_us = 0) or periodic software timer. */
+int no_os_sw_timer_start(struct no_os_timer_wheel *wheel,
+			 struct no_os_sw_timer *timer, uint32_t delay_us,
+			 uint32_t period_us);
+
+/* Disarm a software timer and drop its pending callback run. */
+int no_os_sw_timer_cancel(struct no_os_timer_wheel *wheel,
+			  struct no_os_sw_timer *timer);
+
+/* Check whether a software timer is armed or has a pending callback run. */
+bool no_os_sw_timer_is_active(struct no_os_sw_timer *timer);
+
+#endif /* _NO_OS_TIMER_WHEEL_H_ */
@@ -0,0 +1,163 @@
+/***************************************************************************//**
+ *   @file   no_os_trng_pool.h
+ *   @brief  TRNG entropy pool and HMAC-DRBG header.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef _NO_OS_TRNG_POOL_H_
+#define _NO_OS_TRNG_POOL_H_
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "no_os_trng.h"
+#include "no_os_sha256.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+/* Bytes read from the TRNG by each no_os_trng_pool_step() call */
+#define NO_OS_TRNG_POOL_CHUNK			32
+/* Default number of generate requests between two reseeds */
+#define NO_OS_TRNG_POOL_RESEED_INTERVAL		1024
+/* Largest request served by a single DRBG generate call */
+#define NO_OS_TRNG_POOL_MAX_REQUEST		65536
+/* Window of the adaptive proportion health test, in samples */
+#define NO_OS_TRNG_POOL_APT_WINDOW		512
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct no_os_trng_pool_init_param
+ * @brief Entropy pool parameters, passed as the extra field of the
+ * no_os_trng_init_param that uses no_os_trng_pool_ops.
+ */
+struct no_os_trng_pool_init_param {
+	/** Hardware TRNG the entropy is gathered from */
+	const struct no_os_trng_init_param *trng_init;
+	/** Claimed min-entropy of a TRNG output byte, in bits (1 to 8) */
+	uint8_t min_entropy;
+	/** Generate requests between two reseeds, 0 for the default */
+	uint32_t reseed_interval;
+	/** Personalization string of the DRBG, optional */
+	const uint8_t *personalization;
+	/** Length of the personalization string */
+	uint32_t personalization_len;
+};
+
+/**
+ * @struct no_os_trng_pool_stats
+ * @brief Entropy pool and DRBG counters.
+ */
+struct no_os_trng_pool_stats {
+	/** Bytes read from the hardware TRNG */
+	uint64_t hw_bytes;
+	/** Random bytes served by the DRBG */
+	uint64_t out_bytes;
+	/** Fill requests served */
+	uint32_t requests;
+	/** DRBG reseeds */
+	uint32_t reseeds;
+	/** Reseeds that had to wait for the hardware TRNG */
+	uint32_t stalls;
+	/** Time spent waiting for the hardware TRNG in fill requests */
+	uint64_t stall_us;
+	/** Repetition count health test failures */
+	uint32_t rct_failures;
+	/** Adaptive proportion health test failures */
+	uint32_t apt_failures;
+};
+
+/**
+ * @struct no_os_trng_pool
+ * @brief Entropy pool and HMAC-DRBG state, the extra field of the TRNG
+ * descriptor.
+ */
+struct no_os_trng_pool {
+	/** Hardware TRNG */
+	struct no_os_trng_desc *trng;
+	/** Claimed min-entropy per TRNG byte, in bits */
+	uint8_t min_entropy;
+	/** Repetition count test cutoff */
+	uint32_t rct_cutoff;
+	/** Adaptive proportion test cutoff */
+	uint32_t apt_cutoff;
+	/** Value of the current repetition */
+	uint8_t rct_value;
+	/** Length of the current repetition */
+	uint32_t rct_count;
+	/** Reference value of the adaptive proportion window */
+	uint8_t apt_value;
+	/** Occurrences of the reference value in the window */
+	uint32_t apt_count;
+	/** Samples seen in the window */
+	uint32_t apt_index;
+	/** Conditioning hash of the gathered entropy */
+	struct no_os_sha256_ctx pool;
+	/** Entropy gathered in the pool, in bits */
+	uint32_t pool_bits;
+	/** DRBG key, kept expanded */
+	struct no_os_hmac_sha256_ctx key;
+	/** DRBG value */
+	uint8_t v[NO_OS_SHA256_DIGEST_SIZE];
+	/** Generate requests since the last reseed */
+	uint32_t reseed_counter;
+	/** Generate requests between two reseeds */
+	uint32_t reseed_interval;
+	/** Counters */
+	struct no_os_trng_pool_stats stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Gather one chunk of entropy from the hardware TRNG into the pool */
+int no_os_trng_pool_step(struct no_os_trng_desc *desc);
+
+/* Get the entropy pool counters */
+int no_os_trng_pool_get_stats(struct no_os_trng_desc *desc,
+			      struct no_os_trng_pool_stats *stats);
+
+/* TRNG platform ops serving DRBG output seeded from the entropy pool */
+extern const struct no_os_trng_platform_ops no_os_trng_pool_ops;
+
+#endif // _NO_OS_TRNG_POOL_H_
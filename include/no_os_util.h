@@ -121,6 +121,22 @@
 #define no_os_bcd2bin(x)	(((x) & 0x0f) + ((x) >> 4) * 10)
 #define no_os_bin2bcd(x)	((((x) / 10) << 4) + (x) % 10)
 
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+/**
+ * @struct no_os_bitfield
+ * @brief Bitfield of a big endian (MSB first) data frame.
+ */
+struct no_os_bitfield {
+	/** Position of the field MSB, in bits from the start of the frame */
+	uint16_t	offset;
+	/** Field width in bits, 1 to 32 */
+	uint8_t		width;
+	/** Sign extend the field when unpacking it */
+	bool		is_signed;
+};
+
 /******************************************************************************/
 /************************ Functions Declarations ******************************/
 /******************************************************************************/
@@ -200,6 +216,14 @@ uint64_t no_os_mul_u32_u32(uint32_t a, uint32_t b);
 uint64_t no_os_mul_u64_u32_shr(uint64_t a, uint32_t mul, unsigned int shift);
 
 bool no_os_is_big_endian(void);
+/* Extract a bitfield from a big endian bit stream. */
+uint32_t no_os_get_bitfield_be(const uint8_t *buf, uint32_t offset,
+			       uint8_t width);
+/* Unpack the selected bitfields of a frame into a packed array. */
+uint32_t no_os_unpack_bitfields(const uint8_t *frame,
+				const struct no_os_bitfield *fields,
+				uint32_t nb_fields, uint32_t mask,
+				uint8_t storage, void *out);
 void no_os_memswap64(void *buf, uint32_t bytes, uint32_t step);
 
 #endif // _NO_OS_UTIL_H_
@@ -71,7 +71,10 @@ static int32_t linux_socket_open(void *desc, uint32_t *sock_id,
 	int32_t flags;
 	int err;
 
-	err = socket(AF_INET,SOCK_STREAM,IPPROTO_TCP);
+	if (prot == PROTOCOL_UDP)
+		err = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	else
+		err = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
 	if(err < 0)
 		return err;
 
@@ -183,10 +186,10 @@ static int32_t linux_socket_sendto(void *desc, uint32_t sock_id,
 
 	ret = sendto(sock_id, data, size, 0, (struct sockaddr*) &saddr_to, len);
 
-	if(ret != 0)
-		return ret;
+	if(ret < 0)
+		return -errno;
 
-	return 0;
+	return ret;
 }
 
 /** @brief See \ref network_interface.socket_recvfrom */
@@ -197,21 +200,19 @@ static int32_t linux_socket_recvfrom(void *desc, uint32_t sock_id,
 	int32_t ret;
 	struct sockaddr_in saddr_from = {0};
 	socklen_t len;
-	struct hostent* hptr;
 
-	saddr_from.sin_family = AF_INET;
-	saddr_from.sin_port = htons(from->port);
-	hptr = gethostbyname(from->addr);
-	saddr_from.sin_addr.s_addr = ((struct in_addr*) hptr->h_addr_list[0])->s_addr;
 	len = sizeof(saddr_from);
 
 	ret = recvfrom(sock_id, data, size, MSG_DONTWAIT,(struct sockaddr*) &saddr_from,
 		       &len);
 
-	if(ret != 0)
-		return ret;
+	if(ret < 0)
+		return -errno;
 
-	return 0;
+	if (from)
+		from->port = ntohs(saddr_from.sin_port);
+
+	return ret;
 }
 
 /** @brief See \ref network_interface.socket_bind */
@@ -265,6 +266,26 @@ static int32_t linux_socket_accept(void *desc, uint32_t sock_id,
 	return 0;
 }
 
+/** @brief See \ref network_interface.socket_join_group */
+static int32_t linux_socket_join_group(void *desc, uint32_t sock_id,
+				       const char *group)
+{
+	struct ip_mreq mreq = {0};
+	int32_t ret;
+
+	if (!inet_aton(group, &mreq.imr_multiaddr))
+		return -EINVAL;
+
+	mreq.imr_interface.s_addr = htonl(INADDR_ANY);
+
+	ret = setsockopt(sock_id, IPPROTO_IP, IP_ADD_MEMBERSHIP, &mreq,
+			 sizeof(mreq));
+	if(ret < 0)
+		return -errno;
+
+	return 0;
+}
+
 struct network_interface linux_net = {
 	.socket_open = (int32_t (*)(void *, uint32_t *, enum socket_protocol,
 				    uint32_t)) linux_socket_open,
@@ -277,7 +298,8 @@ struct network_interface linux_net = {
 	.socket_recvfrom = (int32_t (*)(void *, uint32_t, void *, uint32_t, struct socket_address* from))linux_socket_recvfrom,
 	.socket_bind = (int32_t (*)(void *, uint32_t, uint16_t))linux_socket_bind,
 	.socket_listen = (int32_t (*)(void *, uint32_t, uint32_t))linux_socket_listen,
-	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept
+	.socket_accept= (int32_t (*)(void *, uint32_t, uint32_t*))linux_socket_accept,
+	.socket_join_group = linux_socket_join_group,
 };
 
 #endif
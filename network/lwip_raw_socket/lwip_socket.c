@@ -50,6 +50,7 @@
 #include "lwip/tcpbase.h"
 #include "lwip/tcpip.h"
 #include "lwip/tcp.h"
+#include "lwip/udp.h"
 #include "lwip/netif.h"
 #include "lwip/api.h"
 #include "lwip/etharp.h"
@@ -77,6 +78,8 @@ static bool mdns_is_conflict;
 static uint32_t mdns_conflict_id;
 
 static void lwip_config_if(struct lwip_network_desc *desc);
+static err_t lwip_accept_callback(void *arg, struct tcp_pcb *new_pcb,
+				  err_t err);
 
 /**
  * @brief Get a socket structure based on id.
@@ -126,6 +129,100 @@ static void _release_socket(struct lwip_network_desc *desc, uint32_t id)
 	sock->state = SOCKET_CLOSED;
 }
 
+/**
+ * @brief Call the readiness callback of a socket.
+ * @param sock - the socket on which the events occurred.
+ * @param events - mask of NO_OS_LWIP_EV_* events.
+ */
+static void _notify_socket(struct lwip_socket_desc *sock, uint32_t events)
+{
+	if (sock->event_cb)
+		sock->event_cb(sock->event_ctx, sock->id, events);
+}
+
+/**
+ * @brief Reopen the receive window after data was consumed, withholding the
+ * part of TCP_WND that exceeds the socket's receive window limit.
+ * @param sock - the connected socket.
+ * @param len - number of bytes consumed.
+ */
+static void _socket_recved(struct lwip_socket_desc *sock, uint32_t len)
+{
+	uint32_t target = 0;
+	uint32_t take;
+
+	if (sock->rx_window && sock->rx_window < TCP_WND)
+		target = TCP_WND - sock->rx_window;
+
+	if (sock->wnd_held < target) {
+		take = no_os_min(target - sock->wnd_held, len);
+		sock->wnd_held += take;
+		len -= take;
+	} else if (sock->wnd_held > target) {
+		len += sock->wnd_held - target;
+		sock->wnd_held = target;
+	}
+
+	if (len)
+		tcp_recved(sock->pcb, len);
+}
+
+/**
+ * @brief Apply the receive window limit of a connected socket. The advertised
+ * window is never shrunk, it is only reopened more slowly until the limit is
+ * reached.
+ * @param sock - the connected socket.
+ */
+static void _apply_rx_window(struct lwip_socket_desc *sock)
+{
+	uint32_t target = 0;
+	uint32_t take;
+
+	if (sock->rx_window && sock->rx_window < TCP_WND)
+		target = TCP_WND - sock->rx_window;
+
+	if (sock->wnd_held < target) {
+		take = no_os_min(target - sock->wnd_held, sock->pcb->rcv_wnd);
+		sock->pcb->rcv_wnd -= take;
+		sock->wnd_held += take;
+	} else {
+		_socket_recved(sock, 0);
+	}
+}
+
+/**
+ * @brief Get the events pending on a socket.
+ * @param sock - the socket.
+ * @return mask of NO_OS_LWIP_EV_* events.
+ */
+static uint32_t _socket_events(struct lwip_socket_desc *sock)
+{
+	struct lwip_network_desc *desc = sock->desc;
+	uint32_t events;
+	uint32_t i;
+
+	switch (sock->state) {
+	case SOCKET_CLOSED:
+		return NO_OS_LWIP_EV_CLOSED;
+	case SOCKET_LISTENING:
+	case SOCKET_ACCEPTING:
+		for (i = 0; i < NO_OS_MAX_SOCKETS; i++)
+			if (desc->sockets[i].state == SOCKET_WAITING_ACCEPT &&
+			    desc->sockets[i].server == sock)
+				return NO_OS_LWIP_EV_READ;
+
+		return 0;
+	case SOCKET_CONNECTED:
+		events = sock->p ? NO_OS_LWIP_EV_READ : 0;
+		if (tcp_sndbuf(sock->pcb))
+			events |= NO_OS_LWIP_EV_WRITE;
+
+		return events;
+	default:
+		return 0;
+	}
+}
+
 /**
  * @brief Low level pbuf output function. Lwip will call this to send data
  * on the wire.
@@ -415,7 +512,16 @@ static void lwip_err_callback(void *arg, err_t err)
 {
 	struct lwip_socket_desc *socket = arg;
 
+	/* The pcb was already freed by lwip, only drop the references. */
+	if (socket->p)
+		pbuf_free(socket->p);
+
+	socket->p = NULL;
+	socket->p_idx = 0;
+	socket->pcb = NULL;
 	socket->state = SOCKET_CLOSED;
+
+	_notify_socket(socket, NO_OS_LWIP_EV_CLOSED);
 }
 
 /**
@@ -433,6 +539,14 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 	if (!sock)
 		return -EINVAL;
 
+	if (sock->upcb) {
+		udp_remove(sock->upcb);
+		sock->upcb = NULL;
+		_release_socket(desc, sock_id);
+
+		return 0;
+	}
+
 	if (!sock->pcb)
 		return 0;
 
@@ -443,6 +557,7 @@ static int32_t lwip_socket_close(void *net, uint32_t sock_id)
 
 	tcp_close(sock->pcb);
 	tcp_recv(sock->pcb, NULL);
+	tcp_sent(sock->pcb, NULL);
 	tcp_err(sock->pcb, NULL);
 
 	sock->p_idx = 0;
@@ -472,6 +587,7 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 		sock->state = SOCKET_CLOSED;
 
 		lwip_socket_close(sock->desc, sock->id);
+		_notify_socket(sock, NO_OS_LWIP_EV_CLOSED);
 
 		return ERR_OK;
 	}
@@ -488,6 +604,27 @@ static err_t lwip_recv_callback(void *arg, struct tcp_pcb *tpcb, struct pbuf *p,
 		pbuf_cat(sock->p, p);
 	}
 
+	/* Accepted connections are reported on their server socket first. */
+	if (sock->state == SOCKET_CONNECTED)
+		_notify_socket(sock, NO_OS_LWIP_EV_READ);
+
+	return ERR_OK;
+}
+
+/**
+ * @brief Called when sent data was acknowledged by the remote.
+ * @param arg - the socket the data was sent on.
+ * @param tpcb - lwip TCP descriptor of the socket.
+ * @param len - number of acknowledged bytes.
+ * @return ERR_OK
+ */
+static err_t lwip_sent_callback(void *arg, struct tcp_pcb *tpcb, u16_t len)
+{
+	struct lwip_socket_desc *sock = arg;
+
+	if (sock->state == SOCKET_CONNECTED)
+		_notify_socket(sock, NO_OS_LWIP_EV_WRITE);
+
 	return ERR_OK;
 }
 
@@ -500,14 +637,48 @@ static void lwip_config_socket(struct lwip_socket_desc *desc)
 {
 	tcp_arg(desc->pcb, desc);
 	tcp_recv(desc->pcb, lwip_recv_callback);
+	tcp_sent(desc->pcb, lwip_sent_callback);
 	tcp_err(desc->pcb, lwip_err_callback);
 }
 
 /**
- * @brief Create a TCP socket.
+ * @brief Create a UDP socket, which can only send datagrams.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket that was created.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+static int32_t lwip_udp_socket_open(struct lwip_network_desc *desc,
+				    uint32_t *sock_id)
+{
+	struct lwip_socket_desc *sock;
+	uint32_t socket_id;
+	int32_t ret;
+
+	ret = _get_closed_socket(desc, &socket_id);
+	if (ret)
+		return ret;
+
+	sock = &desc->sockets[socket_id];
+	sock->upcb = udp_new_ip_type(IPADDR_TYPE_ANY);
+	if (!sock->upcb)
+		return -ENOMEM;
+
+	sock->pcb = NULL;
+	sock->p = NULL;
+	sock->server = NULL;
+	sock->event_cb = NULL;
+	sock->event_ctx = NULL;
+	sock->state = SOCKET_DATAGRAM;
+	*sock_id = socket_id;
+
+	return 0;
+}
+
+/**
+ * @brief Create a TCP or UDP socket.
  * @param net - lwip sockets layer specific descriptor.
  * @param sock_id - index of the socket that was created.
- * @param proto - Layer 4 protocol (only TCP is supported).
+ * @param proto - Layer 4 protocol.
  * @param buff_size - unused.
  * @return 0 in the case of success, negative error code otherwise
  */
@@ -521,6 +692,9 @@ static int32_t lwip_socket_open(void *net, uint32_t *sock_id,
 	int32_t ret;
 
 	NO_OS_UNUSED_PARAM(buff_size);
+	if (proto == PROTOCOL_UDP)
+		return lwip_udp_socket_open(desc, sock_id);
+
 	if (proto != PROTOCOL_TCP)
 		return -EPROTONOSUPPORT;
 
@@ -540,6 +714,11 @@ static int32_t lwip_socket_open(void *net, uint32_t *sock_id,
 	desc->sockets[socket_id].desc = desc;
 	desc->sockets[socket_id].id = socket_id;
 	desc->sockets[socket_id].p = NULL;
+	desc->sockets[socket_id].server = NULL;
+	desc->sockets[socket_id].event_cb = NULL;
+	desc->sockets[socket_id].event_ctx = NULL;
+	desc->sockets[socket_id].rx_window = 0;
+	desc->sockets[socket_id].wnd_held = 0;
 
 	lwip_config_socket(&desc->sockets[socket_id]);
 
@@ -640,7 +819,7 @@ static int32_t lwip_socket_recv(void *net, uint32_t sock_id, void *data,
 			if (old_p->ref > 0)
 				pbuf_free(old_p);
 
-			tcp_recved(socket->pcb, socket->p_idx);
+			_socket_recved(socket, socket->p_idx);
 			socket->p_idx = 0;
 		}
 	}
@@ -666,7 +845,10 @@ static int32_t lwip_socket_bind(void *net, uint32_t sock_id, uint16_t port)
 	if (!socket)
 		return -EINVAL;
 
-	err = tcp_bind(socket->pcb, IP_ANY_TYPE, port);
+	if (socket->upcb)
+		err = udp_bind(socket->upcb, IP_ANY_TYPE, port);
+	else
+		err = tcp_bind(socket->pcb, IP_ANY_TYPE, port);
 	if (err != ERR_OK) {
 		printf("Unable to bind port %"PRIu16"\n", port);
 		return -EINVAL;
@@ -701,6 +883,14 @@ static int32_t lwip_socket_listen(void *net, uint32_t sock_id,
 	socket->pcb = pcb;
 	socket->state = SOCKET_LISTENING;
 
+	/*
+	 * Start accepting right away, so that pending connections are
+	 * reported through the readiness callback and no_os_lwip_poll().
+	 */
+	tcp_arg(socket->pcb, socket);
+	tcp_accept(socket->pcb, lwip_accept_callback);
+	socket->state = SOCKET_ACCEPTING;
+
 	return 0;
 }
 
@@ -730,11 +920,21 @@ static err_t lwip_accept_callback(void *arg, struct tcp_pcb *new_pcb, err_t err)
 
 	socket = _get_sock(desc, id);
 	socket->pcb = new_pcb;
+	socket->p = NULL;
+	socket->p_idx = 0;
+	socket->server = serv_sock;
+	socket->event_cb = serv_sock->event_cb;
+	socket->event_ctx = serv_sock->event_ctx;
+	socket->rx_window = serv_sock->rx_window;
+	socket->wnd_held = 0;
 	socket->state = SOCKET_WAITING_ACCEPT;
 
 	tcp_setprio(socket->pcb, 0);
 	lwip_config_socket(socket);
 	tcp_nagle_disable(socket->pcb);
+	_apply_rx_window(socket);
+
+	_notify_socket(serv_sock, NO_OS_LWIP_EV_READ);
 
 	return 0;
 }
@@ -766,7 +966,8 @@ static int32_t lwip_socket_accept(void *net, uint32_t sock_id,
 
 	for (i = 0; i < NO_OS_MAX_SOCKETS; ++i) {
 		cli_sock = &desc->sockets[i];
-		if (cli_sock->state == SOCKET_WAITING_ACCEPT) {
+		if (cli_sock->state == SOCKET_WAITING_ACCEPT &&
+		    cli_sock->server == serv_sock) {
 			/* New client connection for server */
 			*client_socket_id = i;
 			cli_sock->state = SOCKET_CONNECTED;
@@ -778,18 +979,50 @@ static int32_t lwip_socket_accept(void *net, uint32_t sock_id,
 }
 
 /**
- * @brief Not implemented.
- * @param net - Not used.
- * @param sock_id - Not used.
- * @param data - Not used.
- * @param size - Not used.
- * @param to - Not used.
- * @return -ENOSYS
+ * @brief Send a UDP datagram.
+ * @param net - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the UDP socket.
+ * @param data - pointer to the data array.
+ * @param size - size of data array.
+ * @param to - destination, a unicast, broadcast or multicast IP address.
+ * @return number of sent bytes in the case of success, negative error code
+ * otherwise
  */
 static int32_t lwip_socket_sendto(void *net, uint32_t sock_id, const void *data,
 				  uint32_t size, const struct socket_address *to)
 {
-	return -ENOSYS;
+	struct lwip_network_desc *desc = net;
+	struct lwip_socket_desc *sock;
+	ip_addr_t addr;
+	struct pbuf *p;
+	err_t err;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock || !to || !to->addr)
+		return -EINVAL;
+
+	if (sock->state != SOCKET_DATAGRAM || !sock->upcb)
+		return -EPROTOTYPE;
+
+	if (size > 0xFFFF)
+		return -EMSGSIZE;
+
+	if (!ipaddr_aton(to->addr, &addr))
+		return -EINVAL;
+
+	p = pbuf_alloc(PBUF_TRANSPORT, size, PBUF_RAM);
+	if (!p)
+		return -ENOMEM;
+
+	err = pbuf_take(p, data, size);
+	if (err == ERR_OK)
+		err = udp_sendto(sock->upcb, p, &addr, to->port);
+	pbuf_free(p);
+
+	if (err != ERR_OK)
+		return err == ERR_MEM ? -ENOMEM : -EIO;
+
+	return size;
 }
 
 /**
@@ -831,6 +1064,122 @@ static int32_t lwip_socket_disconnect(void *net, uint32_t sock_id)
 	return -ENOSYS;
 }
 
+/**
+ * @brief Set the readiness callback of a socket. The callback is called from
+ * the lwip context (no_os_lwip_step() or the MAC receive path) with a mask of
+ * NO_OS_LWIP_EV_* events, so it should only record the event or do a short,
+ * non-blocking socket operation. Connections accepted on a server socket
+ * inherit its callback.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket.
+ * @param event_cb - the callback, NULL to disable it.
+ * @param event_ctx - parameter passed to the callback.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+int32_t no_os_lwip_socket_set_callback(struct lwip_network_desc *desc,
+				       uint32_t sock_id,
+				       void (*event_cb)(void *, uint32_t,
+						       uint32_t),
+				       void *event_ctx)
+{
+	struct lwip_socket_desc *sock;
+
+	if (!desc)
+		return -EINVAL;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	sock->event_cb = event_cb;
+	sock->event_ctx = event_ctx;
+
+	return 0;
+}
+
+/**
+ * @brief Limit the amount of unread data the remote may send to a socket.
+ * Only values below TCP_WND have an effect, since lwip sizes the receive
+ * window at build time. Connections accepted on a server socket inherit its
+ * limit.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param sock_id - index of the socket.
+ * @param window - receive window in bytes, 0 for TCP_WND.
+ * @return 0 in the case of success, negative error code otherwise
+ */
+int32_t no_os_lwip_socket_set_rx_window(struct lwip_network_desc *desc,
+					uint32_t sock_id, uint32_t window)
+{
+	struct lwip_socket_desc *sock;
+
+	if (!desc)
+		return -EINVAL;
+
+	sock = _get_sock(desc, sock_id);
+	if (!sock)
+		return -EINVAL;
+
+	if (window && window < TCP_MSS)
+		return -EINVAL;
+
+	sock->rx_window = window;
+	if (sock->pcb && (sock->state == SOCKET_CONNECTED ||
+			  sock->state == SOCKET_WAITING_ACCEPT))
+		_apply_rx_window(sock);
+
+	return 0;
+}
+
+/**
+ * @brief Wait for events on several sockets. The lwip stack is stepped while
+ * waiting, so this can replace the no_os_lwip_step() loop of the application.
+ * A read event on a server socket means that accept() will not return
+ * -EAGAIN.
+ * @param desc - lwip sockets layer specific descriptor.
+ * @param fds - sockets and requested events.
+ * @param nfds - number of entries in fds.
+ * @param timeout_ms - time to wait in ms, negative to wait forever.
+ * @return the number of sockets with events, 0 on timeout, negative error
+ * code otherwise
+ */
+int32_t no_os_lwip_poll(struct lwip_network_desc *desc,
+			struct no_os_lwip_pollfd *fds, uint32_t nfds,
+			int32_t timeout_ms)
+{
+	struct lwip_socket_desc *sock;
+	u32_t start = sys_now();
+	int32_t ready;
+	uint32_t i;
+	int32_t ret;
+
+	if (!desc || (!fds && nfds))
+		return -EINVAL;
+
+	while (true) {
+		ready = 0;
+		for (i = 0; i < nfds; i++) {
+			sock = _get_sock(desc, fds[i].sock_id);
+			if (!sock)
+				return -EINVAL;
+
+			fds[i].revents = _socket_events(sock) &
+					 (fds[i].events | NO_OS_LWIP_EV_CLOSED);
+			if (fds[i].revents)
+				ready++;
+		}
+
+		if (ready || !timeout_ms)
+			return ready;
+
+		if (timeout_ms > 0 && sys_now() - start >= (u32_t)timeout_ms)
+			return 0;
+
+		ret = no_os_lwip_step(desc, desc);
+		if (ret)
+			return ret;
+	}
+}
+
 /**
  * @brief Get the time from system power-up (ms resolution).
  * @return Time in ms.
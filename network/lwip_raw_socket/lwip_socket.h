@@ -45,12 +45,20 @@
 #include "lwip/netif.h"
 #include "network_interface.h"
 #include "tcp_socket.h"
+#include "no_os_util.h"
 
 #define NO_OS_LWIP_BUFF_SIZE	1530
 #define NO_OS_MTU_SIZE		1500
 #define NO_OS_DOMAIN_NAME	"analog"
 #define NO_OS_MAX_SOCKETS	10
 
+/* Data can be read, or a connection can be accepted on a server socket */
+#define NO_OS_LWIP_EV_READ	NO_OS_BIT(0)
+/* Data can be sent */
+#define NO_OS_LWIP_EV_WRITE	NO_OS_BIT(1)
+/* The connection was closed by the remote or aborted */
+#define NO_OS_LWIP_EV_CLOSED	NO_OS_BIT(2)
+
 #ifndef NO_OS_LWIP_INIT_ONETIME
 #define NO_OS_LWIP_INIT_ONETIME		0
 #endif
@@ -72,15 +80,41 @@ struct lwip_socket_desc {
 		SOCKET_WAITING_ACCEPT,
 		/* Socket is connected to remote */
 		SOCKET_CONNECTED,
+		/* UDP socket, only sending datagrams is supported */
+		SOCKET_DATAGRAM,
 	} state;
 	/* Lwip specific descriptor for each connection. */
 	struct tcp_pcb *pcb;
+	/* Lwip specific descriptor of a UDP socket */
+	struct udp_pcb *upcb;
 	/* Either a packet buffer chain or queue containing the received frames */
 	struct pbuf *p;
 	/* Index of the current read byte in the first pbuf of the chain */
 	uint32_t p_idx;
 	/* Reference to the parent network descriptor. */
 	struct lwip_network_desc *desc;
+	/* Server socket a connection was accepted on */
+	struct lwip_socket_desc *server;
+	/*
+	 * Readiness callback, called from the lwip context with a mask of
+	 * NO_OS_LWIP_EV_* events. Inherited by the accepted connections.
+	 */
+	void (*event_cb)(void *ctx, uint32_t sock_id, uint32_t events);
+	/* Parameter passed to event_cb */
+	void *event_ctx;
+	/* Receive window limit (0 for TCP_WND), inherited on accept */
+	uint32_t rx_window;
+	/* Part of TCP_WND withheld from the remote to enforce rx_window */
+	uint32_t wnd_held;
+};
+
+struct no_os_lwip_pollfd {
+	/* Socket to be polled */
+	uint32_t sock_id;
+	/* Requested NO_OS_LWIP_EV_* events */
+	uint32_t events;
+	/* Returned events, NO_OS_LWIP_EV_CLOSED is always reported */
+	uint32_t revents;
 };
 
 struct lwip_network_desc {
@@ -121,6 +155,23 @@ int32_t no_os_lwip_remove(struct lwip_network_desc *);
  */
 int32_t no_os_lwip_step(struct lwip_network_desc *, void *);
 
+/* Set the readiness callback of a socket */
+int32_t no_os_lwip_socket_set_callback(struct lwip_network_desc *desc,
+				       uint32_t sock_id,
+				       void (*event_cb)(void *, uint32_t,
+						       uint32_t),
+				       void *event_ctx);
+/* Limit the amount of unread data the remote may send to a socket */
+int32_t no_os_lwip_socket_set_rx_window(struct lwip_network_desc *desc,
+					uint32_t sock_id, uint32_t window);
+/*
+ * Wait for events on several sockets, stepping the stack while waiting.
+ * A negative timeout waits forever, 0 returns immediately.
+ */
+int32_t no_os_lwip_poll(struct lwip_network_desc *desc,
+			struct no_os_lwip_pollfd *fds, uint32_t nfds,
+			int32_t timeout_ms);
+
 extern struct network_interface lwip_socket_ops;
 
 #endif /* NO_OS_LWIP_NETWORKING */
@@ -218,6 +218,20 @@ struct network_interface {
 	 */
 	int32_t (*socket_accept)(void *net, uint32_t sock_id,
 				 uint32_t *client_socket_id);
+
+	/**
+	 * @brief Join a multicast group on a UDP socket.
+	 *
+	 * Optional, may be NULL if the interface has no multicast support.
+	 * @param net - Network interface
+	 * @param sock_id - Socket id
+	 * @param group - Address of the multicast group
+	 * @return
+	 *  - 0 : On success
+	 *  - \ref Negative error code on failure
+	 */
+	int32_t (*socket_join_group)(void *net, uint32_t sock_id,
+				     const char *group);
 };
 
 #endif
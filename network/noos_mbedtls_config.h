@@ -99,6 +99,12 @@
  */
 #define ENABLE_MEMORY_OPTIMIZATIONS
 
+/*
+ * Resume sessions with RFC 5077 session tickets, for servers not keeping a
+ * session ID cache. Resumption through session IDs is always enabled.
+ */
+#define ENABLE_SESSION_TICKETS
+
 /******************************************************************************/
 /********************* Minimal tls client requirements ************************/
 /******************************************************************************/
@@ -154,6 +160,12 @@
 
 #endif /* ENABLE_MEMORY_OPTIMIZATIONS */
 
+#ifdef ENABLE_SESSION_TICKETS
+
+#define MBEDTLS_SSL_SESSION_TICKETS
+
+#endif /* ENABLE_SESSION_TICKETS */
+
 #ifdef ENABLE_PEM_CERT
 
 #define MBEDTLS_BASE64_C
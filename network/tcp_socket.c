@@ -43,6 +43,7 @@
 /******************************************************************************/
 
 #include <stdlib.h>
+#include <string.h>
 #include "no_os_error.h"
 #include "tcp_socket.h"
 #include "no_os_util.h"
@@ -51,6 +52,7 @@
 #ifndef DISABLE_SECURE_SOCKET
 #include "noos_mbedtls_config.h"
 #include "no_os_trng.h"
+#include "no_os_delay.h"
 #endif /* DISABLE_SECURE_SOCKET */
 
 /******************************************************************************/
@@ -96,6 +98,20 @@ struct secure_socket_desc {
 	mbedtls_ssl_config	conf;
 	/** Mbedtls tls context */
 	mbedtls_ssl_context	ssl;
+	/** Session of the last handshake, offered for resumption */
+	mbedtls_ssl_session	session;
+	/** Set when session holds a session that can be resumed */
+	bool			session_valid;
+	/** Set once ssl was used for a handshake and needs a reset */
+	bool			ssl_used;
+	/** Send coalescing buffer */
+	uint8_t			*tx_buff;
+	/** Size of tx_buff */
+	uint32_t		tx_size;
+	/** Number of bytes held in tx_buff */
+	uint32_t		tx_len;
+	/** Handshake and record statistics */
+	struct secure_socket_stats	stats;
 };
 #endif /* DISABLE_SECURE_SOCKET */
 
@@ -124,9 +140,20 @@ static int tls_net_send(struct tcp_socket_desc *sock, unsigned char *buff,
 	return sock->net->socket_send(sock->net->net, sock->id, buff, len);
 }
 
+/* Current time in microseconds, used for the statistics */
+static uint64_t stcp_time_us(void)
+{
+	struct no_os_time t = no_os_get_time();
+
+	return (uint64_t)t.s * 1000000 + t.us;
+}
+
 /* Remove secure descriptor*/
 static void stcp_socket_remove(struct secure_socket_desc *desc)
 {
+	mbedtls_ssl_session_free(&desc->session);
+	mbedtls_ssl_free(&desc->ssl);
+	no_os_free(desc->tx_buff);
 	mbedtls_pk_free(&desc->pkey);
 	mbedtls_x509_crt_free(&desc->clicert);
 	mbedtls_x509_crt_free(&desc->cacert);
@@ -158,6 +185,17 @@ static int32_t stcp_socket_init(struct secure_socket_desc **desc,
 	mbedtls_x509_crt_init(&ldesc->clicert);
 	mbedtls_pk_init(&ldesc->pkey);
 	mbedtls_ssl_init(&ldesc->ssl);
+	mbedtls_ssl_session_init(&ldesc->session);
+
+	if (param->tx_coalesce_size) {
+		ldesc->tx_size = no_os_min_t(uint32_t, param->tx_coalesce_size,
+					     MBEDTLS_SSL_OUT_CONTENT_LEN);
+		ldesc->tx_buff = no_os_calloc(1, ldesc->tx_size);
+		if (!ldesc->tx_buff) {
+			ret = -ENOMEM;
+			goto exit;
+		}
+	}
 
 	ret = no_os_trng_init(&ldesc->trng, param->trng_init_param);
 	if (NO_OS_IS_ERR_VALUE(ret)) {
@@ -220,6 +258,11 @@ static int32_t stcp_socket_init(struct secure_socket_desc **desc,
 			goto exit;
 	}
 
+#ifdef MBEDTLS_SSL_SESSION_TICKETS
+	mbedtls_ssl_conf_session_tickets(&ldesc->conf,
+					 MBEDTLS_SSL_SESSION_TICKETS_ENABLED);
+#endif /* MBEDTLS_SSL_SESSION_TICKETS */
+
 	/* Config Random number generator */
 	mbedtls_ssl_conf_rng(&ldesc->conf,
 			     (int (*)(void *, unsigned char *, size_t))
@@ -249,6 +292,133 @@ exit:
 
 	return ret;
 }
+
+/*
+ * Perform the TLS handshake. The session of the previous connection, if any,
+ * is offered to the server so that a full handshake can be avoided.
+ */
+static int32_t stcp_socket_handshake(struct secure_socket_desc *desc)
+{
+	bool offered = false;
+	uint64_t start;
+	uint32_t elapsed;
+	int32_t ret;
+
+	if (desc->ssl_used) {
+		ret = mbedtls_ssl_session_reset(&desc->ssl);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+	desc->ssl_used = true;
+	desc->tx_len = 0;
+
+	if (desc->session_valid &&
+	    !mbedtls_ssl_set_session(&desc->ssl, &desc->session)) {
+		offered = true;
+		desc->stats.resume_attempts++;
+	}
+
+	start = stcp_time_us();
+	do {
+		ret = mbedtls_ssl_handshake(&desc->ssl);
+	} while (ret == MBEDTLS_ERR_SSL_WANT_READ);
+	if (NO_OS_IS_ERR_VALUE(ret)) {
+		desc->session_valid = false;
+		return ret;
+	}
+
+	elapsed = stcp_time_us() - start;
+	desc->stats.handshakes++;
+	desc->stats.last_handshake_us = elapsed;
+	desc->stats.total_handshake_us += elapsed;
+
+	/* The server echoes the offered session ID when resuming */
+	if (offered && desc->ssl.session->id_len &&
+	    desc->ssl.session->id_len == desc->session.id_len &&
+	    !memcmp(desc->ssl.session->id, desc->session.id,
+		    desc->session.id_len))
+		desc->stats.resumed++;
+
+	desc->session_valid = !mbedtls_ssl_get_session(&desc->ssl,
+			      &desc->session);
+
+	return 0;
+}
+
+/* Send one or more records, retrying while the transport is busy */
+static int32_t stcp_socket_write(struct secure_socket_desc *desc,
+				 const uint8_t *data, uint32_t len)
+{
+	uint32_t sent = 0;
+	uint64_t start;
+	int32_t ret;
+
+	start = stcp_time_us();
+	while (sent < len) {
+		ret = mbedtls_ssl_write(&desc->ssl, data + sent, len - sent);
+		if (ret == MBEDTLS_ERR_SSL_WANT_READ ||
+		    ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+			continue;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		sent += ret;
+		desc->stats.records++;
+	}
+	desc->stats.tx_bytes += len;
+	desc->stats.total_record_us += stcp_time_us() - start;
+
+	return 0;
+}
+
+/* Send the content of the coalescing buffer */
+static int32_t stcp_socket_flush(struct secure_socket_desc *desc)
+{
+	int32_t ret;
+
+	if (!desc->tx_len)
+		return 0;
+
+	ret = stcp_socket_write(desc, desc->tx_buff, desc->tx_len);
+	if (NO_OS_IS_ERR_VALUE(ret))
+		return ret;
+
+	desc->tx_len = 0;
+
+	return 0;
+}
+
+/* Queue data in the coalescing buffer, sending it once full */
+static int32_t stcp_socket_send(struct secure_socket_desc *desc,
+				const void *data, uint32_t len)
+{
+	int32_t ret;
+
+	if (desc->tx_len + len > desc->tx_size) {
+		ret = stcp_socket_flush(desc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	/* Large writes already fill records, send them without copying */
+	if (len >= desc->tx_size) {
+		ret = stcp_socket_write(desc, data, len);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		return len;
+	}
+
+	memcpy(desc->tx_buff + desc->tx_len, data, len);
+	desc->tx_len += len;
+	if (desc->tx_len == desc->tx_size) {
+		ret = stcp_socket_flush(desc);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+	}
+
+	return len;
+}
 #endif /* DISABLE_SECURE_SOCKET */
 
 /**
@@ -347,13 +517,8 @@ int32_t socket_connect(struct tcp_socket_desc *desc,
 		return ret;
 
 #ifndef DISABLE_SECURE_SOCKET
-	if (desc->secure) {
-		do {
-			ret = mbedtls_ssl_handshake(&desc->secure->ssl);
-		} while (ret == MBEDTLS_ERR_SSL_WANT_READ);
-		if (NO_OS_IS_ERR_VALUE(ret))
-			return ret;
-	}
+	if (desc->secure)
+		return stcp_socket_handshake(desc->secure);
 #endif /* DISABLE_SECURE_SOCKET */
 
 	return 0;
@@ -366,8 +531,12 @@ int32_t socket_disconnect(struct tcp_socket_desc *desc)
 		return -1;
 
 #ifndef DISABLE_SECURE_SOCKET
-	if (desc->secure)
+	if (desc->secure) {
+		/* Best effort, the connection is closed anyway */
+		stcp_socket_flush(desc->secure);
+		desc->secure->tx_len = 0;
 		mbedtls_ssl_close_notify(&desc->secure->ssl);
+	}
 #endif /* DISABLE_SECURE_SOCKET */
 
 	return desc->net->socket_disconnect(desc->net->net, desc->id);
@@ -382,8 +551,20 @@ int32_t socket_send(struct tcp_socket_desc *desc, const void *data,
 		return -1;
 
 #ifndef DISABLE_SECURE_SOCKET
-	if (desc->secure)
-		return mbedtls_ssl_write(&desc->secure->ssl, data, len);
+	int32_t ret;
+
+	if (desc->secure && desc->secure->tx_buff)
+		return stcp_socket_send(desc->secure, data, len);
+
+	if (desc->secure) {
+		ret = mbedtls_ssl_write(&desc->secure->ssl, data, len);
+		if (ret > 0) {
+			desc->secure->stats.records++;
+			desc->secure->stats.tx_bytes += ret;
+		}
+
+		return ret;
+	}
 #endif /* DISABLE_SECURE_SOCKET */
 
 	return desc->net->socket_send(desc->net->net, desc->id,
@@ -400,6 +581,11 @@ int32_t socket_recv(struct tcp_socket_desc *desc, void *data, uint32_t len)
 	int32_t ret;
 
 	if (desc->secure) {
+		/* The peer may wait for the queued data before answering */
+		ret = stcp_socket_flush(desc->secure);
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
 		ret = mbedtls_ssl_read(&desc->secure->ssl, data, len);
 		if (ret == MBEDTLS_ERR_SSL_WANT_READ)
 			return -EAGAIN;
@@ -461,3 +647,41 @@ int32_t socket_accept(struct tcp_socket_desc *desc,
 	return 0;
 }
 
+
+/**
+ * @brief Send the data queued in the coalescing buffer of a secure socket.
+ * Nothing to do for sockets without TLS or without coalescing buffer.
+ * @param desc - Socket descriptor
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t socket_flush(struct tcp_socket_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+#ifndef DISABLE_SECURE_SOCKET
+	if (desc->secure)
+		return stcp_socket_flush(desc->secure);
+#endif /* DISABLE_SECURE_SOCKET */
+
+	return 0;
+}
+
+#ifndef DISABLE_SECURE_SOCKET
+/**
+ * @brief Get the handshake and record statistics of a secure socket.
+ * @param desc - Socket descriptor
+ * @param stats - Filled with the statistics.
+ * @return 0 in case of success, negative error code otherwise.
+ */
+int32_t socket_get_tls_stats(struct tcp_socket_desc *desc,
+			     struct secure_socket_stats *stats)
+{
+	if (!desc || !stats || !desc->secure)
+		return -EINVAL;
+
+	*stats = desc->secure->stats;
+
+	return 0;
+}
+#endif /* DISABLE_SECURE_SOCKET */
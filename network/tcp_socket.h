@@ -74,7 +74,11 @@ struct tcp_socket_desc {
  * @brief Parameter to initialize a TCP Socket
  */
 struct secure_init_param {
-	/** Init param for true random number generator */
+	/**
+	 * Init param for true random number generator. Use
+	 * no_os_trng_pool_ops to serve the handshakes from a DRBG seeded in
+	 * the background instead of reading the TRNG on every request.
+	 */
 	struct no_os_trng_init_param	*trng_init_param;
 	/** Server Hostname */
 	uint8_t			*hostname;
@@ -109,6 +113,36 @@ struct secure_init_param {
 	uint8_t			*cli_pk;
 	/** cli_pk length */
 	uint32_t		cli_pk_len;
+	/**
+	 * Size of the send coalescing buffer, clamped to the maximum record
+	 * payload. Small socket_send() writes are packed in it and sent as a
+	 * single record once it is full, on socket_flush() or before reading.
+	 * 0 sends a record for each socket_send() call.
+	 */
+	uint32_t		tx_coalesce_size;
+};
+
+/**
+ * @struct secure_socket_stats
+ * @brief TLS statistics of a secure socket
+ */
+struct secure_socket_stats {
+	/** Completed handshakes */
+	uint32_t	handshakes;
+	/** Handshakes for which a cached session was offered */
+	uint32_t	resume_attempts;
+	/** Handshakes that resumed the cached session */
+	uint32_t	resumed;
+	/** Duration of the last handshake, in microseconds */
+	uint32_t	last_handshake_us;
+	/** Total handshake time, in microseconds */
+	uint64_t	total_handshake_us;
+	/** Records sent */
+	uint32_t	records;
+	/** Application bytes sent */
+	uint32_t	tx_bytes;
+	/** Total time spent encrypting and sending records, in microseconds */
+	uint64_t	total_record_us;
 };
 
 #endif /* DISABLE_SECURE_SOCKET */
@@ -170,4 +204,13 @@ int32_t socket_listen(struct tcp_socket_desc *desc, uint32_t back_log);
 int32_t socket_accept(struct tcp_socket_desc *desc,
 		      struct tcp_socket_desc **new_client);
 
+/* Send the data held in the coalescing buffer */
+int32_t socket_flush(struct tcp_socket_desc *desc);
+
+#ifndef DISABLE_SECURE_SOCKET
+/* Get the TLS statistics of a secure socket */
+int32_t socket_get_tls_stats(struct tcp_socket_desc *desc,
+			     struct secure_socket_stats *stats);
+#endif /* DISABLE_SECURE_SOCKET */
+
 #endif
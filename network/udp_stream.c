@@ -0,0 +1,588 @@
+/***************************************************************************//**
+ *   @file   udp_stream.c
+ *   @brief  UDP/multicast streaming of IIO buffer blocks.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdlib.h>
+#include <string.h>
+#include "no_os_error.h"
+#include "no_os_util.h"
+#include "no_os_alloc.h"
+#include "udp_stream.h"
+
+/******************************************************************************/
+/************************ Functions Definitions *******************************/
+/******************************************************************************/
+
+/**
+ * @brief Encode a datagram header.
+ * @param hdr - Header to be encoded.
+ * @param buf - Destination, at least UDP_STREAM_HDR_SIZE bytes.
+ */
+void udp_stream_hdr_pack(const struct udp_stream_hdr *hdr, uint8_t *buf)
+{
+	no_os_put_unaligned_be16(UDP_STREAM_MAGIC, &buf[0]);
+	buf[2] = UDP_STREAM_VERSION;
+	buf[3] = hdr->flags;
+	no_os_put_unaligned_be16(hdr->stream_id, &buf[4]);
+	no_os_put_unaligned_be16(hdr->scan_size, &buf[6]);
+	no_os_put_unaligned_be32(hdr->ch_mask, &buf[8]);
+	no_os_put_unaligned_be32(hdr->seq, &buf[12]);
+	no_os_put_unaligned_be32(hdr->block, &buf[16]);
+	no_os_put_unaligned_be32(hdr->offset, &buf[20]);
+	no_os_put_unaligned_be32(hdr->block_len, &buf[24]);
+	no_os_put_unaligned_be32(hdr->timestamp_us >> 32, &buf[28]);
+	no_os_put_unaligned_be32(hdr->timestamp_us, &buf[32]);
+}
+
+/**
+ * @brief Decode and validate a datagram header.
+ * @param buf - Received datagram.
+ * @param len - Size of the datagram.
+ * @param hdr - Decoded header.
+ * @return
+ *  - 0 : On success
+ *  - -EBADMSG : If the datagram is not a valid stream datagram
+ */
+int32_t udp_stream_hdr_unpack(const uint8_t *buf, uint32_t len,
+			      struct udp_stream_hdr *hdr)
+{
+	uint8_t *b = (uint8_t *)buf;
+	uint32_t payload;
+
+	if (len < UDP_STREAM_HDR_SIZE)
+		return -EBADMSG;
+
+	if (no_os_get_unaligned_be16(&b[0]) != UDP_STREAM_MAGIC ||
+	    b[2] != UDP_STREAM_VERSION)
+		return -EBADMSG;
+
+	hdr->flags = b[3];
+	hdr->stream_id = no_os_get_unaligned_be16(&b[4]);
+	hdr->scan_size = no_os_get_unaligned_be16(&b[6]);
+	hdr->ch_mask = no_os_get_unaligned_be32(&b[8]);
+	hdr->seq = no_os_get_unaligned_be32(&b[12]);
+	hdr->block = no_os_get_unaligned_be32(&b[16]);
+	hdr->offset = no_os_get_unaligned_be32(&b[20]);
+	hdr->block_len = no_os_get_unaligned_be32(&b[24]);
+	hdr->timestamp_us = (uint64_t)no_os_get_unaligned_be32(&b[28]) << 32 |
+			    no_os_get_unaligned_be32(&b[32]);
+
+	payload = len - UDP_STREAM_HDR_SIZE;
+	if (hdr->offset > hdr->block_len ||
+	    payload > hdr->block_len - hdr->offset)
+		return -EBADMSG;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a UDP stream transmitter.
+ * @param desc - Address where to store the transmitter descriptor.
+ * @param param - Initialization parameters.
+ * @return
+ *  - 0 : On success
+ *  - Negative error code : Otherwise
+ */
+int32_t udp_stream_init(struct udp_stream_desc **desc,
+			struct udp_stream_init_param *param)
+{
+	struct udp_stream_desc *ldesc;
+	int32_t ret;
+
+	if (!desc || !param || !param->net || !param->dest.addr)
+		return -EINVAL;
+
+	if (param->max_payload > UDP_STREAM_MAX_PAYLOAD)
+		return -EINVAL;
+
+	ldesc = no_os_calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return -ENOMEM;
+
+	ldesc->dgram = no_os_calloc(1, UDP_STREAM_MAX_DGRAM);
+	if (!ldesc->dgram) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ldesc->net = param->net;
+	ldesc->dest = param->dest;
+	ldesc->stream_id = param->stream_id;
+	ldesc->max_payload = param->max_payload ? param->max_payload :
+			     UDP_STREAM_MAX_PAYLOAD;
+
+	ret = ldesc->net->socket_open(ldesc->net->net, &ldesc->sock_id,
+				      PROTOCOL_UDP, UDP_STREAM_MAX_DGRAM);
+	if (ret)
+		goto free_dgram;
+
+	*desc = ldesc;
+
+	return 0;
+
+free_dgram:
+	no_os_free(ldesc->dgram);
+free_desc:
+	no_os_free(ldesc);
+
+	return ret;
+}
+
+/**
+ * @brief Remove a UDP stream transmitter.
+ * @param desc - Transmitter descriptor.
+ * @return
+ *  - 0 : On success
+ *  - Negative error code : Otherwise
+ */
+int32_t udp_stream_remove(struct udp_stream_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	desc->net->socket_close(desc->net->net, desc->sock_id);
+	no_os_free(desc->dgram);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Send a block of IIO buffer data.
+ *
+ * The block is split in sequence numbered datagrams of at most max_payload
+ * bytes. A datagram that can't be sent still consumes its sequence number,
+ * so that receivers account for it as lost.
+ * @param desc - Transmitter descriptor.
+ * @param data - Block data, a whole number of scans.
+ * @param len - Size of the block in bytes.
+ * @param ch_mask - Mask of the active channels (iio_buffer active_mask).
+ * @param scan_size - Size of a scan in bytes (iio_buffer bytes_per_scan).
+ * @param timestamp_us - Timestamp of the first scan of the block.
+ * @return
+ *  - 0 : On success
+ *  - Negative error code : Otherwise
+ */
+int32_t udp_stream_send(struct udp_stream_desc *desc, const void *data,
+			uint32_t len, uint32_t ch_mask, uint16_t scan_size,
+			uint64_t timestamp_us)
+{
+	struct udp_stream_hdr hdr;
+	const uint8_t *src = data;
+	uint32_t offset;
+	uint32_t chunk;
+	int32_t ret = 0;
+
+	if (!desc || !data || !len)
+		return -EINVAL;
+
+	hdr.stream_id = desc->stream_id;
+	hdr.scan_size = scan_size;
+	hdr.ch_mask = ch_mask;
+	hdr.block = desc->block++;
+	hdr.block_len = len;
+	hdr.timestamp_us = timestamp_us;
+
+	for (offset = 0; offset < len; offset += chunk) {
+		chunk = no_os_min(len - offset, (uint32_t)desc->max_payload);
+
+		hdr.flags = 0;
+		if (!offset)
+			hdr.flags |= UDP_STREAM_FLAG_FIRST;
+		if (offset + chunk == len)
+			hdr.flags |= UDP_STREAM_FLAG_LAST;
+		hdr.seq = desc->seq++;
+		hdr.offset = offset;
+
+		udp_stream_hdr_pack(&hdr, desc->dgram);
+		memcpy(desc->dgram + UDP_STREAM_HDR_SIZE, src + offset, chunk);
+
+		ret = desc->net->socket_sendto(desc->net->net, desc->sock_id,
+					       desc->dgram,
+					       UDP_STREAM_HDR_SIZE + chunk,
+					       &desc->dest);
+		if (NO_OS_IS_ERR_VALUE(ret)) {
+			desc->stats.errors++;
+			break;
+		}
+
+		desc->stats.datagrams++;
+		desc->stats.bytes += chunk;
+	}
+
+	desc->stats.blocks++;
+
+	return NO_OS_IS_ERR_VALUE(ret) ? ret : 0;
+}
+
+/**
+ * @brief Get the transmitter statistics.
+ * @param desc - Transmitter descriptor.
+ * @param stats - Statistics.
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Otherwise
+ */
+int32_t udp_stream_get_stats(struct udp_stream_desc *desc,
+			     struct udp_stream_stats *stats)
+{
+	if (!desc || !stats)
+		return -EINVAL;
+
+	*stats = desc->stats;
+
+	return 0;
+}
+
+/**
+ * @brief Initialize a UDP stream receiver.
+ *
+ * With a NULL network interface, only the buffers are allocated and the
+ * datagrams must be fed through udp_stream_rx_process().
+ * @param desc - Address where to store the receiver descriptor.
+ * @param param - Initialization parameters.
+ * @return
+ *  - 0 : On success
+ *  - Negative error code : Otherwise
+ */
+int32_t udp_stream_rx_init(struct udp_stream_rx_desc **desc,
+			   struct udp_stream_rx_init_param *param)
+{
+	struct udp_stream_rx_desc *ldesc;
+	int32_t ret;
+
+	if (!desc || !param || !param->max_block_size)
+		return -EINVAL;
+
+	if (param->group && (!param->net || !param->net->socket_join_group))
+		return -ENOSYS;
+
+	ldesc = no_os_calloc(1, sizeof(*ldesc));
+	if (!ldesc)
+		return -ENOMEM;
+
+	ldesc->dgram = no_os_calloc(1, UDP_STREAM_MAX_DGRAM);
+	if (!ldesc->dgram) {
+		ret = -ENOMEM;
+		goto free_desc;
+	}
+
+	ldesc->block_buf = no_os_calloc(1, param->max_block_size);
+	if (!ldesc->block_buf) {
+		ret = -ENOMEM;
+		goto free_dgram;
+	}
+
+	ldesc->max_block_size = param->max_block_size;
+	ldesc->net = param->net;
+	if (!ldesc->net)
+		goto out;
+
+	ret = ldesc->net->socket_open(ldesc->net->net, &ldesc->sock_id,
+				      PROTOCOL_UDP, UDP_STREAM_MAX_DGRAM);
+	if (ret)
+		goto free_block;
+
+	ret = ldesc->net->socket_bind(ldesc->net->net, ldesc->sock_id,
+				      param->port);
+	if (ret)
+		goto close_socket;
+
+	if (param->group) {
+		ret = ldesc->net->socket_join_group(ldesc->net->net,
+						    ldesc->sock_id,
+						    param->group);
+		if (ret)
+			goto close_socket;
+	}
+
+out:
+	*desc = ldesc;
+
+	return 0;
+
+close_socket:
+	ldesc->net->socket_close(ldesc->net->net, ldesc->sock_id);
+free_block:
+	no_os_free(ldesc->block_buf);
+free_dgram:
+	no_os_free(ldesc->dgram);
+free_desc:
+	no_os_free(ldesc);
+
+	return ret;
+}
+
+/**
+ * @brief Remove a UDP stream receiver.
+ * @param desc - Receiver descriptor.
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Otherwise
+ */
+int32_t udp_stream_rx_remove(struct udp_stream_rx_desc *desc)
+{
+	if (!desc)
+		return -EINVAL;
+
+	if (desc->net)
+		desc->net->socket_close(desc->net->net, desc->sock_id);
+
+	no_os_free(desc->block_buf);
+	no_os_free(desc->dgram);
+	no_os_free(desc);
+
+	return 0;
+}
+
+/**
+ * @brief Account for a datagram sequence number.
+ * @param desc - Receiver descriptor.
+ * @param seq - Sequence number of the received datagram.
+ * @return true if the datagram should be used, false if it is a duplicate or
+ * too old to be tracked.
+ */
+static bool udp_stream_rx_track(struct udp_stream_rx_desc *desc, uint32_t seq)
+{
+	int32_t diff;
+	uint32_t age;
+
+	if (!desc->synced) {
+		desc->synced = true;
+		desc->next_seq = seq + 1;
+		desc->seen = 1;
+
+		return true;
+	}
+
+	diff = (int32_t)(seq - desc->next_seq);
+	if (diff >= 0) {
+		/* Bit i of seen tracks next_seq - 1 - i */
+		desc->stats.lost += diff;
+		if (diff >= 31)
+			desc->seen = 1;
+		else
+			desc->seen = desc->seen << (diff + 1) | 1;
+		desc->next_seq = seq + 1;
+
+		return true;
+	}
+
+	age = desc->next_seq - 1 - seq;
+	if (age >= 32) {
+		desc->stats.reordered++;
+
+		return false;
+	}
+
+	if (desc->seen & NO_OS_BIT(age)) {
+		desc->stats.duplicates++;
+
+		return false;
+	}
+
+	/* A late datagram, previously accounted as lost */
+	desc->seen |= NO_OS_BIT(age);
+	desc->stats.reordered++;
+	if (desc->stats.lost)
+		desc->stats.lost--;
+
+	return true;
+}
+
+/**
+ * @brief End the reassembly of the current block, its late datagrams are
+ * ignored from now on.
+ * @param desc - Receiver descriptor.
+ */
+static void udp_stream_rx_close_block(struct udp_stream_rx_desc *desc)
+{
+	desc->in_block = false;
+	desc->has_last = true;
+	desc->last_stream_id = desc->cur.stream_id;
+	desc->last_block = desc->cur.block;
+}
+
+/**
+ * @brief Feed a received datagram to the receiver.
+ *
+ * Datagrams are reassembled in blocks. A block missing any datagram is
+ * dropped and accounted as incomplete once a datagram of a newer block
+ * arrives.
+ * @param desc - Receiver descriptor.
+ * @param dgram - Received datagram.
+ * @param len - Size of the datagram.
+ * @param block - Filled in when a block is complete.
+ * @return
+ *  - 1 : A block is complete
+ *  - 0 : More datagrams are needed
+ *  - Negative error code : Invalid datagram
+ */
+int32_t udp_stream_rx_process(struct udp_stream_rx_desc *desc,
+			      const uint8_t *dgram, uint32_t len,
+			      struct udp_stream_block *block)
+{
+	struct udp_stream_hdr hdr;
+	uint32_t payload;
+	int32_t ret;
+
+	if (!desc || !dgram || !block)
+		return -EINVAL;
+
+	ret = udp_stream_hdr_unpack(dgram, len, &hdr);
+	if (ret) {
+		desc->stats.malformed++;
+		return ret;
+	}
+
+	desc->stats.datagrams++;
+	if (!udp_stream_rx_track(desc, hdr.seq))
+		return 0;
+
+	/* Late datagram of a block already completed or given up on */
+	if (desc->has_last && hdr.stream_id == desc->last_stream_id &&
+	    (int32_t)(hdr.block - desc->last_block) <= 0)
+		return 0;
+
+	if (!desc->in_block || hdr.block != desc->cur.block ||
+	    hdr.stream_id != desc->cur.stream_id) {
+		if (desc->in_block) {
+			if (hdr.stream_id == desc->cur.stream_id &&
+			    (int32_t)(hdr.block - desc->cur.block) < 0)
+				return 0;
+
+			desc->stats.incomplete++;
+			udp_stream_rx_close_block(desc);
+		}
+
+		desc->cur = hdr;
+		desc->cur_bytes = 0;
+		if (hdr.block_len > desc->max_block_size) {
+			desc->stats.incomplete++;
+			udp_stream_rx_close_block(desc);
+			return -EMSGSIZE;
+		}
+		desc->in_block = true;
+	} else if (hdr.block_len != desc->cur.block_len ||
+		   hdr.scan_size != desc->cur.scan_size ||
+		   hdr.ch_mask != desc->cur.ch_mask) {
+		/* Inconsistent with the first datagram of the block */
+		desc->stats.malformed++;
+		return -EBADMSG;
+	}
+
+	payload = len - UDP_STREAM_HDR_SIZE;
+	if (hdr.offset > desc->max_block_size ||
+	    payload > desc->max_block_size - hdr.offset) {
+		desc->stats.malformed++;
+		return -EBADMSG;
+	}
+
+	memcpy(desc->block_buf + hdr.offset, dgram + UDP_STREAM_HDR_SIZE,
+	       payload);
+	desc->cur_bytes += payload;
+	if (desc->cur_bytes < desc->cur.block_len)
+		return 0;
+
+	udp_stream_rx_close_block(desc);
+	desc->stats.blocks++;
+
+	block->stream_id = desc->cur.stream_id;
+	block->block = desc->cur.block;
+	block->ch_mask = desc->cur.ch_mask;
+	block->scan_size = desc->cur.scan_size;
+	block->timestamp_us = desc->cur.timestamp_us;
+	block->data = desc->block_buf;
+	block->len = desc->cur.block_len;
+
+	return 1;
+}
+
+/**
+ * @brief Receive the pending datagrams until a block is complete.
+ * @param desc - Receiver descriptor.
+ * @param block - Filled in when a block is complete.
+ * @return
+ *  - 1 : A block is complete
+ *  - -EAGAIN : No complete block yet
+ *  - Negative error code : Otherwise
+ */
+int32_t udp_stream_rx_poll(struct udp_stream_rx_desc *desc,
+			   struct udp_stream_block *block)
+{
+	int32_t ret;
+
+	if (!desc || !desc->net || !block)
+		return -EINVAL;
+
+	while (true) {
+		ret = desc->net->socket_recvfrom(desc->net->net, desc->sock_id,
+						 desc->dgram,
+						 UDP_STREAM_MAX_DGRAM, NULL);
+		if (ret == 0 || ret == -EAGAIN || ret == -EWOULDBLOCK)
+			return -EAGAIN;
+		if (NO_OS_IS_ERR_VALUE(ret))
+			return ret;
+
+		ret = udp_stream_rx_process(desc, desc->dgram, ret, block);
+		if (ret == 1)
+			return ret;
+	}
+}
+
+/**
+ * @brief Get the receiver statistics.
+ * @param desc - Receiver descriptor.
+ * @param stats - Statistics.
+ * @return
+ *  - 0 : On success
+ *  - -EINVAL : Otherwise
+ */
+int32_t udp_stream_rx_get_stats(struct udp_stream_rx_desc *desc,
+				struct udp_stream_rx_stats *stats)
+{
+	if (!desc || !stats)
+		return -EINVAL;
+
+	*stats = desc->stats;
+
+	return 0;
+}
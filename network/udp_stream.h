@@ -0,0 +1,296 @@
+/***************************************************************************//**
+ *   @file   udp_stream.h
+ *   @brief  UDP/multicast streaming of IIO buffer blocks.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+#ifndef UDP_STREAM_H
+#define UDP_STREAM_H
+
+/******************************************************************************/
+/***************************** Include Files **********************************/
+/******************************************************************************/
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "network_interface.h"
+
+/******************************************************************************/
+/********************** Macros and Constants Definitions **********************/
+/******************************************************************************/
+
+#define UDP_STREAM_MAGIC		0xAD15
+#define UDP_STREAM_VERSION		1
+/* Size of the datagram header */
+#define UDP_STREAM_HDR_SIZE		36
+/* Largest UDP payload that fits a 1500 bytes MTU without fragmentation */
+#define UDP_STREAM_MAX_DGRAM		1472
+#define UDP_STREAM_MAX_PAYLOAD		(UDP_STREAM_MAX_DGRAM - \
+					 UDP_STREAM_HDR_SIZE)
+/* First datagram of a block */
+#define UDP_STREAM_FLAG_FIRST		0x01
+/* Last datagram of a block */
+#define UDP_STREAM_FLAG_LAST		0x02
+
+/******************************************************************************/
+/*************************** Types Declarations *******************************/
+/******************************************************************************/
+
+/**
+ * @struct udp_stream_hdr
+ * @brief Decoded datagram header. On the wire, all the fields are big endian
+ * and follow the magic (16 bits), version (8 bits) and flags (8 bits).
+ */
+struct udp_stream_hdr {
+	/** UDP_STREAM_FLAG_* flags */
+	uint8_t		flags;
+	/** Stream identifier, to tell apart several streams on one port */
+	uint16_t	stream_id;
+	/** Size of a scan (one sample of every active channel) in bytes */
+	uint16_t	scan_size;
+	/** Mask of the channels present in the block */
+	uint32_t	ch_mask;
+	/** Datagram sequence number */
+	uint32_t	seq;
+	/** Block sequence number */
+	uint32_t	block;
+	/** Offset of the payload in the block */
+	uint32_t	offset;
+	/** Size of the block in bytes */
+	uint32_t	block_len;
+	/** Timestamp of the block, in microseconds */
+	uint64_t	timestamp_us;
+};
+
+/**
+ * @struct udp_stream_init_param
+ * @brief Parameters of a UDP stream transmitter
+ */
+struct udp_stream_init_param {
+	/** Reference to the network interface */
+	struct network_interface	*net;
+	/**
+	 * Destination of the datagrams, either a unicast host or a multicast
+	 * group. The address string must remain valid while streaming.
+	 */
+	struct socket_address		dest;
+	/** Stream identifier */
+	uint16_t			stream_id;
+	/** Maximum block bytes per datagram, 0 for UDP_STREAM_MAX_PAYLOAD */
+	uint16_t			max_payload;
+};
+
+/**
+ * @struct udp_stream_stats
+ * @brief Statistics of a UDP stream transmitter
+ */
+struct udp_stream_stats {
+	/** Datagrams sent */
+	uint32_t	datagrams;
+	/** Blocks sent */
+	uint32_t	blocks;
+	/** Block bytes sent */
+	uint64_t	bytes;
+	/** Datagrams that could not be sent */
+	uint32_t	errors;
+};
+
+/**
+ * @struct udp_stream_desc
+ * @brief UDP stream transmitter descriptor
+ */
+struct udp_stream_desc {
+	/** Reference to the network interface */
+	struct network_interface	*net;
+	/** Id of the UDP socket */
+	uint32_t			sock_id;
+	/** Destination of the datagrams */
+	struct socket_address		dest;
+	/** Stream identifier */
+	uint16_t			stream_id;
+	/** Maximum block bytes per datagram */
+	uint16_t			max_payload;
+	/** Next datagram sequence number */
+	uint32_t			seq;
+	/** Next block sequence number */
+	uint32_t			block;
+	/** Datagram buffer */
+	uint8_t				*dgram;
+	/** Statistics */
+	struct udp_stream_stats		stats;
+};
+
+/**
+ * @struct udp_stream_block
+ * @brief Block of IIO buffer data reassembled by a receiver
+ */
+struct udp_stream_block {
+	/** Stream identifier */
+	uint16_t	stream_id;
+	/** Block sequence number */
+	uint32_t	block;
+	/** Mask of the channels present in the block */
+	uint32_t	ch_mask;
+	/** Size of a scan in bytes */
+	uint16_t	scan_size;
+	/** Timestamp of the block, in microseconds */
+	uint64_t	timestamp_us;
+	/** Block data, valid until the next datagram is processed */
+	uint8_t		*data;
+	/** Size of the block in bytes */
+	uint32_t	len;
+};
+
+/**
+ * @struct udp_stream_rx_init_param
+ * @brief Parameters of a UDP stream receiver
+ */
+struct udp_stream_rx_init_param {
+	/** Reference to the network interface */
+	struct network_interface	*net;
+	/** Port to receive on */
+	uint16_t			port;
+	/** Multicast group to join, NULL for unicast */
+	const char			*group;
+	/** Size of the largest block to be reassembled */
+	uint32_t			max_block_size;
+};
+
+/**
+ * @struct udp_stream_rx_stats
+ * @brief Statistics of a UDP stream receiver
+ */
+struct udp_stream_rx_stats {
+	/** Valid datagrams received */
+	uint32_t	datagrams;
+	/** Datagrams missing from the sequence */
+	uint32_t	lost;
+	/** Datagrams received out of order */
+	uint32_t	reordered;
+	/** Datagrams received more than once */
+	uint32_t	duplicates;
+	/** Datagrams with an invalid header */
+	uint32_t	malformed;
+	/** Blocks completely reassembled */
+	uint32_t	blocks;
+	/** Blocks dropped because of missing datagrams */
+	uint32_t	incomplete;
+};
+
+/**
+ * @struct udp_stream_rx_desc
+ * @brief UDP stream receiver descriptor
+ */
+struct udp_stream_rx_desc {
+	/** Reference to the network interface, NULL if only parsing */
+	struct network_interface	*net;
+	/** Id of the UDP socket */
+	uint32_t			sock_id;
+	/** Datagram buffer */
+	uint8_t				*dgram;
+	/** Reassembly buffer */
+	uint8_t				*block_buf;
+	/** Size of the reassembly buffer */
+	uint32_t			max_block_size;
+	/** Header of the block being reassembled */
+	struct udp_stream_hdr		cur;
+	/** Bytes of the current block received so far */
+	uint32_t			cur_bytes;
+	/** Whether a block is being reassembled */
+	bool				in_block;
+	/** Whether a block was completed or given up on */
+	bool				has_last;
+	/** Stream of the last block completed or given up on */
+	uint16_t			last_stream_id;
+	/** Last block completed or given up on */
+	uint32_t			last_block;
+	/** Whether the first datagram was received */
+	bool				synced;
+	/** Next expected datagram sequence number */
+	uint32_t			next_seq;
+	/** Datagrams received among the 32 preceding next_seq */
+	uint32_t			seen;
+	/** Statistics */
+	struct udp_stream_rx_stats	stats;
+};
+
+/******************************************************************************/
+/************************ Functions Declarations ******************************/
+/******************************************************************************/
+
+/* Encode a datagram header */
+void udp_stream_hdr_pack(const struct udp_stream_hdr *hdr, uint8_t *buf);
+
+/* Decode and validate a datagram header */
+int32_t udp_stream_hdr_unpack(const uint8_t *buf, uint32_t len,
+			      struct udp_stream_hdr *hdr);
+
+/* Initialize a UDP stream transmitter */
+int32_t udp_stream_init(struct udp_stream_desc **desc,
+			struct udp_stream_init_param *param);
+
+/* Remove a UDP stream transmitter */
+int32_t udp_stream_remove(struct udp_stream_desc *desc);
+
+/* Send a block of IIO buffer data */
+int32_t udp_stream_send(struct udp_stream_desc *desc, const void *data,
+			uint32_t len, uint32_t ch_mask, uint16_t scan_size,
+			uint64_t timestamp_us);
+
+/* Get the transmitter statistics */
+int32_t udp_stream_get_stats(struct udp_stream_desc *desc,
+			     struct udp_stream_stats *stats);
+
+/* Initialize a UDP stream receiver */
+int32_t udp_stream_rx_init(struct udp_stream_rx_desc **desc,
+			   struct udp_stream_rx_init_param *param);
+
+/* Remove a UDP stream receiver */
+int32_t udp_stream_rx_remove(struct udp_stream_rx_desc *desc);
+
+/* Feed a received datagram to the receiver */
+int32_t udp_stream_rx_process(struct udp_stream_rx_desc *desc,
+			      const uint8_t *dgram, uint32_t len,
+			      struct udp_stream_block *block);
+
+/* Receive pending datagrams until a block is complete */
+int32_t udp_stream_rx_poll(struct udp_stream_rx_desc *desc,
+			   struct udp_stream_block *block);
+
+/* Get the receiver statistics */
+int32_t udp_stream_rx_get_stats(struct udp_stream_rx_desc *desc,
+				struct udp_stream_rx_stats *stats);
+
+#endif /* UDP_STREAM_H */
@@ -78,6 +78,7 @@ INCS += $(INCLUDE)/no_os_delay.h     \
 		$(INCLUDE)/no_os_alloc.h \
 		$(INCLUDE)/no_os_crc8.h \
 		$(INCLUDE)/no_os_crc16.h \
+		$(INCLUDE)/no_os_circular_buffer.h \
 		$(INCLUDE)/no_os_init.h \
 		$(INCLUDE)/no_os_mutex.h
 
@@ -94,6 +95,7 @@ SRCS += $(DRIVERS)/api/no_os_gpio.c \
 		$(NO-OS)/util/no_os_alloc.c \
 		$(NO-OS)/util/no_os_crc8.c \
 		$(NO-OS)/util/no_os_crc16.c \
+		$(NO-OS)/util/no_os_circular_buffer.c \
 		$(NO-OS)/util/no_os_mutex.c
 
 # ADT75 driver files
@@ -90,6 +90,7 @@ struct iio_hw_trig_init_param ad74413r_gpio_trig_ip = {
 
 struct iio_trigger ad74413r_iio_trig_desc = {
 	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable
 };
@@ -68,7 +68,7 @@ int main(void)
 	uint32_t max = 0;
 	uint32_t mm = 0;
 	uint32_t temperature = 0;
-	struct ad7746_init_param adcip;
+	struct ad7746_init_param adcip = { 0 };
 	struct ad7746_dev *adc = NULL;
 
 	struct no_os_uart_desc *uart;
@@ -13,6 +13,7 @@ SRCS += $(PROJECT)/src/app.c \
 	$(PROJECT)/src/app_clock.c \
 	$(PROJECT)/src/app_jesd.c \
 	$(DRIVERS)/adc/ad9081/ad9081.c \
+	$(DRIVERS)/adc/ad9081/ad9081_nco_hop.c \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_adc.c \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_dac.c \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_device.c \
@@ -53,6 +54,7 @@ SRCS += $(NO-OS)/iio/iio_app/iio_app.c \
 	$(NO-OS)/util/no_os_fifo.c \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.c \
 	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.c \
+	$(DRIVERS)/adc/ad9081/iio_ad9081_nco_hop.c \
 	$(DRIVERS)/api/no_os_irq.c
 endif
 INCS +=	$(PROJECT)/src/app_clock.h \
@@ -60,6 +62,7 @@ INCS +=	$(PROJECT)/src/app_clock.h \
 	$(PROJECT)/src/app_config.h \
 	$(PROJECT)/src/parameters.h \
 	$(DRIVERS)/adc/ad9081/ad9081.h \
+	$(DRIVERS)/adc/ad9081/ad9081_nco_hop.h \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_ad9081.h \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_impala_tc.h \
 	$(DRIVERS)/adc/ad9081/api/adi_ad9081_bf_jrxa_des.h \
@@ -116,5 +119,6 @@ INCS += $(NO-OS)/iio/iio_app/iio_app.h \
 	$(INCLUDE)/no_os_fifo.h \
 	$(INCLUDE)/no_os_list.h \
 	$(DRIVERS)/axi_core/iio_axi_adc/iio_axi_adc.h \
-	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h
+	$(DRIVERS)/axi_core/iio_axi_dac/iio_axi_dac.h \
+	$(DRIVERS)/adc/ad9081/iio_ad9081_nco_hop.h
 endif
@@ -13,6 +13,7 @@ SRCS += $(NO-OS)/util/no_os_util.c \
 	$(DRIVERS)/cdc/ad7746/ad7746.c \
 	$(DRIVERS)/cdc/ad7746/iio_ad7746.c \
 	$(DRIVERS)/api/no_os_irq.c \
+	$(DRIVERS)/api/no_os_gpio.c \
 	$(DRIVERS)/api/no_os_i2c.c \
 	$(DRIVERS)/api/no_os_timer.c \
 	$(DRIVERS)/api/no_os_uart.c \
@@ -59,7 +59,7 @@
 int32_t main(void)
 {
 	int32_t ret;
-	struct ad7746_init_param adcip;
+	struct ad7746_init_param adcip = { 0 };
 	struct ad7746_iio_dev *adciio = NULL;
 	struct ad7746_iio_init_param adciio_init;
 	struct iio_app_desc *app;
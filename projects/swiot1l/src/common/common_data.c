@@ -320,6 +320,41 @@ struct iio_hw_trig_init_param ad74413r_gpio_trig_ip = {
 
 struct iio_trigger ad74413r_iio_trig_desc = {
 	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
+	.enable = iio_trig_enable,
+	.disable = iio_trig_disable
+};
+
+/* MAX14906 scan timer */
+struct no_os_timer_init_param max14906_timer_ip = {
+	.id = MAX14906_TIMER_DEVICE_ID,
+	.freq_hz = MAX14906_TIMER_FREQ_HZ,
+	.ticks_count = MAX14906_TIMER_TICKS_COUNT,
+	.platform_ops = &max_timer_ops,
+	.extra = MAX14906_TIMER_EXTRA,
+};
+
+struct no_os_irq_init_param max14906_timer_irq_ip = {
+	.irq_ctrl_id = 0,
+	.platform_ops = &max_irq_ops,
+	.extra = NULL,
+};
+
+const struct iio_hw_trig_cb_info max14906_timer_cb_info = {
+	.event = NO_OS_EVT_TIM_ELAPSED,
+	.peripheral = NO_OS_TIM_IRQ,
+	.handle = MAX14906_TIMER_CB_HANDLE,
+};
+
+struct iio_hw_trig_init_param max14906_timer_trig_ip = {
+	.irq_id = MAX14906_TIMER_IRQ_ID,
+	.cb_info = max14906_timer_cb_info,
+	.name = MAX14906_TIMER_TRIG_NAME,
+};
+
+struct iio_trigger max14906_iio_trig_desc = {
+	.is_synchronous = true,
+	.attributes = iio_hw_trig_attrs,
 	.enable = iio_trig_enable,
 	.disable = iio_trig_disable
 };
@@ -46,8 +46,10 @@
 #include "adin1110.h"
 #include "adt75.h"
 #include "iio_trigger.h"
+#include "no_os_timer.h"
 
 #define AD74413R_GPIO_TRIG_NAME "ad74413r-dev0"
+#define MAX14906_TIMER_TRIG_NAME "max14906-timer-trig"
 
 extern struct no_os_uart_init_param uart_ip;
 extern struct adin1110_init_param adin1110_ip;
@@ -87,5 +89,9 @@ extern struct iio_trigger swiot_trigger;
 extern struct iio_hw_trig_init_param ad74413r_gpio_trig_ip;
 extern struct no_os_irq_init_param ad74413r_gpio_irq_ip;
 extern struct iio_trigger ad74413r_iio_trig_desc;
+extern struct no_os_timer_init_param max14906_timer_ip;
+extern struct no_os_irq_init_param max14906_timer_irq_ip;
+extern struct iio_hw_trig_init_param max14906_timer_trig_ip;
+extern struct iio_trigger max14906_iio_trig_desc;
 
 #endif /* __COMMON_DATA_H__ */
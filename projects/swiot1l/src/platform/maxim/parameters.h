@@ -45,6 +45,7 @@
 #include "maxim_i2c.h"
 #include "maxim_uart.h"
 #include "maxim_uart_stdio.h"
+#include "maxim_timer.h"
 
 #ifdef IIO_SUPPORT
 #define INTC_DEVICE_ID  0
@@ -77,4 +78,12 @@ extern struct max_gpio_init_param vddioh_gpio_extra;
 #define GPIO_IRQ_OPS            &max_gpio_irq_ops
 #define GPIO_IRQ_EXTRA          NULL
 
+/* MAX14906 scan timer, 1 kHz */
+#define MAX14906_TIMER_DEVICE_ID	1
+#define MAX14906_TIMER_FREQ_HZ		1000000
+#define MAX14906_TIMER_TICKS_COUNT	1000
+#define MAX14906_TIMER_EXTRA		NULL
+#define MAX14906_TIMER_IRQ_ID		TMR1_IRQn
+#define MAX14906_TIMER_CB_HANDLE	MXC_TMR1
+
 #endif /* __PARAMETERS_H__ */
@@ -57,6 +57,7 @@
 #define IIO_IGNORE_BUFF_OVERRUN_ERR
 
 uint8_t iio_data_buffer[DATA_BUFFER_SIZE * sizeof(uint32_t) * 8];
+uint8_t max14906_data_buffer[DATA_BUFFER_SIZE * sizeof(uint64_t) * 2];
 
 int step_callback(void *arg)
 {
@@ -85,6 +86,9 @@ int swiot_firmware()
 	struct ad74413r_iio_desc *ad74413r_iio_desc;
 	struct no_os_irq_ctrl_desc *ad74413r_nvic;
 	struct iio_hw_trig *ad74413r_trig_desc;
+	struct no_os_irq_ctrl_desc *max14906_timer_irq_desc;
+	struct no_os_timer_desc *max14906_timer_desc;
+	struct iio_hw_trig *max14906_trig_desc;
 	struct max14906_iio_desc *max14906_iio_desc;
 	struct adt75_iio_desc *adt75_iio_desc;
 	struct swiot_iio_desc *swiot_iio_desc;
@@ -115,6 +119,10 @@ int swiot_firmware()
 		.buff = (void *)iio_data_buffer,
 		.size = DATA_BUFFER_SIZE * sizeof(uint32_t) * 8,
 	};
+	struct iio_data_buffer max14906_buff = {
+		.buff = (void *)max14906_data_buffer,
+		.size = sizeof(max14906_data_buffer),
+	};
 
 	struct adt75_iio_init_param adt75_iio_ip;
 	struct iio_app_init_param app_init_param = { 0 };
@@ -186,12 +194,39 @@ int swiot_firmware()
 	if (ret)
 		return ret;
 
+	/* Timer used to scan the MAX14906 channel states and faults */
+	ret = no_os_timer_init(&max14906_timer_desc, &max14906_timer_ip);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_ctrl_init(&max14906_timer_irq_desc,
+				  &max14906_timer_irq_ip);
+	if (ret)
+		return ret;
+
+	ret = no_os_irq_set_priority(max14906_timer_irq_desc,
+				     MAX14906_TIMER_IRQ_ID, 1);
+	if (ret)
+		return ret;
+
+	max14906_timer_trig_ip.irq_ctrl = max14906_timer_irq_desc;
+
+	ret = iio_hw_trig_init(&max14906_trig_desc, &max14906_timer_trig_ip);
+	if (ret)
+		return ret;
+
+	ret = no_os_timer_start(max14906_timer_desc);
+	if (ret)
+		return ret;
+
 	struct iio_trigger_init trigs[] = {
 		/* Software trigger used as a heartbeat by the IIO client */
 		IIO_APP_TRIGGER("sw_trig", sw_trig,
 				&ad74413r_iio_trig_desc),
 		IIO_APP_TRIGGER(AD74413R_GPIO_TRIG_NAME, ad74413r_trig_desc,
 				&ad74413r_iio_trig_desc),
+		IIO_APP_TRIGGER(MAX14906_TIMER_TRIG_NAME, max14906_trig_desc,
+				&max14906_iio_trig_desc),
 	};
 
 	while (1) {
@@ -269,6 +304,7 @@ int swiot_firmware()
 		iio_devices[1].name = "max14906";
 		iio_devices[1].dev = max14906_iio_desc;
 		iio_devices[1].dev_descriptor = max14906_iio_desc->iio_dev;
+		iio_devices[1].read_buff = &max14906_buff;
 
 		iio_devices[2].name = "adt75";
 		iio_devices[2].dev = adt75_iio_desc;
@@ -318,6 +354,7 @@ int swiot_firmware()
 
 		sw_trig->iio_desc = app->iio_desc;
 		ad74413r_trig_desc->iio_desc = app->iio_desc;
+		max14906_trig_desc->iio_desc = app->iio_desc;
 		swiot_iio_desc->adin1110 = app->lwip_desc->mac_desc;
 		app->arg = swiot_iio_desc;
 
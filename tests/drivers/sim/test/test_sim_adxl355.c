@@ -0,0 +1,221 @@
+/***************************************************************************//**
+ *   @file   test_sim_adxl355.c
+ *   @brief  Runs the ADXL355 driver against the simulated device.
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+
+/*******************************************************************************
+ *    INCLUDED FILES
+ ******************************************************************************/
+
+#include "unity.h"
+#include "adxl355.h"
+#include "sim_device.h"
+#include "sim_spi.h"
+#include "sim_adxl355.h"
+#include "no_os_spi.h"
+#include "no_os_alloc.h"
+#include "no_os_util.h"
+#include "mock_no_os_delay.h"
+#include "mock_no_os_mutex.h"
+#include "mock_no_os_i2c.h"
+#include <errno.h>
+
+/* The sine generator table has no header of its own */
+TEST_FILE("no_os_sin_lut.c")
+
+/*******************************************************************************
+ *    PRIVATE DATA
+ ******************************************************************************/
+
+#define SIM_ADXL355_SPI_HZ	10000000
+#define SIM_ADXL355_CS_NS	100
+/* Bus time of a transaction of n bytes at SIM_ADXL355_SPI_HZ */
+#define SIM_ADXL355_XFER_NS(n)	(SIM_ADXL355_CS_NS + (n) * 800)
+/* One sample set at the power-on output data rate of 4 kHz */
+#define SIM_ADXL355_ODR_NS	250000
+
+static struct sim_device *sim;
+static struct adxl355_dev *dev;
+
+static struct sim_adxl355_init_param sim_ip = {
+	.timing = {
+		.xfer_overhead_ns = SIM_ADXL355_CS_NS,
+	},
+	.accel = {
+		{ .type = SIM_GEN_CONST, .offset = 1000 },
+		{ .type = SIM_GEN_CONST, .offset = -1000 },
+		{ .type = SIM_GEN_RAMP, .offset = 100, .amplitude = 2 },
+	},
+	.temp = { .type = SIM_GEN_CONST, .offset = 1885 },
+};
+
+static struct adxl355_init_param adxl355_ip = {
+	.comm_init.spi_init = {
+		.max_speed_hz = SIM_ADXL355_SPI_HZ,
+		.mode = NO_OS_SPI_MODE_0,
+		.platform_ops = &sim_spi_ops,
+	},
+	.comm_type = ADXL355_SPI_COMM,
+	.dev_type = ID_ADXL355,
+};
+
+/*******************************************************************************
+ *    SETUP, TEARDOWN
+ ******************************************************************************/
+
+void setUp(void)
+{
+	no_os_mutex_init_Ignore();
+	no_os_mutex_lock_Ignore();
+	no_os_mutex_unlock_Ignore();
+	no_os_mutex_remove_Ignore();
+
+	TEST_ASSERT_EQUAL_INT(0, sim_adxl355_init(&sim, &sim_ip));
+	adxl355_ip.comm_init.spi_init.extra = sim;
+	dev = NULL;
+}
+
+void tearDown(void)
+{
+	if (dev)
+		adxl355_remove(dev);
+	sim_device_remove(sim);
+}
+
+/*******************************************************************************
+ *    TESTS
+ ******************************************************************************/
+
+void test_sim_adxl355_init(void)
+{
+	struct sim_stats stats;
+	int ret;
+
+	SIM_PROFILE(sim, &stats, ret, adxl355_init(&dev, adxl355_ip));
+	TEST_ASSERT_EQUAL_INT(0, ret);
+	TEST_ASSERT_NOT_NULL(dev);
+
+	/* DEVID_AD, DEVID_MST, PARTID and the 5 shadow registers */
+	TEST_ASSERT_EQUAL_UINT32(4, stats.transactions);
+	TEST_ASSERT_EQUAL_UINT32(3 * 2 + 6, stats.bytes);
+	TEST_ASSERT_EQUAL_UINT64(3 * SIM_ADXL355_XFER_NS(2) +
+				 SIM_ADXL355_XFER_NS(6), stats.bus_ns);
+}
+
+void test_sim_adxl355_init_wrong_part(void)
+{
+	struct sim_device *other;
+	struct sim_adxl355_init_param ip = sim_ip;
+	struct adxl355_dev *tmp = NULL;
+
+	/* The driver must reject a part ID it does not know */
+	ip.part_id = 0xE9;
+	TEST_ASSERT_EQUAL_INT(0, sim_adxl355_init(&other, &ip));
+	adxl355_ip.comm_init.spi_init.extra = other;
+
+	TEST_ASSERT_NOT_EQUAL(0, adxl355_init(&tmp, adxl355_ip));
+	TEST_ASSERT_NULL(tmp);
+
+	sim_device_remove(other);
+}
+
+void test_sim_adxl355_get_raw_xyz(void)
+{
+	struct sim_stats stats;
+	uint32_t x, y, z;
+	int ret;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT(0, adxl355_init(&dev, adxl355_ip));
+
+	for (i = 0; i < 4; i++) {
+		SIM_PROFILE(sim, &stats, ret,
+			    adxl355_get_raw_xyz(dev, &x, &y, &z));
+		TEST_ASSERT_EQUAL_INT(0, ret);
+
+		/* 20 bit two's complement samples */
+		TEST_ASSERT_EQUAL_UINT32(1000, x);
+		TEST_ASSERT_EQUAL_UINT32(NO_OS_BIT(20) - 1000, y);
+		TEST_ASSERT_EQUAL_UINT32(100 + 2 * i, z);
+
+		/* One 3 byte burst per axis */
+		TEST_ASSERT_EQUAL_UINT32(3, stats.transactions);
+		TEST_ASSERT_EQUAL_UINT32(3 * 4, stats.bytes);
+		TEST_ASSERT_EQUAL_UINT64(3 * SIM_ADXL355_XFER_NS(4),
+					 stats.bus_ns);
+	}
+}
+
+void test_sim_adxl355_get_raw_temp(void)
+{
+	uint16_t temp;
+
+	TEST_ASSERT_EQUAL_INT(0, adxl355_init(&dev, adxl355_ip));
+	TEST_ASSERT_EQUAL_INT(0, adxl355_get_raw_temp(dev, &temp));
+	TEST_ASSERT_EQUAL_UINT16(1885, temp);
+}
+
+void test_sim_adxl355_fifo(void)
+{
+	uint32_t x[32], y[32], z[32];
+	uint8_t entries;
+	int i;
+
+	TEST_ASSERT_EQUAL_INT(0, adxl355_init(&dev, adxl355_ip));
+
+	/* Nothing is sampled in standby */
+	sim_device_advance(sim, 10 * SIM_ADXL355_ODR_NS);
+	TEST_ASSERT_EQUAL_INT(0, adxl355_get_nb_of_fifo_entries(dev, &entries));
+	TEST_ASSERT_EQUAL_UINT8(0, entries);
+
+	TEST_ASSERT_EQUAL_INT(0, adxl355_set_op_mode(dev,
+			      ADXL355_MEAS_TEMP_ON_DRDY_ON));
+	sim_device_advance(sim, 10 * SIM_ADXL355_ODR_NS);
+
+	TEST_ASSERT_EQUAL_INT(0, adxl355_get_raw_fifo_data(dev, &entries,
+			      x, y, z));
+	TEST_ASSERT_EQUAL_UINT8(10 * 3, entries);
+	for (i = 0; i < 10; i++) {
+		TEST_ASSERT_EQUAL_UINT32(1000, x[i]);
+		TEST_ASSERT_EQUAL_UINT32(NO_OS_BIT(20) - 1000, y[i]);
+		TEST_ASSERT_EQUAL_UINT32(100 + 2 * i, z[i]);
+	}
+
+	/* The FIFO holds 32 sample sets, older data is dropped */
+	sim_device_advance(sim, 40 * SIM_ADXL355_ODR_NS);
+	TEST_ASSERT_EQUAL_INT(0, adxl355_get_nb_of_fifo_entries(dev, &entries));
+	TEST_ASSERT_EQUAL_UINT8(32 * 3, entries);
+}
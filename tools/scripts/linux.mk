@@ -8,6 +8,9 @@ PROJECT_BUILD = $(BUILD_DIR)/app
 CFLAGS +=  -g3 \
 		-DLINUX_PLATFORM \
 
+# Used by the IRQ and DMA emulation
+LIB_FLAGS += -lpthread
+
 $(PLATFORM)_project:
 	$(call mk_dir, $(BUILD_DIR)) $(HIDE)
 
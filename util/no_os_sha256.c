@@ -0,0 +1,286 @@
+/***************************************************************************//**
+ *   @file   no_os_sha256.c
+ *   @brief  SHA-256 and HMAC-SHA-256 (FIPS 180-4, RFC 2104).
+********************************************************************************
+ * Copyright 2024(c) Analog Devices, Inc.
+ *
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *  - Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *  - Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in
+ *    the documentation and/or other materials provided with the
+ *    distribution.
+ *  - Neither the name of Analog Devices, Inc. nor the names of its
+ *    contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *  - The use of this software may or may not infringe the patent rights
+ *    of one or more patent holders.  This license does not release you
+ *    from the requirement that you obtain separate licenses from these
+ *    patent holders to use this software.
+ *  - Use of the software either in source or binary form, must be run
+ *    on or directly connected to an Analog Devices Inc. component.
+ *
+ * THIS SOFTWARE IS PROVIDED BY ANALOG DEVICES "AS IS" AND ANY EXPRESS OR
+ * IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, NON-INFRINGEMENT,
+ * MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED.
+ * IN NO EVENT SHALL ANALOG DEVICES BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, INTELLECTUAL PROPERTY RIGHTS, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*******************************************************************************/
+#include <string.h>
+#include "no_os_sha256.h"
+#include "no_os_util.h"
+
+#define SHA256_ROR(x, n)	(((x) >> (n)) | ((x) << (32 - (n))))
+#define SHA256_CH(x, y, z)	(((x) & (y)) ^ (~(x) & (z)))
+#define SHA256_MAJ(x, y, z)	(((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SHA256_EP0(x)	(SHA256_ROR(x, 2) ^ SHA256_ROR(x, 13) ^ \
+			 SHA256_ROR(x, 22))
+#define SHA256_EP1(x)	(SHA256_ROR(x, 6) ^ SHA256_ROR(x, 11) ^ \
+			 SHA256_ROR(x, 25))
+#define SHA256_SIG0(x)	(SHA256_ROR(x, 7) ^ SHA256_ROR(x, 18) ^ ((x) >> 3))
+#define SHA256_SIG1(x)	(SHA256_ROR(x, 17) ^ SHA256_ROR(x, 19) ^ ((x) >> 10))
+
+static const uint32_t sha256_k[64] = {
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+	0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+	0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+	0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+	0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+	0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+	0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+	0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+/***************************************************************************//**
+ * @brief Process one 64 byte block.
+ *
+ * @param ctx   - SHA-256 context.
+ * @param block - Message block.
+*******************************************************************************/
+static void no_os_sha256_transform(struct no_os_sha256_ctx *ctx,
+				   const uint8_t *block)
+{
+	uint32_t a, b, c, d, e, f, g, h, t1, t2;
+	uint32_t w[64];
+	int i;
+
+	for (i = 0; i < 16; i++)
+		w[i] = no_os_get_unaligned_be32((uint8_t *)&block[i * 4]);
+	for (; i < 64; i++)
+		w[i] = SHA256_SIG1(w[i - 2]) + w[i - 7] +
+		       SHA256_SIG0(w[i - 15]) + w[i - 16];
+
+	a = ctx->state[0];
+	b = ctx->state[1];
+	c = ctx->state[2];
+	d = ctx->state[3];
+	e = ctx->state[4];
+	f = ctx->state[5];
+	g = ctx->state[6];
+	h = ctx->state[7];
+
+	for (i = 0; i < 64; i++) {
+		t1 = h + SHA256_EP1(e) + SHA256_CH(e, f, g) + sha256_k[i] +
+		     w[i];
+		t2 = SHA256_EP0(a) + SHA256_MAJ(a, b, c);
+		h = g;
+		g = f;
+		f = e;
+		e = d + t1;
+		d = c;
+		c = b;
+		b = a;
+		a = t1 + t2;
+	}
+
+	ctx->state[0] += a;
+	ctx->state[1] += b;
+	ctx->state[2] += c;
+	ctx->state[3] += d;
+	ctx->state[4] += e;
+	ctx->state[5] += f;
+	ctx->state[6] += g;
+	ctx->state[7] += h;
+}
+
+/***************************************************************************//**
+ * @brief Start a SHA-256 computation.
+ *
+ * @param ctx - SHA-256 context.
+*******************************************************************************/
+void no_os_sha256_init(struct no_os_sha256_ctx *ctx)
+{
+	ctx->state[0] = 0x6a09e667;
+	ctx->state[1] = 0xbb67ae85;
+	ctx->state[2] = 0x3c6ef372;
+	ctx->state[3] = 0xa54ff53a;
+	ctx->state[4] = 0x510e527f;
+	ctx->state[5] = 0x9b05688c;
+	ctx->state[6] = 0x1f83d9ab;
+	ctx->state[7] = 0x5be0cd19;
+	ctx->len = 0;
+}
+
+/***************************************************************************//**
+ * @brief Hash more message bytes.
+ *
+ * @param ctx  - SHA-256 context.
+ * @param data - Message bytes.
+ * @param len  - Number of message bytes.
+*******************************************************************************/
+void no_os_sha256_update(struct no_os_sha256_ctx *ctx, const uint8_t *data,
+			 size_t len)
+{
+	size_t used = ctx->len % NO_OS_SHA256_BLOCK_SIZE;
+	size_t n;
+
+	ctx->len += len;
+
+	if (used) {
+		n = no_os_min(len, NO_OS_SHA256_BLOCK_SIZE - used);
+		memcpy(&ctx->block[used], data, n);
+		data += n;
+		len -= n;
+		if (used + n < NO_OS_SHA256_BLOCK_SIZE)
+			return;
+
+		no_os_sha256_transform(ctx, ctx->block);
+	}
+
+	while (len >= NO_OS_SHA256_BLOCK_SIZE) {
+		no_os_sha256_transform(ctx, data);
+		data += NO_OS_SHA256_BLOCK_SIZE;
+		len -= NO_OS_SHA256_BLOCK_SIZE;
+	}
+
+	memcpy(ctx->block, data, len);
+}
+
+/***************************************************************************//**
+ * @brief Finish a SHA-256 computation.
+ *
+ * @param ctx    - SHA-256 context.
+ * @param digest - Resulting digest.
+*******************************************************************************/
+void no_os_sha256_final(struct no_os_sha256_ctx *ctx,
+			uint8_t digest[NO_OS_SHA256_DIGEST_SIZE])
+{
+	size_t used = ctx->len % NO_OS_SHA256_BLOCK_SIZE;
+	uint64_t bits = ctx->len * 8;
+	int i;
+
+	ctx->block[used++] = 0x80;
+	if (used > NO_OS_SHA256_BLOCK_SIZE - 8) {
+		memset(&ctx->block[used], 0, NO_OS_SHA256_BLOCK_SIZE - used);
+		no_os_sha256_transform(ctx, ctx->block);
+		used = 0;
+	}
+	memset(&ctx->block[used], 0, NO_OS_SHA256_BLOCK_SIZE - 8 - used);
+	no_os_put_unaligned_be32(bits >> 32, &ctx->block[56]);
+	no_os_put_unaligned_be32(bits, &ctx->block[60]);
+	no_os_sha256_transform(ctx, ctx->block);
+
+	for (i = 0; i < 8; i++)
+		no_os_put_unaligned_be32(ctx->state[i], &digest[i * 4]);
+}
+
+/***************************************************************************//**
+ * @brief Compute the SHA-256 digest of a message.
+ *
+ * @param data   - Message.
+ * @param len    - Message length.
+ * @param digest - Resulting digest.
+*******************************************************************************/
+void no_os_sha256(const uint8_t *data, size_t len,
+		  uint8_t digest[NO_OS_SHA256_DIGEST_SIZE])
+{
+	struct no_os_sha256_ctx ctx;
+
+	no_os_sha256_init(&ctx);
+	no_os_sha256_update(&ctx, data, len);
+	no_os_sha256_final(&ctx, digest);
+}
+
+/***************************************************************************//**
+ * @brief Set the HMAC key and precompute the keyed inner and outer states.
+ *
+ * @param ctx     - HMAC-SHA-256 context.
+ * @param key     - Key.
+ * @param key_len - Key length. Keys longer than a block are hashed first.
+*******************************************************************************/
+void no_os_hmac_sha256_setkey(struct no_os_hmac_sha256_ctx *ctx,
+			      const uint8_t *key, size_t key_len)
+{
+	uint8_t pad[NO_OS_SHA256_BLOCK_SIZE] = {0};
+	int i;
+
+	if (key_len > NO_OS_SHA256_BLOCK_SIZE)
+		no_os_sha256(key, key_len, pad);
+	else
+		memcpy(pad, key, key_len);
+
+	for (i = 0; i < NO_OS_SHA256_BLOCK_SIZE; i++)
+		pad[i] ^= 0x36;
+	no_os_sha256_init(&ctx->inner);
+	no_os_sha256_update(&ctx->inner, pad, NO_OS_SHA256_BLOCK_SIZE);
+
+	for (i = 0; i < NO_OS_SHA256_BLOCK_SIZE; i++)
+		pad[i] ^= 0x36 ^ 0x5c;
+	no_os_sha256_init(&ctx->outer);
+	no_os_sha256_update(&ctx->outer, pad, NO_OS_SHA256_BLOCK_SIZE);
+
+	memset(pad, 0, sizeof(pad));
+	no_os_hmac_sha256_start(ctx);
+}
+
+/***************************************************************************//**
+ * @brief Start authenticating a new message with the current key.
+ *
+ * @param ctx - HMAC-SHA-256 context.
+*******************************************************************************/
+void no_os_hmac_sha256_start(struct no_os_hmac_sha256_ctx *ctx)
+{
+	ctx->msg = ctx->inner;
+}
+
+/***************************************************************************//**
+ * @brief Authenticate more message bytes.
+ *
+ * @param ctx  - HMAC-SHA-256 context.
+ * @param data - Message bytes.
+ * @param len  - Number of message bytes.
+*******************************************************************************/
+void no_os_hmac_sha256_update(struct no_os_hmac_sha256_ctx *ctx,
+			      const uint8_t *data, size_t len)
+{
+	no_os_sha256_update(&ctx->msg, data, len);
+}
+
+/***************************************************************************//**
+ * @brief Finish the message and get its MAC.
+ *
+ * @param ctx - HMAC-SHA-256 context.
+ * @param mac - Resulting MAC.
+*******************************************************************************/
+void no_os_hmac_sha256_final(struct no_os_hmac_sha256_ctx *ctx,
+			     uint8_t mac[NO_OS_SHA256_DIGEST_SIZE])
+{
+	struct no_os_sha256_ctx outer = ctx->outer;
+	uint8_t inner[NO_OS_SHA256_DIGEST_SIZE];
+
+	no_os_sha256_final(&ctx->msg, inner);
+	no_os_sha256_update(&outer, inner, sizeof(inner));
+	no_os_sha256_final(&outer, mac);
+}
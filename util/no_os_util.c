@@ -429,6 +429,77 @@ bool no_os_is_big_endian(void)
 	return (bool) *(uint8_t *)&a;
 }
 
+/**
+ * @brief Extract a bitfield from a big endian (MSB first) bit stream.
+ * @param buf - The bit stream.
+ * @param offset - Position of the field MSB, in bits from the start of buf.
+ * @param width - Field width in bits, 1 to 32.
+ * @return The right aligned field value.
+ */
+uint32_t no_os_get_bitfield_be(const uint8_t *buf, uint32_t offset,
+			       uint8_t width)
+{
+	uint32_t last = (offset + width - 1) / 8;
+	uint64_t acc = 0;
+	uint32_t i;
+
+	for (i = offset / 8; i <= last; i++)
+		acc = (acc << 8) | buf[i];
+
+	acc >>= (last + 1) * 8 - (offset + width);
+
+	return acc & (((uint64_t)1 << width) - 1);
+}
+
+/**
+ * @brief Unpack the selected bitfields of a frame into a packed array.
+ *
+ * Lets drivers describe packed or status-appended conversion frames with a
+ * constant field table instead of per-layout shift and mask loops. The
+ * fields selected by mask are written back to back, in table order, which
+ * matches the layout of an IIO scan with one storage size for all channels.
+ * @param frame - The big endian frame.
+ * @param fields - Field table.
+ * @param nb_fields - Number of entries in fields, up to 32.
+ * @param mask - Bit i selects fields[i].
+ * @param storage - Size of one output element: 1, 2 or 4 bytes.
+ * @param out - Output array.
+ * @return Number of elements written to out.
+ */
+uint32_t no_os_unpack_bitfields(const uint8_t *frame,
+				const struct no_os_bitfield *fields,
+				uint32_t nb_fields, uint32_t mask,
+				uint8_t storage, void *out)
+{
+	const struct no_os_bitfield *f;
+	uint32_t i, val, n = 0;
+
+	for (i = 0; i < nb_fields; i++) {
+		if (!(mask & NO_OS_BIT(i)))
+			continue;
+
+		f = &fields[i];
+		val = no_os_get_bitfield_be(frame, f->offset, f->width);
+		if (f->is_signed)
+			val = no_os_sign_extend32(val, f->width - 1);
+
+		switch (storage) {
+		case 1:
+			((uint8_t *)out)[n] = val;
+			break;
+		case 2:
+			((uint16_t *)out)[n] = val;
+			break;
+		default:
+			((uint32_t *)out)[n] = val;
+			break;
+		}
+		n++;
+	}
+
+	return n;
+}
+
 /* @brief Swap bytes in a buffer with a given step
  *        Swap with step of 2:
  *        AA BB CC DD EE FF 00 11 becomes